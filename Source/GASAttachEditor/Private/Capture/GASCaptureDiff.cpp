@@ -0,0 +1,496 @@
+#include "Capture/GASCaptureDiff.h"
+#include "Capture/GASCaptureFile.h"
+#include "Capture/GASFreezeFrame.h"
+#include "HAL/IConsoleManager.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+namespace GASCaptureDiff
+{
+	// 同一个效果类的汇总
+	// Totals of one effect class
+	struct FEffectTotals
+	{
+		int32 Count = 0;
+
+		int32 InfiniteCount = 0;
+
+		int32 Stacks = 0;
+	};
+
+	void GatherEffects(const FGASCaptureAscSnapshot& InSnapshot, TMap<FName, FEffectTotals>& OutEffects)
+	{
+		for (const FGASCaptureEffect& Effect : InSnapshot.Effects)
+		{
+			FEffectTotals& Totals = OutEffects.FindOrAdd(Effect.Definition);
+			++Totals.Count;
+			Totals.InfiniteCount += Effect.Duration <= 0.f ? 1 : 0;
+			Totals.Stacks += Effect.StackCount;
+		}
+	}
+
+	void AddEffectTotals(TMap<FName, FGASCaptureEffectDelta>& InOutTotals, const FGASCaptureEffectDelta& InDelta)
+	{
+		FGASCaptureEffectDelta& Total = InOutTotals.FindOrAdd(InDelta.Definition);
+		Total.Definition = InDelta.Definition;
+		Total.OldCount += InDelta.OldCount;
+		Total.NewCount += InDelta.NewCount;
+		Total.OldInfiniteCount += InDelta.OldInfiniteCount;
+		Total.NewInfiniteCount += InDelta.NewInfiniteCount;
+		Total.OldStacks += InDelta.OldStacks;
+		Total.NewStacks += InDelta.NewStacks;
+	}
+
+	// 把一边的ASC的所有效果计入汇总
+	// Counts every effect of an ASC on one side
+	void AddSnapshotEffects(TMap<FName, FGASCaptureEffectDelta>& InOutTotals, const FGASCaptureAscSnapshot& InSnapshot, bool bIsNew)
+	{
+		TMap<FName, FEffectTotals> Effects;
+		GatherEffects(InSnapshot, Effects);
+
+		for (const TPair<FName, FEffectTotals>& Pair : Effects)
+		{
+			FGASCaptureEffectDelta Delta;
+			Delta.Definition = Pair.Key;
+			(bIsNew ? Delta.NewCount : Delta.OldCount) = Pair.Value.Count;
+			(bIsNew ? Delta.NewInfiniteCount : Delta.OldInfiniteCount) = Pair.Value.InfiniteCount;
+			(bIsNew ? Delta.NewStacks : Delta.OldStacks) = Pair.Value.Stacks;
+			AddEffectTotals(InOutTotals, Delta);
+		}
+	}
+
+	FString GetDisplayName(const FGASCaptureAscSnapshot& InSnapshot)
+	{
+		return FString::Printf(TEXT("%s [%s]"), *InSnapshot.Actor.ToString(), *InSnapshot.ActorClass.ToString());
+	}
+
+	void DiffAbilitySystem(const FGASCaptureAscSnapshot& InOld, const FGASCaptureAscSnapshot& InNew, FGASCaptureAscDiff& OutDiff)
+	{
+		OutDiff.Actor = InOld.Actor;
+		OutDiff.OtherActor = InOld.Actor != InNew.Actor ? InNew.Actor : NAME_None;
+		OutDiff.ActorClass = InOld.ActorClass;
+
+		// 技能
+		// Abilities
+		{
+			TSet<FName> OldAbilities;
+			for (const FGASCaptureAbility& Ability : InOld.Abilities)
+			{
+				OldAbilities.Add(Ability.Ability);
+			}
+
+			TSet<FName> NewAbilities;
+			for (const FGASCaptureAbility& Ability : InNew.Abilities)
+			{
+				NewAbilities.Add(Ability.Ability);
+			}
+
+			OutDiff.AddedAbilities = NewAbilities.Difference(OldAbilities).Array();
+			OutDiff.RemovedAbilities = OldAbilities.Difference(NewAbilities).Array();
+		}
+
+		// 效果
+		// Effects
+		{
+			TMap<FName, FEffectTotals> OldEffects;
+			GatherEffects(InOld, OldEffects);
+
+			TMap<FName, FEffectTotals> NewEffects;
+			GatherEffects(InNew, NewEffects);
+
+			TSet<FName> Definitions;
+			OldEffects.GetKeys(Definitions);
+			for (const TPair<FName, FEffectTotals>& Pair : NewEffects)
+			{
+				Definitions.Add(Pair.Key);
+			}
+
+			for (FName Definition : Definitions)
+			{
+				const FEffectTotals OldTotals = OldEffects.FindRef(Definition);
+				const FEffectTotals NewTotals = NewEffects.FindRef(Definition);
+				if (OldTotals.Count == NewTotals.Count && OldTotals.InfiniteCount == NewTotals.InfiniteCount && OldTotals.Stacks == NewTotals.Stacks)
+				{
+					continue;
+				}
+
+				FGASCaptureEffectDelta& Delta = OutDiff.Effects.AddDefaulted_GetRef();
+				Delta.Definition = Definition;
+				Delta.OldCount = OldTotals.Count;
+				Delta.NewCount = NewTotals.Count;
+				Delta.OldInfiniteCount = OldTotals.InfiniteCount;
+				Delta.NewInfiniteCount = NewTotals.InfiniteCount;
+				Delta.OldStacks = OldTotals.Stacks;
+				Delta.NewStacks = NewTotals.Stacks;
+			}
+		}
+
+		// 属性，只在一边存在的属性也列出
+		// Attributes; attributes present on one side only are listed too
+		{
+			TMap<FName, const FGASCaptureAttribute*> OldAttributes;
+			for (const FGASCaptureAttribute& Attribute : InOld.Attributes)
+			{
+				OldAttributes.Add(Attribute.Attribute, &Attribute);
+			}
+
+			for (const FGASCaptureAttribute& Attribute : InNew.Attributes)
+			{
+				const FGASCaptureAttribute* OldAttribute = nullptr;
+				OldAttributes.RemoveAndCopyValue(Attribute.Attribute, OldAttribute);
+
+				if (OldAttribute && FMath::IsNearlyEqual(OldAttribute->CurrentValue, Attribute.CurrentValue) && FMath::IsNearlyEqual(OldAttribute->BaseValue, Attribute.BaseValue))
+				{
+					continue;
+				}
+
+				FGASCaptureAttributeDelta& Delta = OutDiff.Attributes.AddDefaulted_GetRef();
+				Delta.Attribute = Attribute.Attribute;
+				Delta.OldValue = OldAttribute ? OldAttribute->CurrentValue : 0.f;
+				Delta.OldBaseValue = OldAttribute ? OldAttribute->BaseValue : 0.f;
+				Delta.NewValue = Attribute.CurrentValue;
+				Delta.NewBaseValue = Attribute.BaseValue;
+			}
+
+			for (const TPair<FName, const FGASCaptureAttribute*>& Pair : OldAttributes)
+			{
+				FGASCaptureAttributeDelta& Delta = OutDiff.Attributes.AddDefaulted_GetRef();
+				Delta.Attribute = Pair.Key;
+				Delta.OldValue = Pair.Value->CurrentValue;
+				Delta.OldBaseValue = Pair.Value->BaseValue;
+			}
+		}
+
+		// 标签
+		// Tags
+		{
+			TMap<FName, int32> OldTags;
+			for (const FGASCaptureTagCount& Tag : InOld.Tags)
+			{
+				OldTags.Add(Tag.Tag, Tag.Count);
+			}
+
+			for (const FGASCaptureTagCount& Tag : InNew.Tags)
+			{
+				int32 OldCount = 0;
+				OldTags.RemoveAndCopyValue(Tag.Tag, OldCount);
+				if (OldCount != Tag.Count)
+				{
+					OutDiff.Tags.Add({ Tag.Tag, OldCount, Tag.Count });
+				}
+			}
+
+			for (const TPair<FName, int32>& Pair : OldTags)
+			{
+				OutDiff.Tags.Add({ Pair.Key, Pair.Value, 0 });
+			}
+
+			TSet<FName> OldBlockedTags(InOld.BlockedTags);
+			TSet<FName> NewBlockedTags(InNew.BlockedTags);
+			OutDiff.AddedBlockedTags = NewBlockedTags.Difference(OldBlockedTags).Array();
+			OutDiff.RemovedBlockedTags = OldBlockedTags.Difference(NewBlockedTags).Array();
+		}
+	}
+
+	// 可以是冻结帧编号，或者录制文件[@帧号]
+	// Either a freeze frame id, or a capture file[@frame]
+	bool LoadSnapshot(const FString& InSource, FGASCaptureWorldSnapshot& OutSnapshot)
+	{
+		if (InSource.IsNumeric())
+		{
+			const int32 Id = FCString::Atoi(*InSource);
+			for (const TSharedRef<const FGASFreezeFrame>& FreezeFrame : FGASFreezeFrames::GetFreezeFrames())
+			{
+				if (FreezeFrame->Id == Id)
+				{
+					OutSnapshot = *FreezeFrame->Snapshot;
+					return true;
+				}
+			}
+
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("No freeze frame #%d"), Id);
+			return false;
+		}
+
+		FString Filename = InSource;
+		uint64 Frame = MAX_uint64;
+
+		FString FrameString;
+		if (InSource.Split(TEXT("@"), &Filename, &FrameString, ESearchCase::IgnoreCase, ESearchDir::FromEnd))
+		{
+			LexFromString(Frame, *FrameString);
+		}
+
+		FGASCaptureReader Reader;
+		if (!Reader.Open(FGASCaptureReader::ResolveFilename(Filename)))
+		{
+			return false;
+		}
+
+		if (!Reader.ReadKeyframe(Frame, OutSnapshot))
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("No keyframe at or before frame %llu in %s"), Frame, *Reader.GetFilename());
+			return false;
+		}
+
+		return true;
+	}
+}
+
+static FAutoConsoleCommand GASAttachEditorDiffCmd(
+	TEXT("GASAttachEditor.Diff"),
+	TEXT("Compares two GAS snapshots: <Old> <New>, each a freeze frame id or a capture file (or 'latest') with an optional @Frame for the keyframe to use."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 2)
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Usage: GASAttachEditor.Diff <Old> <New>"));
+			return;
+		}
+
+		FGASCaptureWorldSnapshot OldSnapshot;
+		FGASCaptureWorldSnapshot NewSnapshot;
+		if (!GASCaptureDiff::LoadSnapshot(Args[0], OldSnapshot) || !GASCaptureDiff::LoadSnapshot(Args[1], NewSnapshot))
+		{
+			return;
+		}
+
+		FGASCaptureSnapshotDiff Diff;
+		FGASCaptureDiff::Diff(OldSnapshot, NewSnapshot, Diff);
+		FGASCaptureDiff::LogDiff(Diff);
+	}));
+
+uint32 FGASCaptureDiff::HashAbilitySystem(const FGASCaptureAscSnapshot& InSnapshot)
+{
+	// 各项哈希相加，和数组顺序无关
+	// Item hashes are summed so the array order does not matter
+	uint32 TagsHash = 0;
+	for (const FGASCaptureTagCount& Tag : InSnapshot.Tags)
+	{
+		TagsHash += HashCombine(GetTypeHash(Tag.Tag), GetTypeHash(Tag.Count));
+	}
+
+	uint32 BlockedTagsHash = 0;
+	for (const FName& Tag : InSnapshot.BlockedTags)
+	{
+		BlockedTagsHash += GetTypeHash(Tag);
+	}
+
+	uint32 AttributesHash = 0;
+	for (const FGASCaptureAttribute& Attribute : InSnapshot.Attributes)
+	{
+		AttributesHash += HashCombine(GetTypeHash(Attribute.Attribute), HashCombine(GetTypeHash(Attribute.CurrentValue), GetTypeHash(Attribute.BaseValue)));
+	}
+
+	// 效果的句柄和开始时间每次运行都不同，不计入
+	// Effect handles and start times differ on every run and are left out
+	uint32 EffectsHash = 0;
+	for (const FGASCaptureEffect& Effect : InSnapshot.Effects)
+	{
+		EffectsHash += HashCombine(GetTypeHash(Effect.Definition), HashCombine(GetTypeHash(Effect.StackCount), GetTypeHash(Effect.Duration <= 0.f)));
+	}
+
+	uint32 AbilitiesHash = 0;
+	for (const FGASCaptureAbility& Ability : InSnapshot.Abilities)
+	{
+		AbilitiesHash += GetTypeHash(Ability.Ability);
+	}
+
+	uint32 Hash = GetTypeHash(InSnapshot.ActorClass);
+	Hash = HashCombine(Hash, TagsHash);
+	Hash = HashCombine(Hash, BlockedTagsHash);
+	Hash = HashCombine(Hash, AttributesHash);
+	Hash = HashCombine(Hash, EffectsHash);
+	Hash = HashCombine(Hash, AbilitiesHash);
+	return Hash;
+}
+
+void FGASCaptureDiff::Diff(const FGASCaptureWorldSnapshot& InOld, const FGASCaptureWorldSnapshot& InNew, FGASCaptureSnapshotDiff& OutDiff)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_SnapshotDiff);
+
+	OutDiff = FGASCaptureSnapshotDiff();
+
+	TArrayView<const FGASCaptureAscSnapshot> OldAbilitySystems = InOld.GetAbilitySystems();
+	TArrayView<const FGASCaptureAscSnapshot> NewAbilitySystems = InNew.GetAbilitySystems();
+
+	// 先按角色名和类精确匹配
+	// Exact matches by actor name and class first
+	TMap<TPair<FName, FName>, int32> NewByName;
+	for (int32 Index = 0; Index < NewAbilitySystems.Num(); ++Index)
+	{
+		NewByName.Add(TPair<FName, FName>(NewAbilitySystems[Index].Actor, NewAbilitySystems[Index].ActorClass), Index);
+	}
+
+	TArray<int32> OldToNew;
+	OldToNew.Init(INDEX_NONE, OldAbilitySystems.Num());
+	TBitArray<> NewMatched(false, NewAbilitySystems.Num());
+
+	for (int32 Index = 0; Index < OldAbilitySystems.Num(); ++Index)
+	{
+		int32 NewIndex = INDEX_NONE;
+		if (NewByName.RemoveAndCopyValue(TPair<FName, FName>(OldAbilitySystems[Index].Actor, OldAbilitySystems[Index].ActorClass), NewIndex))
+		{
+			OldToNew[Index] = NewIndex;
+			NewMatched[NewIndex] = true;
+		}
+	}
+
+	// 剩下的按类依次匹配，不同版本里角色名的后缀可能不同
+	// The rest are matched by class in order since actor name suffixes can differ between builds
+	TMap<FName, TArray<int32>> UnmatchedNewByClass;
+	for (int32 Index = NewAbilitySystems.Num() - 1; Index >= 0; --Index)
+	{
+		if (!NewMatched[Index])
+		{
+			UnmatchedNewByClass.FindOrAdd(NewAbilitySystems[Index].ActorClass).Add(Index);
+		}
+	}
+
+	for (int32 Index = 0; Index < OldAbilitySystems.Num(); ++Index)
+	{
+		if (OldToNew[Index] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		TArray<int32>* Candidates = UnmatchedNewByClass.Find(OldAbilitySystems[Index].ActorClass);
+		if (Candidates && Candidates->Num() > 0)
+		{
+			const int32 NewIndex = Candidates->Pop(EAllowShrinking::No);
+			OldToNew[Index] = NewIndex;
+			NewMatched[NewIndex] = true;
+		}
+	}
+
+	TMap<FName, FGASCaptureEffectDelta> EffectTotals;
+
+	for (int32 Index = 0; Index < OldAbilitySystems.Num(); ++Index)
+	{
+		const FGASCaptureAscSnapshot& OldSnapshot = OldAbilitySystems[Index];
+
+		if (OldToNew[Index] == INDEX_NONE)
+		{
+			OutDiff.RemovedAbilitySystems.Add(GASCaptureDiff::GetDisplayName(OldSnapshot));
+			GASCaptureDiff::AddSnapshotEffects(EffectTotals, OldSnapshot, false);
+			continue;
+		}
+
+		// 汇总包括没有变化的ASC，新旧数量才是全部ASC的总数
+		// Totals include unchanged ASCs so the old and new counts cover every ASC
+		const FGASCaptureAscSnapshot& NewSnapshot = NewAbilitySystems[OldToNew[Index]];
+		GASCaptureDiff::AddSnapshotEffects(EffectTotals, OldSnapshot, false);
+		GASCaptureDiff::AddSnapshotEffects(EffectTotals, NewSnapshot, true);
+
+		if (HashAbilitySystem(OldSnapshot) == HashAbilitySystem(NewSnapshot))
+		{
+			++OutDiff.NumUnchanged;
+			continue;
+		}
+
+		FGASCaptureAscDiff AscDiff;
+		GASCaptureDiff::DiffAbilitySystem(OldSnapshot, NewSnapshot, AscDiff);
+
+		// 哈希冲突之外，只有效果句柄等被忽略的内容不同时也会为空
+		// Besides hash collisions, it is also empty when only ignored content such as effect handles differs
+		if (AscDiff.IsEmpty())
+		{
+			++OutDiff.NumUnchanged;
+			continue;
+		}
+
+		OutDiff.Changed.Add(MoveTemp(AscDiff));
+	}
+
+	for (int32 Index = 0; Index < NewAbilitySystems.Num(); ++Index)
+	{
+		if (!NewMatched[Index])
+		{
+			OutDiff.AddedAbilitySystems.Add(GASCaptureDiff::GetDisplayName(NewAbilitySystems[Index]));
+			GASCaptureDiff::AddSnapshotEffects(EffectTotals, NewAbilitySystems[Index], true);
+		}
+	}
+
+	EffectTotals.GenerateValueArray(OutDiff.EffectTotals);
+	OutDiff.EffectTotals.Sort([](const FGASCaptureEffectDelta& A, const FGASCaptureEffectDelta& B)
+	{
+		return FMath::Abs(A.NewCount - A.OldCount) > FMath::Abs(B.NewCount - B.OldCount);
+	});
+
+	OutDiff.Changed.Sort([](const FGASCaptureAscDiff& A, const FGASCaptureAscDiff& B)
+	{
+		return A.Actor.LexicalLess(B.Actor);
+	});
+}
+
+void FGASCaptureDiff::LogDiff(const FGASCaptureSnapshotDiff& InDiff)
+{
+	UE_LOG(LogGASAttachEditor, Display, TEXT("GAS diff: %d changed, %d unchanged, %d added, %d removed ASC(s)"),
+		InDiff.Changed.Num(), InDiff.NumUnchanged, InDiff.AddedAbilitySystems.Num(), InDiff.RemovedAbilitySystems.Num());
+
+	for (const FString& Name : InDiff.AddedAbilitySystems)
+	{
+		UE_LOG(LogGASAttachEditor, Display, TEXT("  + %s"), *Name);
+	}
+
+	for (const FString& Name : InDiff.RemovedAbilitySystems)
+	{
+		UE_LOG(LogGASAttachEditor, Display, TEXT("  - %s"), *Name);
+	}
+
+	for (const FGASCaptureEffectDelta& Total : InDiff.EffectTotals)
+	{
+		// 日志里只列出有变化的效果类
+		// Only effect classes that changed are logged
+		if (Total.OldCount == Total.NewCount && Total.OldInfiniteCount == Total.NewInfiniteCount && Total.OldStacks == Total.NewStacks)
+		{
+			continue;
+		}
+
+		UE_LOG(LogGASAttachEditor, Display, TEXT("  Effect %s: %d -> %d (infinite %d -> %d, stacks %d -> %d)"),
+			*Total.Definition.ToString(), Total.OldCount, Total.NewCount, Total.OldInfiniteCount, Total.NewInfiniteCount, Total.OldStacks, Total.NewStacks);
+	}
+
+	for (const FGASCaptureAscDiff& AscDiff : InDiff.Changed)
+	{
+		UE_LOG(LogGASAttachEditor, Display, TEXT("  %s [%s]%s"), *AscDiff.Actor.ToString(), *AscDiff.ActorClass.ToString(),
+			AscDiff.OtherActor.IsNone() ? TEXT("") : *FString::Printf(TEXT(" <-> %s"), *AscDiff.OtherActor.ToString()));
+
+		for (const FName& Ability : AscDiff.AddedAbilities)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("    + Ability %s"), *Ability.ToString());
+		}
+
+		for (const FName& Ability : AscDiff.RemovedAbilities)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("    - Ability %s"), *Ability.ToString());
+		}
+
+		for (const FGASCaptureEffectDelta& Delta : AscDiff.Effects)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("    Effect %s: %d -> %d (infinite %d -> %d, stacks %d -> %d)"),
+				*Delta.Definition.ToString(), Delta.OldCount, Delta.NewCount, Delta.OldInfiniteCount, Delta.NewInfiniteCount, Delta.OldStacks, Delta.NewStacks);
+		}
+
+		for (const FGASCaptureAttributeDelta& Delta : AscDiff.Attributes)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("    Attribute %s: %s -> %s (base %s -> %s)"),
+				*Delta.Attribute.ToString(), *LexToSanitizedString(Delta.OldValue), *LexToSanitizedString(Delta.NewValue), *LexToSanitizedString(Delta.OldBaseValue), *LexToSanitizedString(Delta.NewBaseValue));
+		}
+
+		for (const FGASCaptureCountDelta& Delta : AscDiff.Tags)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("    %s Tag %s: %d -> %d"), Delta.OldCount == 0 ? TEXT("+") : Delta.NewCount == 0 ? TEXT("-") : TEXT("~"), *Delta.Name.ToString(), Delta.OldCount, Delta.NewCount);
+		}
+
+		for (const FName& Tag : AscDiff.AddedBlockedTags)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("    + Blocked %s"), *Tag.ToString());
+		}
+
+		for (const FName& Tag : AscDiff.RemovedBlockedTags)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("    - Blocked %s"), *Tag.ToString());
+		}
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/GASCaptureTypes.h"
+
+// 数量的变化，旧值为0表示新增，新值为0表示移除
+// A count that changed; an old value of 0 means added, a new value of 0 means removed
+struct FGASCaptureCountDelta
+{
+	FName Name;
+
+	int32 OldCount = 0;
+
+	int32 NewCount = 0;
+};
+
+struct FGASCaptureAttributeDelta
+{
+	FName Attribute;
+
+	float OldValue = 0.f;
+
+	float NewValue = 0.f;
+
+	float OldBaseValue = 0.f;
+
+	float NewBaseValue = 0.f;
+};
+
+// 同一个效果类的实例数量、无限时长的实例数量和层数的变化
+// Change in instance count, infinite instance count and stacks of one effect class
+struct FGASCaptureEffectDelta
+{
+	FName Definition;
+
+	int32 OldCount = 0;
+
+	int32 NewCount = 0;
+
+	int32 OldInfiniteCount = 0;
+
+	int32 NewInfiniteCount = 0;
+
+	int32 OldStacks = 0;
+
+	int32 NewStacks = 0;
+};
+
+// 两个快照里匹配上的一对ASC之间的差异
+// Differences between one matched pair of ASCs of two snapshots
+struct FGASCaptureAscDiff
+{
+	FName Actor;
+
+	// 按类匹配时另一边的角色名
+	// Actor name on the other side when matched by class
+	FName OtherActor;
+
+	FName ActorClass;
+
+	TArray<FName> AddedAbilities;
+
+	TArray<FName> RemovedAbilities;
+
+	TArray<FGASCaptureEffectDelta> Effects;
+
+	TArray<FGASCaptureAttributeDelta> Attributes;
+
+	TArray<FGASCaptureCountDelta> Tags;
+
+	TArray<FName> AddedBlockedTags;
+
+	TArray<FName> RemovedBlockedTags;
+
+	bool IsEmpty() const
+	{
+		return AddedAbilities.Num() == 0 && RemovedAbilities.Num() == 0 && Effects.Num() == 0 && Attributes.Num() == 0
+			&& Tags.Num() == 0 && AddedBlockedTags.Num() == 0 && RemovedBlockedTags.Num() == 0;
+	}
+};
+
+struct FGASCaptureSnapshotDiff
+{
+	TArray<FGASCaptureAscDiff> Changed;
+
+	// 只在一边出现的ASC，"Actor [Class]"
+	// ASCs present on one side only, as "Actor [Class]"
+	TArray<FString> AddedAbilitySystems;
+
+	TArray<FString> RemovedAbilitySystems;
+
+	// 内容哈希相同而直接跳过的ASC
+	// ASCs skipped because their content hashes matched
+	int32 NumUnchanged = 0;
+
+	// 按效果类汇总所有ASC的新旧数量，包括没有变化、新增和移除的ASC
+	// Old and new totals per effect class summed over every ASC, unchanged, added and removed ASCs included
+	TArray<FGASCaptureEffectDelta> EffectTotals;
+
+	bool IsEmpty() const { return Changed.Num() == 0 && AddedAbilitySystems.Num() == 0 && RemovedAbilitySystems.Num() == 0; }
+};
+
+// 比较两个快照: 先按角色名和类匹配ASC，剩下的再按类依次匹配
+// 内容哈希相同的ASC不再逐项比较
+//
+// Compares two snapshots: ASCs are matched by actor name and class first, the rest by class in order
+// ASCs with equal content hashes are not compared item by item
+class FGASCaptureDiff
+{
+public:
+
+	static void Diff(const FGASCaptureWorldSnapshot& InOld, const FGASCaptureWorldSnapshot& InNew, FGASCaptureSnapshotDiff& OutDiff);
+
+	// 与数组顺序无关的内容哈希，不包含角色名
+	// Content hash that ignores array order and the actor name
+	static uint32 HashAbilitySystem(const FGASCaptureAscSnapshot& InSnapshot);
+
+	static void LogDiff(const FGASCaptureSnapshotDiff& InDiff);
+};
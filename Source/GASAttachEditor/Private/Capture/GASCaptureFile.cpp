@@ -0,0 +1,768 @@
+#include "Capture/GASCaptureFile.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/DateTime.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Tasks/Pipe.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+namespace GASCaptureFile
+{
+	UE::Tasks::FPipe& GetWritePipe()
+	{
+		static UE::Tasks::FPipe WritePipe(TEXT("GASCaptureWriter"));
+		return WritePipe;
+	}
+
+	void SerializeHeader(FArchive& Ar, FGASCaptureHeader& InOutHeader, uint32& InOutVersion)
+	{
+		uint32 FileMagic = Magic;
+		Ar << FileMagic;
+		Ar << InOutVersion;
+
+		if (FileMagic != Magic)
+		{
+			Ar.SetError();
+			return;
+		}
+
+		Ar << InOutHeader.World;
+		Ar << InOutHeader.Reason;
+		Ar << InOutHeader.TriggerFrame;
+		Ar << InOutHeader.TriggerWorldTime;
+	}
+
+	// 读取时数量先和剩下的字节数比较，每项至少占 InMinItemBytes，损坏的文件不会导致过大的分配
+	// When loading, the count is checked against the bytes left with each item taking at least InMinItemBytes, so a corrupt file cannot cause a huge allocation
+	void SerializeCount(FArchive& Ar, int32& InOutCount, int64 InMinItemBytes)
+	{
+		Ar << InOutCount;
+		if (Ar.IsLoading() && (Ar.IsError() || InOutCount < 0 || InOutCount * InMinItemBytes > Ar.TotalSize() - Ar.Tell()))
+		{
+			Ar.SetError();
+			InOutCount = 0;
+		}
+	}
+
+	void SerializeBool(FArchive& Ar, bool& InOutValue)
+	{
+		uint8 Value = InOutValue ? 1 : 0;
+		Ar << Value;
+		InOutValue = Value != 0;
+	}
+
+	void SerializeAbilitySystem(FArchive& Ar, FGASCaptureAscSnapshot& InOutSnapshot, FGASCaptureNameTable& NameTable)
+	{
+		NameTable.SerializeName(Ar, InOutSnapshot.Actor);
+		NameTable.SerializeName(Ar, InOutSnapshot.ActorClass);
+		Ar << InOutSnapshot.Role;
+
+		int32 NumTags = InOutSnapshot.Tags.Num();
+		SerializeCount(Ar, NumTags, sizeof(int32));
+		InOutSnapshot.Tags.SetNum(NumTags);
+		for (FGASCaptureTagCount& TagCount : InOutSnapshot.Tags)
+		{
+			NameTable.SerializeName(Ar, TagCount.Tag);
+			Ar << TagCount.Count;
+		}
+
+		int32 NumBlockedTags = InOutSnapshot.BlockedTags.Num();
+		SerializeCount(Ar, NumBlockedTags, sizeof(int32));
+		InOutSnapshot.BlockedTags.SetNum(NumBlockedTags);
+		for (FName& Tag : InOutSnapshot.BlockedTags)
+		{
+			NameTable.SerializeName(Ar, Tag);
+		}
+
+		int32 NumAttributes = InOutSnapshot.Attributes.Num();
+		SerializeCount(Ar, NumAttributes, 1);
+		InOutSnapshot.Attributes.SetNum(NumAttributes);
+		for (FGASCaptureAttribute& Attribute : InOutSnapshot.Attributes)
+		{
+			NameTable.SerializeName(Ar, Attribute.Attribute);
+			Ar << Attribute.BaseValue;
+			Ar << Attribute.CurrentValue;
+		}
+
+		int32 NumEffects = InOutSnapshot.Effects.Num();
+		SerializeCount(Ar, NumEffects, 1);
+		InOutSnapshot.Effects.SetNum(NumEffects);
+		for (FGASCaptureEffect& Effect : InOutSnapshot.Effects)
+		{
+			NameTable.SerializeName(Ar, Effect.Definition);
+			Ar << Effect.Handle;
+			Ar << Effect.StackCount;
+			Ar << Effect.Level;
+			Ar << Effect.StartWorldTime;
+			Ar << Effect.Duration;
+			SerializeBool(Ar, Effect.bInhibited);
+		}
+
+		int32 NumAbilities = InOutSnapshot.Abilities.Num();
+		SerializeCount(Ar, NumAbilities, 1);
+		InOutSnapshot.Abilities.SetNum(NumAbilities);
+		for (FGASCaptureAbility& Ability : InOutSnapshot.Abilities)
+		{
+			NameTable.SerializeName(Ar, Ability.Ability);
+			Ar << Ability.Level;
+			Ar << Ability.InputID;
+			Ar << Ability.ActiveCount;
+		}
+	}
+
+	void SerializeFrame(FArchive& Ar, FGASCaptureFrame& InOutFrame, FGASCaptureNameTable& NameTable)
+	{
+		Ar << InOutFrame.Frame;
+		Ar << InOutFrame.WorldTime;
+		Ar << InOutFrame.DeltaSeconds;
+
+		int32 NumEvents = InOutFrame.Events.Num();
+		SerializeCount(Ar, NumEvents, 1);
+		InOutFrame.Events.SetNum(NumEvents);
+		for (FGASCaptureEvent& Event : InOutFrame.Events)
+		{
+			uint8 Type = static_cast<uint8>(Event.Type);
+			Ar << Type;
+			Event.Type = static_cast<EGASCaptureEventType>(Type);
+
+			NameTable.SerializeName(Ar, Event.Actor);
+			NameTable.SerializeName(Ar, Event.Subject);
+			NameTable.SerializeName(Ar, Event.Detail);
+			Ar << Event.Value;
+			Ar << Event.Handle;
+		}
+
+		SerializeBool(Ar, InOutFrame.bHasKeyframe);
+		if (!InOutFrame.bHasKeyframe)
+		{
+			return;
+		}
+
+		FGASCaptureWorldSnapshot& Keyframe = InOutFrame.Keyframe;
+		Ar << Keyframe.Frame;
+		Ar << Keyframe.WorldTime;
+
+		int32 NumAbilitySystems = Keyframe.NumAbilitySystems;
+		SerializeCount(Ar, NumAbilitySystems, 1);
+
+		if (Ar.IsLoading())
+		{
+			Keyframe.NumAbilitySystems = 0;
+			for (int32 Index = 0; Index < NumAbilitySystems; ++Index)
+			{
+				SerializeAbilitySystem(Ar, Keyframe.AddAbilitySystem(), NameTable);
+			}
+		}
+		else
+		{
+			for (int32 Index = 0; Index < NumAbilitySystems; ++Index)
+			{
+				SerializeAbilitySystem(Ar, Keyframe.AbilitySystems[Index], NameTable);
+			}
+		}
+	}
+
+	void SerializeChunkInfo(FArchive& Ar, FGASCaptureChunkInfo& InOutChunk, uint32 InVersion)
+	{
+		Ar << InOutChunk.Offset;
+		Ar << InOutChunk.Size;
+		Ar << InOutChunk.FirstFrame;
+		Ar << InOutChunk.LastFrame;
+		Ar << InOutChunk.FirstWorldTime;
+		Ar << InOutChunk.LastWorldTime;
+		Ar << InOutChunk.NumEvents;
+
+		if (InVersion >= VersionIndex)
+		{
+			Ar << InOutChunk.EventTypeMask;
+		}
+		else
+		{
+			InOutChunk.EventTypeMask = MAX_uint32;
+		}
+	}
+
+	// 目录里一个块的信息占的字节数
+	// Bytes one chunk entry of the directory takes
+	int64 GetChunkInfoSize(uint32 InVersion)
+	{
+		return sizeof(int64) * 2 + sizeof(uint64) * 2 + sizeof(float) * 2 + sizeof(int32) + (InVersion >= VersionIndex ? sizeof(uint32) : 0);
+	}
+
+	// 文件尾: 名字表偏移、目录偏移、(版本2起)索引偏移、Magic
+	// Trailer: name table offset, directory offset, index offset (from version 2), magic
+	int64 GetTrailerSize(uint32 InVersion)
+	{
+		return sizeof(int64) * (InVersion >= VersionIndex ? 3 : 2) + sizeof(uint32);
+	}
+}
+
+void FGASCaptureIndex::Serialize(FArchive& Ar)
+{
+	int32 NumPostings = Postings.Num();
+	GASCaptureFile::SerializeCount(Ar, NumPostings, sizeof(int32) * 2);
+	if (Ar.IsLoading())
+	{
+		Postings.Reset();
+		Postings.Reserve(NumPostings);
+		for (int32 Index = 0; Index < NumPostings && !Ar.IsError(); ++Index)
+		{
+			int32 NameIndex = INDEX_NONE;
+			Ar << NameIndex;
+
+			int32 NumChunks = 0;
+			GASCaptureFile::SerializeCount(Ar, NumChunks, sizeof(int32));
+
+			TArray<int32>& Chunks = Postings.Add(NameIndex);
+			Chunks.SetNum(NumChunks);
+			for (int32& Chunk : Chunks)
+			{
+				Ar << Chunk;
+			}
+		}
+	}
+	else
+	{
+		for (TPair<int32, TArray<int32>>& Posting : Postings)
+		{
+			Ar << Posting.Key;
+
+			int32 NumChunks = Posting.Value.Num();
+			Ar << NumChunks;
+			for (int32& Chunk : Posting.Value)
+			{
+				Ar << Chunk;
+			}
+		}
+	}
+
+	int32 NumActorClasses = ActorClasses.Num();
+	GASCaptureFile::SerializeCount(Ar, NumActorClasses, sizeof(int32) * 2);
+	if (Ar.IsLoading())
+	{
+		ActorClasses.Reset();
+		ActorClasses.Reserve(NumActorClasses);
+		for (int32 Index = 0; Index < NumActorClasses && !Ar.IsError(); ++Index)
+		{
+			int32 ActorIndex = INDEX_NONE;
+			int32 ClassIndex = INDEX_NONE;
+			Ar << ActorIndex;
+			Ar << ClassIndex;
+			ActorClasses.Add(ActorIndex, ClassIndex);
+		}
+	}
+	else
+	{
+		for (TPair<int32, int32>& ActorClass : ActorClasses)
+		{
+			Ar << ActorClass.Key;
+			Ar << ActorClass.Value;
+		}
+	}
+}
+
+void FGASCaptureNameTable::SerializeName(FArchive& Ar, FName& InOutName)
+{
+	int32 Index = INDEX_NONE;
+
+	if (Ar.IsLoading())
+	{
+		Ar << Index;
+		InOutName = GetName(Index);
+		return;
+	}
+
+	if (!InOutName.IsNone())
+	{
+		if (const int32* Found = NameToIndex.Find(InOutName))
+		{
+			Index = *Found;
+		}
+		else
+		{
+			Index = Names.Add(InOutName);
+			NameToIndex.Add(InOutName, Index);
+		}
+	}
+
+	Ar << Index;
+}
+
+void FGASCaptureNameTable::SerializeTable(FArchive& Ar)
+{
+	int32 NumNames = Names.Num();
+	GASCaptureFile::SerializeCount(Ar, NumNames, sizeof(int32));
+
+	if (Ar.IsLoading())
+	{
+		Names.Reset(NumNames);
+		NameToIndex.Reset();
+
+		FString NameString;
+		for (int32 Index = 0; Index < NumNames && !Ar.IsError(); ++Index)
+		{
+			Ar << NameString;
+			NameToIndex.Add(Names.Add_GetRef(FName(*NameString)), Index);
+		}
+	}
+	else
+	{
+		for (const FName& Name : Names)
+		{
+			FString NameString = Name.ToString();
+			Ar << NameString;
+		}
+	}
+}
+
+int32 FGASCaptureNameTable::FindIndex(FName InName) const
+{
+	const int32* Found = NameToIndex.Find(InName);
+	return Found ? *Found : INDEX_NONE;
+}
+
+FGASCaptureWriter::FGASCaptureWriter()
+	:FramesInChunk(0)
+{
+}
+
+FGASCaptureWriter::~FGASCaptureWriter()
+{
+	if (IsOpen())
+	{
+		Close();
+	}
+}
+
+bool FGASCaptureWriter::Open(const FString& InFilename, const FGASCaptureHeader& InHeader)
+{
+	Filename = InFilename;
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not open capture file %s for writing"), *Filename);
+		return false;
+	}
+
+	FGASCaptureHeader Header = InHeader;
+	uint32 Version = GASCaptureFile::Version;
+	GASCaptureFile::SerializeHeader(*FileWriter, Header, Version);
+
+	NameTable = FGASCaptureNameTable();
+	Chunks.Reset();
+	ChunkBuffer.Reset();
+	CurrentChunk = FGASCaptureChunkInfo();
+	FramesInChunk = 0;
+	Index = FGASCaptureIndex();
+	ChunkNames.Reset();
+
+	return true;
+}
+
+void FGASCaptureWriter::AppendFrame(const FGASCaptureFrame& InFrame)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	if (FramesInChunk == 0)
+	{
+		CurrentChunk.FirstFrame = InFrame.Frame;
+		CurrentChunk.FirstWorldTime = InFrame.WorldTime;
+	}
+
+	CurrentChunk.LastFrame = InFrame.Frame;
+	CurrentChunk.LastWorldTime = InFrame.WorldTime;
+	CurrentChunk.NumEvents += InFrame.Events.Num();
+
+	FMemoryWriter ChunkWriter(ChunkBuffer);
+	ChunkWriter.Seek(ChunkBuffer.Num());
+	GASCaptureFile::SerializeFrame(ChunkWriter, const_cast<FGASCaptureFrame&>(InFrame), NameTable);
+
+	// 名字在序列化时已经加入名字表
+	// Names were added to the name table while serializing
+	for (const FGASCaptureEvent& Event : InFrame.Events)
+	{
+		CurrentChunk.EventTypeMask |= 1u << static_cast<uint32>(Event.Type);
+
+		for (FName Name : { Event.Actor, Event.Subject })
+		{
+			const int32 NameIndex = NameTable.FindIndex(Name);
+			if (NameIndex != INDEX_NONE)
+			{
+				ChunkNames.Add(NameIndex);
+			}
+		}
+	}
+
+	if (InFrame.bHasKeyframe)
+	{
+		for (const FGASCaptureAscSnapshot& Snapshot : InFrame.Keyframe.GetAbilitySystems())
+		{
+			const int32 ActorIndex = NameTable.FindIndex(Snapshot.Actor);
+			const int32 ClassIndex = NameTable.FindIndex(Snapshot.ActorClass);
+			if (ActorIndex != INDEX_NONE && ClassIndex != INDEX_NONE)
+			{
+				Index.ActorClasses.Add(ActorIndex, ClassIndex);
+			}
+		}
+	}
+
+	if (++FramesInChunk >= GASCaptureFile::FramesPerChunk)
+	{
+		FlushChunk();
+	}
+}
+
+void FGASCaptureWriter::FlushChunk()
+{
+	if (FramesInChunk == 0)
+	{
+		return;
+	}
+
+	CurrentChunk.Offset = FileWriter->Tell();
+	CurrentChunk.Size = ChunkBuffer.Num();
+	FileWriter->Serialize(ChunkBuffer.GetData(), ChunkBuffer.Num());
+
+	const int32 ChunkIndex = Chunks.Add(CurrentChunk);
+	for (int32 NameIndex : ChunkNames)
+	{
+		Index.Postings.FindOrAdd(NameIndex).Add(ChunkIndex);
+	}
+	ChunkNames.Reset();
+
+	ChunkBuffer.Reset();
+	CurrentChunk = FGASCaptureChunkInfo();
+	FramesInChunk = 0;
+}
+
+bool FGASCaptureWriter::Close()
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+
+	FlushChunk();
+
+	int64 NameTableOffset = FileWriter->Tell();
+	NameTable.SerializeTable(*FileWriter);
+
+	int64 DirectoryOffset = FileWriter->Tell();
+	int32 NumChunks = Chunks.Num();
+	*FileWriter << NumChunks;
+	for (FGASCaptureChunkInfo& Chunk : Chunks)
+	{
+		GASCaptureFile::SerializeChunkInfo(*FileWriter, Chunk, GASCaptureFile::Version);
+	}
+
+	int64 IndexOffset = FileWriter->Tell();
+	Index.Serialize(*FileWriter);
+
+	uint32 TrailerMagic = GASCaptureFile::Magic;
+	*FileWriter << NameTableOffset;
+	*FileWriter << DirectoryOffset;
+	*FileWriter << IndexOffset;
+	*FileWriter << TrailerMagic;
+
+	const bool bSucceeded = FileWriter->Close() && !FileWriter->IsError();
+	FileWriter.Reset();
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to write capture file %s"), *Filename);
+	}
+
+	return bSucceeded;
+}
+
+FString FGASCaptureWriter::GetCaptureDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GASAttachEditor") / TEXT("Captures");
+}
+
+FString FGASCaptureWriter::MakeCaptureFilename(const FString& InWorld, const FString& InReason)
+{
+	const FString BaseName = FPaths::MakeValidFileName(FString::Printf(TEXT("%s_%s_%s"), *InWorld, *InReason.Left(48), *FDateTime::Now().ToString()), TEXT('_')).Replace(TEXT(" "), TEXT("_"));
+	return GetCaptureDir() / BaseName + GASCaptureFile::Extension;
+}
+
+void FGASCaptureWriter::WriteAsync(const FString& InFilename, const FGASCaptureHeader& InHeader, TArray<FGASCaptureFrame>&& InFrames,
+	int32 InNumFrames, TSharedPtr<FGASCaptureFramePool, ESPMode::ThreadSafe> InPool)
+{
+	const int32 NumFrames = InNumFrames == INDEX_NONE ? InFrames.Num() : FMath::Min(InNumFrames, InFrames.Num());
+
+	GASCaptureFile::GetWritePipe().Launch(TEXT("WriteGASCapture"), [Filename = InFilename, Header = InHeader, Frames = MoveTemp(InFrames), NumFrames, Pool = MoveTemp(InPool)]() mutable
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureWrite);
+
+		FGASCaptureWriter Writer;
+		if (Writer.Open(Filename, Header))
+		{
+			for (int32 Index = 0; Index < NumFrames; ++Index)
+			{
+				Writer.AppendFrame(Frames[Index]);
+			}
+
+			if (Writer.Close())
+			{
+				UE_LOG(LogGASAttachEditor, Log, TEXT("Wrote GAS capture (%d frames, %s) to %s"), NumFrames, *Header.Reason, *Filename);
+			}
+		}
+
+		if (Pool.IsValid())
+		{
+			// 帧的数组保留容量，下次录制直接复用
+			// The frames keep their array capacity so the next recording reuses it
+			for (FGASCaptureFrame& Frame : Frames)
+			{
+				Frame.Reset();
+			}
+
+			FScopeLock Lock(&Pool->Lock);
+			Pool->Buffers.Add(MoveTemp(Frames));
+		}
+	});
+}
+
+void FGASCaptureWriter::FlushAsyncWrites()
+{
+	GASCaptureFile::GetWritePipe().WaitUntilEmpty();
+}
+
+bool FGASCaptureReader::Open(const FString& InFilename)
+{
+	Filename = InFilename;
+	FileReader.Reset(IFileManager::Get().CreateFileReader(*Filename));
+	if (!FileReader.IsValid())
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not open capture file %s"), *Filename);
+		return false;
+	}
+
+	FArchive& Ar = *FileReader;
+	GASCaptureFile::SerializeHeader(Ar, Header, FileVersion);
+	if (Ar.IsError() || FileVersion > GASCaptureFile::Version)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("%s is not a capture file this version can read"), *Filename);
+		FileReader.Reset();
+		return false;
+	}
+
+	const int64 TrailerSize = GASCaptureFile::GetTrailerSize(FileVersion);
+	if (Ar.TotalSize() < Ar.Tell() + TrailerSize)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Capture file %s is truncated"), *Filename);
+		FileReader.Reset();
+		return false;
+	}
+
+	int64 NameTableOffset = 0;
+	int64 DirectoryOffset = 0;
+	int64 IndexOffset = INDEX_NONE;
+	uint32 TrailerMagic = 0;
+
+	Ar.Seek(Ar.TotalSize() - TrailerSize);
+	Ar << NameTableOffset;
+	Ar << DirectoryOffset;
+	if (FileVersion >= GASCaptureFile::VersionIndex)
+	{
+		Ar << IndexOffset;
+	}
+	Ar << TrailerMagic;
+
+	if (TrailerMagic != GASCaptureFile::Magic)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Capture file %s was not closed properly"), *Filename);
+		FileReader.Reset();
+		return false;
+	}
+
+	// 表的偏移必须落在文件头和文件尾之间
+	// The table offsets must lie between the header and the trailer
+	const int64 TablesEnd = Ar.TotalSize() - TrailerSize;
+	if (NameTableOffset < 0 || NameTableOffset > TablesEnd || DirectoryOffset < NameTableOffset || DirectoryOffset > TablesEnd
+		|| (IndexOffset != INDEX_NONE && (IndexOffset < DirectoryOffset || IndexOffset > TablesEnd)))
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Capture file %s has a corrupt trailer"), *Filename);
+		FileReader.Reset();
+		return false;
+	}
+
+	Ar.Seek(NameTableOffset);
+	NameTable.SerializeTable(Ar);
+
+	Ar.Seek(DirectoryOffset);
+	int32 NumChunks = 0;
+	GASCaptureFile::SerializeCount(Ar, NumChunks, GASCaptureFile::GetChunkInfoSize(FileVersion));
+	Chunks.SetNum(NumChunks);
+	for (FGASCaptureChunkInfo& Chunk : Chunks)
+	{
+		GASCaptureFile::SerializeChunkInfo(Ar, Chunk, FileVersion);
+
+		// 数据块都在名字表之前
+		// Chunks all lie before the name table
+		if (Chunk.Offset < 0 || Chunk.Size < 0 || Chunk.Size > NameTableOffset - Chunk.Offset)
+		{
+			Ar.SetError();
+			break;
+		}
+	}
+
+	Index = FGASCaptureIndex();
+	bActorClassesResolved = HasIndex();
+	if (IndexOffset != INDEX_NONE)
+	{
+		Ar.Seek(IndexOffset);
+		Index.Serialize(Ar);
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to read the directory of capture file %s"), *Filename);
+		FileReader.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FGASCaptureReader::ReadChunk(int32 InChunkIndex, TArray<FGASCaptureFrame>& OutFrames)
+{
+	OutFrames.Reset();
+
+	if (!FileReader.IsValid() || !Chunks.IsValidIndex(InChunkIndex))
+	{
+		return false;
+	}
+
+	const FGASCaptureChunkInfo& Chunk = Chunks[InChunkIndex];
+	ChunkBuffer.SetNumUninitialized(Chunk.Size);
+
+	FileReader->Seek(Chunk.Offset);
+	FileReader->Serialize(ChunkBuffer.GetData(), Chunk.Size);
+	if (FileReader->IsError())
+	{
+		return false;
+	}
+
+	FMemoryReader ChunkReader(ChunkBuffer);
+	while (!ChunkReader.AtEnd() && !ChunkReader.IsError())
+	{
+		GASCaptureFile::SerializeFrame(ChunkReader, OutFrames.AddDefaulted_GetRef(), NameTable);
+	}
+
+	return !ChunkReader.IsError();
+}
+
+const TMap<int32, int32>& FGASCaptureReader::GetActorClasses()
+{
+	if (bActorClassesResolved)
+	{
+		return Index.ActorClasses;
+	}
+
+	// 版本1的文件没有索引，解码所有块，从关键帧里收集角色类
+	// Version 1 files have no index; decode every chunk and collect the actor classes from the keyframes
+	bActorClassesResolved = true;
+
+	TArray<FGASCaptureFrame> Frames;
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		if (!ReadChunk(ChunkIndex, Frames))
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to read chunk %d of %s"), ChunkIndex, *Filename);
+			continue;
+		}
+
+		for (const FGASCaptureFrame& Frame : Frames)
+		{
+			if (!Frame.bHasKeyframe)
+			{
+				continue;
+			}
+
+			for (const FGASCaptureAscSnapshot& Snapshot : Frame.Keyframe.GetAbilitySystems())
+			{
+				const int32 ActorIndex = NameTable.FindIndex(Snapshot.Actor);
+				const int32 ClassIndex = NameTable.FindIndex(Snapshot.ActorClass);
+				if (ActorIndex != INDEX_NONE && ClassIndex != INDEX_NONE)
+				{
+					Index.ActorClasses.Add(ActorIndex, ClassIndex);
+				}
+			}
+		}
+	}
+
+	return Index.ActorClasses;
+}
+
+bool FGASCaptureReader::ReadKeyframe(uint64 InFrame, FGASCaptureWorldSnapshot& OutSnapshot)
+{
+	TArray<FGASCaptureFrame> Frames;
+	for (int32 ChunkIndex = Chunks.Num() - 1; ChunkIndex >= 0; --ChunkIndex)
+	{
+		if (Chunks[ChunkIndex].FirstFrame > InFrame)
+		{
+			continue;
+		}
+
+		if (!ReadChunk(ChunkIndex, Frames))
+		{
+			return false;
+		}
+
+		for (int32 FrameIndex = Frames.Num() - 1; FrameIndex >= 0; --FrameIndex)
+		{
+			if (Frames[FrameIndex].bHasKeyframe && Frames[FrameIndex].Frame <= InFrame)
+			{
+				OutSnapshot = MoveTemp(Frames[FrameIndex].Keyframe);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+FString FGASCaptureReader::ResolveFilename(const FString& InName)
+{
+	const FString CaptureDir = FGASCaptureWriter::GetCaptureDir();
+
+	if (InName.Equals(TEXT("latest"), ESearchCase::IgnoreCase))
+	{
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *(CaptureDir / (FString(TEXT("*")) + GASCaptureFile::Extension)), true, false);
+
+		FString Latest;
+		FDateTime LatestTime = FDateTime::MinValue();
+		for (const FString& File : Files)
+		{
+			const FDateTime FileTime = IFileManager::Get().GetTimeStamp(*(CaptureDir / File));
+			if (FileTime > LatestTime)
+			{
+				LatestTime = FileTime;
+				Latest = CaptureDir / File;
+			}
+		}
+		return Latest;
+	}
+
+	if (FPaths::FileExists(InName))
+	{
+		return InName;
+	}
+
+	const FString InCaptureDir = CaptureDir / InName;
+	if (FPaths::FileExists(InCaptureDir))
+	{
+		return InCaptureDir;
+	}
+
+	return InCaptureDir + GASCaptureFile::Extension;
+}
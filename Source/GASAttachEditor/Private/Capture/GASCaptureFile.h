@@ -0,0 +1,240 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/GASCaptureTypes.h"
+#include "HAL/CriticalSection.h"
+
+class FArchive;
+
+// 录制文件格式:
+// 文件头 | 数据块... | 名字表 | 数据块目录 | 索引 | 文件尾(名字表、目录与索引的偏移)
+// 数据块按帧顺序写入，名字在块里只保存名字表的下标
+// 版本1的文件没有索引，文件尾也少一个偏移
+//
+// Capture file layout:
+// Header | Chunks... | Name table | Chunk directory | Index | Trailer (offsets of the name table, the directory and the index)
+// Chunks are written in frame order and only store indices into the name table
+// Version 1 files have no index and one offset less in the trailer
+namespace GASCaptureFile
+{
+	constexpr uint32 Magic = 0x43534147;
+
+	constexpr uint32 Version = 2;
+
+	// 第一个带索引的版本
+	// First version with an index
+	constexpr uint32 VersionIndex = 2;
+
+	constexpr int32 FramesPerChunk = 64;
+
+	const TCHAR* const Extension = TEXT(".gascap");
+}
+
+// 写完之后还给录制器的帧缓冲，录制器换上一块备用的继续录制，不重新分配
+// Frame buffers handed back to the recorder once written; the recorder swaps in a spare one and keeps recording without allocating
+struct FGASCaptureFramePool
+{
+	FCriticalSection Lock;
+
+	TArray<TArray<FGASCaptureFrame>> Buffers;
+};
+
+// 目录里每个数据块的范围
+// Range of one chunk in the directory
+struct FGASCaptureChunkInfo
+{
+	int64 Offset = 0;
+
+	int64 Size = 0;
+
+	uint64 FirstFrame = 0;
+
+	uint64 LastFrame = 0;
+
+	float FirstWorldTime = 0.f;
+
+	float LastWorldTime = 0.f;
+
+	int32 NumEvents = 0;
+
+	// 块内出现过的事件类型，按 1 << EGASCaptureEventType
+	// Event types present in the chunk, as 1 << EGASCaptureEventType
+	uint32 EventTypeMask = 0;
+};
+
+// 名字表，写入时把 FName 映射为下标，读取时反过来
+// Name table; maps FNames to indices while writing and back while reading
+class FGASCaptureNameTable
+{
+public:
+
+	void SerializeName(FArchive& Ar, FName& InOutName);
+
+	void SerializeTable(FArchive& Ar);
+
+	int32 Num() const { return Names.Num(); }
+
+	FName GetName(int32 InIndex) const { return Names.IsValidIndex(InIndex) ? Names[InIndex] : FName(); }
+
+	int32 FindIndex(FName InName) const;
+
+private:
+
+	TArray<FName> Names;
+
+	TMap<FName, int32> NameToIndex;
+};
+
+// 录制的倒排索引：名字 -> 事件里出现过这个名字(角色或主体)的数据块
+// 查询只需要解码命中的块
+//
+// Inverted index of a capture: name -> chunks whose events mention it (as actor or subject)
+// Queries only decode the chunks that are hit
+struct FGASCaptureIndex
+{
+	// 名字表下标 -> 升序的块下标
+	// Name table index -> ascending chunk indices
+	TMap<int32, TArray<int32>> Postings;
+
+	// 角色名 -> 角色类，来自关键帧
+	// Actor name -> actor class, taken from keyframes
+	TMap<int32, int32> ActorClasses;
+
+	void Serialize(FArchive& Ar);
+
+	const TArray<int32>* FindPostings(int32 InNameIndex) const { return Postings.Find(InNameIndex); }
+};
+
+// 按帧追加写入录制文件，内存里只保留当前数据块
+// Appends frames to a capture file; only the current chunk is kept in memory
+class FGASCaptureWriter
+{
+public:
+
+	FGASCaptureWriter();
+	~FGASCaptureWriter();
+
+	bool Open(const FString& InFilename, const FGASCaptureHeader& InHeader);
+
+	void AppendFrame(const FGASCaptureFrame& InFrame);
+
+	// 写入名字表、目录和文件尾
+	// Writes the name table, the directory and the trailer
+	bool Close();
+
+	bool IsOpen() const { return FileWriter.IsValid(); }
+
+	const FString& GetFilename() const { return Filename; }
+
+public:
+
+	// 录制文件的默认目录 Saved/GASAttachEditor/Captures
+	// Default capture directory, Saved/GASAttachEditor/Captures
+	static FString GetCaptureDir();
+
+	static FString MakeCaptureFilename(const FString& InWorld, const FString& InReason);
+
+	// 在后台按顺序写入，游戏线程只负责移交数据
+	// 只写前 InNumFrames 帧(INDEX_NONE 为全部)；给了 InPool 时写完把清空的缓冲还回去
+	//
+	// Writes in the background in submission order; the game thread only hands the data over
+	// Only the first InNumFrames frames are written (INDEX_NONE for all); with InPool the emptied buffer is returned to it once written
+	static void WriteAsync(const FString& InFilename, const FGASCaptureHeader& InHeader, TArray<FGASCaptureFrame>&& InFrames,
+		int32 InNumFrames = INDEX_NONE, TSharedPtr<FGASCaptureFramePool, ESPMode::ThreadSafe> InPool = nullptr);
+
+	// 等待所有后台写入完成
+	// Waits for every pending background write
+	static void FlushAsyncWrites();
+
+private:
+
+	void FlushChunk();
+
+private:
+
+	FString Filename;
+
+	TUniquePtr<FArchive> FileWriter;
+
+	FGASCaptureNameTable NameTable;
+
+	TArray<FGASCaptureChunkInfo> Chunks;
+
+	TArray<uint8> ChunkBuffer;
+
+	FGASCaptureChunkInfo CurrentChunk;
+
+	int32 FramesInChunk;
+
+	FGASCaptureIndex Index;
+
+	// 当前块的事件里出现过的名字
+	// Names mentioned by the events of the current chunk
+	TSet<int32> ChunkNames;
+};
+
+// 读取录制文件，只读取目录和索引，数据块按需解码
+// Reads a capture file; only the directory and the index are loaded, chunks are decoded on demand
+class FGASCaptureReader
+{
+public:
+
+	bool Open(const FString& InFilename);
+
+	const FGASCaptureHeader& GetHeader() const { return Header; }
+
+	const FGASCaptureNameTable& GetNameTable() const { return NameTable; }
+
+	const TArray<FGASCaptureChunkInfo>& GetChunks() const { return Chunks; }
+
+	const FGASCaptureIndex& GetIndex() const { return Index; }
+
+	// 角色名 -> 角色类；版本1的文件第一次调用时从关键帧解析
+	// Actor name -> actor class; resolved from the keyframes on the first call for version 1 files
+	const TMap<int32, int32>& GetActorClasses();
+
+	// 版本1的文件没有索引
+	// Version 1 files have no index
+	bool HasIndex() const { return FileVersion >= GASCaptureFile::VersionIndex; }
+
+	// 解码一个数据块里的所有帧
+	// Decodes every frame of one chunk
+	bool ReadChunk(int32 InChunkIndex, TArray<FGASCaptureFrame>& OutFrames);
+
+	// 读取指定帧或之前最近的关键帧
+	// Reads the closest keyframe at or before the given frame
+	bool ReadKeyframe(uint64 InFrame, FGASCaptureWorldSnapshot& OutSnapshot);
+
+	const FString& GetFilename() const { return Filename; }
+
+public:
+
+	// 文件名可以是完整路径、录制目录下的文件名，或者 latest 表示最新的录制
+	// The file may be a full path, a file name in the capture directory, or "latest" for the newest capture
+	static FString ResolveFilename(const FString& InName);
+
+private:
+
+	FString Filename;
+
+	TUniquePtr<FArchive> FileReader;
+
+	uint32 FileVersion = 0;
+
+	FGASCaptureHeader Header;
+
+	FGASCaptureNameTable NameTable;
+
+	TArray<FGASCaptureChunkInfo> Chunks;
+
+	FGASCaptureIndex Index;
+
+	bool bActorClassesResolved = false;
+
+	TArray<uint8> ChunkBuffer;
+};
+
+namespace GASCaptureFile
+{
+	void SerializeFrame(FArchive& Ar, FGASCaptureFrame& InOutFrame, FGASCaptureNameTable& NameTable);
+}
@@ -0,0 +1,387 @@
+#include "Capture/GASCaptureQuery.h"
+#include "Capture/GASCaptureFile.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+namespace GASCaptureQuery
+{
+	const EGASCaptureEventType AllEventTypes[] =
+	{
+		EGASCaptureEventType::TagChanged,
+		EGASCaptureEventType::EffectApplied,
+		EGASCaptureEventType::EffectRemoved,
+		EGASCaptureEventType::AbilityActivated,
+		EGASCaptureEventType::AbilityEnded,
+		EGASCaptureEventType::AbilityFailed,
+		EGASCaptureEventType::TriggerFired,
+	};
+
+	uint32 GetTypeBit(EGASCaptureEventType InType)
+	{
+		return 1u << static_cast<uint32>(InType);
+	}
+
+	// 在名字表里解析名字条件，包含 * 或 ? 时按通配符匹配
+	// Resolves a name filter against the name table; patterns containing * or ? are matched as wildcards
+	void ResolveNames(const FGASCaptureNameTable& InNameTable, const FString& InPattern, TSet<int32>& OutIndices)
+	{
+		if (InPattern.Contains(TEXT("*")) || InPattern.Contains(TEXT("?")))
+		{
+			for (int32 Index = 0; Index < InNameTable.Num(); ++Index)
+			{
+				if (InNameTable.GetName(Index).ToString().MatchesWildcard(InPattern))
+				{
+					OutIndices.Add(Index);
+				}
+			}
+			return;
+		}
+
+		const int32 Index = InNameTable.FindIndex(FName(*InPattern));
+		if (Index != INDEX_NONE)
+		{
+			OutIndices.Add(Index);
+		}
+	}
+
+	// 名字集合命中的块，按位标记
+	// Chunks hit by a set of names, as a bit per chunk
+	TBitArray<> GetChunksForNames(const FGASCaptureIndex& InIndex, const TSet<int32>& InNames, int32 InNumChunks)
+	{
+		TBitArray<> ChunkBits(false, InNumChunks);
+		for (int32 NameIndex : InNames)
+		{
+			if (const TArray<int32>* Postings = InIndex.FindPostings(NameIndex))
+			{
+				for (int32 ChunkIndex : *Postings)
+				{
+					if (ChunkIndex < InNumChunks)
+					{
+						ChunkBits[ChunkIndex] = true;
+					}
+				}
+			}
+		}
+		return ChunkBits;
+	}
+
+	TSet<FName> ToNames(const FGASCaptureNameTable& InNameTable, const TSet<int32>& InIndices)
+	{
+		TSet<FName> Names;
+		Names.Reserve(InIndices.Num());
+		for (int32 Index : InIndices)
+		{
+			Names.Add(InNameTable.GetName(Index));
+		}
+		return Names;
+	}
+}
+
+static FAutoConsoleCommand GASAttachEditorCaptureQueryCmd(
+	TEXT("GASAttachEditor.Capture.Query"),
+	TEXT("Queries a capture file: <File|latest> [Type=TagAdded|TagRemoved|TagChanged|EffectApplied|EffectRemoved|AbilityActivated|AbilityEnded|AbilityFailed|TriggerFired] [Actor=Name] [Class=BP_Player*] [Subject=Status.Stunned] [From=Seconds] [To=Seconds] [FromFrame=N] [ToFrame=N] [Limit=N]."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Missing capture file"));
+			return;
+		}
+
+		FGASCaptureQuery Query;
+		FString Error;
+		if (!FGASCaptureQuery::Parse(TArray<FString>(Args.GetData() + 1, Args.Num() - 1), Query, Error))
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("%s"), *Error);
+			return;
+		}
+
+		FGASCaptureReader Reader;
+		if (!Reader.Open(FGASCaptureReader::ResolveFilename(Args[0])))
+		{
+			return;
+		}
+
+		TArray<FGASCaptureQueryResult> Results;
+		FGASCaptureQueryStats Stats;
+		Query.Execute(Reader, Results, &Stats);
+
+		for (const FGASCaptureQueryResult& Result : Results)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("  [%llu] %8.3fs %-16s %s %s %s %d"),
+				Result.Frame, Result.WorldTime, FGASCaptureQuery::GetEventTypeName(Result.Event.Type),
+				*Result.Event.Actor.ToString(), *Result.Event.Subject.ToString(), Result.Event.Detail.IsNone() ? TEXT("") : *Result.Event.Detail.ToString(), Result.Event.Value);
+		}
+
+		UE_LOG(LogGASAttachEditor, Display, TEXT("%d match(es) in %s, decoded %d of %d chunks in %.2f ms%s"),
+			Results.Num(), *FPaths::GetCleanFilename(Reader.GetFilename()), Stats.NumChunksRead, Stats.NumChunks, Stats.Milliseconds,
+			Reader.HasIndex() ? TEXT("") : TEXT(" (no index, version 1 file)"));
+	}));
+
+const TCHAR* FGASCaptureQuery::GetEventTypeName(EGASCaptureEventType InType)
+{
+	switch (InType)
+	{
+	case EGASCaptureEventType::TagChanged:
+		return TEXT("TagChanged");
+	case EGASCaptureEventType::EffectApplied:
+		return TEXT("EffectApplied");
+	case EGASCaptureEventType::EffectRemoved:
+		return TEXT("EffectRemoved");
+	case EGASCaptureEventType::AbilityActivated:
+		return TEXT("AbilityActivated");
+	case EGASCaptureEventType::AbilityEnded:
+		return TEXT("AbilityEnded");
+	case EGASCaptureEventType::AbilityFailed:
+		return TEXT("AbilityFailed");
+	case EGASCaptureEventType::TriggerFired:
+		return TEXT("TriggerFired");
+	}
+
+	return TEXT("Unknown");
+}
+
+bool FGASCaptureQuery::Parse(const TArray<FString>& InArgs, FGASCaptureQuery& OutQuery, FString& OutError)
+{
+	OutQuery = FGASCaptureQuery();
+
+	for (const FString& Arg : InArgs)
+	{
+		FString Key;
+		FString Value;
+		if (!Arg.Split(TEXT("="), &Key, &Value))
+		{
+			OutError = FString::Printf(TEXT("Expected Key=Value, got '%s'"), *Arg);
+			return false;
+		}
+
+		if (Key.Equals(TEXT("Type"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.TypeMask = 0;
+
+			if (Value.Equals(TEXT("TagAdded"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("TagRemoved"), ESearchCase::IgnoreCase))
+			{
+				OutQuery.TypeMask = GASCaptureQuery::GetTypeBit(EGASCaptureEventType::TagChanged);
+				OutQuery.TagDirection = Value.Equals(TEXT("TagAdded"), ESearchCase::IgnoreCase) ? 1 : -1;
+				continue;
+			}
+
+			for (EGASCaptureEventType EventType : GASCaptureQuery::AllEventTypes)
+			{
+				if (Value.Equals(GetEventTypeName(EventType), ESearchCase::IgnoreCase))
+				{
+					OutQuery.TypeMask = GASCaptureQuery::GetTypeBit(EventType);
+					break;
+				}
+			}
+
+			if (OutQuery.TypeMask == 0)
+			{
+				OutError = FString::Printf(TEXT("Unknown event type '%s'"), *Value);
+				return false;
+			}
+		}
+		else if (Key.Equals(TEXT("Actor"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.Actor = Value;
+		}
+		else if (Key.Equals(TEXT("Class"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.ActorClass = Value;
+		}
+		else if (Key.Equals(TEXT("Subject"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.Subject = Value;
+		}
+		else if (Key.Equals(TEXT("From"), ESearchCase::IgnoreCase))
+		{
+			LexFromString(OutQuery.MinWorldTime, *Value);
+		}
+		else if (Key.Equals(TEXT("To"), ESearchCase::IgnoreCase))
+		{
+			LexFromString(OutQuery.MaxWorldTime, *Value);
+		}
+		else if (Key.Equals(TEXT("FromFrame"), ESearchCase::IgnoreCase))
+		{
+			LexFromString(OutQuery.MinFrame, *Value);
+		}
+		else if (Key.Equals(TEXT("ToFrame"), ESearchCase::IgnoreCase))
+		{
+			LexFromString(OutQuery.MaxFrame, *Value);
+		}
+		else if (Key.Equals(TEXT("Limit"), ESearchCase::IgnoreCase))
+		{
+			LexFromString(OutQuery.MaxResults, *Value);
+		}
+		else
+		{
+			OutError = FString::Printf(TEXT("Unknown query key '%s'"), *Key);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FGASCaptureQuery::Execute(FGASCaptureReader& InReader, TArray<FGASCaptureQueryResult>& OutResults, FGASCaptureQueryStats* OutStats) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureQuery);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	OutResults.Reset();
+
+	const FGASCaptureNameTable& NameTable = InReader.GetNameTable();
+	const FGASCaptureIndex& Index = InReader.GetIndex();
+	const TArray<FGASCaptureChunkInfo>& Chunks = InReader.GetChunks();
+
+	// 目录先按类型和范围筛掉数据块
+	// The directory first drops chunks by type and range
+	TBitArray<> CandidateChunks(false, Chunks.Num());
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		const FGASCaptureChunkInfo& Chunk = Chunks[ChunkIndex];
+		CandidateChunks[ChunkIndex] = (Chunk.EventTypeMask & TypeMask) != 0
+			&& Chunk.LastFrame >= MinFrame && Chunk.FirstFrame <= MaxFrame
+			&& Chunk.LastWorldTime >= MinWorldTime && Chunk.FirstWorldTime <= MaxWorldTime;
+	}
+
+	// 角色条件: 名字匹配，再与角色类匹配的角色求交
+	// Actor filter: matching names, intersected with the actors of a matching class
+	TOptional<TSet<int32>> ActorIndices;
+	if (!Actor.IsEmpty())
+	{
+		ActorIndices.Emplace();
+		GASCaptureQuery::ResolveNames(NameTable, Actor, ActorIndices.GetValue());
+	}
+
+	if (!ActorClass.IsEmpty())
+	{
+		TSet<int32> ClassIndices;
+		GASCaptureQuery::ResolveNames(NameTable, ActorClass, ClassIndices);
+
+		TSet<int32> ClassActors;
+		for (const TPair<int32, int32>& ActorClassPair : InReader.GetActorClasses())
+		{
+			if (ClassIndices.Contains(ActorClassPair.Value))
+			{
+				ClassActors.Add(ActorClassPair.Key);
+			}
+		}
+
+		ActorIndices = ActorIndices.IsSet() ? ActorIndices->Intersect(ClassActors) : ClassActors;
+	}
+
+	TOptional<TSet<int32>> SubjectIndices;
+	if (!Subject.IsEmpty())
+	{
+		SubjectIndices.Emplace();
+		GASCaptureQuery::ResolveNames(NameTable, Subject, SubjectIndices.GetValue());
+	}
+
+	// 倒排索引: 每个条件命中的块求交
+	// Inverted index: intersect the chunks hit by each filter
+	if (InReader.HasIndex())
+	{
+		if (ActorIndices.IsSet())
+		{
+			CandidateChunks.CombineWithBitwiseAND(GASCaptureQuery::GetChunksForNames(Index, ActorIndices.GetValue(), Chunks.Num()), EBitwiseOperatorFlags::MinSize);
+		}
+
+		if (SubjectIndices.IsSet())
+		{
+			CandidateChunks.CombineWithBitwiseAND(GASCaptureQuery::GetChunksForNames(Index, SubjectIndices.GetValue(), Chunks.Num()), EBitwiseOperatorFlags::MinSize);
+		}
+	}
+
+	TOptional<TSet<FName>> ActorNames;
+	if (ActorIndices.IsSet())
+	{
+		ActorNames = GASCaptureQuery::ToNames(NameTable, ActorIndices.GetValue());
+	}
+
+	TOptional<TSet<FName>> SubjectNames;
+	if (SubjectIndices.IsSet())
+	{
+		SubjectNames = GASCaptureQuery::ToNames(NameTable, SubjectIndices.GetValue());
+	}
+
+	int32 NumChunksRead = 0;
+	TArray<FGASCaptureFrame> Frames;
+	for (TConstSetBitIterator<> It(CandidateChunks); It && OutResults.Num() < MaxResults; ++It)
+	{
+		if (!InReader.ReadChunk(It.GetIndex(), Frames))
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to read chunk %d of %s"), It.GetIndex(), *InReader.GetFilename());
+			continue;
+		}
+
+		++NumChunksRead;
+
+		for (const FGASCaptureFrame& Frame : Frames)
+		{
+			if (Frame.Frame < MinFrame || Frame.Frame > MaxFrame || Frame.WorldTime < MinWorldTime || Frame.WorldTime > MaxWorldTime)
+			{
+				continue;
+			}
+
+			for (const FGASCaptureEvent& Event : Frame.Events)
+			{
+				if (!MatchesEvent(Event, ActorNames.GetPtrOrNull(), SubjectNames.GetPtrOrNull()))
+				{
+					continue;
+				}
+
+				FGASCaptureQueryResult& Result = OutResults.AddDefaulted_GetRef();
+				Result.Frame = Frame.Frame;
+				Result.WorldTime = Frame.WorldTime;
+				Result.Event = Event;
+
+				if (OutResults.Num() >= MaxResults)
+				{
+					break;
+				}
+			}
+
+			if (OutResults.Num() >= MaxResults)
+			{
+				break;
+			}
+		}
+	}
+
+	if (OutStats)
+	{
+		OutStats->NumChunks = Chunks.Num();
+		OutStats->NumChunksRead = NumChunksRead;
+		OutStats->Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+}
+
+bool FGASCaptureQuery::MatchesEvent(const FGASCaptureEvent& InEvent, const TSet<FName>* InActors, const TSet<FName>* InSubjects) const
+{
+	if ((GASCaptureQuery::GetTypeBit(InEvent.Type) & TypeMask) == 0)
+	{
+		return false;
+	}
+
+	if (InEvent.Type == EGASCaptureEventType::TagChanged && TagDirection != 0 && (InEvent.Value > 0) != (TagDirection > 0))
+	{
+		return false;
+	}
+
+	if (InActors && !InActors->Contains(InEvent.Actor))
+	{
+		return false;
+	}
+
+	if (InSubjects && !InSubjects->Contains(InEvent.Subject))
+	{
+		return false;
+	}
+
+	return true;
+}
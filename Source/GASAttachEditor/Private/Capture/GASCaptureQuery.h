@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/GASCaptureTypes.h"
+
+class FGASCaptureReader;
+
+// 查询命中的一个事件
+// One event matched by a query
+struct FGASCaptureQueryResult
+{
+	uint64 Frame = 0;
+
+	float WorldTime = 0.f;
+
+	FGASCaptureEvent Event;
+};
+
+// 查询的开销，用来确认索引确实跳过了数据块
+// Cost of a query, used to check that the index actually skipped chunks
+struct FGASCaptureQueryStats
+{
+	int32 NumChunks = 0;
+
+	int32 NumChunksRead = 0;
+
+	double Milliseconds = 0.0;
+};
+
+// 按角色、角色类、主体(标签/技能类/效果类)、事件类型和帧/时间范围查询录制
+// 名字条件支持通配符，先在名字表里解析，再用倒排索引求出需要解码的块
+//
+// Queries a capture by actor, actor class, subject (tag / ability class / effect class), event type and frame/time range
+// Name filters accept wildcards; they are resolved against the name table and the inverted index picks the chunks to decode
+struct FGASCaptureQuery
+{
+	// 按 1 << EGASCaptureEventType
+	// As 1 << EGASCaptureEventType
+	uint32 TypeMask = MAX_uint32;
+
+	// 只匹配标签数量从0变为正数(1)或从正数变为0(-1)，0为不限
+	// Only match tags going from zero to positive (1) or positive to zero (-1); 0 matches both
+	int32 TagDirection = 0;
+
+	FString Actor;
+
+	FString ActorClass;
+
+	FString Subject;
+
+	float MinWorldTime = -MAX_flt;
+
+	float MaxWorldTime = MAX_flt;
+
+	uint64 MinFrame = 0;
+
+	uint64 MaxFrame = MAX_uint64;
+
+	int32 MaxResults = 1000;
+
+	// 解析 Key=Value 形式的参数: Type Actor Class Subject From To FromFrame ToFrame Limit
+	// Parses Key=Value arguments: Type Actor Class Subject From To FromFrame ToFrame Limit
+	static bool Parse(const TArray<FString>& InArgs, FGASCaptureQuery& OutQuery, FString& OutError);
+
+	// 执行查询，结果按帧排序
+	// Runs the query; results are in frame order
+	void Execute(FGASCaptureReader& InReader, TArray<FGASCaptureQueryResult>& OutResults, FGASCaptureQueryStats* OutStats = nullptr) const;
+
+	static const TCHAR* GetEventTypeName(EGASCaptureEventType InType);
+
+private:
+
+	bool MatchesEvent(const FGASCaptureEvent& InEvent, const TSet<FName>* InActors, const TSet<FName>* InSubjects) const;
+};
@@ -0,0 +1,571 @@
+#include "Capture/GASCaptureRecorder.h"
+#include "Capture/GASCaptureSampler.h"
+#include "Capture/GASCaptureFile.h"
+#include "AbilitySystemComponent.h"
+#include "Algo/Rotate.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorCaptureFramesBefore(
+	TEXT("GASAttachEditor.Capture.FramesBefore"),
+	300,
+	TEXT("Number of world frames kept in the ring buffer before a capture trigger fires."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorCaptureFramesAfter(
+	TEXT("GASAttachEditor.Capture.FramesAfter"),
+	120,
+	TEXT("Number of world frames recorded after a capture trigger fires before the capture is written."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorCaptureKeyframeInterval(
+	TEXT("GASAttachEditor.Capture.KeyframeInterval"),
+	30,
+	TEXT("Number of world frames between full state keyframes in the ring buffer. Events are recorded every frame."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarGASAttachEditorCaptureCooldown(
+	TEXT("GASAttachEditor.Capture.Cooldown"),
+	10.f,
+	TEXT("Seconds after a capture was written during which triggers of the same world are ignored."),
+	ECVF_Default);
+
+static FAutoConsoleCommand GASAttachEditorCaptureStartCmd(
+	TEXT("GASAttachEditor.Capture.Start"),
+	TEXT("Starts keeping every game world's recent GAS frames in memory so triggers can persist them."),
+	FConsoleCommandDelegate::CreateStatic(&FGASCaptureRecorder::StartRecording));
+
+static FAutoConsoleCommand GASAttachEditorCaptureStopCmd(
+	TEXT("GASAttachEditor.Capture.Stop"),
+	TEXT("Stops recording. Captures that already fired are written with the frames recorded so far."),
+	FConsoleCommandDelegate::CreateStatic(&FGASCaptureRecorder::StopRecording));
+
+static FAutoConsoleCommand GASAttachEditorCaptureAddTriggerCmd(
+	TEXT("GASAttachEditor.Capture.AddTrigger"),
+	TEXT("Adds a capture trigger and starts recording: <TagAdded|TagRemoved|EffectApplied|AbilityFailed> [Tag|Class], or <AttributeBelow|AttributeAbove> <Attribute> <Threshold>."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FGASCaptureTrigger Trigger;
+		FString Error;
+		if (!FGASCaptureTrigger::Parse(Args, Trigger, Error))
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("%s"), *Error);
+			return;
+		}
+
+		FGASCaptureRecorder::AddTrigger(Trigger);
+		UE_LOG(LogGASAttachEditor, Display, TEXT("Added capture trigger: %s"), *Trigger.ToString());
+	}));
+
+static FAutoConsoleCommand GASAttachEditorCaptureClearTriggersCmd(
+	TEXT("GASAttachEditor.Capture.ClearTriggers"),
+	TEXT("Removes every capture trigger."),
+	FConsoleCommandDelegate::CreateStatic(&FGASCaptureRecorder::ClearTriggers));
+
+static FAutoConsoleCommand GASAttachEditorCaptureListTriggersCmd(
+	TEXT("GASAttachEditor.Capture.ListTriggers"),
+	TEXT("Lists the capture triggers."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		UE_LOG(LogGASAttachEditor, Display, TEXT("Capture %s, %d trigger(s)"), FGASCaptureRecorder::IsRecording() ? TEXT("recording") : TEXT("stopped"), FGASCaptureRecorder::GetTriggers().Num());
+		for (const FGASCaptureTrigger& Trigger : FGASCaptureRecorder::GetTriggers())
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("  %s"), *Trigger.ToString());
+		}
+	}));
+
+static FAutoConsoleCommand GASAttachEditorCaptureFireCmd(
+	TEXT("GASAttachEditor.Capture.Fire"),
+	TEXT("Fires a capture in every recorded world. Optional argument: reason."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FGASCaptureRecorder::FireAll(Args.Num() > 0 ? FString::Join(Args, TEXT(" ")) : FString(TEXT("Manual")));
+	}));
+
+TArray<FGASCaptureTrigger> FGASCaptureRecorder::Triggers;
+uint32 FGASCaptureRecorder::CurrentTriggersSerial = 0;
+TArray<TSharedRef<FGASCaptureRecorder>> FGASCaptureRecorder::Recorders;
+bool FGASCaptureRecorder::bRecording = false;
+TArray<FString> FGASCaptureRecorder::WrittenFiles;
+FDelegateHandle FGASCaptureRecorder::MonitorCreatedHandle;
+FDelegateHandle FGASCaptureRecorder::WorldCleanupHandle;
+
+static const FName CaptureAutoCreateOwner(TEXT("Capture"));
+
+TSharedRef<FGASCaptureRecorder> FGASCaptureRecorder::Create(const TSharedRef<FGASWorldMonitor>& InMonitor)
+{
+	TSharedRef<FGASCaptureRecorder> Recorder = MakeShareable(new FGASCaptureRecorder(InMonitor));
+	Recorder->Bind();
+	return Recorder;
+}
+
+FGASCaptureRecorder::FGASCaptureRecorder(const TSharedRef<FGASWorldMonitor>& InMonitor)
+	:Monitor(InMonitor)
+	,World(InMonitor->GetWorld())
+	,Head(0)
+	,FramePool(MakeShared<FGASCaptureFramePool, ESPMode::ThreadSafe>())
+	,NumFrames(0)
+	,FramesSinceKeyframe(0)
+	,bForceKeyframe(false)
+	,PostFramesRemaining(INDEX_NONE)
+	,LastPersistTime(0.0)
+	,TriggersSerial(0)
+{
+	WorldName = GetNameSafe(World.Get());
+
+	ResizeBuffer();
+}
+
+FGASCaptureRecorder::~FGASCaptureRecorder()
+{
+	Unbind();
+}
+
+void FGASCaptureRecorder::Bind()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	TagChangedHandle = LocalMonitor->OnTagChanged.AddSP(this, &FGASCaptureRecorder::HandleTagChanged);
+	EffectAppliedHandle = LocalMonitor->OnEffectApplied.AddSP(this, &FGASCaptureRecorder::HandleEffectApplied);
+	EffectChangedHandle = LocalMonitor->OnEffectChanged.AddSP(this, &FGASCaptureRecorder::HandleEffectChanged);
+	AbilityEventHandle = LocalMonitor->OnAbilityEvent.AddSP(this, &FGASCaptureRecorder::HandleAbilityEvent);
+	TickHandle = LocalMonitor->OnTick.AddSP(this, &FGASCaptureRecorder::HandleTick);
+}
+
+void FGASCaptureRecorder::Unbind()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	LocalMonitor->OnTagChanged.Remove(TagChangedHandle);
+	LocalMonitor->OnEffectApplied.Remove(EffectAppliedHandle);
+	LocalMonitor->OnEffectChanged.Remove(EffectChangedHandle);
+	LocalMonitor->OnAbilityEvent.Remove(AbilityEventHandle);
+	LocalMonitor->OnTick.Remove(TickHandle);
+}
+
+void FGASCaptureRecorder::ResizeBuffer()
+{
+	// 触发前的帧 + 触发帧 + 触发后的帧 + 正在记录的帧
+	// Frames before + the trigger frame + frames after + the frame being recorded
+	const int32 Capacity = FMath::Max(0, CVarGASAttachEditorCaptureFramesBefore.GetValueOnGameThread()) + FMath::Max(0, CVarGASAttachEditorCaptureFramesAfter.GetValueOnGameThread()) + 2;
+	if (Frames.Num() == Capacity)
+	{
+		return;
+	}
+
+	Frames.Reset();
+	Frames.SetNum(Capacity);
+	Head = 0;
+	NumFrames = 0;
+	FramesSinceKeyframe = 0;
+
+	// 预先分配一块备用缓冲，触发时直接换上
+	// Preallocates one spare buffer to swap in when a trigger fires
+	FScopeLock Lock(&FramePool->Lock);
+	FramePool->Buffers.Reset();
+	FramePool->Buffers.Reserve(4);
+	FramePool->Buffers.AddDefaulted_GetRef().SetNum(Capacity);
+}
+
+void FGASCaptureRecorder::Fire(const FString& InReason)
+{
+	// 手动触发不受冷却时间限制
+	// Manual captures ignore the cooldown
+	LastPersistTime = 0.0;
+	OnTriggerFired(TEXT("Manual"), InReason);
+}
+
+void FGASCaptureRecorder::FlushPending()
+{
+	if (IsWaitingForPostFrames())
+	{
+		Persist();
+	}
+}
+
+void FGASCaptureRecorder::AddEvent(EGASCaptureEventType InType, const UAbilitySystemComponent* InASC, FName InSubject, FName InDetail, int32 InValue, int32 InHandle)
+{
+	FGASCaptureEvent& Event = GetCurrentFrame().Events.AddDefaulted_GetRef();
+	Event.Type = InType;
+	Event.Actor = FGASCaptureSampler::GetActorName(InASC);
+	Event.Subject = InSubject;
+	Event.Detail = InDetail;
+	Event.Value = InValue;
+	Event.Handle = InHandle;
+}
+
+void FGASCaptureRecorder::EvaluateAttributeTriggers()
+{
+	if (TriggersSerial != CurrentTriggersSerial)
+	{
+		TriggersSerial = CurrentTriggersSerial;
+		AttributeTriggerStates.Reset();
+		AttributeTriggerStates.SetNum(Triggers.Num());
+	}
+
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	for (int32 TriggerIndex = 0; TriggerIndex < Triggers.Num(); ++TriggerIndex)
+	{
+		const FGASCaptureTrigger& Trigger = Triggers[TriggerIndex];
+		if (!Trigger.IsAttributeTrigger())
+		{
+			continue;
+		}
+
+		TSet<TWeakObjectPtr<UAbilitySystemComponent>>& MetAbilitySystems = AttributeTriggerStates[TriggerIndex];
+
+		for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : LocalMonitor->GetAbilitySystems())
+		{
+			const UAbilitySystemComponent* ASC = WeakASC.Get();
+			if (!ASC || !ASC->HasAttributeSetForAttribute(Trigger.Attribute))
+			{
+				continue;
+			}
+
+			const float Value = ASC->GetNumericAttribute(Trigger.Attribute);
+			if (!Trigger.IsAttributeConditionMet(Value))
+			{
+				MetAbilitySystems.Remove(WeakASC);
+				continue;
+			}
+
+			bool bAlreadyMet = false;
+			MetAbilitySystems.Add(WeakASC, &bAlreadyMet);
+			if (!bAlreadyMet)
+			{
+				OnTriggerFired(FName(*Trigger.ToString()), FString::Printf(TEXT("%s (%s) on %s"), *Trigger.ToString(), *LexToSanitizedString(Value), *FGASCaptureSampler::GetActorName(ASC).ToString()));
+			}
+		}
+	}
+}
+
+void FGASCaptureRecorder::OnTriggerFired(FName InTriggerName, const FString& InReason)
+{
+	if (IsWaitingForPostFrames())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (LastPersistTime > 0.0 && Now - LastPersistTime < CVarGASAttachEditorCaptureCooldown.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	UWorld* LocalWorld = World.Get();
+
+	PendingHeader.World = WorldName;
+	PendingHeader.Reason = InReason;
+	PendingHeader.TriggerFrame = GFrameCounter;
+	PendingHeader.TriggerWorldTime = LocalWorld ? LocalWorld->GetTimeSeconds() : 0.f;
+
+	PostFramesRemaining = FMath::Max(0, CVarGASAttachEditorCaptureFramesAfter.GetValueOnGameThread());
+
+	// 触发的这一帧总是带有完整状态
+	// The frame of the trigger always carries the full state
+	bForceKeyframe = true;
+
+	// 原因里有具体的值，每次都不一样，不能变成名字
+	// The reason holds values and differs every time, so it must not become a name
+	AddEvent(EGASCaptureEventType::TriggerFired, nullptr, InTriggerName, NAME_None, 0, INDEX_NONE);
+
+	UE_LOG(LogGASAttachEditor, Log, TEXT("GAS capture triggered in %s: %s"), *WorldName, *InReason);
+}
+
+void FGASCaptureRecorder::Persist()
+{
+	// 把最老的帧转到开头，整块缓冲交给后台写入，换上写完还回来的备用缓冲
+	// Rotates the oldest frame to the front, hands the whole buffer to the background write and swaps in a spare one that was handed back
+	const int32 Capacity = Frames.Num();
+	const int32 Oldest = (Head - NumFrames + Capacity) % Capacity;
+	Algo::Rotate(Frames, Oldest);
+
+	TArray<FGASCaptureFrame> Spare;
+	{
+		FScopeLock Lock(&FramePool->Lock);
+		while (Spare.Num() != Capacity && FramePool->Buffers.Num() > 0)
+		{
+			Spare = FramePool->Buffers.Pop(EAllowShrinking::No);
+		}
+	}
+
+	// 只有上一次写入还没完成时才需要分配
+	// Only allocates while the previous write is still in flight
+	if (Spare.Num() != Capacity)
+	{
+		Spare.SetNum(Capacity);
+	}
+
+	const FString& Filename = WrittenFiles.Add_GetRef(FGASCaptureWriter::MakeCaptureFilename(WorldName, PendingHeader.Reason));
+	FGASCaptureWriter::WriteAsync(Filename, PendingHeader, MoveTemp(Frames), NumFrames, FramePool);
+	Frames = MoveTemp(Spare);
+
+	Head = 0;
+	NumFrames = 0;
+	FramesSinceKeyframe = 0;
+	PostFramesRemaining = INDEX_NONE;
+	LastPersistTime = FPlatformTime::Seconds();
+}
+
+void FGASCaptureRecorder::HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 NewCount)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureRecord);
+
+	AddEvent(EGASCaptureEventType::TagChanged, InASC, InTag.GetTagName(), NAME_None, NewCount, INDEX_NONE);
+
+	for (const FGASCaptureTrigger& Trigger : Triggers)
+	{
+		if (Trigger.MatchesTag(InTag, NewCount))
+		{
+			OnTriggerFired(FName(*Trigger.ToString()), FString::Printf(TEXT("%s (%s) on %s"), *Trigger.ToString(), *InTag.ToString(), *FGASCaptureSampler::GetActorName(InASC).ToString()));
+			break;
+		}
+	}
+}
+
+void FGASCaptureRecorder::HandleEffectApplied(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureRecord);
+
+	// 瞬时效果的句柄无效，记为 INDEX_NONE
+	// Instant effects have no valid handle and are recorded with INDEX_NONE
+	const FName EffectClass = InSpec.Def ? InSpec.Def->GetClass()->GetFName() : NAME_None;
+	AddEvent(EGASCaptureEventType::EffectApplied, InASC, EffectClass, NAME_None, InSpec.GetStackCount(), InHandle.IsValid() ? GetTypeHash(InHandle) : INDEX_NONE);
+
+	for (const FGASCaptureTrigger& Trigger : Triggers)
+	{
+		if (Trigger.MatchesEffect(EffectClass))
+		{
+			OnTriggerFired(FName(*Trigger.ToString()), FString::Printf(TEXT("%s (%s) on %s"), *Trigger.ToString(), *EffectClass.ToString(), *FGASCaptureSampler::GetActorName(InASC).ToString()));
+			break;
+		}
+	}
+}
+
+void FGASCaptureRecorder::HandleEffectChanged(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle, bool bAdded)
+{
+	// 加入在 HandleEffectApplied 里记录
+	// Additions are recorded in HandleEffectApplied
+	if (bAdded)
+	{
+		return;
+	}
+
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureRecord);
+
+	const FName EffectClass = InSpec.Def ? InSpec.Def->GetClass()->GetFName() : NAME_None;
+	AddEvent(EGASCaptureEventType::EffectRemoved, InASC, EffectClass, NAME_None, InSpec.GetStackCount(), GetTypeHash(InHandle));
+}
+
+void FGASCaptureRecorder::HandleAbilityEvent(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, EGASMonitorAbilityEvent InEvent, const FGameplayTagContainer& InFailureTags)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureRecord);
+
+	const FName AbilityClass = InAbility ? InAbility->GetClass()->GetFName() : NAME_None;
+
+	switch (InEvent)
+	{
+	case EGASMonitorAbilityEvent::Activated:
+		AddEvent(EGASCaptureEventType::AbilityActivated, InASC, AbilityClass, NAME_None, 0, INDEX_NONE);
+		break;
+
+	case EGASMonitorAbilityEvent::Ended:
+		AddEvent(EGASCaptureEventType::AbilityEnded, InASC, AbilityClass, NAME_None, 0, INDEX_NONE);
+		break;
+
+	case EGASMonitorAbilityEvent::Failed:
+	{
+		const FName FailureTag = InFailureTags.Num() > 0 ? InFailureTags.First().GetTagName() : NAME_None;
+		AddEvent(EGASCaptureEventType::AbilityFailed, InASC, AbilityClass, FailureTag, InFailureTags.Num(), INDEX_NONE);
+
+		for (const FGASCaptureTrigger& Trigger : Triggers)
+		{
+			if (Trigger.MatchesFailedAbility(AbilityClass))
+			{
+				OnTriggerFired(FName(*Trigger.ToString()), FString::Printf(TEXT("%s (%s) on %s"), *Trigger.ToString(), *AbilityClass.ToString(), *FGASCaptureSampler::GetActorName(InASC).ToString()));
+				break;
+			}
+		}
+		break;
+	}
+	}
+}
+
+void FGASCaptureRecorder::HandleTick(float DeltaSeconds)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureRecord);
+
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	UWorld* LocalWorld = World.Get();
+	if (!LocalMonitor.IsValid() || !LocalWorld)
+	{
+		return;
+	}
+
+	EvaluateAttributeTriggers();
+
+	FGASCaptureFrame& Frame = GetCurrentFrame();
+	Frame.Frame = LocalMonitor->GetFrameNumber();
+	Frame.WorldTime = LocalWorld->GetTimeSeconds();
+	Frame.DeltaSeconds = DeltaSeconds;
+
+	const int32 KeyframeInterval = FMath::Max(1, CVarGASAttachEditorCaptureKeyframeInterval.GetValueOnGameThread());
+	if (bForceKeyframe || NumFrames == 0 || ++FramesSinceKeyframe >= KeyframeInterval)
+	{
+		FGASCaptureSampler::CaptureWorld(*LocalMonitor, Frame.Keyframe);
+		Frame.bHasKeyframe = true;
+		FramesSinceKeyframe = 0;
+		bForceKeyframe = false;
+	}
+
+	// Head 总是正在记录的帧，完成的帧在它之前，所以最多保留 Num - 1 帧
+	// Head is always the frame being recorded and finished frames precede it, so at most Num - 1 are kept
+	NumFrames = FMath::Min(NumFrames + 1, Frames.Num() - 1);
+	Head = (Head + 1) % Frames.Num();
+	Frames[Head].Reset();
+
+	if (!IsWaitingForPostFrames())
+	{
+		// 缓冲大小只在没有待写入的录制时调整
+		// The buffer is only resized while no capture is pending
+		ResizeBuffer();
+	}
+	else if (PostFramesRemaining-- == 0)
+	{
+		Persist();
+	}
+}
+
+void FGASCaptureRecorder::Startup()
+{
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FGASCaptureRecorder::HandleWorldCleanup);
+}
+
+void FGASCaptureRecorder::Shutdown()
+{
+	StopRecording();
+
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+	FGASCaptureWriter::FlushAsyncWrites();
+}
+
+void FGASCaptureRecorder::StartRecording()
+{
+	if (bRecording)
+	{
+		return;
+	}
+
+	bRecording = true;
+
+	FGASWorldMonitor::SetAutoCreate(CaptureAutoCreateOwner, true);
+	MonitorCreatedHandle = FGASWorldMonitor::OnMonitorCreated.AddStatic(&FGASCaptureRecorder::HandleMonitorCreated);
+
+	for (const TSharedRef<FGASWorldMonitor>& ExistingMonitor : FGASWorldMonitor::GetMonitors())
+	{
+		HandleMonitorCreated(ExistingMonitor);
+	}
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("GAS capture recording started, captures are written to %s"), *FGASCaptureWriter::GetCaptureDir());
+}
+
+void FGASCaptureRecorder::StopRecording()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	bRecording = false;
+
+	for (const TSharedRef<FGASCaptureRecorder>& Recorder : Recorders)
+	{
+		Recorder->FlushPending();
+	}
+	Recorders.Reset();
+
+	FGASWorldMonitor::OnMonitorCreated.Remove(MonitorCreatedHandle);
+	FGASWorldMonitor::SetAutoCreate(CaptureAutoCreateOwner, false);
+}
+
+void FGASCaptureRecorder::AddTrigger(const FGASCaptureTrigger& InTrigger)
+{
+	Triggers.Add(InTrigger);
+	++CurrentTriggersSerial;
+
+	StartRecording();
+}
+
+void FGASCaptureRecorder::ClearTriggers()
+{
+	Triggers.Reset();
+	++CurrentTriggersSerial;
+}
+
+void FGASCaptureRecorder::FireAll(const FString& InReason)
+{
+	if (Recorders.Num() == 0)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("No GAS capture is recording, run GASAttachEditor.Capture.Start first"));
+		return;
+	}
+
+	for (const TSharedRef<FGASCaptureRecorder>& Recorder : Recorders)
+	{
+		Recorder->Fire(InReason);
+	}
+}
+
+TArray<FString> FGASCaptureRecorder::TakeWrittenFiles()
+{
+	return MoveTemp(WrittenFiles);
+}
+
+void FGASCaptureRecorder::HandleMonitorCreated(const TSharedRef<FGASWorldMonitor>& InMonitor)
+{
+	const bool bHasRecorder = Recorders.ContainsByPredicate([&InMonitor](const TSharedRef<FGASCaptureRecorder>& Recorder)
+	{
+		return Recorder->GetWorld() == InMonitor->GetWorld();
+	});
+
+	if (!bHasRecorder)
+	{
+		Recorders.Add(Create(InMonitor));
+	}
+}
+
+void FGASCaptureRecorder::HandleWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	for (int32 Index = Recorders.Num() - 1; Index >= 0; --Index)
+	{
+		UWorld* RecorderWorld = Recorders[Index]->GetWorld();
+		if (RecorderWorld && RecorderWorld != InWorld)
+		{
+			continue;
+		}
+
+		// 世界结束时写出已经触发的录制
+		// A capture that already fired is written when its world goes away
+		Recorders[Index]->FlushPending();
+		Recorders.RemoveAtSwap(Index);
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Capture/GASCaptureTypes.h"
+#include "Capture/GASCaptureFile.h"
+#include "Capture/GASCaptureTrigger.h"
+#include "Monitor/GASWorldMonitor.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+class UWorld;
+
+// 把一个世界最近的若干帧保存在环形缓冲里，触发器触发后再录制若干帧，然后在后台写入文件
+// 平时只在内存里复用同一块缓冲，不做任何磁盘读写
+//
+// Keeps the last frames of one world in a ring buffer; when a trigger fires it records a few more
+// frames and writes them to disk in the background. Until then the same memory is reused and nothing touches the disk
+class FGASCaptureRecorder : public TSharedFromThis<FGASCaptureRecorder>
+{
+public:
+
+	static TSharedRef<FGASCaptureRecorder> Create(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	~FGASCaptureRecorder();
+
+	// 手动触发一次录制
+	// Fires a capture manually
+	void Fire(const FString& InReason);
+
+	// 正在等待触发后的帧
+	// Waiting for the frames after a trigger
+	bool IsWaitingForPostFrames() const { return PostFramesRemaining != INDEX_NONE; }
+
+	// 立即写出已触发但还未完成的录制
+	// Writes out a fired capture that has not finished yet
+	void FlushPending();
+
+	UWorld* GetWorld() const { return World.Get(); }
+
+public:
+
+	// 模块启动/关闭时调用
+	// Called on module startup/shutdown
+	static void Startup();
+	static void Shutdown();
+
+	// 开始/停止为所有游戏世界录制
+	// Starts/stops recording every game world
+	static void StartRecording();
+	static void StopRecording();
+	static bool IsRecording() { return bRecording; }
+
+	static void AddTrigger(const FGASCaptureTrigger& InTrigger);
+	static void ClearTriggers();
+	static const TArray<FGASCaptureTrigger>& GetTriggers() { return Triggers; }
+
+	static void FireAll(const FString& InReason);
+
+	// 取出上次调用以来交给后台写入的录制文件名
+	// Takes the capture filenames handed to the background writer since the last call
+	static TArray<FString> TakeWrittenFiles();
+
+private:
+
+	explicit FGASCaptureRecorder(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	void Bind();
+
+	void Unbind();
+
+	void ResizeBuffer();
+
+	FGASCaptureFrame& GetCurrentFrame() { return Frames[Head]; }
+
+	void AddEvent(EGASCaptureEventType InType, const UAbilitySystemComponent* InASC, FName InSubject, FName InDetail, int32 InValue, int32 InHandle);
+
+	void EvaluateAttributeTriggers();
+
+	// InTriggerName 是固定的触发器名，记进事件里；InReason 带着具体的值，只写进文件头
+	// InTriggerName is the fixed trigger name recorded in the event; InReason carries the values and only goes into the file header
+	void OnTriggerFired(FName InTriggerName, const FString& InReason);
+
+	void Persist();
+
+private:
+
+	void HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 NewCount);
+
+	void HandleEffectApplied(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle);
+
+	void HandleEffectChanged(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle, bool bAdded);
+
+	void HandleAbilityEvent(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, EGASMonitorAbilityEvent InEvent, const FGameplayTagContainer& InFailureTags);
+
+	void HandleTick(float DeltaSeconds);
+
+	static void HandleMonitorCreated(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	static void HandleWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
+
+private:
+
+	TWeakPtr<FGASWorldMonitor> Monitor;
+
+	TWeakObjectPtr<UWorld> World;
+
+	FString WorldName;
+
+	FDelegateHandle TagChangedHandle;
+	FDelegateHandle EffectAppliedHandle;
+	FDelegateHandle EffectChangedHandle;
+	FDelegateHandle AbilityEventHandle;
+	FDelegateHandle TickHandle;
+
+	// 环形缓冲，Head 为正在记录的帧
+	// Ring buffer; Head is the frame being recorded
+	TArray<FGASCaptureFrame> Frames;
+
+	int32 Head;
+
+	// 写完的缓冲还回这里，Persist 换上它继续录制
+	// Written buffers come back here and Persist swaps them in to keep recording
+	TSharedRef<FGASCaptureFramePool, ESPMode::ThreadSafe> FramePool;
+
+	int32 NumFrames;
+
+	int32 FramesSinceKeyframe;
+
+	bool bForceKeyframe;
+
+	FGASCaptureHeader PendingHeader;
+
+	int32 PostFramesRemaining;
+
+	double LastPersistTime;
+
+	// 每个属性触发器当前满足条件的ASC，用于边沿检测
+	// ASCs currently meeting each attribute trigger, used for edge detection
+	TArray<TSet<TWeakObjectPtr<UAbilitySystemComponent>>> AttributeTriggerStates;
+
+	uint32 TriggersSerial;
+
+private:
+
+	static TArray<FGASCaptureTrigger> Triggers;
+
+	static uint32 CurrentTriggersSerial;
+
+	static TArray<TSharedRef<FGASCaptureRecorder>> Recorders;
+
+	static bool bRecording;
+
+	static TArray<FString> WrittenFiles;
+
+	static FDelegateHandle MonitorCreatedHandle;
+
+	static FDelegateHandle WorldCleanupHandle;
+};
@@ -0,0 +1,180 @@
+#include "Capture/GASCaptureSampler.h"
+#include "AbilitySystemComponent.h"
+#include "AttributeSet.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Monitor/GASWorldMonitor.h"
+#include "UObject/UObjectHash.h"
+#include "GASAttachEditorStats.h"
+
+const FActiveGameplayEffectsContainer* FGASCaptureSampler::GetActiveGameplayEffects(const UAbilitySystemComponent* InASC)
+{
+	static FProperty* GameplayEffectsProperty = FindFProperty<FProperty>(UAbilitySystemComponent::StaticClass(), TEXT("ActiveGameplayEffects"));
+	if (!GameplayEffectsProperty)
+	{
+		return nullptr;
+	}
+
+	return GameplayEffectsProperty->ContainerPtrToValuePtr<FActiveGameplayEffectsContainer>(InASC);
+}
+
+AActor* FGASCaptureSampler::GetActor(const UAbilitySystemComponent* InASC)
+{
+	if (!InASC)
+	{
+		return nullptr;
+	}
+
+	if (AActor* LocalAvatarActor = InASC->GetAvatarActor_Direct())
+	{
+		return LocalAvatarActor;
+	}
+
+	return InASC->GetOwnerActor();
+}
+
+FName FGASCaptureSampler::GetActorName(const UAbilitySystemComponent* InASC)
+{
+	const AActor* Actor = GetActor(InASC);
+	return Actor ? Actor->GetFName() : NAME_None;
+}
+
+void FGASCaptureSampler::CaptureAbilitySystem(const UAbilitySystemComponent* InASC, FGASCaptureAscSnapshot& OutSnapshot)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureSample);
+
+	OutSnapshot.Reset();
+
+	if (!InASC)
+	{
+		return;
+	}
+
+	if (const AActor* Actor = GetActor(InASC))
+	{
+		OutSnapshot.Actor = Actor->GetFName();
+		OutSnapshot.ActorClass = Actor->GetClass()->GetFName();
+		OutSnapshot.Role = static_cast<uint8>(Actor->GetLocalRole());
+	}
+
+	// 复用同一个容器，避免每个ASC都分配一次
+	// The same container is reused so every ASC does not allocate again
+	static FGameplayTagContainer ScratchTags;
+
+	ScratchTags.Reset();
+	InASC->GetOwnedGameplayTags(ScratchTags);
+	OutSnapshot.Tags.Reserve(ScratchTags.Num());
+	for (const FGameplayTag& Tag : ScratchTags)
+	{
+		FGASCaptureTagCount& TagCount = OutSnapshot.Tags.AddDefaulted_GetRef();
+		TagCount.Tag = Tag.GetTagName();
+		TagCount.Count = InASC->GetTagCount(Tag);
+	}
+
+	ScratchTags.Reset();
+	InASC->GetBlockedAbilityTags(ScratchTags);
+	OutSnapshot.BlockedTags.Reserve(ScratchTags.Num());
+	for (const FGameplayTag& Tag : ScratchTags)
+	{
+		OutSnapshot.BlockedTags.Add(Tag.GetTagName());
+	}
+
+	for (const UAttributeSet* Set : InASC->GetSpawnedAttributes())
+	{
+		if (!Set)
+		{
+			continue;
+		}
+
+		for (TFieldIterator<FStructProperty> It(Set->GetClass()); It; ++It)
+		{
+			if ((*It)->Struct != FGameplayAttributeData::StaticStruct())
+			{
+				continue;
+			}
+
+			const FGameplayAttributeData* Data = (*It)->ContainerPtrToValuePtr<FGameplayAttributeData>(Set);
+
+			FGASCaptureAttribute& Attribute = OutSnapshot.Attributes.AddDefaulted_GetRef();
+			Attribute.Attribute = (*It)->GetFName();
+			Attribute.BaseValue = Data->GetBaseValue();
+			Attribute.CurrentValue = Data->GetCurrentValue();
+		}
+	}
+
+	if (const FActiveGameplayEffectsContainer* ActiveGameplayEffects = GetActiveGameplayEffects(InASC))
+	{
+		for (const FActiveGameplayEffect& ActiveGE : ActiveGameplayEffects)
+		{
+			FGASCaptureEffect& Effect = OutSnapshot.Effects.AddDefaulted_GetRef();
+			Effect.Definition = ActiveGE.Spec.Def ? ActiveGE.Spec.Def->GetClass()->GetFName() : NAME_None;
+			Effect.Handle = GetTypeHash(ActiveGE.Handle);
+			Effect.StackCount = ActiveGE.Spec.GetStackCount();
+			Effect.Level = ActiveGE.Spec.GetLevel();
+			Effect.StartWorldTime = ActiveGE.StartWorldTime;
+			Effect.Duration = ActiveGE.GetDuration();
+			Effect.bInhibited = ActiveGE.bIsInhibited;
+		}
+	}
+
+	const TArray<FGameplayAbilitySpec>& Abilities = InASC->GetActivatableAbilities();
+	OutSnapshot.Abilities.Reserve(Abilities.Num());
+	for (const FGameplayAbilitySpec& AbilitySpec : Abilities)
+	{
+		if (!AbilitySpec.Ability)
+		{
+			continue;
+		}
+
+		FGASCaptureAbility& Ability = OutSnapshot.Abilities.AddDefaulted_GetRef();
+		Ability.Ability = AbilitySpec.Ability->GetClass()->GetFName();
+		Ability.Level = AbilitySpec.Level;
+		Ability.InputID = AbilitySpec.InputID;
+		Ability.ActiveCount = AbilitySpec.ActiveCount;
+	}
+}
+
+void FGASCaptureSampler::CaptureWorld(const FGASWorldMonitor& InMonitor, FGASCaptureWorldSnapshot& OutSnapshot)
+{
+	OutSnapshot.Reset();
+	OutSnapshot.Frame = InMonitor.GetFrameNumber();
+
+	if (const UWorld* World = InMonitor.GetWorld())
+	{
+		OutSnapshot.WorldTime = World->GetTimeSeconds();
+	}
+
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : InMonitor.GetAbilitySystems())
+	{
+		if (const UAbilitySystemComponent* ASC = WeakASC.Get())
+		{
+			CaptureAbilitySystem(ASC, OutSnapshot.AddAbilitySystem());
+		}
+	}
+}
+
+void FGASCaptureSampler::CaptureWorld(const UWorld* InWorld, FGASCaptureWorldSnapshot& OutSnapshot)
+{
+	OutSnapshot.Reset();
+	OutSnapshot.Frame = GFrameCounter;
+
+	if (!InWorld)
+	{
+		return;
+	}
+
+	OutSnapshot.WorldTime = InWorld->GetTimeSeconds();
+
+	TArray<UObject*> Objects;
+	GetObjectsOfClass(UAbilitySystemComponent::StaticClass(), Objects, true, RF_ClassDefaultObject, EInternalObjectFlags::Garbage);
+
+	for (const UObject* Object : Objects)
+	{
+		const UAbilitySystemComponent* ASC = static_cast<const UAbilitySystemComponent*>(Object);
+		if (ASC->GetWorld() == InWorld)
+		{
+			CaptureAbilitySystem(ASC, OutSnapshot.AddAbilitySystem());
+		}
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/GASCaptureTypes.h"
+
+class UAbilitySystemComponent;
+class FGASWorldMonitor;
+class UWorld;
+struct FActiveGameplayEffectsContainer;
+
+// 在游戏线程上把ASC状态拷贝成 POD 数据，只做拷贝不做格式化
+// Copies ASC state into POD data on the game thread; no formatting happens here
+class FGASCaptureSampler
+{
+public:
+
+	static void CaptureAbilitySystem(const UAbilitySystemComponent* InASC, FGASCaptureAscSnapshot& OutSnapshot);
+
+	static void CaptureWorld(const FGASWorldMonitor& InMonitor, FGASCaptureWorldSnapshot& OutSnapshot);
+
+	// 没有监听器时通过类哈希查找世界里的ASC
+	// Finds the world's ASCs through the class hash when no monitor exists
+	static void CaptureWorld(const UWorld* InWorld, FGASCaptureWorldSnapshot& OutSnapshot);
+
+	// 优先使用 Avatar，没有时使用 Owner，与面板里的角色选择一致
+	// Prefers the avatar and falls back to the owner, like the actor picker of the panel
+	static AActor* GetActor(const UAbilitySystemComponent* InASC);
+
+	static FName GetActorName(const UAbilitySystemComponent* InASC);
+
+	// ActiveGameplayEffects 是 protected 的，通过反射访问
+	// ActiveGameplayEffects is protected and is reached through reflection
+	static const FActiveGameplayEffectsContainer* GetActiveGameplayEffects(const UAbilitySystemComponent* InASC);
+};
@@ -0,0 +1,193 @@
+#include "Capture/GASCaptureTrigger.h"
+#include "UObject/UObjectIterator.h"
+
+namespace GASCaptureTrigger
+{
+	const EGASCaptureTriggerType AllTypes[] =
+	{
+		EGASCaptureTriggerType::TagAdded,
+		EGASCaptureTriggerType::TagRemoved,
+		EGASCaptureTriggerType::EffectApplied,
+		EGASCaptureTriggerType::AbilityFailed,
+		EGASCaptureTriggerType::AttributeBelow,
+		EGASCaptureTriggerType::AttributeAbove,
+	};
+}
+
+bool FGASCaptureTrigger::MatchesTag(const FGameplayTag& InTag, int32 NewCount) const
+{
+	if (Type == EGASCaptureTriggerType::TagAdded && NewCount <= 0)
+	{
+		return false;
+	}
+
+	if (Type == EGASCaptureTriggerType::TagRemoved && NewCount > 0)
+	{
+		return false;
+	}
+
+	if (Type != EGASCaptureTriggerType::TagAdded && Type != EGASCaptureTriggerType::TagRemoved)
+	{
+		return false;
+	}
+
+	return !Tag.IsValid() || InTag.MatchesTag(Tag);
+}
+
+bool FGASCaptureTrigger::MatchesEffect(FName InEffectClass) const
+{
+	return Type == EGASCaptureTriggerType::EffectApplied && (Subject.IsNone() || Subject == InEffectClass);
+}
+
+bool FGASCaptureTrigger::MatchesFailedAbility(FName InAbilityClass) const
+{
+	return Type == EGASCaptureTriggerType::AbilityFailed && (Subject.IsNone() || Subject == InAbilityClass);
+}
+
+bool FGASCaptureTrigger::IsAttributeConditionMet(float InValue) const
+{
+	if (Type == EGASCaptureTriggerType::AttributeBelow)
+	{
+		return InValue < Threshold;
+	}
+
+	if (Type == EGASCaptureTriggerType::AttributeAbove)
+	{
+		return InValue > Threshold;
+	}
+
+	return false;
+}
+
+FString FGASCaptureTrigger::ToString() const
+{
+	const FString SubjectString = Subject.IsNone() ? TEXT("Any") : Subject.ToString();
+
+	if (IsAttributeTrigger())
+	{
+		return FString::Printf(TEXT("%s %s %s"), GetTypeName(Type), *SubjectString, *LexToSanitizedString(Threshold));
+	}
+
+	return FString::Printf(TEXT("%s %s"), GetTypeName(Type), *SubjectString);
+}
+
+bool FGASCaptureTrigger::Parse(const TArray<FString>& InArgs, FGASCaptureTrigger& OutTrigger, FString& OutError)
+{
+	if (InArgs.Num() == 0)
+	{
+		OutError = TEXT("Missing trigger type");
+		return false;
+	}
+
+	bool bFoundType = false;
+	for (EGASCaptureTriggerType TriggerType : GASCaptureTrigger::AllTypes)
+	{
+		if (InArgs[0].Equals(GetTypeName(TriggerType), ESearchCase::IgnoreCase))
+		{
+			OutTrigger.Type = TriggerType;
+			bFoundType = true;
+			break;
+		}
+	}
+
+	if (!bFoundType)
+	{
+		OutError = FString::Printf(TEXT("Unknown trigger type '%s'"), *InArgs[0]);
+		return false;
+	}
+
+	OutTrigger.Subject = InArgs.IsValidIndex(1) ? FName(*InArgs[1]) : NAME_None;
+	OutTrigger.Tag = FGameplayTag();
+	OutTrigger.Attribute = FGameplayAttribute();
+
+	switch (OutTrigger.Type)
+	{
+	case EGASCaptureTriggerType::TagAdded:
+	case EGASCaptureTriggerType::TagRemoved:
+		if (!OutTrigger.Subject.IsNone())
+		{
+			OutTrigger.Tag = FGameplayTag::RequestGameplayTag(OutTrigger.Subject, false);
+			if (!OutTrigger.Tag.IsValid())
+			{
+				OutError = FString::Printf(TEXT("Unknown gameplay tag '%s'"), *InArgs[1]);
+				return false;
+			}
+		}
+		break;
+
+	case EGASCaptureTriggerType::AttributeBelow:
+	case EGASCaptureTriggerType::AttributeAbove:
+		if (OutTrigger.Subject.IsNone() || !InArgs.IsValidIndex(2))
+		{
+			OutError = TEXT("Attribute triggers need an attribute name and a threshold");
+			return false;
+		}
+
+		OutTrigger.Attribute = FindAttributeByName(InArgs[1]);
+		if (!OutTrigger.Attribute.IsValid())
+		{
+			OutError = FString::Printf(TEXT("Unknown attribute '%s'"), *InArgs[1]);
+			return false;
+		}
+
+		LexFromString(OutTrigger.Threshold, *InArgs[2]);
+		break;
+
+	default:
+		break;
+	}
+
+	return true;
+}
+
+const TCHAR* FGASCaptureTrigger::GetTypeName(EGASCaptureTriggerType InType)
+{
+	switch (InType)
+	{
+	case EGASCaptureTriggerType::TagAdded:
+		return TEXT("TagAdded");
+	case EGASCaptureTriggerType::TagRemoved:
+		return TEXT("TagRemoved");
+	case EGASCaptureTriggerType::EffectApplied:
+		return TEXT("EffectApplied");
+	case EGASCaptureTriggerType::AbilityFailed:
+		return TEXT("AbilityFailed");
+	case EGASCaptureTriggerType::AttributeBelow:
+		return TEXT("AttributeBelow");
+	case EGASCaptureTriggerType::AttributeAbove:
+		return TEXT("AttributeAbove");
+	}
+
+	return TEXT("");
+}
+
+FGameplayAttribute FGASCaptureTrigger::FindAttributeByName(const FString& InName)
+{
+	FString SetName;
+	FString AttributeName = InName;
+	InName.Split(TEXT("."), &SetName, &AttributeName);
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (!Class->IsChildOf(UAttributeSet::StaticClass()))
+		{
+			continue;
+		}
+
+		if (!SetName.IsEmpty() && SetName != Class->GetName() && SetName != Class->GetPrefixCPP() + Class->GetName())
+		{
+			continue;
+		}
+
+		// 只取声明在该类上的属性，避免子类重复匹配
+		// Only properties declared on the class itself, so subclasses do not match twice
+		FStructProperty* Property = FindFProperty<FStructProperty>(Class, *AttributeName);
+		if (Property && Property->GetOwnerClass() == Class && Property->Struct == FGameplayAttributeData::StaticStruct())
+		{
+			return FGameplayAttribute(Property);
+		}
+	}
+
+	return FGameplayAttribute();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "AttributeSet.h"
+
+class UAbilitySystemComponent;
+
+// 录制触发条件
+// Conditions that persist a capture
+enum class EGASCaptureTriggerType : uint8
+{
+	TagAdded,
+
+	TagRemoved,
+
+	EffectApplied,
+
+	AbilityFailed,
+
+	// 属性值低于阈值，恢复之前不会再次触发
+	// Attribute is below the threshold; does not fire again until it recovers
+	AttributeBelow,
+
+	// 属性值高于阈值，恢复之前不会再次触发
+	// Attribute is above the threshold; does not fire again until it recovers
+	AttributeAbove,
+};
+
+struct FGASCaptureTrigger
+{
+	EGASCaptureTriggerType Type = EGASCaptureTriggerType::TagAdded;
+
+	// 标签、效果类、技能类或属性名，None 表示任意
+	// Tag, effect class, ability class or attribute name; None matches anything
+	FName Subject;
+
+	float Threshold = 0.f;
+
+	// 解析后的标签，子标签也会匹配
+	// Resolved tag; child tags match as well
+	FGameplayTag Tag;
+
+	// 解析后的属性
+	// Resolved attribute
+	FGameplayAttribute Attribute;
+
+public:
+
+	bool IsAttributeTrigger() const { return Type == EGASCaptureTriggerType::AttributeBelow || Type == EGASCaptureTriggerType::AttributeAbove; }
+
+	bool MatchesTag(const FGameplayTag& InTag, int32 NewCount) const;
+
+	bool MatchesEffect(FName InEffectClass) const;
+
+	bool MatchesFailedAbility(FName InAbilityClass) const;
+
+	// 属性触发器的条件是否成立，边沿检测由录制器负责
+	// Whether the condition of an attribute trigger holds; the recorder does the edge detection
+	bool IsAttributeConditionMet(float InValue) const;
+
+	FString ToString() const;
+
+	// 解析 "<Type> [Subject] [Threshold]"
+	// Parses "<Type> [Subject] [Threshold]"
+	static bool Parse(const TArray<FString>& InArgs, FGASCaptureTrigger& OutTrigger, FString& OutError);
+
+	static const TCHAR* GetTypeName(EGASCaptureTriggerType InType);
+
+	// 在所有属性集里按名字查找属性，支持 "Health" 和 "UMyAttributeSet.Health"
+	// Finds an attribute by name in every attribute set, both "Health" and "UMyAttributeSet.Health" work
+	static FGameplayAttribute FindAttributeByName(const FString& InName);
+};
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 录制里的数据只保存 FName 和数值，游戏线程上拷贝时不做任何字符串格式化
+// Captured data only holds FNames and numbers so the game thread never formats strings while copying
+
+// 录制的事件类型
+// Type of a captured event
+enum class EGASCaptureEventType : uint8
+{
+	// 标签数量变化，Value 为新的数量
+	// Tag count changed, Value is the new count
+	TagChanged,
+
+	// 持续效果添加，Value 为层数
+	// Duration effect added, Value is the stack count
+	EffectApplied,
+
+	// 持续效果移除
+	// Duration effect removed
+	EffectRemoved,
+
+	AbilityActivated,
+
+	AbilityEnded,
+
+	// 技能激活失败，Subject 为技能类，Detail 为第一个失败原因标签
+	// Ability failed to activate, Subject is the ability class, Detail the first failure tag
+	AbilityFailed,
+
+	// 触发器触发，Subject 为触发器描述
+	// A trigger fired, Subject describes the trigger
+	TriggerFired,
+};
+
+struct FGASCaptureEvent
+{
+	EGASCaptureEventType Type = EGASCaptureEventType::TagChanged;
+
+	// ASC所在的角色
+	// Actor that owns the ASC
+	FName Actor;
+
+	// 标签 / 效果类 / 技能类
+	// Tag / effect class / ability class
+	FName Subject;
+
+	FName Detail;
+
+	int32 Value = 0;
+
+	// 同一个效果添加和移除时的句柄，用于配对
+	// Handle shared by the add and remove of one effect, used to pair them
+	int32 Handle = INDEX_NONE;
+};
+
+struct FGASCaptureTagCount
+{
+	FName Tag;
+
+	int32 Count = 0;
+};
+
+struct FGASCaptureAttribute
+{
+	FName Attribute;
+
+	float BaseValue = 0.f;
+
+	float CurrentValue = 0.f;
+};
+
+struct FGASCaptureEffect
+{
+	FName Definition;
+
+	int32 Handle = INDEX_NONE;
+
+	int32 StackCount = 0;
+
+	float Level = 0.f;
+
+	float StartWorldTime = 0.f;
+
+	// 小于等于0为无限时长
+	// Zero or less means infinite
+	float Duration = 0.f;
+
+	bool bInhibited = false;
+};
+
+struct FGASCaptureAbility
+{
+	FName Ability;
+
+	int32 Level = 0;
+
+	int32 InputID = INDEX_NONE;
+
+	uint8 ActiveCount = 0;
+};
+
+// 一个ASC在某一帧的完整状态
+// Full state of one ASC at one frame
+struct FGASCaptureAscSnapshot
+{
+	FName Actor;
+
+	FName ActorClass;
+
+	uint8 Role = 0;
+
+	TArray<FGASCaptureTagCount> Tags;
+
+	TArray<FName> BlockedTags;
+
+	TArray<FGASCaptureAttribute> Attributes;
+
+	TArray<FGASCaptureEffect> Effects;
+
+	TArray<FGASCaptureAbility> Abilities;
+
+	// 清空内容但保留内存，环形缓冲复用时不再分配
+	// Clears the content but keeps the memory so a reused ring buffer slot does not allocate
+	void Reset()
+	{
+		Actor = NAME_None;
+		ActorClass = NAME_None;
+		Role = 0;
+		Tags.Reset();
+		BlockedTags.Reset();
+		Attributes.Reset();
+		Effects.Reset();
+		Abilities.Reset();
+	}
+};
+
+// 一个世界里所有ASC在某一帧的状态
+// State of every ASC of a world at one frame
+struct FGASCaptureWorldSnapshot
+{
+	uint64 Frame = 0;
+
+	float WorldTime = 0.f;
+
+	TArray<FGASCaptureAscSnapshot> AbilitySystems;
+
+	int32 NumAbilitySystems = 0;
+
+	// 取一个可复用的ASC槽位
+	// Returns a reusable ASC slot
+	FGASCaptureAscSnapshot& AddAbilitySystem()
+	{
+		if (NumAbilitySystems == AbilitySystems.Num())
+		{
+			AbilitySystems.AddDefaulted();
+		}
+
+		FGASCaptureAscSnapshot& Snapshot = AbilitySystems[NumAbilitySystems++];
+		Snapshot.Reset();
+		return Snapshot;
+	}
+
+	TArrayView<const FGASCaptureAscSnapshot> GetAbilitySystems() const
+	{
+		return MakeArrayView(AbilitySystems.GetData(), NumAbilitySystems);
+	}
+
+	void Reset()
+	{
+		Frame = 0;
+		WorldTime = 0.f;
+		NumAbilitySystems = 0;
+	}
+};
+
+// 环形缓冲中的一帧，关键帧带有完整的世界状态
+// One frame of the ring buffer; keyframes carry the full world state
+struct FGASCaptureFrame
+{
+	uint64 Frame = 0;
+
+	float WorldTime = 0.f;
+
+	float DeltaSeconds = 0.f;
+
+	TArray<FGASCaptureEvent> Events;
+
+	bool bHasKeyframe = false;
+
+	FGASCaptureWorldSnapshot Keyframe;
+
+	void Reset()
+	{
+		Frame = 0;
+		WorldTime = 0.f;
+		DeltaSeconds = 0.f;
+		Events.Reset();
+		bHasKeyframe = false;
+		Keyframe.Reset();
+	}
+};
+
+// 一次录制的描述信息
+// Describes one persisted capture
+struct FGASCaptureHeader
+{
+	FString World;
+
+	FString Reason;
+
+	uint64 TriggerFrame = 0;
+
+	float TriggerWorldTime = 0.f;
+};
@@ -0,0 +1,302 @@
+#include "Capture/GASColumnarExport.h"
+#include "Capture/GASCaptureFile.h"
+#include "Capture/GASCaptureQuery.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+static FAutoConsoleCommand GASAttachEditorCaptureExportColumnsCmd(
+	TEXT("GASAttachEditor.Capture.ExportColumns"),
+	TEXT("Exports a capture to columnar .gascol files (events and keyframe attributes) next to it: <File|latest> [RowsPerGroup]."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Missing capture file"));
+			return;
+		}
+
+		int32 RowsPerGroup = GASColumnarFile::DefaultRowsPerGroup;
+		if (Args.IsValidIndex(1))
+		{
+			LexFromString(RowsPerGroup, *Args[1]);
+		}
+
+		const FString CaptureFile = FGASCaptureReader::ResolveFilename(Args[0]);
+		FGASColumnarExport::ExportCapture(CaptureFile, FPaths::ChangeExtension(CaptureFile, TEXT("")), RowsPerGroup);
+	}));
+
+FGASColumnarWriter::FGASColumnarWriter()
+	:RowsPerGroup(GASColumnarFile::DefaultRowsPerGroup)
+	,RowsInGroup(0)
+	,TotalRows(0)
+{
+}
+
+FGASColumnarWriter::~FGASColumnarWriter()
+{
+	if (FileWriter.IsValid())
+	{
+		Close();
+	}
+}
+
+int32 FGASColumnarWriter::AddColumn(const FString& InName, EGASColumnType InType)
+{
+	check(!FileWriter.IsValid());
+	return Columns.Add({ InName, InType, TArray<uint8>() });
+}
+
+bool FGASColumnarWriter::Open(const FString& InFilename, int32 InRowsPerGroup)
+{
+	Filename = InFilename;
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not open %s for writing"), *Filename);
+		return false;
+	}
+
+	RowsPerGroup = FMath::Max(1, InRowsPerGroup);
+	RowsInGroup = 0;
+	TotalRows = 0;
+	Dictionary.Reset();
+	DictionaryNames.Reset();
+	RowGroups.Reset();
+
+	uint32 FileMagic = GASColumnarFile::Magic;
+	uint32 FileVersion = GASColumnarFile::Version;
+	int32 NumColumns = Columns.Num();
+	*FileWriter << FileMagic;
+	*FileWriter << FileVersion;
+	*FileWriter << NumColumns;
+
+	for (FColumn& Column : Columns)
+	{
+		SerializeUtf8(*FileWriter, Column.Name);
+
+		uint8 Type = static_cast<uint8>(Column.Type);
+		*FileWriter << Type;
+
+		// 所有类型都不超过8字节，按最大值预留
+		// No type is wider than 8 bytes, reserve for the widest
+		Column.Buffer.Reset(RowsPerGroup * sizeof(uint64));
+	}
+
+	return true;
+}
+
+void FGASColumnarWriter::SetName(int32 InColumn, FName InValue)
+{
+	int32 Index = INDEX_NONE;
+	if (!InValue.IsNone())
+	{
+		if (const int32* Found = Dictionary.Find(InValue))
+		{
+			Index = *Found;
+		}
+		else
+		{
+			Index = DictionaryNames.Add(InValue);
+			Dictionary.Add(InValue, Index);
+		}
+	}
+
+	Append(InColumn, &Index, sizeof(Index));
+}
+
+void FGASColumnarWriter::Append(int32 InColumn, const void* InData, int32 InSize)
+{
+	TArray<uint8>& Buffer = Columns[InColumn].Buffer;
+	const int32 Offset = Buffer.AddUninitialized(InSize);
+	FMemory::Memcpy(Buffer.GetData() + Offset, InData, InSize);
+}
+
+void FGASColumnarWriter::EndRow()
+{
+	++TotalRows;
+
+	if (++RowsInGroup >= RowsPerGroup)
+	{
+		FlushRowGroup();
+	}
+}
+
+void FGASColumnarWriter::FlushRowGroup()
+{
+	if (RowsInGroup == 0 || !FileWriter.IsValid())
+	{
+		return;
+	}
+
+	RowGroups.Emplace(FileWriter->Tell(), RowsInGroup);
+	*FileWriter << RowsInGroup;
+
+	for (FColumn& Column : Columns)
+	{
+		FileWriter->Serialize(Column.Buffer.GetData(), Column.Buffer.Num());
+		Column.Buffer.Reset();
+	}
+
+	RowsInGroup = 0;
+}
+
+bool FGASColumnarWriter::Close()
+{
+	if (!FileWriter.IsValid())
+	{
+		return false;
+	}
+
+	FlushRowGroup();
+
+	int64 DictionaryOffset = FileWriter->Tell();
+	int32 NumNames = DictionaryNames.Num();
+	*FileWriter << NumNames;
+	for (const FName& Name : DictionaryNames)
+	{
+		SerializeUtf8(*FileWriter, Name.ToString());
+	}
+
+	int64 DirectoryOffset = FileWriter->Tell();
+	int32 NumRowGroups = RowGroups.Num();
+	*FileWriter << NumRowGroups;
+	for (TPair<int64, int32>& RowGroup : RowGroups)
+	{
+		*FileWriter << RowGroup.Key;
+		*FileWriter << RowGroup.Value;
+	}
+
+	uint32 TrailerMagic = GASColumnarFile::Magic;
+	*FileWriter << DictionaryOffset;
+	*FileWriter << DirectoryOffset;
+	*FileWriter << TrailerMagic;
+
+	const bool bSucceeded = FileWriter->Close() && !FileWriter->IsError();
+	FileWriter.Reset();
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to write %s"), *Filename);
+	}
+
+	return bSucceeded;
+}
+
+void FGASColumnarWriter::SerializeUtf8(FArchive& Ar, const FString& InString)
+{
+	FTCHARToUTF8 Utf8(*InString);
+	int32 Length = Utf8.Length();
+	Ar << Length;
+	Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Length);
+}
+
+bool FGASColumnarExport::ExportCapture(const FString& InCaptureFile, const FString& InOutputBase, int32 InRowsPerGroup)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureExport);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FGASCaptureReader Reader;
+	if (!Reader.Open(InCaptureFile))
+	{
+		return false;
+	}
+
+	FGASColumnarWriter Events;
+	const int32 EventFrame = Events.AddColumn(TEXT("frame"), EGASColumnType::UInt64);
+	const int32 EventTime = Events.AddColumn(TEXT("world_time"), EGASColumnType::Float);
+	const int32 EventType = Events.AddColumn(TEXT("type"), EGASColumnType::Name);
+	const int32 EventActor = Events.AddColumn(TEXT("actor"), EGASColumnType::Name);
+	const int32 EventSubject = Events.AddColumn(TEXT("subject"), EGASColumnType::Name);
+	const int32 EventDetail = Events.AddColumn(TEXT("detail"), EGASColumnType::Name);
+	const int32 EventValue = Events.AddColumn(TEXT("value"), EGASColumnType::Int32);
+	const int32 EventHandle = Events.AddColumn(TEXT("handle"), EGASColumnType::Int32);
+
+	FGASColumnarWriter Attributes;
+	const int32 AttributeFrame = Attributes.AddColumn(TEXT("frame"), EGASColumnType::UInt64);
+	const int32 AttributeTime = Attributes.AddColumn(TEXT("world_time"), EGASColumnType::Float);
+	const int32 AttributeActor = Attributes.AddColumn(TEXT("actor"), EGASColumnType::Name);
+	const int32 AttributeClass = Attributes.AddColumn(TEXT("actor_class"), EGASColumnType::Name);
+	const int32 AttributeName = Attributes.AddColumn(TEXT("attribute"), EGASColumnType::Name);
+	const int32 AttributeBase = Attributes.AddColumn(TEXT("base_value"), EGASColumnType::Float);
+	const int32 AttributeCurrent = Attributes.AddColumn(TEXT("current_value"), EGASColumnType::Float);
+
+	const FString EventsFilename = InOutputBase + TEXT(".events") + GASColumnarFile::Extension;
+	const FString AttributesFilename = InOutputBase + TEXT(".attributes") + GASColumnarFile::Extension;
+	if (!Events.Open(EventsFilename, InRowsPerGroup) || !Attributes.Open(AttributesFilename, InRowsPerGroup))
+	{
+		return false;
+	}
+
+	// 事件类型的名字只生成一次
+	// Event type names are only created once
+	TArray<FName> TypeNames;
+	for (uint8 Type = 0; Type <= static_cast<uint8>(EGASCaptureEventType::TriggerFired); ++Type)
+	{
+		TypeNames.Add(FGASCaptureQuery::GetEventTypeName(static_cast<EGASCaptureEventType>(Type)));
+	}
+
+	// 一次只解码一个数据块，内存占用与录制大小无关
+	// Only one chunk is decoded at a time so memory does not grow with the capture
+	TArray<FGASCaptureFrame> Frames;
+	for (int32 ChunkIndex = 0; ChunkIndex < Reader.GetChunks().Num(); ++ChunkIndex)
+	{
+		if (!Reader.ReadChunk(ChunkIndex, Frames))
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to read chunk %d of %s"), ChunkIndex, *InCaptureFile);
+			continue;
+		}
+
+		for (const FGASCaptureFrame& Frame : Frames)
+		{
+			for (const FGASCaptureEvent& Event : Frame.Events)
+			{
+				Events.SetUInt64(EventFrame, Frame.Frame);
+				Events.SetFloat(EventTime, Frame.WorldTime);
+				Events.SetName(EventType, TypeNames.IsValidIndex(static_cast<int32>(Event.Type)) ? TypeNames[static_cast<int32>(Event.Type)] : NAME_None);
+				Events.SetName(EventActor, Event.Actor);
+				Events.SetName(EventSubject, Event.Subject);
+				Events.SetName(EventDetail, Event.Detail);
+				Events.SetInt32(EventValue, Event.Value);
+				Events.SetInt32(EventHandle, Event.Handle);
+				Events.EndRow();
+			}
+
+			if (!Frame.bHasKeyframe)
+			{
+				continue;
+			}
+
+			for (const FGASCaptureAscSnapshot& AbilitySystem : Frame.Keyframe.GetAbilitySystems())
+			{
+				for (const FGASCaptureAttribute& Attribute : AbilitySystem.Attributes)
+				{
+					Attributes.SetUInt64(AttributeFrame, Frame.Frame);
+					Attributes.SetFloat(AttributeTime, Frame.WorldTime);
+					Attributes.SetName(AttributeActor, AbilitySystem.Actor);
+					Attributes.SetName(AttributeClass, AbilitySystem.ActorClass);
+					Attributes.SetName(AttributeName, Attribute.Attribute);
+					Attributes.SetFloat(AttributeBase, Attribute.BaseValue);
+					Attributes.SetFloat(AttributeCurrent, Attribute.CurrentValue);
+					Attributes.EndRow();
+				}
+			}
+		}
+	}
+
+	const int64 NumEvents = Events.GetNumRows();
+	const int64 NumAttributes = Attributes.GetNumRows();
+	const bool bSucceeded = Events.Close() & Attributes.Close();
+
+	if (bSucceeded)
+	{
+		UE_LOG(LogGASAttachEditor, Display, TEXT("Exported %lld event(s) and %lld attribute sample(s) from %s in %.2f s"),
+			NumEvents, NumAttributes, *FPaths::GetCleanFilename(InCaptureFile), FPlatformTime::Seconds() - StartTime);
+	}
+
+	return bSucceeded;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+
+// 列式导出文件格式(小端):
+// "GCOL" | 版本 | 列数 | 每列(名字, 类型) | 行组... | 字典 | 行组目录 | 尾部(字典偏移, 目录偏移, "GCOL")
+// 行组: 行数, 然后每列连续存放该组所有行的值
+// 字符串列保存字典下标，字典在文件尾部
+// 字符串为 int32 字节数 + UTF-8
+//
+// Columnar export layout (little endian):
+// "GCOL" | Version | Column count | (Name, Type) per column | Row groups... | Dictionary | Row group directory | Trailer (dictionary offset, directory offset, "GCOL")
+// Row group: row count, then the values of every row of the group stored contiguously per column
+// String columns store dictionary indices; the dictionary is at the end of the file
+// Strings are an int32 byte count followed by UTF-8
+namespace GASColumnarFile
+{
+	constexpr uint32 Magic = 0x4C4F4347;
+
+	constexpr uint32 Version = 1;
+
+	constexpr int32 DefaultRowsPerGroup = 65536;
+
+	const TCHAR* const Extension = TEXT(".gascol");
+}
+
+enum class EGASColumnType : uint8
+{
+	UInt64,
+
+	Int32,
+
+	Float,
+
+	// 字典下标(int32)
+	// Dictionary index (int32)
+	Name,
+};
+
+// 按行组写入列式文件，内存里只保留当前行组
+// Writes a columnar file in row groups; only the current row group is kept in memory
+class FGASColumnarWriter
+{
+public:
+
+	FGASColumnarWriter();
+	~FGASColumnarWriter();
+
+	int32 AddColumn(const FString& InName, EGASColumnType InType);
+
+	// 所有列添加完后打开文件
+	// Opens the file once every column was added
+	bool Open(const FString& InFilename, int32 InRowsPerGroup = GASColumnarFile::DefaultRowsPerGroup);
+
+	void SetUInt64(int32 InColumn, uint64 InValue) { Append(InColumn, &InValue, sizeof(InValue)); }
+
+	void SetInt32(int32 InColumn, int32 InValue) { Append(InColumn, &InValue, sizeof(InValue)); }
+
+	void SetFloat(int32 InColumn, float InValue) { Append(InColumn, &InValue, sizeof(InValue)); }
+
+	void SetName(int32 InColumn, FName InValue);
+
+	// 每列都写入一个值后结束一行
+	// Ends a row once every column received a value
+	void EndRow();
+
+	bool Close();
+
+	int64 GetNumRows() const { return TotalRows; }
+
+private:
+
+	void Append(int32 InColumn, const void* InData, int32 InSize);
+
+	void FlushRowGroup();
+
+	static void SerializeUtf8(FArchive& Ar, const FString& InString);
+
+private:
+
+	struct FColumn
+	{
+		FString Name;
+
+		EGASColumnType Type;
+
+		TArray<uint8> Buffer;
+	};
+
+	FString Filename;
+
+	TUniquePtr<FArchive> FileWriter;
+
+	TArray<FColumn> Columns;
+
+	TMap<FName, int32> Dictionary;
+
+	TArray<FName> DictionaryNames;
+
+	TArray<TPair<int64, int32>> RowGroups;
+
+	int32 RowsPerGroup;
+
+	int32 RowsInGroup;
+
+	int64 TotalRows;
+};
+
+// 把录制导出成列式文件: <名字>.events.gascol 和 <名字>.attributes.gascol
+// Exports a capture to columnar files: <Name>.events.gascol and <Name>.attributes.gascol
+class FGASColumnarExport
+{
+public:
+
+	static bool ExportCapture(const FString& InCaptureFile, const FString& InOutputBase, int32 InRowsPerGroup = GASColumnarFile::DefaultRowsPerGroup);
+};
@@ -0,0 +1,114 @@
+#include "Capture/GASFreezeFrame.h"
+#include "Capture/GASCaptureSampler.h"
+#include "GASAttachEditor/SGASSnapshotNodeBase.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Tasks/Task.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorMaxFreezeFrames(
+	TEXT("GASAttachEditor.FreezeFrame.MaxCount"),
+	8,
+	TEXT("Number of freeze frames kept for browsing in the panel."),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorld GASAttachEditorFreezeFrameCmd(
+	TEXT("GASAttachEditor.FreezeFrame"),
+	TEXT("Takes a freeze frame snapshot of every ASC in the world."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&FGASFreezeFrames::Take));
+
+TArray<TSharedRef<const FGASFreezeFrame>> FGASFreezeFrames::FreezeFrames;
+int32 FGASFreezeFrames::NextId = 1;
+FOnGASFreezeFrameReady FGASFreezeFrames::OnReady;
+TArray<TPair<UE::Tasks::FTask, TSharedRef<FGASFreezeFrame>>> FGASFreezeFrames::Building;
+FTSTicker::FDelegateHandle FGASFreezeFrames::PublishTickerHandle;
+
+void FGASFreezeFrames::Take(UWorld* InWorld)
+{
+	check(IsInGameThread());
+
+	if (!InWorld)
+	{
+		return;
+	}
+
+	TSharedRef<FGASFreezeFrame> FreezeFrame = MakeShared<FGASFreezeFrame>();
+	FreezeFrame->Id = NextId++;
+	FreezeFrame->World = InWorld->GetName();
+	FreezeFrame->Time = FDateTime::Now();
+	FreezeFrame->Snapshot = MakeShared<FGASCaptureWorldSnapshot>();
+
+	{
+		GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_FreezeFrame);
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		FGASCaptureSampler::CaptureWorld(InWorld, *FreezeFrame->Snapshot);
+		FreezeFrame->CopyMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+	UE::Tasks::FTask Task = UE::Tasks::Launch(TEXT("BuildGASFreezeFrame"), [FreezeFrame]()
+	{
+		FGASSnapshotNode::BuildTree(*FreezeFrame->Snapshot, FreezeFrame->Roots);
+	});
+	Building.Emplace(MoveTemp(Task), FreezeFrame);
+
+	if (!PublishTickerHandle.IsValid())
+	{
+		PublishTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FGASFreezeFrames::PublishBuilt));
+	}
+}
+
+bool FGASFreezeFrames::PublishBuilt(float DeltaTime)
+{
+	// 按拍摄顺序发布，前面的还没整理完时后面的等着
+	// Published in the order taken; later ones wait while an earlier one is still being built
+	int32 NumBuilt = 0;
+	while (NumBuilt < Building.Num() && Building[NumBuilt].Key.IsCompleted())
+	{
+		++NumBuilt;
+	}
+
+	TArray<TSharedRef<FGASFreezeFrame>> Built;
+	for (int32 Index = 0; Index < NumBuilt; ++Index)
+	{
+		Built.Add(Building[Index].Value);
+	}
+	Building.RemoveAt(0, NumBuilt);
+
+	const int32 MaxCount = FMath::Max(1, CVarGASAttachEditorMaxFreezeFrames.GetValueOnGameThread());
+	for (const TSharedRef<FGASFreezeFrame>& FreezeFrame : Built)
+	{
+		if (FreezeFrames.Num() >= MaxCount)
+		{
+			FreezeFrames.RemoveAt(0, FreezeFrames.Num() - MaxCount + 1);
+		}
+		FreezeFrames.Add(FreezeFrame);
+
+		UE_LOG(LogGASAttachEditor, Log, TEXT("Freeze frame %d of %s: %d ASCs copied in %.3f ms"), FreezeFrame->Id, *FreezeFrame->World, FreezeFrame->Snapshot->NumAbilitySystems, FreezeFrame->CopyMs);
+
+		OnReady.Broadcast(FreezeFrame);
+	}
+
+	if (Building.Num() == 0)
+	{
+		PublishTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FGASFreezeFrames::Reset()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(PublishTickerHandle);
+	PublishTickerHandle.Reset();
+
+	for (const TPair<UE::Tasks::FTask, TSharedRef<FGASFreezeFrame>>& Pair : Building)
+	{
+		Pair.Key.Wait();
+	}
+	Building.Reset();
+
+	FreezeFrames.Reset();
+	OnReady.Clear();
+}
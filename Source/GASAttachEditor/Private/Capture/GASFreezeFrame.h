@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/GASCaptureTypes.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+
+class FGASSnapshotNodeBase;
+class UWorld;
+
+// 一次冻结帧: 游戏线程上拷贝的原始数据和后台整理好的树
+// One freeze frame: the raw data copied on the game thread and the tree built in the background
+struct FGASFreezeFrame
+{
+	int32 Id = 0;
+
+	FString World;
+
+	FDateTime Time;
+
+	// 游戏线程上拷贝所花的时间
+	// Time spent copying on the game thread
+	double CopyMs = 0.0;
+
+	TSharedPtr<FGASCaptureWorldSnapshot> Snapshot;
+
+	TArray<TSharedRef<FGASSnapshotNodeBase>> Roots;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnGASFreezeFrameReady, const TSharedRef<const FGASFreezeFrame>&)
+
+// 冻结帧快照，游戏线程只拷贝 POD 数据，格式化和建树都在后台完成
+// Freeze frame snapshots; the game thread only copies POD data, formatting and tree building happen in the background
+class FGASFreezeFrames
+{
+public:
+
+	static void Take(UWorld* InWorld);
+
+	// 最近的冻结帧，最新的在最后
+	// Recent freeze frames, newest last
+	static const TArray<TSharedRef<const FGASFreezeFrame>>& GetFreezeFrames() { return FreezeFrames; }
+
+	// 模块关闭时调用，等还在后台整理的冻结帧完成，之后不再广播
+	// Called on module shutdown; waits for the freeze frames still being built and broadcasts nothing afterwards
+	static void Reset();
+
+	// 整理完成后在游戏线程上广播
+	// Broadcast on the game thread once the tree is built
+	static FOnGASFreezeFrameReady OnReady;
+
+private:
+
+	// 在游戏线程上发布整理完的冻结帧，不往任务图里投递回调，模块关闭后不会有残留的任务
+	// Publishes the built freeze frames on the game thread; nothing is posted to the task graph, so no callback outlives the module
+	static bool PublishBuilt(float DeltaTime);
+
+private:
+
+	static TArray<TSharedRef<const FGASFreezeFrame>> FreezeFrames;
+
+	// 还在后台整理的冻结帧，按拍摄顺序
+	// Freeze frames still being built in the background, in the order they were taken
+	static TArray<TPair<UE::Tasks::FTask, TSharedRef<FGASFreezeFrame>>> Building;
+
+	static FTSTicker::FDelegateHandle PublishTickerHandle;
+
+	static int32 NextId;
+};
@@ -0,0 +1,234 @@
+#include "Capture/GASSessionMetrics.h"
+#include "Capture/GASCaptureSampler.h"
+#include "Abilities/GameplayAbility.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "GASAttachEditorLog.h"
+
+TSharedRef<FGASSessionMetrics> FGASSessionMetrics::Create(const TSharedRef<FGASWorldMonitor>& InMonitor, float InSampleInterval)
+{
+	TSharedRef<FGASSessionMetrics> Metrics = MakeShareable(new FGASSessionMetrics(InMonitor, InSampleInterval));
+	Metrics->Bind();
+	return Metrics;
+}
+
+FGASSessionMetrics::FGASSessionMetrics(const TSharedRef<FGASWorldMonitor>& InMonitor, float InSampleInterval)
+	:Monitor(InMonitor)
+	,SampleInterval(FMath::Max(0.f, InSampleInterval))
+	,StartWorldTime(-1.f)
+	,LastSampleWorldTime(-1.f)
+{
+}
+
+FGASSessionMetrics::~FGASSessionMetrics()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	LocalMonitor->OnEffectApplied.Remove(EffectAppliedHandle);
+	LocalMonitor->OnAbilityEvent.Remove(AbilityEventHandle);
+	LocalMonitor->OnTick.Remove(TickHandle);
+}
+
+void FGASSessionMetrics::Bind()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	EffectAppliedHandle = LocalMonitor->OnEffectApplied.AddSP(this, &FGASSessionMetrics::HandleEffectApplied);
+	AbilityEventHandle = LocalMonitor->OnAbilityEvent.AddSP(this, &FGASSessionMetrics::HandleAbilityEvent);
+	TickHandle = LocalMonitor->OnTick.AddSP(this, &FGASSessionMetrics::HandleTick);
+}
+
+float FGASSessionMetrics::GetDuration() const
+{
+	return Samples.Num() > 0 && StartWorldTime >= 0.f ? Samples.Last().WorldTime - StartWorldTime : 0.f;
+}
+
+void FGASSessionMetrics::HandleEffectApplied(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle)
+{
+	++Pending.EffectsApplied;
+}
+
+void FGASSessionMetrics::HandleAbilityEvent(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, EGASMonitorAbilityEvent InEvent, const FGameplayTagContainer& InFailureTags)
+{
+	FGASSessionAbilityStats& Stats = AbilityStats.FindOrAdd(InAbility ? InAbility->GetClass()->GetFName() : NAME_None);
+
+	switch (InEvent)
+	{
+	case EGASMonitorAbilityEvent::Activated:
+		++Stats.Activations;
+		++Pending.AbilitiesActivated;
+		break;
+	case EGASMonitorAbilityEvent::Ended:
+		++Stats.Ends;
+		break;
+	case EGASMonitorAbilityEvent::Failed:
+		++Stats.Failures;
+		++Pending.AbilitiesFailed;
+		break;
+	}
+}
+
+void FGASSessionMetrics::HandleTick(float DeltaSeconds)
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	UWorld* World = LocalMonitor.IsValid() ? LocalMonitor->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	const float WorldTime = World->GetTimeSeconds();
+	if (StartWorldTime < 0.f)
+	{
+		StartWorldTime = WorldTime;
+	}
+
+	if (LastSampleWorldTime >= 0.f && WorldTime - LastSampleWorldTime < SampleInterval)
+	{
+		return;
+	}
+
+	LastSampleWorldTime = WorldTime;
+	TakeSample();
+}
+
+void FGASSessionMetrics::TakeSample()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	FGASCaptureSampler::CaptureWorld(*LocalMonitor, Scratch);
+
+	FGASSessionSample& Sample = Samples.Add_GetRef(Pending);
+	Pending = FGASSessionSample();
+
+	Sample.Frame = Scratch.Frame;
+	Sample.WorldTime = Scratch.WorldTime;
+	Sample.NumAbilitySystems = Scratch.NumAbilitySystems;
+
+	for (const FGASCaptureAscSnapshot& AbilitySystem : Scratch.GetAbilitySystems())
+	{
+		Sample.ActiveEffects += AbilitySystem.Effects.Num();
+		for (const FGASCaptureEffect& Effect : AbilitySystem.Effects)
+		{
+			Sample.InfiniteEffects += Effect.Duration <= 0.f ? 1 : 0;
+		}
+
+		Sample.OwnedTags += AbilitySystem.Tags.Num();
+
+		int32& Peak = PeakTags.FindOrAdd(AbilitySystem.Actor);
+		Peak = FMath::Max(Peak, AbilitySystem.Tags.Num());
+	}
+}
+
+bool FGASSessionMetrics::WriteReport(const FString& InDirectory, const FString& InMapName, const TArray<FString>& InCaptureFiles) const
+{
+	// 时间线，每行一个采样
+	// Timeline, one row per sample
+	{
+		const FString Filename = InDirectory / TEXT("timeline.csv");
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+		if (!Writer.IsValid())
+		{
+			UE_LOG(LogGASAttachEditor, Error, TEXT("Could not write %s"), *Filename);
+			return false;
+		}
+
+		FString Line = TEXT("Frame,WorldTime,AbilitySystems,ActiveEffects,InfiniteEffects,OwnedTags,EffectsApplied,AbilitiesActivated,AbilitiesFailed\n");
+		for (const FGASSessionSample& Sample : Samples)
+		{
+			Line += FString::Printf(TEXT("%llu,%.3f,%d,%d,%d,%d,%d,%d,%d\n"), Sample.Frame, Sample.WorldTime, Sample.NumAbilitySystems, Sample.ActiveEffects,
+				Sample.InfiniteEffects, Sample.OwnedTags, Sample.EffectsApplied, Sample.AbilitiesActivated, Sample.AbilitiesFailed);
+
+			FTCHARToUTF8 Utf8(*Line);
+			Writer->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+			Line.Reset();
+		}
+	}
+
+	// 汇总，键按名字排序，方便在CI里直接比较两次运行的文件
+	// Summary; keys are sorted by name so CI can diff the files of two runs directly
+	const FString Filename = InDirectory / TEXT("summary.json");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogGASAttachEditor, Error, TEXT("Could not write %s"), *Filename);
+		return false;
+	}
+
+	const float Duration = GetDuration();
+
+	int32 PeakEffects = 0;
+	int32 PeakInfiniteEffects = 0;
+	int32 PeakAbilitySystems = 0;
+	for (const FGASSessionSample& Sample : Samples)
+	{
+		PeakEffects = FMath::Max(PeakEffects, Sample.ActiveEffects);
+		PeakInfiniteEffects = FMath::Max(PeakInfiniteEffects, Sample.InfiniteEffects);
+		PeakAbilitySystems = FMath::Max(PeakAbilitySystems, Sample.NumAbilitySystems);
+	}
+
+	TSharedRef<TJsonWriter<UTF8CHAR>> Json = TJsonWriterFactory<UTF8CHAR>::Create(Writer.Get());
+	Json->WriteObjectStart();
+	Json->WriteValue(TEXT("map"), InMapName);
+	Json->WriteValue(TEXT("duration"), Duration);
+	Json->WriteValue(TEXT("samples"), Samples.Num());
+	Json->WriteValue(TEXT("peakAbilitySystems"), PeakAbilitySystems);
+	Json->WriteValue(TEXT("peakActiveEffects"), PeakEffects);
+	Json->WriteValue(TEXT("peakInfiniteEffects"), PeakInfiniteEffects);
+	Json->WriteValue(TEXT("finalActiveEffects"), Samples.Num() > 0 ? Samples.Last().ActiveEffects : 0);
+	Json->WriteValue(TEXT("finalInfiniteEffects"), Samples.Num() > 0 ? Samples.Last().InfiniteEffects : 0);
+
+	TArray<FName> AbilityNames;
+	AbilityStats.GetKeys(AbilityNames);
+	AbilityNames.Sort(FNameLexicalLess());
+
+	Json->WriteObjectStart(TEXT("abilities"));
+	for (const FName& AbilityName : AbilityNames)
+	{
+		const FGASSessionAbilityStats& Stats = AbilityStats.FindChecked(AbilityName);
+		Json->WriteObjectStart(AbilityName.ToString());
+		Json->WriteValue(TEXT("activations"), Stats.Activations);
+		Json->WriteValue(TEXT("ends"), Stats.Ends);
+		Json->WriteValue(TEXT("failures"), Stats.Failures);
+		Json->WriteValue(TEXT("activationsPerSecond"), Duration > 0.f ? Stats.Activations / Duration : 0.f);
+		Json->WriteObjectEnd();
+	}
+	Json->WriteObjectEnd();
+
+	TArray<FName> ActorNames;
+	PeakTags.GetKeys(ActorNames);
+	ActorNames.Sort(FNameLexicalLess());
+
+	Json->WriteObjectStart(TEXT("peakTagsPerActor"));
+	for (const FName& ActorName : ActorNames)
+	{
+		Json->WriteValue(ActorName.ToString(), PeakTags.FindChecked(ActorName));
+	}
+	Json->WriteObjectEnd();
+
+	Json->WriteArrayStart(TEXT("captures"));
+	for (const FString& CaptureFile : InCaptureFiles)
+	{
+		Json->WriteValue(FPaths::GetCleanFilename(CaptureFile));
+	}
+	Json->WriteArrayEnd();
+
+	Json->WriteObjectEnd();
+	Json->Close();
+
+	return !Writer->IsError();
+}
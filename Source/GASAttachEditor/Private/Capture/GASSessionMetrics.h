@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/GASCaptureTypes.h"
+#include "Monitor/GASWorldMonitor.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+
+// 按时间间隔统计的一行
+// One row of the timeline, sampled on an interval
+struct FGASSessionSample
+{
+	uint64 Frame = 0;
+
+	float WorldTime = 0.f;
+
+	int32 NumAbilitySystems = 0;
+
+	int32 ActiveEffects = 0;
+
+	int32 InfiniteEffects = 0;
+
+	int32 OwnedTags = 0;
+
+	// 自上一行以来的事件数量
+	// Events since the previous row
+	int32 EffectsApplied = 0;
+
+	int32 AbilitiesActivated = 0;
+
+	int32 AbilitiesFailed = 0;
+};
+
+// 一个技能类在整个会话里的激活情况
+// Activations of one ability class over the whole session
+struct FGASSessionAbilityStats
+{
+	int32 Activations = 0;
+
+	int32 Ends = 0;
+
+	int32 Failures = 0;
+};
+
+// 一个世界在整个会话里的汇总指标，不依赖任何 Slate 控件，可以在无界面的命令行工具里使用
+// Summary metrics of one world over a session; independent of any Slate widget so it runs in headless commandlets
+class FGASSessionMetrics : public TSharedFromThis<FGASSessionMetrics>
+{
+public:
+
+	static TSharedRef<FGASSessionMetrics> Create(const TSharedRef<FGASWorldMonitor>& InMonitor, float InSampleInterval);
+
+	~FGASSessionMetrics();
+
+	const TArray<FGASSessionSample>& GetSamples() const { return Samples; }
+
+	const TMap<FName, FGASSessionAbilityStats>& GetAbilityStats() const { return AbilityStats; }
+
+	// 每个角色同时拥有的最多标签数
+	// Most tags each actor owned at once
+	const TMap<FName, int32>& GetPeakTags() const { return PeakTags; }
+
+	float GetDuration() const;
+
+	// 写出 timeline.csv 和 summary.json
+	// Writes timeline.csv and summary.json
+	bool WriteReport(const FString& InDirectory, const FString& InMapName, const TArray<FString>& InCaptureFiles) const;
+
+private:
+
+	FGASSessionMetrics(const TSharedRef<FGASWorldMonitor>& InMonitor, float InSampleInterval);
+
+	void Bind();
+
+	void TakeSample();
+
+	void HandleEffectApplied(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle);
+
+	void HandleAbilityEvent(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, EGASMonitorAbilityEvent InEvent, const FGameplayTagContainer& InFailureTags);
+
+	void HandleTick(float DeltaSeconds);
+
+private:
+
+	TWeakPtr<FGASWorldMonitor> Monitor;
+
+	FDelegateHandle EffectAppliedHandle;
+	FDelegateHandle AbilityEventHandle;
+	FDelegateHandle TickHandle;
+
+	float SampleInterval;
+
+	float StartWorldTime;
+
+	float LastSampleWorldTime;
+
+	FGASSessionSample Pending;
+
+	TArray<FGASSessionSample> Samples;
+
+	TMap<FName, FGASSessionAbilityStats> AbilityStats;
+
+	TMap<FName, int32> PeakTags;
+
+	// 采样时复用，避免每次分配
+	// Reused on every sample to avoid allocations
+	FGASCaptureWorldSnapshot Scratch;
+};
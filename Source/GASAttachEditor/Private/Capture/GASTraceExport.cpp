@@ -0,0 +1,398 @@
+#include "Capture/GASTraceExport.h"
+#include "Capture/GASCaptureFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+static FAutoConsoleCommand GASAttachEditorCaptureExportTraceCmd(
+	TEXT("GASAttachEditor.Capture.ExportTrace"),
+	TEXT("Exports the ability and effect spans of a capture as Chrome trace-event JSON (<Name>.trace.json) next to it: <File|latest>."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Missing capture file"));
+			return;
+		}
+
+		const FString CaptureFile = FGASCaptureReader::ResolveFilename(Args[0]);
+		FGASTraceExport::ExportCapture(CaptureFile, FPaths::ChangeExtension(CaptureFile, TEXT("trace.json")));
+	}));
+
+namespace GASTraceExport
+{
+	const TCHAR* const AbilityCategory = TEXT("ability");
+
+	const TCHAR* const EffectCategory = TEXT("effect");
+
+	// 录制时间是秒，trace 时间是微秒
+	// Capture time is in seconds, trace time in microseconds
+	double ToTraceTime(float InWorldTime)
+	{
+		return static_cast<double>(InWorldTime) * 1000000.0;
+	}
+
+	// 写出 trace 事件并记录还没结束的段
+	// Writes trace events and keeps track of the spans that have not ended yet
+	class FTraceWriter
+	{
+	public:
+
+		FTraceWriter(FArchive* InArchive, const FGASCaptureReader& InReader)
+			:Reader(InReader)
+			,Json(TJsonWriterFactory<UTF8CHAR>::Create(InArchive))
+			,NextSpanId(1)
+			,LastTime(0.0)
+			,bSeeded(false)
+			,NumSpans(0)
+		{
+			Json->WriteObjectStart();
+			Json->WriteArrayStart(TEXT("traceEvents"));
+		}
+
+		void ProcessFrame(const FGASCaptureFrame& InFrame)
+		{
+			const double Time = ToTraceTime(InFrame.WorldTime);
+
+			for (const FGASCaptureEvent& Event : InFrame.Events)
+			{
+				switch (Event.Type)
+				{
+				case EGASCaptureEventType::AbilityActivated:
+					OpenAbility(Event.Actor, Event.Subject, Time, false);
+					break;
+
+				case EGASCaptureEventType::AbilityEnded:
+				{
+					// 技能没有句柄，同一个角色的同一个技能按激活顺序配对
+					// Abilities have no handle; activations of one ability on one actor are paired in order
+					TArray<int64>* Ids = OpenAbilities.Find(TPair<FName, FName>(Event.Actor, Event.Subject));
+					if (Ids && Ids->Num() > 0)
+					{
+						WriteEnd(GetTrack(Event.Actor), AbilityCategory, Event.Subject, Time, (*Ids)[0], false);
+						Ids->RemoveAt(0, 1, false);
+					}
+					break;
+				}
+
+				case EGASCaptureEventType::AbilityFailed:
+					WriteInstant(GetTrack(Event.Actor), Event.Subject, Event.Detail, Time, false);
+					break;
+
+				case EGASCaptureEventType::EffectApplied:
+					// 瞬时效果没有句柄，叠层时段已经开着
+					// Instant effects have no handle, and a stacking application finds its span already open
+					if (Event.Handle == INDEX_NONE)
+					{
+						WriteInstant(GetTrack(Event.Actor), Event.Subject, NAME_None, Time, false);
+					}
+					else if (!OpenEffects.Contains(TPair<FName, int32>(Event.Actor, Event.Handle)))
+					{
+						OpenEffect(Event.Actor, Event.Subject, Event.Handle, Time, false);
+					}
+					break;
+
+				case EGASCaptureEventType::EffectRemoved:
+				{
+					FOpenEffect Removed;
+					if (OpenEffects.RemoveAndCopyValue(TPair<FName, int32>(Event.Actor, Event.Handle), Removed))
+					{
+						WriteEnd(GetTrack(Event.Actor), EffectCategory, Removed.Effect, Time, Removed.Id, false);
+					}
+					break;
+				}
+
+				case EGASCaptureEventType::TriggerFired:
+					WriteInstant(INDEX_NONE, Event.Subject, NAME_None, Time, true);
+					break;
+
+				default:
+					break;
+				}
+			}
+
+			LastTime = Time;
+
+			// 第一个关键帧补上录制开始前就已经存在的段
+			// The first keyframe opens the spans that already existed before the capture started
+			if (!bSeeded && InFrame.bHasKeyframe)
+			{
+				bSeeded = true;
+
+				for (const FGASCaptureAscSnapshot& AbilitySystem : InFrame.Keyframe.GetAbilitySystems())
+				{
+					for (const FGASCaptureAbility& Ability : AbilitySystem.Abilities)
+					{
+						const TArray<int64>* Ids = OpenAbilities.Find(TPair<FName, FName>(AbilitySystem.Actor, Ability.Ability));
+						for (int32 Count = Ids ? Ids->Num() : 0; Count < Ability.ActiveCount; ++Count)
+						{
+							OpenAbility(AbilitySystem.Actor, Ability.Ability, Time, true);
+						}
+					}
+
+					for (const FGASCaptureEffect& Effect : AbilitySystem.Effects)
+					{
+						if (!OpenEffects.Contains(TPair<FName, int32>(AbilitySystem.Actor, Effect.Handle)))
+						{
+							OpenEffect(AbilitySystem.Actor, Effect.Definition, Effect.Handle, ToTraceTime(Effect.StartWorldTime), true);
+						}
+					}
+				}
+			}
+		}
+
+		// 结束录制结束时还没结束的段，并写完文件
+		// Ends the spans still open when the capture ends and completes the file
+		void Finish()
+		{
+			for (const TPair<TPair<FName, FName>, TArray<int64>>& Pair : OpenAbilities)
+			{
+				for (int64 Id : Pair.Value)
+				{
+					WriteEnd(GetTrack(Pair.Key.Key), AbilityCategory, Pair.Key.Value, LastTime, Id, true);
+				}
+			}
+			OpenAbilities.Reset();
+
+			for (const TPair<TPair<FName, int32>, FOpenEffect>& Pair : OpenEffects)
+			{
+				WriteEnd(GetTrack(Pair.Key.Key), EffectCategory, Pair.Value.Effect, LastTime, Pair.Value.Id, true);
+			}
+			OpenEffects.Reset();
+
+			Json->WriteArrayEnd();
+
+			Json->WriteValue(TEXT("displayTimeUnit"), TEXT("ms"));
+
+			Json->WriteObjectStart(TEXT("otherData"));
+			Json->WriteValue(TEXT("world"), Reader.GetHeader().World);
+			Json->WriteValue(TEXT("reason"), Reader.GetHeader().Reason);
+			Json->WriteValue(TEXT("capture"), FPaths::GetCleanFilename(Reader.GetFilename()));
+			Json->WriteObjectEnd();
+
+			Json->WriteObjectEnd();
+			Json->Close();
+		}
+
+		int64 GetNumSpans() const { return NumSpans; }
+
+		int32 GetNumTracks() const { return Tracks.Num(); }
+
+	private:
+
+		struct FOpenEffect
+		{
+			FName Effect;
+
+			int64 Id = 0;
+		};
+
+		void OpenAbility(FName InActor, FName InAbility, double InTime, bool bAtCaptureStart)
+		{
+			const int64 Id = NextSpanId++;
+			OpenAbilities.FindOrAdd(TPair<FName, FName>(InActor, InAbility)).Add(Id);
+			WriteBegin(GetTrack(InActor), AbilityCategory, InAbility, InTime, Id, bAtCaptureStart);
+		}
+
+		void OpenEffect(FName InActor, FName InEffect, int32 InHandle, double InTime, bool bAtCaptureStart)
+		{
+			FOpenEffect& Effect = OpenEffects.FindOrAdd(TPair<FName, int32>(InActor, InHandle));
+			if (Effect.Id != 0)
+			{
+				return;
+			}
+
+			Effect.Effect = InEffect;
+			Effect.Id = NextSpanId++;
+			WriteBegin(GetTrack(InActor), EffectCategory, InEffect, InTime, Effect.Id, bAtCaptureStart);
+		}
+
+		// 第一次见到角色时分配轨道，并写出轨道名字 "角色 (类)"
+		// Assigns a track the first time an actor is seen and writes its name, "Actor (Class)"
+		int32 GetTrack(FName InActor)
+		{
+			if (const int32* Found = Tracks.Find(InActor))
+			{
+				return *Found;
+			}
+
+			const int32 Track = Tracks.Num() + 1;
+			Tracks.Add(InActor, Track);
+
+			FString TrackName = InActor.ToString();
+			if (const int32* ClassIndex = Reader.GetIndex().ActorClasses.Find(Reader.GetNameTable().FindIndex(InActor)))
+			{
+				TrackName += FString::Printf(TEXT(" (%s)"), *Reader.GetNameTable().GetName(*ClassIndex).ToString());
+			}
+
+			WriteMetadata(Track, TEXT("process_name"), TEXT("name"), TrackName);
+			WriteMetadata(Track, TEXT("process_sort_index"), TEXT("sort_index"), Track);
+
+			return Track;
+		}
+
+		template<typename ValueType>
+		void WriteMetadata(int32 InTrack, const TCHAR* InName, const TCHAR* InArgName, const ValueType& InValue)
+		{
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("name"), InName);
+			Json->WriteValue(TEXT("ph"), TEXT("M"));
+			Json->WriteValue(TEXT("pid"), InTrack);
+			Json->WriteValue(TEXT("tid"), InTrack);
+			Json->WriteObjectStart(TEXT("args"));
+			Json->WriteValue(InArgName, InValue);
+			Json->WriteObjectEnd();
+			Json->WriteObjectEnd();
+		}
+
+		// 技能和效果会互相重叠，用可重叠的异步段 (b/e)
+		// Abilities and effects overlap, so overlapping async spans (b/e) are used
+		void WriteBegin(int32 InTrack, const TCHAR* InCategory, FName InName, double InTime, int64 InId, bool bAtCaptureStart)
+		{
+			++NumSpans;
+
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("name"), InName.ToString());
+			Json->WriteValue(TEXT("cat"), InCategory);
+			Json->WriteValue(TEXT("ph"), TEXT("b"));
+			Json->WriteValue(TEXT("ts"), InTime);
+			Json->WriteValue(TEXT("pid"), InTrack);
+			Json->WriteValue(TEXT("tid"), InTrack);
+			Json->WriteValue(TEXT("id"), InId);
+			if (bAtCaptureStart)
+			{
+				Json->WriteObjectStart(TEXT("args"));
+				Json->WriteValue(TEXT("openAtCaptureStart"), true);
+				Json->WriteObjectEnd();
+			}
+			Json->WriteObjectEnd();
+		}
+
+		void WriteEnd(int32 InTrack, const TCHAR* InCategory, FName InName, double InTime, int64 InId, bool bAtCaptureEnd)
+		{
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("name"), InName.ToString());
+			Json->WriteValue(TEXT("cat"), InCategory);
+			Json->WriteValue(TEXT("ph"), TEXT("e"));
+			Json->WriteValue(TEXT("ts"), InTime);
+			Json->WriteValue(TEXT("pid"), InTrack);
+			Json->WriteValue(TEXT("tid"), InTrack);
+			Json->WriteValue(TEXT("id"), InId);
+			if (bAtCaptureEnd)
+			{
+				Json->WriteObjectStart(TEXT("args"));
+				Json->WriteValue(TEXT("openAtCaptureEnd"), true);
+				Json->WriteObjectEnd();
+			}
+			Json->WriteObjectEnd();
+		}
+
+		// 技能失败画在角色轨道上，触发器画成全局标记
+		// Failed abilities are drawn on the actor's track, triggers as global markers
+		void WriteInstant(int32 InTrack, FName InName, FName InReason, double InTime, bool bGlobal)
+		{
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("name"), bGlobal ? InName.ToString() : FString::Printf(TEXT("Failed %s"), *InName.ToString()));
+			Json->WriteValue(TEXT("cat"), bGlobal ? TEXT("trigger") : AbilityCategory);
+			Json->WriteValue(TEXT("ph"), TEXT("i"));
+			Json->WriteValue(TEXT("s"), bGlobal ? TEXT("g") : TEXT("p"));
+			Json->WriteValue(TEXT("ts"), InTime);
+			Json->WriteValue(TEXT("pid"), bGlobal ? 0 : InTrack);
+			Json->WriteValue(TEXT("tid"), bGlobal ? 0 : InTrack);
+			if (!InReason.IsNone())
+			{
+				Json->WriteObjectStart(TEXT("args"));
+				Json->WriteValue(TEXT("reason"), InReason.ToString());
+				Json->WriteObjectEnd();
+			}
+			Json->WriteObjectEnd();
+		}
+
+	private:
+
+		const FGASCaptureReader& Reader;
+
+		TSharedRef<TJsonWriter<UTF8CHAR>> Json;
+
+		// 角色 -> 轨道(pid)
+		// Actor -> track (pid)
+		TMap<FName, int32> Tracks;
+
+		// (角色, 技能) -> 按激活顺序的段
+		// (Actor, ability) -> spans in activation order
+		TMap<TPair<FName, FName>, TArray<int64>> OpenAbilities;
+
+		// (角色, 效果句柄) -> 段
+		// (Actor, effect handle) -> span
+		TMap<TPair<FName, int32>, FOpenEffect> OpenEffects;
+
+		int64 NextSpanId;
+
+		double LastTime;
+
+		bool bSeeded;
+
+		int64 NumSpans;
+	};
+}
+
+bool FGASTraceExport::ExportCapture(const FString& InCaptureFile, const FString& InOutputFile)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CaptureExport);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FGASCaptureReader Reader;
+	if (!Reader.Open(InCaptureFile))
+	{
+		return false;
+	}
+
+	// 轨道名要用角色类，版本1的文件先从关键帧解析
+	// Track names use the actor class; resolve it from the keyframes first for version 1 files
+	Reader.GetActorClasses();
+
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*InOutputFile));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not open %s for writing"), *InOutputFile);
+		return false;
+	}
+
+	GASTraceExport::FTraceWriter TraceWriter(FileWriter.Get(), Reader);
+
+	// 一次只解码一个数据块
+	// Only one chunk is decoded at a time
+	TArray<FGASCaptureFrame> Frames;
+	for (int32 ChunkIndex = 0; ChunkIndex < Reader.GetChunks().Num(); ++ChunkIndex)
+	{
+		if (!Reader.ReadChunk(ChunkIndex, Frames))
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to read chunk %d of %s"), ChunkIndex, *InCaptureFile);
+			continue;
+		}
+
+		for (const FGASCaptureFrame& Frame : Frames)
+		{
+			TraceWriter.ProcessFrame(Frame);
+		}
+	}
+
+	TraceWriter.Finish();
+
+	const bool bSucceeded = FileWriter->Close() && !FileWriter->IsError();
+	if (!bSucceeded)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to write %s"), *InOutputFile);
+		return false;
+	}
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("Exported %lld span(s) on %d track(s) from %s to %s in %.2f s"),
+		TraceWriter.GetNumSpans(), TraceWriter.GetNumTracks(), *FPaths::GetCleanFilename(InCaptureFile), *InOutputFile, FPlatformTime::Seconds() - StartTime);
+
+	return true;
+}
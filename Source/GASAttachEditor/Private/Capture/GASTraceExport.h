@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 把录制导出成 Chrome trace-event JSON，可以直接在 Perfetto 或 chrome://tracing 里打开
+// 每个角色是一条轨道(一个进程)，技能从激活到结束、效果从添加到移除各是一段
+// 边解码边写出，内存里只保留还没结束的段
+//
+// Exports a capture as Chrome trace-event JSON that opens directly in Perfetto or chrome://tracing
+// Every actor is one track (one process); an ability from activation to end and an effect from apply to removal are one span each
+// Written while the capture is decoded; only spans that have not ended yet are kept in memory
+class FGASTraceExport
+{
+public:
+
+	static bool ExportCapture(const FString& InCaptureFile, const FString& InOutputFile);
+};
@@ -0,0 +1,188 @@
+#include "Commandlets/GASCaptureCommandlet.h"
+#include "Capture/GASCaptureFile.h"
+#include "Capture/GASCaptureRecorder.h"
+#include "Capture/GASCaptureTrigger.h"
+#include "Capture/GASSessionMetrics.h"
+#include "Monitor/GASWorldMonitor.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "GASAttachEditorLog.h"
+
+UGASCaptureCommandlet::UGASCaptureCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UGASCaptureCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogGASAttachEditor, Error, TEXT("Missing -Map=<package>"));
+		return 1;
+	}
+
+	float Duration = 30.f;
+	float FixedStep = 1.f / 30.f;
+	float SampleInterval = 1.f;
+	FParse::Value(*Params, TEXT("Duration="), Duration);
+	FParse::Value(*Params, TEXT("FixedStep="), FixedStep);
+	FParse::Value(*Params, TEXT("SampleInterval="), SampleInterval);
+	FixedStep = FMath::Max(FixedStep, UE_KINDA_SMALL_NUMBER);
+
+	const FString MapShortName = FPackageName::GetShortName(MapName);
+
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputDir))
+	{
+		OutputDir = FPaths::ProjectSavedDir() / TEXT("GASAttachEditor") / TEXT("Reports") / FString::Printf(TEXT("%s_%s"), *MapShortName, *FDateTime::Now().ToString());
+	}
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	// 触发器以分号分隔，格式与 GASAttachEditor.Capture.AddTrigger 相同
+	// Triggers are separated by semicolons and use the GASAttachEditor.Capture.AddTrigger syntax
+	FString TriggerString;
+	if (FParse::Value(*Params, TEXT("Trigger="), TriggerString, false))
+	{
+		TArray<FString> TriggerStrings;
+		TriggerString.ParseIntoArray(TriggerStrings, TEXT(";"));
+		for (const FString& Entry : TriggerStrings)
+		{
+			TArray<FString> Args;
+			Entry.ParseIntoArrayWS(Args);
+
+			FGASCaptureTrigger Trigger;
+			FString Error;
+			if (!FGASCaptureTrigger::Parse(Args, Trigger, Error))
+			{
+				UE_LOG(LogGASAttachEditor, Error, TEXT("Invalid trigger '%s': %s"), *Entry, *Error);
+				return 1;
+			}
+
+			FGASCaptureRecorder::AddTrigger(Trigger);
+		}
+	}
+
+	// 丢掉之前写出的文件名，只归档本次运行写出的录制
+	// Drops the filenames written before so only the captures of this run are archived
+	FGASCaptureRecorder::TakeWrittenFiles();
+
+	const bool bCaptureOnEnd = FParse::Param(*Params, TEXT("CaptureOnEnd"));
+	if (bCaptureOnEnd)
+	{
+		FGASCaptureRecorder::StartRecording();
+	}
+
+	UWorld* World = LoadWorld(MapName);
+	if (!World)
+	{
+		return 1;
+	}
+
+	TSharedRef<FGASSessionMetrics> Metrics = FGASSessionMetrics::Create(FGASWorldMonitor::FindOrCreate(World), SampleInterval);
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("Running %s for %.1fs of game time at a fixed step of %.4fs"), *MapName, Duration, FixedStep);
+
+	// 固定步长推进世界，帧号与游戏时间和机器性能无关
+	// Steps the world at a fixed rate so frame numbers and game time do not depend on the machine
+	const double EndTime = World->GetTimeSeconds() + Duration;
+	while (World->GetTimeSeconds() < EndTime && !IsEngineExitRequested())
+	{
+		// 命令行不跑引擎主循环，没有人推进帧号。监听器、录制和采样都用 GFrameCounter 给帧编号并判断是否进入新的一帧，
+		// 所以这里像 FEngineLoop::Tick 一样每步加一
+		// Commandlets do not run the engine loop, so nothing advances the frame number. The monitor, the recorder and the sampler
+		// all stamp frames with GFrameCounter and use it to detect a new frame, so it is advanced once per step as FEngineLoop::Tick does
+		++GFrameCounter;
+
+		World->Tick(LEVELTICK_All, FixedStep);
+
+		FTSTicker::GetCoreTicker().Tick(FixedStep);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	}
+
+	if (bCaptureOnEnd)
+	{
+		FGASCaptureRecorder::FireAll(TEXT("CommandletEnd"));
+	}
+
+	// 世界清理时写出已触发的录制
+	// Captures that fired are written when the world is cleaned up
+	DestroyWorld(World);
+	FGASCaptureRecorder::StopRecording();
+	FGASCaptureRecorder::ClearTriggers();
+	FGASCaptureWriter::FlushAsyncWrites();
+
+	// 把本次写出的录制复制到输出目录，CI只需要归档一个目录。
+	// 按录制返回的文件名复制，同时运行的其他实例写进共享录制目录的文件不会混进来
+	// Copies the captures written by this run into the output directory so CI only archives one folder.
+	// Uses the filenames the recorder returned so files other concurrent runs write to the shared capture directory are not mixed in
+	TArray<FString> CaptureFiles;
+	for (const FString& File : FGASCaptureRecorder::TakeWrittenFiles())
+	{
+		const FString OutputFile = OutputDir / FPaths::GetCleanFilename(File);
+		if (IFileManager::Get().Copy(*OutputFile, *File) == COPY_OK)
+		{
+			CaptureFiles.Add(OutputFile);
+		}
+		else
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not copy capture %s to %s"), *File, *OutputDir);
+		}
+	}
+
+	if (!Metrics->WriteReport(OutputDir, MapName, CaptureFiles))
+	{
+		return 1;
+	}
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("Wrote GAS report (%d samples, %d capture(s)) to %s"), Metrics->GetSamples().Num(), CaptureFiles.Num(), *OutputDir);
+	return 0;
+}
+
+UWorld* UGASCaptureCommandlet::LoadWorld(const FString& InMapName) const
+{
+	UPackage* Package = LoadPackage(nullptr, *InMapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogGASAttachEditor, Error, TEXT("Could not load map %s"), *InMapName);
+		return nullptr;
+	}
+
+	// 作为游戏世界初始化，这样监听器和录制都会处理它
+	// Initialize it as a game world so the monitor and the recorder pick it up
+	World->WorldType = EWorldType::Game;
+	World->AddToRoot();
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld();
+	}
+
+	const FURL URL;
+	World->UpdateWorldComponents(true, false);
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	return World;
+}
+
+void UGASCaptureCommandlet::DestroyWorld(UWorld* InWorld) const
+{
+	GEngine->DestroyWorldContext(InWorld);
+	InWorld->DestroyWorld(false);
+	InWorld->RemoveFromRoot();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASCaptureCommandlet.generated.h"
+
+class UWorld;
+
+// 无界面加载地图并运行一段时间，写出GAS录制和汇总指标，供CI归档和比较
+// 用法: UnrealEditor-Cmd <Project> -run=GASCapture -Map=/Game/Maps/Arena -nullrhi
+//       [-Duration=60] [-FixedStep=0.0333] [-SampleInterval=1] [-Trigger="TagAdded Status.Stunned;AbilityFailed"] [-CaptureOnEnd] [-Output=Dir]
+// 默认写到 Saved/GASAttachEditor/Reports/<地图>_<时间>: timeline.csv (效果数量和激活随时间变化)、summary.json (激活频率、每个角色的标签峰值) 和录制
+//
+// Loads a map headless, runs it for a while and writes GAS captures and summary metrics for CI to archive and diff
+// Usage: UnrealEditor-Cmd <Project> -run=GASCapture -Map=/Game/Maps/Arena -nullrhi
+//        [-Duration=60] [-FixedStep=0.0333] [-SampleInterval=1] [-Trigger="TagAdded Status.Stunned;AbilityFailed"] [-CaptureOnEnd] [-Output=Dir]
+// Writes to Saved/GASAttachEditor/Reports/<Map>_<Time> by default: timeline.csv (effect counts and activations over time), summary.json (activation rates, peak tags per actor) and the captures
+UCLASS()
+class UGASCaptureCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UGASCaptureCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	UWorld* LoadWorld(const FString& InMapName) const;
+
+	void DestroyWorld(UWorld* InWorld) const;
+};
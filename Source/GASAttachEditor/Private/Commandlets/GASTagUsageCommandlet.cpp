@@ -0,0 +1,438 @@
+#include "Commandlets/GASTagUsageCommandlet.h"
+#include "TagLookAsset/GASTagUsageIndex.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Containers/Ticker.h"
+#include "GameplayTagsManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "GASAttachEditorLog.h"
+
+namespace GASTagUsageCommandlet
+{
+	void SortPaths(TArray<FSoftObjectPath>& InOutPaths)
+	{
+		InOutPaths.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B)
+		{
+			return A.ToString() < B.ToString();
+		});
+	}
+
+	void ParseTagList(const FString& InValue, TArray<FName>& OutTags)
+	{
+		TArray<FString> TagStrings;
+		InValue.ParseIntoArray(TagStrings, TEXT(";"));
+		for (FString& TagString : TagStrings)
+		{
+			TagString.TrimStartAndEndInline();
+			if (!TagString.IsEmpty())
+			{
+				OutTags.AddUnique(FName(*TagString));
+			}
+		}
+	}
+}
+
+UGASTagUsageCommandlet::UGASTagUsageCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGASTagUsageCommandlet::Main(const FString& Params)
+{
+	int32 MaxAbilitiesPerTag = 8;
+	FParse::Value(*Params, TEXT("MaxAbilitiesPerTag="), MaxAbilitiesPerTag);
+
+	FString EventRootsString = TEXT("Event");
+	FParse::Value(*Params, TEXT("EventRoots="), EventRootsString, false);
+
+	// 原生代码发送的事件标签，注册表里看不到
+	// Event tags sent from native code, which the registry cannot see
+	FString SentTagsString;
+	FParse::Value(*Params, TEXT("SentTags="), SentTagsString, false);
+
+	TArray<FName> EventRoots;
+	TArray<FName> NativeSentTags;
+	GASTagUsageCommandlet::ParseTagList(EventRootsString, EventRoots);
+	GASTagUsageCommandlet::ParseTagList(SentTagsString, NativeSentTags);
+
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputDir))
+	{
+		OutputDir = FPaths::ProjectSavedDir() / TEXT("GASAttachEditor") / TEXT("Reports") / FString::Printf(TEXT("TagUsage_%s"), *FDateTime::Now().ToString());
+	}
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	// 命令行下注册表不会自己扫描
+	// The registry does not scan on its own in a commandlet
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	if (!BuildIndex())
+	{
+		return 1;
+	}
+
+	if (FParse::Param(*Params, TEXT("LoadOldAssets")))
+	{
+		UE_LOG(LogGASAttachEditor, Display, TEXT("Loaded %d GAS assets saved before their tag usage was exported"), LoadOldAssets());
+	}
+
+	// 触发标签 -> 触发器，和还没有精确结果的资源
+	// Trigger tag -> triggers, and the assets still without exact results
+	TMap<FName, TArray<const FGASTagUsageEntry*>> Triggers;
+	TSet<FSoftObjectPath> OldAssetSet;
+	for (const TPair<FName, FGASPackageTagUsages>& Package : FGASTagUsageIndex::GetPackages())
+	{
+		for (const FGASTagUsageEntry& Entry : Package.Value.Entries)
+		{
+			if (Entry.Usage == EGASTagUsage::Trigger)
+			{
+				Triggers.FindOrAdd(Entry.TagName).Add(&Entry);
+			}
+			if (!Entry.bExact)
+			{
+				OldAssetSet.Add(Entry.AssetPath);
+			}
+		}
+	}
+
+	TArray<FName> TriggerTags;
+	Triggers.GetKeys(TriggerTags);
+	TriggerTags.Sort(FNameLexicalLess());
+
+	TArray<FSoftObjectPath> OldAssets = OldAssetSet.Array();
+	GASTagUsageCommandlet::SortPaths(OldAssets);
+
+	// 扇出: 一个事件会唤醒触发标签是它自己或者它的父标签的所有技能
+	// Fan-out: one event wakes every ability triggered by its tag or one of its parents
+	TArray<TArray<FSoftObjectPath>> FanOut;
+	FanOut.SetNum(TriggerTags.Num());
+	ParallelFor(TriggerTags.Num(), [&](int32 Index)
+	{
+		TSet<FSoftObjectPath> Abilities;
+		for (FName Tag = TriggerTags[Index]; !Tag.IsNone(); Tag = FGASTagUsageIndex::GetParentTagName(Tag))
+		{
+			if (const TArray<const FGASTagUsageEntry*>* Entries = Triggers.Find(Tag))
+			{
+				for (const FGASTagUsageEntry* Entry : *Entries)
+				{
+					Abilities.Add(Entry->AssetPath);
+				}
+			}
+		}
+
+		if (Abilities.Num() > MaxAbilitiesPerTag)
+		{
+			FanOut[Index] = Abilities.Array();
+			GASTagUsageCommandlet::SortPaths(FanOut[Index]);
+		}
+	});
+
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+
+	// 没有触发任何技能的事件标签: 它自己、父标签和子标签都不是触发标签
+	// Event tags triggering nothing: neither the tag, its parents nor its children are trigger tags
+	TArray<FName> EventTags;
+	for (const FName& Root : EventRoots)
+	{
+		const FGameplayTag RootTag = TagsManager.RequestGameplayTag(Root, false);
+		if (!RootTag.IsValid())
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Event root %s is not a registered gameplay tag"), *Root.ToString());
+			continue;
+		}
+
+		EventTags.AddUnique(Root);
+		for (const FGameplayTag& Child : TagsManager.RequestGameplayTagChildren(RootTag))
+		{
+			EventTags.AddUnique(Child.GetTagName());
+		}
+	}
+	EventTags.Sort(FNameLexicalLess());
+
+	TSet<FName> TriggerTagsAndParents;
+	for (const FName& TriggerTag : TriggerTags)
+	{
+		for (FName Tag = TriggerTag; !Tag.IsNone(); Tag = FGASTagUsageIndex::GetParentTagName(Tag))
+		{
+			bool bAlreadyAdded = false;
+			TriggerTagsAndParents.Add(Tag, &bAlreadyAdded);
+			if (bAlreadyAdded)
+			{
+				break;
+			}
+		}
+	}
+
+	TArray<bool> Orphans;
+	Orphans.SetNumZeroed(EventTags.Num());
+	ParallelFor(EventTags.Num(), [&](int32 Index)
+	{
+		if (TriggerTagsAndParents.Contains(EventTags[Index]))
+		{
+			return;
+		}
+
+		for (FName Parent = FGASTagUsageIndex::GetParentTagName(EventTags[Index]); !Parent.IsNone(); Parent = FGASTagUsageIndex::GetParentTagName(Parent))
+		{
+			if (Triggers.Contains(Parent))
+			{
+				return;
+			}
+		}
+
+		Orphans[Index] = true;
+	});
+
+	// 没有被发送的触发标签: 它和它下面的标签除了在技能的触发器里，没有被任何资源引用
+	// 子标签的事件也会触发，所以一起查；注册的子标签在游戏线程先取出来，工作线程只读索引和注册表
+	//
+	// Trigger tags never sent: no asset references the tag or a tag below it except in an ability's triggers
+	// Events of child tags trigger too, so they are checked as well; registered children are gathered on the game thread first, workers only read the index and the registry
+	TArray<TArray<FName>> CheckedTags;
+	CheckedTags.SetNum(TriggerTags.Num());
+	for (int32 Index = 0; Index < TriggerTags.Num(); ++Index)
+	{
+		TArray<FName>& Tags = CheckedTags[Index];
+		Tags.Add(TriggerTags[Index]);
+
+		const FGameplayTag TriggerTag = TagsManager.RequestGameplayTag(TriggerTags[Index], false);
+		if (TriggerTag.IsValid())
+		{
+			for (const FGameplayTag& Child : TagsManager.RequestGameplayTagChildren(TriggerTag))
+			{
+				Tags.AddUnique(Child.GetTagName());
+			}
+		}
+
+		for (int32 TagIndex = 0; TagIndex < Tags.Num(); ++TagIndex)
+		{
+			if (const TArray<FName>* ChildTags = FGASTagUsageIndex::GetChildTags(Tags[TagIndex]))
+			{
+				for (const FName& ChildTag : *ChildTags)
+				{
+					Tags.AddUnique(ChildTag);
+				}
+			}
+		}
+	}
+
+	UScriptStruct* TagStruct = FGameplayTag::StaticStruct();
+
+	TArray<bool> Unsent;
+	Unsent.SetNumZeroed(TriggerTags.Num());
+	ParallelFor(TriggerTags.Num(), [&](int32 Index)
+	{
+		for (const FName& Tag : CheckedTags[Index])
+		{
+			if (NativeSentTags.Contains(Tag))
+			{
+				return;
+			}
+
+			// 只在触发器里用到这个标签的包
+			// Packages that only use this tag in their triggers
+			TSet<FName> TriggerPackages;
+			if (const TArray<FGASTagUsageEntry>* Entries = FGASTagUsageIndex::FindEntries(Tag))
+			{
+				for (const FGASTagUsageEntry& Entry : *Entries)
+				{
+					if (Entry.Usage != EGASTagUsage::Trigger)
+					{
+						return;
+					}
+					TriggerPackages.Add(Entry.AssetPath.GetLongPackageFName());
+				}
+			}
+
+			// 关卡、数据资源和其他蓝图这些不在索引里的资源
+			// Levels, data assets and other blueprints, which are not in the index
+			TArray<FAssetIdentifier> Referencers;
+			AssetRegistry.GetReferencers(FAssetIdentifier(TagStruct, Tag), Referencers, UE::AssetRegistry::EDependencyCategory::SearchableName);
+			for (const FAssetIdentifier& Referencer : Referencers)
+			{
+				if (!TriggerPackages.Contains(Referencer.PackageName))
+				{
+					return;
+				}
+			}
+		}
+
+		Unsent[Index] = true;
+	});
+
+	// 报告，键按名字排序，方便在CI里直接比较两次运行的文件
+	// Report; keys are sorted by name so CI can diff the files of two runs directly
+	const FString Filename = OutputDir / TEXT("tag_usage.json");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogGASAttachEditor, Error, TEXT("Could not write %s"), *Filename);
+		return 1;
+	}
+
+	const UEnum* SourceEnum = StaticEnum<EGameplayAbilityTriggerSource::Type>();
+
+	int32 NumOrphans = 0;
+	int32 NumUnsent = 0;
+	int32 NumFanOut = 0;
+
+	TSharedRef<TJsonWriter<UTF8CHAR>> Json = TJsonWriterFactory<UTF8CHAR>::Create(Writer.Get());
+	Json->WriteObjectStart();
+	Json->WriteValue(TEXT("packages"), FGASTagUsageIndex::GetNumPackages());
+	Json->WriteValue(TEXT("maxAbilitiesPerTag"), MaxAbilitiesPerTag);
+
+	Json->WriteArrayStart(TEXT("eventRoots"));
+	for (const FName& Root : EventRoots)
+	{
+		Json->WriteValue(Root.ToString());
+	}
+	Json->WriteArrayEnd();
+
+	// 这些资源只知道引用了哪些标签，它们的触发器不在报告里
+	// Only the referenced tags of these assets are known; their triggers are missing from the report
+	Json->WriteArrayStart(TEXT("oldAssets"));
+	for (const FSoftObjectPath& Asset : OldAssets)
+	{
+		Json->WriteValue(Asset.ToString());
+	}
+	Json->WriteArrayEnd();
+
+	Json->WriteArrayStart(TEXT("orphanEventTags"));
+	for (int32 Index = 0; Index < EventTags.Num(); ++Index)
+	{
+		if (Orphans[Index])
+		{
+			Json->WriteValue(EventTags[Index].ToString());
+			++NumOrphans;
+		}
+	}
+	Json->WriteArrayEnd();
+
+	Json->WriteObjectStart(TEXT("unsentTriggers"));
+	for (int32 Index = 0; Index < TriggerTags.Num(); ++Index)
+	{
+		if (!Unsent[Index])
+		{
+			continue;
+		}
+
+		++NumUnsent;
+		Json->WriteArrayStart(TriggerTags[Index].ToString());
+		for (const FGASTagUsageEntry* Entry : Triggers.FindChecked(TriggerTags[Index]))
+		{
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("ability"), Entry->AssetPath.ToString());
+			Json->WriteValue(TEXT("source"), SourceEnum->GetNameStringByValue(Entry->Source));
+			Json->WriteObjectEnd();
+		}
+		Json->WriteArrayEnd();
+	}
+	Json->WriteObjectEnd();
+
+	Json->WriteObjectStart(TEXT("fanOut"));
+	for (int32 Index = 0; Index < TriggerTags.Num(); ++Index)
+	{
+		if (FanOut[Index].Num() == 0)
+		{
+			continue;
+		}
+
+		++NumFanOut;
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Events tagged %s wake %d abilities (limit %d)"), *TriggerTags[Index].ToString(), FanOut[Index].Num(), MaxAbilitiesPerTag);
+
+		Json->WriteArrayStart(TriggerTags[Index].ToString());
+		for (const FSoftObjectPath& Ability : FanOut[Index])
+		{
+			Json->WriteValue(Ability.ToString());
+		}
+		Json->WriteArrayEnd();
+	}
+	Json->WriteObjectEnd();
+
+	Json->WriteObjectEnd();
+	Json->Close();
+
+	if (!Writer->Close())
+	{
+		UE_LOG(LogGASAttachEditor, Error, TEXT("Could not write %s"), *Filename);
+		return 1;
+	}
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("Wrote tag usage report (%d packages, %d orphan event tags, %d unsent trigger tags, %d tags over the fan-out limit, %d old assets) to %s"),
+		FGASTagUsageIndex::GetNumPackages(), NumOrphans, NumUnsent, NumFanOut, OldAssets.Num(), *Filename);
+
+	return FParse::Param(*Params, TEXT("FailOnFanOut")) && NumFanOut > 0 ? 1 : 0;
+}
+
+bool UGASTagUsageCommandlet::BuildIndex() const
+{
+	// 提取在工作线程上并行跑，完成回调投递到游戏线程
+	// Extraction runs in parallel on worker threads and posts its completion to the game thread
+	FGASTagUsageIndex::Build();
+
+	double LastLogTime = 0.0;
+	while (!FGASTagUsageIndex::IsBuilt() && !IsEngineExitRequested())
+	{
+		FTSTicker::GetCoreTicker().Tick(FApp::GetDeltaTime());
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		const TSharedPtr<FGASTagUsageScan> ActiveScan = FGASTagUsageIndex::GetActiveScan();
+		if (ActiveScan.IsValid() && FPlatformTime::Seconds() - LastLogTime > 5.0)
+		{
+			LastLogTime = FPlatformTime::Seconds();
+			UE_LOG(LogGASAttachEditor, Display, TEXT("Indexing %d/%d"), ActiveScan->GetNumDone(), ActiveScan->GetNumTotal());
+		}
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	if (!FGASTagUsageIndex::IsBuilt())
+	{
+		UE_LOG(LogGASAttachEditor, Error, TEXT("Tag usage index was not built"));
+		return false;
+	}
+	return true;
+}
+
+int32 UGASTagUsageCommandlet::LoadOldAssets() const
+{
+	TSet<FSoftObjectPath> OldAssets;
+	for (const TPair<FName, FGASPackageTagUsages>& Package : FGASTagUsageIndex::GetPackages())
+	{
+		for (const FGASTagUsageEntry& Entry : Package.Value.Entries)
+		{
+			if (!Entry.bExact)
+			{
+				OldAssets.Add(Entry.AssetPath);
+			}
+		}
+	}
+
+	int32 NumLoaded = 0;
+	for (const FSoftObjectPath& AssetPath : OldAssets)
+	{
+		UObject* Asset = AssetPath.TryLoad();
+		if (!Asset)
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not load %s"), *AssetPath.ToString());
+			continue;
+		}
+
+		FGASTagUsageIndex::AddLoaded(Asset);
+
+		// 大项目里不能把所有蓝图都留在内存里
+		// Large projects cannot keep every blueprint in memory
+		if (++NumLoaded % 256 == 0)
+		{
+			CollectGarbage(RF_NoFlags);
+		}
+	}
+	return NumLoaded;
+}
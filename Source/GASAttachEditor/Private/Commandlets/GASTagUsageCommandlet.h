@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASTagUsageCommandlet.generated.h"
+
+struct FGASTagUsageEntry;
+
+// 无界面构建整个项目的标签使用索引，写出触发器报告供CI检查:
+// 没有触发任何技能的事件标签、触发标签除了触发器之外没有被任何资源引用的技能、被超过N个技能当作触发器的标签
+// 用法: UnrealEditor-Cmd <Project> -run=GASTagUsage -nullrhi
+//       [-EventRoots="Event;GameplayEvent"] [-MaxAbilitiesPerTag=8] [-SentTags="Event.Native.Hit"] [-LoadOldAssets] [-FailOnFanOut] [-Output=Dir]
+// 报告默认写到 Saved/GASAttachEditor/Reports/TagUsage_<时间>/tag_usage.json。只在C++里发送的事件用 -SentTags 列出，父标签的触发器也计入扇出
+// -LoadOldAssets 加载导出之前保存的技能让它们的触发器也计入，-FailOnFanOut 在超过扇出上限时让运行失败
+//
+// Builds the tag usage index of the whole project headless and writes a trigger report for CI to check:
+// event tags that trigger no ability, abilities whose trigger tags no asset references except as a trigger, and tags used as a trigger by more than N abilities
+// Usage: UnrealEditor-Cmd <Project> -run=GASTagUsage -nullrhi
+//        [-EventRoots="Event;GameplayEvent"] [-MaxAbilitiesPerTag=8] [-SentTags="Event.Native.Hit"] [-LoadOldAssets] [-FailOnFanOut] [-Output=Dir]
+// The report goes to Saved/GASAttachEditor/Reports/TagUsage_<Time>/tag_usage.json by default. Events sent only from C++ are listed with -SentTags; triggers on parent tags count towards the fan-out
+// -LoadOldAssets loads abilities saved before their usage was exported so their triggers count too, and -FailOnFanOut makes the run fail when the fan-out limit is exceeded
+UCLASS()
+class UGASTagUsageCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UGASTagUsageCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	// 等后台扫描完成，期间处理游戏线程任务
+	// Waits for the background scan, processing game thread tasks meanwhile
+	bool BuildIndex() const;
+
+	// 加载在导出使用方式之前保存的技能，用精确结果替换只知道引用的条目
+	// Loads abilities saved before their usage was exported, replacing the reference-only entries with exact results
+	int32 LoadOldAssets() const;
+};
@@ -0,0 +1,337 @@
+#include "Export/GASStreamingExport.h"
+#include "Capture/GASCaptureTypes.h"
+#include "GASAttachEditor/SGASReflectorNodeBase.h"
+#include "GASAttachEditor/SGASGameplayEffectNodeBase.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "GASAttachEditorLog.h"
+
+namespace GASStreamingExport
+{
+	void WriteUtf8(FArchive& Ar, const FString& InString)
+	{
+		FTCHARToUTF8 Utf8(*InString);
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+	}
+
+	// 含有逗号、引号或换行时加引号
+	// Quoted when it contains a comma, a quote or a line break
+	FString EscapeCsv(const FString& InValue)
+	{
+		int32 Index = INDEX_NONE;
+		if (!InValue.FindChar(TEXT(','), Index) && !InValue.FindChar(TEXT('"'), Index) && !InValue.FindChar(TEXT('\n'), Index) && !InValue.FindChar(TEXT('\r'), Index))
+		{
+			return InValue;
+		}
+
+		return FString::Printf(TEXT("\"%s\""), *InValue.Replace(TEXT("\""), TEXT("\"\"")));
+	}
+}
+
+// 所有表写在同一个 JSON 对象里
+// Every table goes into one JSON object
+class FGASJsonExportWriter : public FGASExportWriter
+{
+public:
+
+	explicit FGASJsonExportWriter(const FString& InFilename)
+	{
+		FileWriter.Reset(IFileManager::Get().CreateFileWriter(*InFilename));
+		if (FileWriter.IsValid())
+		{
+			Filenames.Add(InFilename);
+			JsonWriter = TJsonWriterFactory<UTF8CHAR>::Create(FileWriter.Get());
+			JsonWriter->WriteObjectStart();
+		}
+	}
+
+	virtual bool BeginTable(const FString& InTable, const TArray<FString>& InColumns) override
+	{
+		if (!JsonWriter.IsValid())
+		{
+			return false;
+		}
+
+		Columns = InColumns;
+		JsonWriter->WriteArrayStart(InTable);
+		return true;
+	}
+
+	virtual void AddRow(TArrayView<const FString> InValues) override
+	{
+		if (!JsonWriter.IsValid())
+		{
+			return;
+		}
+
+		JsonWriter->WriteObjectStart();
+		for (int32 Index = 0; Index < Columns.Num() && Index < InValues.Num(); ++Index)
+		{
+			JsonWriter->WriteValue(Columns[Index], InValues[Index]);
+		}
+		JsonWriter->WriteObjectEnd();
+	}
+
+	virtual void EndTable() override
+	{
+		if (JsonWriter.IsValid())
+		{
+			JsonWriter->WriteArrayEnd();
+		}
+	}
+
+	virtual bool Close() override
+	{
+		if (!JsonWriter.IsValid())
+		{
+			return false;
+		}
+
+		JsonWriter->WriteObjectEnd();
+		JsonWriter->Close();
+		JsonWriter.Reset();
+
+		return FileWriter->Close() && !FileWriter->IsError();
+	}
+
+private:
+
+	TUniquePtr<FArchive> FileWriter;
+
+	TSharedPtr<TJsonWriter<UTF8CHAR>> JsonWriter;
+
+	TArray<FString> Columns;
+};
+
+// 每张表一个文件: <名字>_<表名>.csv
+// One file per table: <Name>_<Table>.csv
+class FGASCsvExportWriter : public FGASExportWriter
+{
+public:
+
+	explicit FGASCsvExportWriter(const FString& InFilename)
+		:BaseFilename(FPaths::GetBaseFilename(InFilename, false))
+		,bSucceeded(true)
+	{
+	}
+
+	virtual bool BeginTable(const FString& InTable, const TArray<FString>& InColumns) override
+	{
+		const FString Filename = FString::Printf(TEXT("%s_%s.csv"), *BaseFilename, *InTable);
+		FileWriter.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+		if (!FileWriter.IsValid())
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not open %s for writing"), *Filename);
+			bSucceeded = false;
+			return false;
+		}
+
+		Filenames.Add(Filename);
+		AddRow(InColumns);
+		return true;
+	}
+
+	virtual void AddRow(TArrayView<const FString> InValues) override
+	{
+		if (!FileWriter.IsValid())
+		{
+			return;
+		}
+
+		Line.Reset();
+		for (int32 Index = 0; Index < InValues.Num(); ++Index)
+		{
+			if (Index > 0)
+			{
+				Line += TEXT(',');
+			}
+			Line += GASStreamingExport::EscapeCsv(InValues[Index]);
+		}
+		Line += TEXT('\n');
+
+		GASStreamingExport::WriteUtf8(*FileWriter, Line);
+	}
+
+	virtual void EndTable() override
+	{
+		if (FileWriter.IsValid())
+		{
+			bSucceeded &= FileWriter->Close() && !FileWriter->IsError();
+			FileWriter.Reset();
+		}
+	}
+
+	virtual bool Close() override
+	{
+		EndTable();
+		return bSucceeded;
+	}
+
+private:
+
+	FString BaseFilename;
+
+	TUniquePtr<FArchive> FileWriter;
+
+	FString Line;
+
+	bool bSucceeded;
+};
+
+TUniquePtr<FGASExportWriter> FGASExportWriter::Create(const FString& InFilename)
+{
+	if (FPaths::GetExtension(InFilename).Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+	{
+		return MakeUnique<FGASCsvExportWriter>(InFilename);
+	}
+
+	return MakeUnique<FGASJsonExportWriter>(InFilename);
+}
+
+FString FGASExportWriter::GetExportDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GASAttachEditor") / TEXT("Exports");
+}
+
+void FGASSnapshotExport::WriteSnapshot(FGASExportWriter& Writer, const FGASCaptureWorldSnapshot& InSnapshot, const TArray<FString>& InHiddenColumns)
+{
+	auto IsVisible = [&InHiddenColumns](const FName& InColumnId)
+	{
+		return !InHiddenColumns.Contains(InColumnId.ToString());
+	};
+
+	TArray<FString> Row;
+
+	{
+		const bool bActive = IsVisible(NAME_GAIsActive);
+
+		TArray<FString> Columns({ TEXT("Actor"), TEXT("Class"), TEXT("Ability"), TEXT("Level"), TEXT("InputID") });
+		if (bActive)
+		{
+			Columns.Add(TEXT("ActiveCount"));
+		}
+
+		if (Writer.BeginTable(TEXT("Abilities"), Columns))
+		{
+			for (const FGASCaptureAscSnapshot& AbilitySystem : InSnapshot.GetAbilitySystems())
+			{
+				for (const FGASCaptureAbility& Ability : AbilitySystem.Abilities)
+				{
+					Row.Reset();
+					Row.Add(AbilitySystem.Actor.ToString());
+					Row.Add(AbilitySystem.ActorClass.ToString());
+					Row.Add(Ability.Ability.ToString());
+					Row.Add(LexToString(Ability.Level));
+					Row.Add(LexToString(Ability.InputID));
+					if (bActive)
+					{
+						Row.Add(LexToString(Ability.ActiveCount));
+					}
+					Writer.AddRow(Row);
+				}
+			}
+			Writer.EndTable();
+		}
+	}
+
+	if (Writer.BeginTable(TEXT("Attributes"), { TEXT("Actor"), TEXT("Class"), TEXT("Attribute"), TEXT("BaseValue"), TEXT("CurrentValue") }))
+	{
+		for (const FGASCaptureAscSnapshot& AbilitySystem : InSnapshot.GetAbilitySystems())
+		{
+			for (const FGASCaptureAttribute& Attribute : AbilitySystem.Attributes)
+			{
+				Row.Reset();
+				Row.Add(AbilitySystem.Actor.ToString());
+				Row.Add(AbilitySystem.ActorClass.ToString());
+				Row.Add(Attribute.Attribute.ToString());
+				Row.Add(LexToString(Attribute.BaseValue));
+				Row.Add(LexToString(Attribute.CurrentValue));
+				Writer.AddRow(Row);
+			}
+		}
+		Writer.EndTable();
+	}
+
+	{
+		const bool bDuration = IsVisible(NAME_GAGameplayEffectDuration);
+		const bool bStack = IsVisible(NAME_GAGameplayEffectStack);
+		const bool bLevel = IsVisible(NAME_GAGameplayEffectLevel);
+
+		TArray<FString> Columns({ TEXT("Actor"), TEXT("Class"), TEXT("Effect"), TEXT("Handle") });
+		if (bDuration)
+		{
+			Columns.Add(TEXT("StartWorldTime"));
+			Columns.Add(TEXT("Duration"));
+		}
+		if (bStack)
+		{
+			Columns.Add(TEXT("Stack"));
+		}
+		if (bLevel)
+		{
+			Columns.Add(TEXT("Level"));
+		}
+		Columns.Add(TEXT("Inhibited"));
+
+		if (Writer.BeginTable(TEXT("GameplayEffects"), Columns))
+		{
+			for (const FGASCaptureAscSnapshot& AbilitySystem : InSnapshot.GetAbilitySystems())
+			{
+				for (const FGASCaptureEffect& Effect : AbilitySystem.Effects)
+				{
+					Row.Reset();
+					Row.Add(AbilitySystem.Actor.ToString());
+					Row.Add(AbilitySystem.ActorClass.ToString());
+					Row.Add(Effect.Definition.ToString());
+					Row.Add(LexToString(Effect.Handle));
+					if (bDuration)
+					{
+						Row.Add(LexToString(Effect.StartWorldTime));
+						Row.Add(LexToString(Effect.Duration));
+					}
+					if (bStack)
+					{
+						Row.Add(LexToString(Effect.StackCount));
+					}
+					if (bLevel)
+					{
+						Row.Add(LexToString(Effect.Level));
+					}
+					Row.Add(LexToString(Effect.bInhibited));
+					Writer.AddRow(Row);
+				}
+			}
+			Writer.EndTable();
+		}
+	}
+
+	if (Writer.BeginTable(TEXT("Tags"), { TEXT("Actor"), TEXT("Class"), TEXT("Tag"), TEXT("Count"), TEXT("Blocked") }))
+	{
+		for (const FGASCaptureAscSnapshot& AbilitySystem : InSnapshot.GetAbilitySystems())
+		{
+			for (const FGASCaptureTagCount& Tag : AbilitySystem.Tags)
+			{
+				Row.Reset();
+				Row.Add(AbilitySystem.Actor.ToString());
+				Row.Add(AbilitySystem.ActorClass.ToString());
+				Row.Add(Tag.Tag.ToString());
+				Row.Add(LexToString(Tag.Count));
+				Row.Add(LexToString(false));
+				Writer.AddRow(Row);
+			}
+
+			for (const FName& Tag : AbilitySystem.BlockedTags)
+			{
+				Row.Reset();
+				Row.Add(AbilitySystem.Actor.ToString());
+				Row.Add(AbilitySystem.ActorClass.ToString());
+				Row.Add(Tag.ToString());
+				Row.Add(FString());
+				Row.Add(LexToString(true));
+				Writer.AddRow(Row);
+			}
+		}
+		Writer.EndTable();
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+struct FGASCaptureWorldSnapshot;
+
+// 边遍历边写出的表格导出，不在内存里构建整个文档
+// 一个文件里可以有多张表; JSON 为 { "表名": [ {列: 值}, ... ] }，CSV 每张表一个文件
+//
+// Table export written while walking the data; the whole document is never built in memory
+// One export may hold several tables; JSON is { "Table": [ {Column: Value}, ... ] }, CSV writes one file per table
+class FGASExportWriter
+{
+public:
+
+	// 根据扩展名(.json/.csv)创建
+	// Created from the extension (.json/.csv)
+	static TUniquePtr<FGASExportWriter> Create(const FString& InFilename);
+
+	virtual ~FGASExportWriter() {}
+
+	virtual bool BeginTable(const FString& InTable, const TArray<FString>& InColumns) = 0;
+
+	// 值的顺序与列相同
+	// Values are in column order
+	virtual void AddRow(TArrayView<const FString> InValues) = 0;
+
+	virtual void EndTable() = 0;
+
+	virtual bool Close() = 0;
+
+	// 写出的所有文件
+	// Every file written
+	const TArray<FString>& GetFilenames() const { return Filenames; }
+
+public:
+
+	// 导出文件的默认目录 Saved/GASAttachEditor/Exports
+	// Default export directory, Saved/GASAttachEditor/Exports
+	static FString GetExportDir();
+
+protected:
+
+	TArray<FString> Filenames;
+};
+
+// 把快照里每个ASC写成 Abilities/Attributes/GameplayEffects/Tags 四张表
+// 与面板列名相同的隐藏列不会导出
+//
+// Writes every ASC of a snapshot as the Abilities/Attributes/GameplayEffects/Tags tables
+// Columns hidden under the same id in the panel are left out
+class FGASSnapshotExport
+{
+public:
+
+	static void WriteSnapshot(FGASExportWriter& Writer, const FGASCaptureWorldSnapshot& InSnapshot, const TArray<FString>& InHiddenColumns);
+};
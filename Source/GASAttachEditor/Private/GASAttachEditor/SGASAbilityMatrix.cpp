@@ -0,0 +1,232 @@
+#include "SGASAbilityMatrix.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+
+#define LOCTEXT_NAMESPACE "SGASAttachEditor"
+
+void SGASAbilityMatrixGrid::Construct(const FArguments& InArgs)
+{
+	Matrix = InArgs._Matrix;
+	CellSize = InArgs._CellSize;
+	LabelWidth = InArgs._LabelWidth;
+	HeaderHeight = 18.f;
+	HoveredRow = INDEX_NONE;
+	HoveredColumn = INDEX_NONE;
+	VisibleTopLeft = FVector2D::ZeroVector;
+
+	SetToolTipText(MakeAttributeSP(this, &SGASAbilityMatrixGrid::GetHoveredCellText));
+}
+
+void SGASAbilityMatrixGrid::Refresh()
+{
+	HoveredRow = INDEX_NONE;
+	HoveredColumn = INDEX_NONE;
+	HoveredCellText = FText::GetEmpty();
+
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+FLinearColor SGASAbilityMatrixGrid::GetRelationColor(EGASAbilityRelation InRelation)
+{
+	// 同时有多种关系时显示最严重的一种，提示里列出全部
+	// With several relations the most severe one is shown; the tooltip lists all of them
+	if (EnumHasAnyFlags(InRelation, EGASAbilityRelation::Cancels))
+	{
+		return FLinearColor(0.85f, 0.12f, 0.1f);
+	}
+	if (EnumHasAnyFlags(InRelation, EGASAbilityRelation::Blocks))
+	{
+		return FLinearColor(0.95f, 0.5f, 0.1f);
+	}
+	if (EnumHasAnyFlags(InRelation, EGASAbilityRelation::BlocksByOwnedTags))
+	{
+		return FLinearColor(0.9f, 0.8f, 0.15f);
+	}
+	if (EnumHasAnyFlags(InRelation, EGASAbilityRelation::Enables))
+	{
+		return FLinearColor(0.2f, 0.7f, 0.25f);
+	}
+	return FLinearColor(1.f, 1.f, 1.f, 0.04f);
+}
+
+int32 SGASAbilityMatrixGrid::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const int32 Num = Matrix.IsValid() ? Matrix->Num() : 0;
+	if (Num == 0)
+	{
+		return LayerId;
+	}
+
+	const FSlateBrush* WhiteBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Regular", 8);
+
+	// 滚动框会裁剪，可见区域换算到本地坐标后只画其中的行列
+	// The scroll boxes clip, so the visible area is mapped to local space and only its rows and columns are drawn
+	const FVector2D LocalTopLeft = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft());
+	const FVector2D LocalBottomRight = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight());
+	VisibleTopLeft = FVector2D(FMath::Max(0.0, LocalTopLeft.X), FMath::Max(0.0, LocalTopLeft.Y));
+
+	const int32 FirstRow = FMath::Clamp(FMath::FloorToInt((LocalTopLeft.Y - HeaderHeight) / CellSize), 0, Num - 1);
+	const int32 LastRow = FMath::Clamp(FMath::CeilToInt((LocalBottomRight.Y - HeaderHeight) / CellSize), 0, Num - 1);
+	const int32 FirstColumn = FMath::Clamp(FMath::FloorToInt((LocalTopLeft.X - LabelWidth) / CellSize), 0, Num - 1);
+	const int32 LastColumn = FMath::Clamp(FMath::CeilToInt((LocalBottomRight.X - LabelWidth) / CellSize), 0, Num - 1);
+
+	const FVector2D CellDrawSize(CellSize - 1.f, CellSize - 1.f);
+	for (int32 Row = FirstRow; Row <= LastRow; ++Row)
+	{
+		for (int32 Column = FirstColumn; Column <= LastColumn; ++Column)
+		{
+			const EGASAbilityRelation Relation = Matrix->GetRelation(Row, Column);
+			FLinearColor Color = Row == Column && Relation == EGASAbilityRelation::None ? FLinearColor(0.f, 0.f, 0.f, 0.35f) : GetRelationColor(Relation);
+			if (Row == HoveredRow || Column == HoveredColumn)
+			{
+				Color = Color * 1.3f + FLinearColor(0.05f, 0.05f, 0.05f, 0.08f);
+			}
+
+			FSlateDrawElement::MakeBox(
+				OutDrawElements,
+				LayerId,
+				AllottedGeometry.ToPaintGeometry(CellDrawSize, FSlateLayoutTransform(FVector2D(LabelWidth + Column * CellSize, HeaderHeight + Row * CellSize))),
+				WhiteBrush,
+				ESlateDrawEffect::None,
+				Color);
+		}
+	}
+
+	// 行名固定在左边
+	// Row names pinned to the left
+	const FLinearColor LabelBackground(0.015f, 0.015f, 0.015f, 1.f);
+	const int32 LabelLayer = LayerId + 1;
+	for (int32 Row = FirstRow; Row <= LastRow; ++Row)
+	{
+		const FVector2D Position(VisibleTopLeft.X, HeaderHeight + Row * CellSize);
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			LabelLayer,
+			AllottedGeometry.ToPaintGeometry(FVector2D(LabelWidth, CellSize), FSlateLayoutTransform(Position)),
+			WhiteBrush,
+			ESlateDrawEffect::None,
+			LabelBackground);
+
+		FSlateDrawElement::MakeText(
+			OutDrawElements,
+			LabelLayer + 1,
+			AllottedGeometry.ToPaintGeometry(FVector2D(LabelWidth - 4.f, CellSize), FSlateLayoutTransform(Position + FVector2D(4.f, 0.f))),
+			FString::Printf(TEXT("%d  %s"), Row, *Matrix->GetAbilityName(Row).ToString()),
+			Font,
+			ESlateDrawEffect::None,
+			Row == HoveredRow ? FLinearColor::White : FLinearColor(0.7f, 0.7f, 0.7f));
+	}
+
+	// 列号固定在上边，每5列一个
+	// Column numbers pinned to the top, one every 5 columns
+	const FVector2D HeaderPosition(VisibleTopLeft.X, VisibleTopLeft.Y);
+	FSlateDrawElement::MakeBox(
+		OutDrawElements,
+		LabelLayer + 2,
+		AllottedGeometry.ToPaintGeometry(FVector2D(LocalBottomRight.X - HeaderPosition.X, HeaderHeight), FSlateLayoutTransform(HeaderPosition)),
+		WhiteBrush,
+		ESlateDrawEffect::None,
+		LabelBackground);
+
+	for (int32 Column = FirstColumn - FirstColumn % 5; Column <= LastColumn; Column += 5)
+	{
+		const float X = LabelWidth + Column * CellSize;
+		if (X < VisibleTopLeft.X + LabelWidth)
+		{
+			continue;
+		}
+
+		FSlateDrawElement::MakeText(
+			OutDrawElements,
+			LabelLayer + 3,
+			AllottedGeometry.ToPaintGeometry(FVector2D(CellSize * 5.f, HeaderHeight), FSlateLayoutTransform(FVector2D(X, HeaderPosition.Y + 2.f))),
+			FString::FromInt(Column),
+			Font,
+			ESlateDrawEffect::None,
+			FLinearColor(0.7f, 0.7f, 0.7f));
+	}
+
+	if (HoveredColumn != INDEX_NONE)
+	{
+		FSlateDrawElement::MakeText(
+			OutDrawElements,
+			LabelLayer + 3,
+			AllottedGeometry.ToPaintGeometry(FVector2D(LabelWidth - 4.f, HeaderHeight), FSlateLayoutTransform(HeaderPosition + FVector2D(4.f, 2.f))),
+			FString::Printf(TEXT("-> %d  %s"), HoveredColumn, *Matrix->GetAbilityName(HoveredColumn).ToString()),
+			Font,
+			ESlateDrawEffect::None,
+			FLinearColor::White);
+	}
+
+	return LabelLayer + 3;
+}
+
+FVector2D SGASAbilityMatrixGrid::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	const int32 Num = Matrix.IsValid() ? Matrix->Num() : 0;
+	return FVector2D(LabelWidth + Num * CellSize, HeaderHeight + Num * CellSize);
+}
+
+FReply SGASAbilityMatrixGrid::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	const int32 Num = Matrix.IsValid() ? Matrix->Num() : 0;
+	const FVector2D Local = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
+
+	int32 Row = FMath::FloorToInt((Local.Y - HeaderHeight) / CellSize);
+	int32 Column = FMath::FloorToInt((Local.X - LabelWidth) / CellSize);
+
+	// 固定的行名和列号盖住了下面的格子
+	// The pinned labels cover the cells underneath
+	if (Local.X < VisibleTopLeft.X + LabelWidth)
+	{
+		Column = INDEX_NONE;
+	}
+	if (Local.Y < VisibleTopLeft.Y + HeaderHeight)
+	{
+		Row = INDEX_NONE;
+	}
+
+	SetHoveredCell(Row >= 0 && Row < Num ? Row : INDEX_NONE, Column >= 0 && Column < Num ? Column : INDEX_NONE);
+	return FReply::Unhandled();
+}
+
+void SGASAbilityMatrixGrid::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+	SetHoveredCell(INDEX_NONE, INDEX_NONE);
+}
+
+void SGASAbilityMatrixGrid::SetHoveredCell(int32 InRow, int32 InColumn)
+{
+	if (HoveredRow == InRow && HoveredColumn == InColumn)
+	{
+		return;
+	}
+
+	HoveredRow = InRow;
+	HoveredColumn = InColumn;
+
+	if (HoveredRow != INDEX_NONE && HoveredColumn != INDEX_NONE)
+	{
+		HoveredCellText = FText::FromString(Matrix->DescribeCell(HoveredRow, HoveredColumn));
+	}
+	else if (HoveredRow != INDEX_NONE)
+	{
+		HoveredCellText = FText::FromName(Matrix->GetAbilityName(HoveredRow));
+	}
+	else
+	{
+		HoveredCellText = FText::GetEmpty();
+	}
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+FText SGASAbilityMatrixGrid::GetHoveredCellText() const
+{
+	return HoveredCellText;
+}
+
+#undef LOCTEXT_NAMESPACE
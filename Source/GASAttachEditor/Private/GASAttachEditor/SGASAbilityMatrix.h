@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Monitor/GASAbilityMatrix.h"
+
+// 技能关系矩阵的网格，只绘制可见区域里的格子
+// 行名和列号在滚动时固定在可见区域的边上
+//
+// Grid of the ability relation matrix; only the cells inside the visible area are painted
+// Row names and column numbers stay pinned to the edges of the visible area while scrolling
+class SGASAbilityMatrixGrid : public SLeafWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SGASAbilityMatrixGrid)
+		: _CellSize(14.f)
+		, _LabelWidth(260.f)
+	{}
+	SLATE_ARGUMENT(TSharedPtr<const FGASAbilityMatrix>, Matrix)
+	SLATE_ARGUMENT(float, CellSize)
+	SLATE_ARGUMENT(float, LabelWidth)
+		SLATE_END_ARGS()
+
+public:
+
+	void Construct(const FArguments& InArgs);
+
+	// 矩阵重新计算后调用
+	// Called once the matrix was recomputed
+	void Refresh();
+
+	static FLinearColor GetRelationColor(EGASAbilityRelation InRelation);
+
+public:
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+
+protected:
+
+	void SetHoveredCell(int32 InRow, int32 InColumn);
+
+	FText GetHoveredCellText() const;
+
+	TSharedPtr<const FGASAbilityMatrix> Matrix;
+
+	float CellSize;
+
+	float LabelWidth;
+
+	float HeaderHeight;
+
+	int32 HoveredRow;
+
+	int32 HoveredColumn;
+
+	// 只在悬停的格子变化时重新描述
+	// Only described again when the hovered cell changes
+	FText HoveredCellText;
+
+	// 上次绘制时的可见区域(本地坐标)，固定的行名和列号用它来定位
+	// Visible area in local space from the last paint, used to place the pinned labels
+	mutable FVector2D VisibleTopLeft;
+};
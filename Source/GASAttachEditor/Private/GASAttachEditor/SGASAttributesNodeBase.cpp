@@ -2,15 +2,20 @@
 #include "AbilitySystemComponent.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Layout/SBox.h"
+#include "GASAttachEditorStats.h"
 
 #define LOCTEXT_NAMESPACE "SGASAttachEditor"
 
 FGASAttributesNode::~FGASAttributesNode()
 {
+	DEC_DWORD_STAT(STAT_GASAttachEditor_LiveAttributeNodes);
+	DEC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASAttributesNode));
 }
 
 TSharedRef<FGASAttributesNode> FGASAttributesNode::Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, const FGameplayAttribute& InAttribute)
 {
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CreateNodes);
+
 	return MakeShareable(new FGASAttributesNode(InASComponent, InAttribute));
 }
 
@@ -32,6 +37,9 @@ FGASAttributesNode::FGASAttributesNode(TWeakObjectPtr<UAbilitySystemComponent> I
 {
 	ASComponent = InASComponent;
 	Attribute = InAttribute;
+
+	INC_DWORD_STAT(STAT_GASAttachEditor_LiveAttributeNodes);
+	INC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASAttributesNode));
 }
 
 void SGASAttributesTreeItem::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
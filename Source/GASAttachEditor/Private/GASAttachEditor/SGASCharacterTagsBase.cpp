@@ -4,6 +4,8 @@
 #include "Widgets/Input/SButton.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Widgets/Views/STileView.h"
+#include "Monitor/GASTagSourceIndex.h"
+#include "GASAttachEditorStats.h"
 
 #define LOCTEXT_NAMESPACE "SGASAttachEditor"
 
@@ -21,6 +23,7 @@ void SCharacterTagsView::Tick(const FGeometry& AllottedGeometry, const double In
 void SCharacterTagsViewItem::Construct(const FArguments& InArgs)
 {
 	TagsItem = InArgs._TagsItem;
+	TagCount = INDEX_NONE;
 
 	FTextBlockStyle InTextStyle = FCoreStyle::Get().GetWidgetStyle< FTextBlockStyle >("NormalText");
 	InTextStyle.ColorAndOpacity = FSlateColor(FLinearColor::White);
@@ -31,13 +34,14 @@ void SCharacterTagsViewItem::Construct(const FArguments& InArgs)
 #if WITH_EDITOR
 			.ButtonStyle(FAppStyle::Get(), "NoBorder")
 #endif
-			.ToolTipText(TagsItem.IsValid() ? TagsItem->GetTagTipName() : FText())
+			.ToolTipText(this, &SCharacterTagsViewItem::GetToolTipText)
 			.HAlign(HAlign_Center)
 			.VAlign(VAlign_Center)
 			.OnClicked(this, &SCharacterTagsViewItem::HandleOnClicked)
 			[
 				SAssignNew(ShowTextTag,STextBlock)
-				.Text(TagsItem.IsValid() ? TagsItem->GetTagName() : FText())
+				.Text(this, &SCharacterTagsViewItem::GetTagText)
+				.OverflowPolicy(ETextOverflowPolicy::Ellipsis)
 				.TextStyle(&InTextStyle)
 				
 			]
@@ -45,6 +49,28 @@ void SCharacterTagsViewItem::Construct(const FArguments& InArgs)
 	;
 }
 
+FText SCharacterTagsViewItem::GetTagText() const
+{
+	if (!TagsItem.IsValid())
+	{
+		return FText();
+	}
+
+	const int32 NewTagCount = TagsItem->GetTagCount();
+	if (NewTagCount != TagCount)
+	{
+		TagCount = NewTagCount;
+		TagText = TagsItem->GetTagName();
+	}
+
+	return TagText;
+}
+
+FText SCharacterTagsViewItem::GetToolTipText() const
+{
+	return TagsItem.IsValid() ? TagsItem->GetTagTipName() : FText();
+}
+
 FReply SCharacterTagsViewItem::HandleOnClicked()
 {
 	FString Str = ShowTextTag->GetText().ToString();
@@ -84,21 +110,15 @@ FText FGASCharacterTags::GetTagTipName() const
 		}
 	}
 #endif
-	for (FGameplayAbilitySpec& AbilitySpec : ASComponent->GetActivatableAbilities())
+	// 来源来自倒排索引，不再遍历所有技能
+	// Sources come from the inverted index instead of walking every ability
+	if (TSharedPtr<FGASTagSourceIndex> SourceIndex = FGASTagSourceIndex::FindOrCreate(ASComponent.Get()))
 	{
-		if (!AbilitySpec.IsActive() || !AbilitySpec.Ability) continue;
-
-		FProperty* ActiveTagsPtr = FindFProperty<FProperty>(AbilitySpec.Ability->GetClass(), WidegtName);
-		if (!ActiveTagsPtr) continue;
-		FGameplayTagContainer* ActivationTags = ActiveTagsPtr->ContainerPtrToValuePtr<FGameplayTagContainer>(AbilitySpec.Ability);
-		if (!ActivationTags) continue;
-
-		if (ActivationTags->HasTag(GameplayTag))
+		const FString Sources = SourceIndex->DescribeSources(ASComponent.Get(), GameplayTag, WidegtName == "ActivationBlockedTags");
+		if (!Sources.IsEmpty())
 		{
-			Str += FString::Printf(TEXT("\n\n  %s"),*ASComponent->CleanupName(GetNameSafe(AbilitySpec.Ability)));
+			Str += TEXT("\n") + Sources;
 		}
-
-		//AbilitySpec.DynamicAbilityTags.
 	}
 
 	return FText::FromString(Str);
@@ -113,8 +133,15 @@ FText FGASCharacterTags::GetTagName() const
 	return FText::FromString(FString::Printf(TEXT("%s [%d]"), *GameplayTag.ToString(), ASComponent->GetTagCount(GameplayTag)));
 }
 
+int32 FGASCharacterTags::GetTagCount() const
+{
+	return ASComponent.IsValid() ? ASComponent->GetTagCount(GameplayTag) : 0;
+}
+
 TSharedRef<FGASCharacterTags> FGASCharacterTags::Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayTag InGameplayTag, FName InWidegtName)
 {
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CreateNodes);
+
 	return MakeShareable(new FGASCharacterTags(InASComponent, InGameplayTag, InWidegtName));
 }
 
@@ -124,6 +151,15 @@ FGASCharacterTags::FGASCharacterTags(TWeakObjectPtr<UAbilitySystemComponent> InA
 	ASComponent = InASComponent;
 	GameplayTag = InGameplayTag;
 	WidegtName = InWidegtName;
+
+	INC_DWORD_STAT(STAT_GASAttachEditor_LiveTagItems);
+	INC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASCharacterTags));
+}
+
+FGASCharacterTags::~FGASCharacterTags()
+{
+	DEC_DWORD_STAT(STAT_GASAttachEditor_LiveTagItems);
+	DEC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASCharacterTags));
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
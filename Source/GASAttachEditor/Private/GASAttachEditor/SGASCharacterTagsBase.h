@@ -21,6 +21,12 @@ public:
 	// Get tag comment name
 	virtual FText GetTagTipName() const = 0;
 
+	// 获取Tag当前的数量
+	// Get the current count of the tag
+	virtual int32 GetTagCount() const = 0;
+
+	virtual FGameplayTag GetGameplayTag() const = 0;
+
 protected:
 
 	FGASCharacterTagsBase(){};
@@ -55,18 +61,30 @@ protected:
 
 	FReply HandleOnClicked();
 
+	// 数量变化时才重新生成文本，只有显示出来的控件会调用
+	// Only rebuilds the text when the count changed; only called for widgets on screen
+	FText GetTagText() const;
+
+	// 提示在显示时才生成
+	// The tooltip is only built when shown
+	FText GetToolTipText() const;
+
 protected:
 	/** The data for this item */
 	TSharedPtr<FGASCharacterTagsBase> TagsItem;
 
 	TSharedPtr<STextBlock> ShowTextTag;
+
+	mutable FText TagText;
+
+	mutable int32 TagCount;
 };
 
 class FGASCharacterTags : public FGASCharacterTagsBase
 {
 public:
 
-	virtual ~FGASCharacterTags(){};
+	virtual ~FGASCharacterTags();
 
 
 	virtual FText GetTagName() const override;
@@ -74,6 +92,10 @@ public:
 
 	virtual FText GetTagTipName() const override;
 
+	virtual int32 GetTagCount() const override;
+
+	virtual FGameplayTag GetGameplayTag() const override { return GameplayTag; }
+
 	static TSharedRef<FGASCharacterTags> Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayTag InGameplayTag, FName InWidegtName);
 
 private:
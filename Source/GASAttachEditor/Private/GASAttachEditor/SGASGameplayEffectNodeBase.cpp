@@ -4,15 +4,20 @@
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Engine/World.h"
+#include "GASAttachEditorStats.h"
 
 #define LOCTEXT_NAMESPACE "SGASAttachEditor"
 
 FGASGameplayEffectNode::~FGASGameplayEffectNode()
 {
+	DEC_DWORD_STAT(STAT_GASAttachEditor_LiveEffectNodes);
+	DEC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASGameplayEffectNode));
 }
 
 TSharedRef<FGASGameplayEffectNode> FGASGameplayEffectNode::Create(const UWorld* InWorld, const FActiveGameplayEffect& InGameplayEffect)
 {
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CreateNodes);
+
 	return MakeShareable(new FGASGameplayEffectNode(InWorld, InGameplayEffect));
 }
 
@@ -125,6 +130,9 @@ FGASGameplayEffectNode::FGASGameplayEffectNode(const UWorld* InWorld, const FAct
 	ModInfo = nullptr;
 	ModSpec = nullptr;
 
+	INC_DWORD_STAT(STAT_GASAttachEditor_LiveEffectNodes);
+	INC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASGameplayEffectNode));
+
 	CreateChild();
 }
 
@@ -133,6 +141,9 @@ FGASGameplayEffectNode::FGASGameplayEffectNode(const FModifierSpec* InModSpec,co
 	World = nullptr;
 	ModInfo = InModInfo;
 	ModSpec = InModSpec;
+
+	INC_DWORD_STAT(STAT_GASAttachEditor_LiveEffectNodes);
+	INC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASGameplayEffectNode));
 }
 
 void FGASGameplayEffectNode::CreateChild()
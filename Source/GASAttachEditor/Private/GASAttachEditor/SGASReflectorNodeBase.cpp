@@ -3,6 +3,8 @@
 #include "Widgets/Input/SHyperlink.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
+#include "Monitor/GASAbilityBlockers.h"
+#include "GASAttachEditorStats.h"
 
 #if WITH_EDITOR
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -241,13 +243,23 @@ void SGASAbilitieTreeItem::HanldeTreeItemVis(bool IsShow)
 }
 
 
-TSharedRef<FGASAbilitieNode> FGASAbilitieNode::Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayAbilitySpec InAbilitySpecPtr)
+FGASAbilitieNode::~FGASAbilitieNode()
 {
-	return MakeShareable(new FGASAbilitieNode(InASComponent, InAbilitySpecPtr));
+	DEC_DWORD_STAT(STAT_GASAttachEditor_LiveAbilityNodes);
+	DEC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASAbilitieNode));
+}
+
+TSharedRef<FGASAbilitieNode> FGASAbilitieNode::Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayAbilitySpec InAbilitySpecPtr, FGASAbilityBlockers* InBlockers)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CreateNodes);
+
+	return MakeShareable(new FGASAbilitieNode(InASComponent, InAbilitySpecPtr, InBlockers));
 }
 
 TSharedRef<FGASAbilitieNode> FGASAbilitieNode::Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayAbilitySpec InAbilitySpecPtr, TWeakObjectPtr<UGameplayTask> InGameplayTask)
 {
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_CreateNodes);
+
 	return MakeShareable(new FGASAbilitieNode(InASComponent,InAbilitySpecPtr, InGameplayTask));
 }
 
@@ -362,7 +374,7 @@ FString FGASAbilitieNode::GetAbilityTriggersName() const
 
 FText FGASAbilitieNode::GetAbilitieHasTag() const
 {
-	return FText();
+	return BlockReasons;
 }
 
 FString FGASAbilitieNode::GetWidgetFile() const
@@ -417,7 +429,7 @@ FString FGASAbilitieNode::GetWidgetAssetData() const
 }
 
 
-FGASAbilitieNode::FGASAbilitieNode(TWeakObjectPtr<UAbilitySystemComponent> InASComponent,  FGameplayAbilitySpec InAbilitySpecPtr)
+FGASAbilitieNode::FGASAbilitieNode(TWeakObjectPtr<UAbilitySystemComponent> InASComponent,  FGameplayAbilitySpec InAbilitySpecPtr, FGASAbilityBlockers* InBlockers)
 	:FGASAbilitieNodeBase()
 {
 	AbilitySpecPtr = InAbilitySpecPtr;
@@ -425,8 +437,17 @@ FGASAbilitieNode::FGASAbilitieNode(TWeakObjectPtr<UAbilitySystemComponent> InASC
 
 	GAAbilitieNode = Node_Abilitie;
 
+	INC_DWORD_STAT(STAT_GASAttachEditor_LiveAbilityNodes);
+	INC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASAbilitieNode));
+
 	GetGAStateType();
 
+	FGASAbilityBlockReasons Reasons;
+	if (ScreenGAMode == Blocked && InBlockers && InBlockers->Explain(AbilitySpecPtr.Ability, Reasons))
+	{
+		BlockReasons = FText::FromString(InBlockers->Describe(Reasons));
+	}
+
 	CreateChild();
 }
 
@@ -437,6 +458,9 @@ FGASAbilitieNode::FGASAbilitieNode(TWeakObjectPtr<UAbilitySystemComponent> InASC
 	GameplayTask = InGameplayTask;
 
 	GAAbilitieNode = Node_Task;
+
+	INC_DWORD_STAT(STAT_GASAttachEditor_LiveAbilityNodes);
+	INC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASAbilitieNode));
 }
 
 void FGASAbilitieNode::CreateChild()
@@ -9,6 +9,7 @@
 
 
 class STableViewBase;
+class FGASAbilityBlockers;
 
 enum EGAAbilitieNode
 {
@@ -218,9 +219,11 @@ private:
 class FGASAbilitieNode : public FGASAbilitieNodeBase
 {
 public:
-	virtual ~FGASAbilitieNode(){};
+	virtual ~FGASAbilitieNode();
 
-	static TSharedRef<FGASAbilitieNode> Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayAbilitySpec InAbilitySpecPtr);
+	// InBlockers 不为空时，被阻止的技能会记录阻止它的标签
+	// With InBlockers, a blocked ability records the tags blocking it
+	static TSharedRef<FGASAbilitieNode> Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayAbilitySpec InAbilitySpecPtr, FGASAbilityBlockers* InBlockers = nullptr);
 
 	static TSharedRef<FGASAbilitieNode> Create(TWeakObjectPtr<UAbilitySystemComponent> InASComponent,  FGameplayAbilitySpec InAbilitySpecPtr, TWeakObjectPtr<UGameplayTask> InGameplayTask);
 
@@ -256,7 +259,7 @@ private:
 	/**
 	 * Construct this node from the given widget geometry, caching out any data that may be required for future visualization in the widget reflector
 	 */
-	explicit FGASAbilitieNode(TWeakObjectPtr<UAbilitySystemComponent> InASComponent,  FGameplayAbilitySpec InAbilitySpecPtr);
+	explicit FGASAbilitieNode(TWeakObjectPtr<UAbilitySystemComponent> InASComponent,  FGameplayAbilitySpec InAbilitySpecPtr, FGASAbilityBlockers* InBlockers);
 
 
 	explicit FGASAbilitieNode(TWeakObjectPtr<UAbilitySystemComponent> InASComponent, FGameplayAbilitySpec InAbilitySpecPtr, TWeakObjectPtr<UGameplayTask> InGameplayTask);
@@ -272,4 +275,8 @@ private:
 	TWeakObjectPtr<UAbilitySystemComponent> ASComponent;
 
 	TWeakObjectPtr<UGameplayTask> GameplayTask;
+
+	// 阻止技能的标签，显示在提示里
+	// Tags blocking the ability, shown in the tooltip
+	FText BlockReasons;
 };
\ No newline at end of file
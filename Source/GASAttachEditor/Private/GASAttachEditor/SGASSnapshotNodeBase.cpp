@@ -0,0 +1,261 @@
+#include "SGASSnapshotNodeBase.h"
+#include "Capture/GASCaptureTypes.h"
+#include "Capture/GASCaptureDiff.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Views/SExpanderArrow.h"
+#include "Widgets/SBoxPanel.h"
+#include "Engine/EngineTypes.h"
+#include "GASAttachEditorStats.h"
+
+#define LOCTEXT_NAMESPACE "SGASAttachEditor"
+
+namespace GASSnapshotNode
+{
+	const TCHAR* GetRoleString(uint8 InRole)
+	{
+		switch (static_cast<ENetRole>(InRole))
+		{
+		case ROLE_Authority:
+			return TEXT("Authority");
+		case ROLE_AutonomousProxy:
+			return TEXT("AutonomousProxy");
+		case ROLE_SimulatedProxy:
+			return TEXT("SimulatedProxy");
+		default:
+			return TEXT("None");
+		}
+	}
+
+	TSharedRef<FGASSnapshotNode> AddGroup(const TSharedRef<FGASSnapshotNode>& InParent, const TCHAR* InName, int32 InNum)
+	{
+		TSharedRef<FGASSnapshotNode> Group = FGASSnapshotNode::Create(InName, FString::Printf(TEXT("%d"), InNum));
+		InParent->AddChildNode(Group);
+		return Group;
+	}
+
+	FString GetEffectDeltaString(const FGASCaptureEffectDelta& InDelta)
+	{
+		return FString::Printf(TEXT("%d -> %d (Infinite %d -> %d, Stacks %d -> %d)"), InDelta.OldCount, InDelta.NewCount, InDelta.OldInfiniteCount, InDelta.NewInfiniteCount, InDelta.OldStacks, InDelta.NewStacks);
+	}
+}
+
+FGASSnapshotNode::~FGASSnapshotNode()
+{
+	DEC_DWORD_STAT(STAT_GASAttachEditor_LiveSnapshotNodes);
+	DEC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASSnapshotNode));
+}
+
+TSharedRef<FGASSnapshotNode> FGASSnapshotNode::Create(FString InLabel, FString InValue)
+{
+	return MakeShareable(new FGASSnapshotNode(MoveTemp(InLabel), MoveTemp(InValue)));
+}
+
+FGASSnapshotNode::FGASSnapshotNode(FString InLabel, FString InValue)
+	:Label(MoveTemp(InLabel))
+	,Value(MoveTemp(InValue))
+{
+	INC_DWORD_STAT(STAT_GASAttachEditor_LiveSnapshotNodes);
+	INC_MEMORY_STAT_BY(STAT_GASAttachEditor_NodeMemory, sizeof(FGASSnapshotNode));
+}
+
+void FGASSnapshotNode::BuildTree(const FGASCaptureWorldSnapshot& InSnapshot, TArray<TSharedRef<FGASSnapshotNodeBase>>& OutRoots)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_BuildSnapshotTree);
+
+	TArrayView<const FGASCaptureAscSnapshot> AbilitySystems = InSnapshot.GetAbilitySystems();
+	OutRoots.Reserve(OutRoots.Num() + AbilitySystems.Num());
+
+	for (const FGASCaptureAscSnapshot& AbilitySystem : AbilitySystems)
+	{
+		TSharedRef<FGASSnapshotNode> Root = Create(
+			FString::Printf(TEXT("%s [%s]"), *AbilitySystem.Actor.ToString(), *AbilitySystem.ActorClass.ToString()),
+			GASSnapshotNode::GetRoleString(AbilitySystem.Role));
+
+		TSharedRef<FGASSnapshotNode> Abilities = GASSnapshotNode::AddGroup(Root, TEXT("Abilities"), AbilitySystem.Abilities.Num());
+		for (const FGASCaptureAbility& Ability : AbilitySystem.Abilities)
+		{
+			Abilities->AddChildNode(Create(Ability.Ability.ToString(), FString::Printf(TEXT("Level %d%s"), Ability.Level, Ability.ActiveCount > 0 ? *FString::Printf(TEXT(", Active x%d"), Ability.ActiveCount) : TEXT(""))));
+		}
+
+		TSharedRef<FGASSnapshotNode> Attributes = GASSnapshotNode::AddGroup(Root, TEXT("Attributes"), AbilitySystem.Attributes.Num());
+		for (const FGASCaptureAttribute& Attribute : AbilitySystem.Attributes)
+		{
+			Attributes->AddChildNode(Create(Attribute.Attribute.ToString(), FString::Printf(TEXT("%s (Base %s)"), *LexToSanitizedString(Attribute.CurrentValue), *LexToSanitizedString(Attribute.BaseValue))));
+		}
+
+		TSharedRef<FGASSnapshotNode> Effects = GASSnapshotNode::AddGroup(Root, TEXT("GameplayEffects"), AbilitySystem.Effects.Num());
+		for (const FGASCaptureEffect& Effect : AbilitySystem.Effects)
+		{
+			const FString DurationString = Effect.Duration > 0.f ? FString::Printf(TEXT("Duration %.2f, Start %.2f"), Effect.Duration, Effect.StartWorldTime) : FString(TEXT("Infinite"));
+			Effects->AddChildNode(Create(Effect.Definition.ToString(), FString::Printf(TEXT("%s, Stacks %d, Level %s%s"), *DurationString, Effect.StackCount, *LexToSanitizedString(Effect.Level), Effect.bInhibited ? TEXT(", Inhibited") : TEXT(""))));
+		}
+
+		TSharedRef<FGASSnapshotNode> Tags = GASSnapshotNode::AddGroup(Root, TEXT("Tags"), AbilitySystem.Tags.Num());
+		for (const FGASCaptureTagCount& Tag : AbilitySystem.Tags)
+		{
+			Tags->AddChildNode(Create(Tag.Tag.ToString(), FString::Printf(TEXT("x%d"), Tag.Count)));
+		}
+
+		TSharedRef<FGASSnapshotNode> BlockedTags = GASSnapshotNode::AddGroup(Root, TEXT("Blocked Tags"), AbilitySystem.BlockedTags.Num());
+		for (const FName& Tag : AbilitySystem.BlockedTags)
+		{
+			BlockedTags->AddChildNode(Create(Tag.ToString()));
+		}
+
+		OutRoots.Add(Root);
+	}
+
+	OutRoots.Sort([](const TSharedRef<FGASSnapshotNodeBase>& A, const TSharedRef<FGASSnapshotNodeBase>& B)
+	{
+		return A->GetLabel() < B->GetLabel();
+	});
+}
+
+void FGASSnapshotNode::BuildDiffTree(const FGASCaptureSnapshotDiff& InDiff, TArray<TSharedRef<FGASSnapshotNodeBase>>& OutRoots)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_BuildSnapshotTree);
+
+	OutRoots.Add(Create(TEXT("Unchanged"), FString::Printf(TEXT("%d"), InDiff.NumUnchanged)));
+
+	if (InDiff.EffectTotals.Num() > 0)
+	{
+		TSharedRef<FGASSnapshotNode> Totals = Create(TEXT("GameplayEffects (all ASCs)"), FString::Printf(TEXT("%d"), InDiff.EffectTotals.Num()));
+		for (const FGASCaptureEffectDelta& Delta : InDiff.EffectTotals)
+		{
+			Totals->AddChildNode(Create(Delta.Definition.ToString(), GASSnapshotNode::GetEffectDeltaString(Delta)));
+		}
+		OutRoots.Add(Totals);
+	}
+
+	if (InDiff.AddedAbilitySystems.Num() > 0)
+	{
+		TSharedRef<FGASSnapshotNode> Added = Create(TEXT("Added ASCs"), FString::Printf(TEXT("%d"), InDiff.AddedAbilitySystems.Num()));
+		for (const FString& Name : InDiff.AddedAbilitySystems)
+		{
+			Added->AddChildNode(Create(Name));
+		}
+		OutRoots.Add(Added);
+	}
+
+	if (InDiff.RemovedAbilitySystems.Num() > 0)
+	{
+		TSharedRef<FGASSnapshotNode> Removed = Create(TEXT("Removed ASCs"), FString::Printf(TEXT("%d"), InDiff.RemovedAbilitySystems.Num()));
+		for (const FString& Name : InDiff.RemovedAbilitySystems)
+		{
+			Removed->AddChildNode(Create(Name));
+		}
+		OutRoots.Add(Removed);
+	}
+
+	for (const FGASCaptureAscDiff& AscDiff : InDiff.Changed)
+	{
+		TSharedRef<FGASSnapshotNode> Root = Create(
+			FString::Printf(TEXT("%s [%s]"), *AscDiff.Actor.ToString(), *AscDiff.ActorClass.ToString()),
+			AscDiff.OtherActor.IsNone() ? FString() : FString::Printf(TEXT("Matched with %s"), *AscDiff.OtherActor.ToString()));
+
+		if (AscDiff.AddedAbilities.Num() + AscDiff.RemovedAbilities.Num() > 0)
+		{
+			TSharedRef<FGASSnapshotNode> Abilities = GASSnapshotNode::AddGroup(Root, TEXT("Abilities"), AscDiff.AddedAbilities.Num() + AscDiff.RemovedAbilities.Num());
+			for (const FName& Ability : AscDiff.AddedAbilities)
+			{
+				Abilities->AddChildNode(Create(Ability.ToString(), TEXT("Added")));
+			}
+			for (const FName& Ability : AscDiff.RemovedAbilities)
+			{
+				Abilities->AddChildNode(Create(Ability.ToString(), TEXT("Removed")));
+			}
+		}
+
+		if (AscDiff.Effects.Num() > 0)
+		{
+			TSharedRef<FGASSnapshotNode> Effects = GASSnapshotNode::AddGroup(Root, TEXT("GameplayEffects"), AscDiff.Effects.Num());
+			for (const FGASCaptureEffectDelta& Delta : AscDiff.Effects)
+			{
+				Effects->AddChildNode(Create(Delta.Definition.ToString(), GASSnapshotNode::GetEffectDeltaString(Delta)));
+			}
+		}
+
+		if (AscDiff.Attributes.Num() > 0)
+		{
+			TSharedRef<FGASSnapshotNode> Attributes = GASSnapshotNode::AddGroup(Root, TEXT("Attributes"), AscDiff.Attributes.Num());
+			for (const FGASCaptureAttributeDelta& Delta : AscDiff.Attributes)
+			{
+				Attributes->AddChildNode(Create(Delta.Attribute.ToString(), FString::Printf(TEXT("%s -> %s (Base %s -> %s)"),
+					*LexToSanitizedString(Delta.OldValue), *LexToSanitizedString(Delta.NewValue), *LexToSanitizedString(Delta.OldBaseValue), *LexToSanitizedString(Delta.NewBaseValue))));
+			}
+		}
+
+		if (AscDiff.Tags.Num() > 0)
+		{
+			TSharedRef<FGASSnapshotNode> Tags = GASSnapshotNode::AddGroup(Root, TEXT("Tags"), AscDiff.Tags.Num());
+			for (const FGASCaptureCountDelta& Delta : AscDiff.Tags)
+			{
+				Tags->AddChildNode(Create(Delta.Name.ToString(), FString::Printf(TEXT("x%d -> x%d"), Delta.OldCount, Delta.NewCount)));
+			}
+		}
+
+		if (AscDiff.AddedBlockedTags.Num() + AscDiff.RemovedBlockedTags.Num() > 0)
+		{
+			TSharedRef<FGASSnapshotNode> BlockedTags = GASSnapshotNode::AddGroup(Root, TEXT("Blocked Tags"), AscDiff.AddedBlockedTags.Num() + AscDiff.RemovedBlockedTags.Num());
+			for (const FName& Tag : AscDiff.AddedBlockedTags)
+			{
+				BlockedTags->AddChildNode(Create(Tag.ToString(), TEXT("Added")));
+			}
+			for (const FName& Tag : AscDiff.RemovedBlockedTags)
+			{
+				BlockedTags->AddChildNode(Create(Tag.ToString(), TEXT("Removed")));
+			}
+		}
+
+		OutRoots.Add(Root);
+	}
+}
+
+void SGASSnapshotTreeItem::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+{
+	this->WidgetInfo = InArgs._WidgetInfoToVisualize;
+	this->SetPadding(0);
+
+	check(WidgetInfo.IsValid());
+
+	SMultiColumnTableRow< TSharedRef<FGASSnapshotNodeBase> >::Construct(SMultiColumnTableRow< TSharedRef<FGASSnapshotNodeBase> >::FArguments().Padding(0), InOwnerTableView);
+}
+
+TSharedRef<SWidget> SGASSnapshotTreeItem::GenerateWidgetForColumn(const FName& ColumnName)
+{
+	if (NAME_SnapshotName == ColumnName)
+	{
+		return SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SExpanderArrow, SharedThis(this))
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(2.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(WidgetInfo->GetLabel()))
+			];
+	}
+	else if (NAME_SnapshotValue == ColumnName)
+	{
+		return SNew(SBox)
+			.HAlign(HAlign_Left)
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(2.0f, 0.0f))
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(WidgetInfo->GetValue()))
+			];
+	}
+
+	return SNullWidget::NullWidget;
+}
+
+#undef LOCTEXT_NAMESPACE
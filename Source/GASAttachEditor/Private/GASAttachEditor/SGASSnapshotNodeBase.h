@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/Views/STableViewBase.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/SListView.h"
+
+struct FGASCaptureWorldSnapshot;
+struct FGASCaptureSnapshotDiff;
+
+static FName NAME_SnapshotName(TEXT("SnapshotName"));
+static FName NAME_SnapshotValue(TEXT("SnapshotValue"));
+
+// 冻结帧快照树的节点，在后台线程上创建，只保存已经格式化好的文本
+// Node of the freeze frame tree; created on a background thread and only holds preformatted text
+class FGASSnapshotNodeBase
+{
+public:
+
+	virtual ~FGASSnapshotNodeBase(){};
+
+public:
+
+	virtual const FString& GetLabel() const = 0;
+
+	virtual const FString& GetValue() const = 0;
+
+	const TArray<TSharedRef<FGASSnapshotNodeBase>>& GetChildNodes() const { return ChildNodes; }
+
+	void AddChildNode(TSharedRef<FGASSnapshotNodeBase> InChildNode) { ChildNodes.Add(MoveTemp(InChildNode)); }
+
+protected:
+
+	FGASSnapshotNodeBase(){};
+
+	TArray<TSharedRef<FGASSnapshotNodeBase>> ChildNodes;
+};
+
+class SGASSnapshotTreeItem : public SMultiColumnTableRow<TSharedRef<FGASSnapshotNodeBase>>
+{
+public:
+
+	SLATE_BEGIN_ARGS(SGASSnapshotTreeItem)
+		: _WidgetInfoToVisualize()
+	{}
+	SLATE_ARGUMENT(TSharedPtr<FGASSnapshotNodeBase>, WidgetInfoToVisualize)
+		SLATE_END_ARGS()
+
+public:
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView);
+
+public:
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
+
+protected:
+	/** 关于我们正在可视化的小部件的信息 */
+	/** Information about the widget we are visualizing */
+	TSharedPtr<FGASSnapshotNodeBase> WidgetInfo;
+};
+
+class FGASSnapshotNode : public FGASSnapshotNodeBase
+{
+public:
+	virtual ~FGASSnapshotNode() override;
+
+	static TSharedRef<FGASSnapshotNode> Create(FString InLabel, FString InValue = FString());
+
+	// 把快照整理成树，可以在任意线程调用
+	// Builds the tree of a snapshot; safe to call from any thread
+	static void BuildTree(const FGASCaptureWorldSnapshot& InSnapshot, TArray<TSharedRef<FGASSnapshotNodeBase>>& OutRoots);
+
+	// 把两个快照的差异整理成树
+	// Builds the tree of the differences between two snapshots
+	static void BuildDiffTree(const FGASCaptureSnapshotDiff& InDiff, TArray<TSharedRef<FGASSnapshotNodeBase>>& OutRoots);
+
+public:
+
+	virtual const FString& GetLabel() const override { return Label; }
+
+	virtual const FString& GetValue() const override { return Value; }
+
+private:
+
+	explicit FGASSnapshotNode(FString InLabel, FString InValue);
+
+protected:
+
+	FString Label;
+
+	FString Value;
+};
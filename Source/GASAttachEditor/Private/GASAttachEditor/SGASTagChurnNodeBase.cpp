@@ -0,0 +1,174 @@
+#include "SGASTagChurnNodeBase.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/Actor.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+
+#define LOCTEXT_NAMESPACE "SGASAttachEditor"
+
+FGASTagChurnNode::FGASTagChurnNode()
+	:Adds(0)
+	,Removes(0)
+	,Total(0)
+	,Peak(0)
+	,Threshold(0)
+	,bStorm(false)
+{
+	FMemory::Memzero(Events);
+}
+
+TSharedRef<FGASTagChurnNode> FGASTagChurnNode::Create(const FGameplayTag& InTag, const FGASTagChurnCounters& InCounters, int32 InCurrentBucket, int32 InThreshold)
+{
+	TSharedRef<FGASTagChurnNode> Node = MakeShareable(new FGASTagChurnNode());
+	Node->Tag = InTag;
+	Node->TagText = FText::FromName(InTag.GetTagName());
+	Node->Threshold = InThreshold;
+	Node->bStorm = InCounters.bStorm;
+
+	for (int32 Age = 1; Age <= NumSeconds; ++Age)
+	{
+		const int32 Bucket = (InCurrentBucket - Age + FGASTagChurnCounters::NumBuckets) % FGASTagChurnCounters::NumBuckets;
+		Node->Adds += InCounters.Adds[Bucket];
+		Node->Removes += InCounters.Removes[Bucket];
+		Node->Events[NumSeconds - Age] = InCounters.GetEvents(InCurrentBucket, Age);
+	}
+
+	Node->Total = Node->Adds + Node->Removes;
+	Node->Peak = InCounters.GetPeak(InCurrentBucket);
+
+	if (const UAbilitySystemComponent* ASC = InCounters.LastAbilitySystem.Get())
+	{
+		const AActor* Actor = ASC->GetAvatarActor_Direct() ? ASC->GetAvatarActor_Direct() : ASC->GetOwnerActor();
+		Node->ActorText = FText::FromString(GetNameSafe(Actor));
+	}
+
+	return Node;
+}
+
+void FGASTagChurnNode::Sort(TArray<TSharedPtr<FGASTagChurnNode>>& InOutNodes)
+{
+	InOutNodes.Sort([](const TSharedPtr<FGASTagChurnNode>& A, const TSharedPtr<FGASTagChurnNode>& B)
+	{
+		if (A->Total != B->Total)
+		{
+			return A->Total > B->Total;
+		}
+		return A->Tag.GetTagName().LexicalLess(B->Tag.GetTagName());
+	});
+}
+
+void SGASTagChurnItem::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+{
+	this->WidgetInfo = InArgs._WidgetInfoToVisualize;
+
+	SMultiColumnTableRow<TSharedPtr<FGASTagChurnNode>>::Construct(SMultiColumnTableRow<TSharedPtr<FGASTagChurnNode>>::FArguments().Padding(1.f), InOwnerTableView);
+}
+
+TSharedRef<SWidget> SGASTagChurnItem::GenerateWidgetForColumn(const FName& ColumnName)
+{
+	const FSlateColor StormColor = WidgetInfo->bStorm ? FSlateColor(FLinearColor::Red) : FSlateColor::UseForeground();
+
+	if (NAME_TagChurnTag == ColumnName)
+	{
+		return SNew(SBox)
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(2.0f, 0.0f))
+			[
+				SNew(STextBlock)
+				.Text(WidgetInfo->TagText)
+				.ColorAndOpacity(StormColor)
+				.ToolTipText(WidgetInfo->bStorm
+					//? LOCTEXT("TagStormToolTip", "上一秒的增删次数超过了 GASAttachEditor.TagChurn.StormThreshold")
+					? LOCTEXT("TagStormToolTip", "Changed more often than GASAttachEditor.TagChurn.StormThreshold in the last second")
+					: FText::GetEmpty())
+			];
+	}
+	else if (NAME_TagChurnHeat == ColumnName)
+	{
+		return CreateHeatCells();
+	}
+	else if (NAME_TagChurnLastSecond == ColumnName)
+	{
+		return SNew(SBox)
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(2.0f, 0.0f))
+			[
+				SNew(STextBlock)
+				.Text(FText::AsNumber(WidgetInfo->Events[FGASTagChurnNode::NumSeconds - 1]))
+				.ColorAndOpacity(StormColor)
+			];
+	}
+	else if (NAME_TagChurnPeak == ColumnName)
+	{
+		return SNew(SBox)
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(2.0f, 0.0f))
+			[
+				SNew(STextBlock)
+				.Text(FText::AsNumber(WidgetInfo->Peak))
+			];
+	}
+	else if (NAME_TagChurnTotal == ColumnName)
+	{
+		return SNew(SBox)
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(2.0f, 0.0f))
+			[
+				SNew(STextBlock)
+				.Text(FText::Format(LOCTEXT("TagChurnTotal", "{0} (+{1} / -{2})"), FText::AsNumber(WidgetInfo->Total), FText::AsNumber(WidgetInfo->Adds), FText::AsNumber(WidgetInfo->Removes)))
+			];
+	}
+	else if (NAME_TagChurnActor == ColumnName)
+	{
+		return SNew(SBox)
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(2.0f, 0.0f))
+			[
+				SNew(STextBlock)
+				.Text(WidgetInfo->ActorText)
+			];
+	}
+
+	return SNullWidget::NullWidget;
+}
+
+TSharedRef<SWidget> SGASTagChurnItem::CreateHeatCells() const
+{
+	TSharedRef<SHorizontalBox> Cells = SNew(SHorizontalBox);
+
+	const FSlateBrush* Brush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const float Threshold = FMath::Max(1, WidgetInfo->Threshold);
+
+	for (int32 Second = 0; Second < FGASTagChurnNode::NumSeconds; ++Second)
+	{
+		const int32 Events = WidgetInfo->Events[Second];
+		const float Heat = FMath::Clamp(Events / Threshold, 0.f, 1.f);
+
+		FLinearColor Color = FLinearColor::LerpUsingHSV(FLinearColor(0.1f, 0.1f, 0.1f), FLinearColor(1.f, 0.6f, 0.f), Heat);
+		if (Events > Threshold)
+		{
+			Color = FLinearColor::Red;
+		}
+
+		Cells->AddSlot()
+			.AutoWidth()
+			.Padding(1.f, 2.f)
+			[
+				SNew(SBox)
+				.WidthOverride(10.f)
+				.ToolTipText(FText::Format(LOCTEXT("TagChurnCellToolTip", "{0}s ago: {1}"), FText::AsNumber(FGASTagChurnNode::NumSeconds - Second), FText::AsNumber(Events)))
+				[
+					SNew(SImage)
+					.Image(Brush)
+					.ColorAndOpacity(Color)
+				]
+			];
+	}
+
+	return Cells;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/Views/STableViewBase.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/SListView.h"
+#include "Monitor/GASTagChurn.h"
+
+static FName NAME_TagChurnTag(TEXT("TagChurnTag"));
+static FName NAME_TagChurnHeat(TEXT("TagChurnHeat"));
+static FName NAME_TagChurnLastSecond(TEXT("TagChurnLastSecond"));
+static FName NAME_TagChurnPeak(TEXT("TagChurnPeak"));
+static FName NAME_TagChurnTotal(TEXT("TagChurnTotal"));
+static FName NAME_TagChurnActor(TEXT("TagChurnActor"));
+
+// 标签抖动热力图的一行，每秒从统计表复制一次
+// One row of the tag churn heatmap, copied from the counters once per second
+class FGASTagChurnNode
+{
+public:
+
+	// 已经结束的秒数，从旧到新
+	// Seconds that have ended, oldest first
+	static constexpr int32 NumSeconds = FGASTagChurnCounters::NumBuckets - 1;
+
+	static TSharedRef<FGASTagChurnNode> Create(const FGameplayTag& InTag, const FGASTagChurnCounters& InCounters, int32 InCurrentBucket, int32 InThreshold);
+
+	// 总数降序，相同时按名字
+	// Total descending, then by name
+	static void Sort(TArray<TSharedPtr<FGASTagChurnNode>>& InOutNodes);
+
+public:
+
+	FGameplayTag Tag;
+
+	FText TagText;
+
+	FText ActorText;
+
+	int32 Events[NumSeconds];
+
+	int32 Adds;
+
+	int32 Removes;
+
+	int32 Total;
+
+	int32 Peak;
+
+	int32 Threshold;
+
+	bool bStorm;
+
+private:
+
+	FGASTagChurnNode();
+};
+
+class SGASTagChurnItem : public SMultiColumnTableRow<TSharedPtr<FGASTagChurnNode>>
+{
+public:
+
+	SLATE_BEGIN_ARGS(SGASTagChurnItem)
+		: _WidgetInfoToVisualize()
+	{}
+	SLATE_ARGUMENT(TSharedPtr<FGASTagChurnNode>, WidgetInfoToVisualize)
+		SLATE_END_ARGS()
+
+public:
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView);
+
+public:
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
+
+protected:
+
+	// 每秒一个色块，达到阈值时为红色
+	// One cell per second, red once the threshold is reached
+	TSharedRef<SWidget> CreateHeatCells() const;
+
+	/** 关于我们正在可视化的小部件的信息 */
+	/** Information about the widget we are visualizing */
+	TSharedPtr<FGASTagChurnNode> WidgetInfo;
+};
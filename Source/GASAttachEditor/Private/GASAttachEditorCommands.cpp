@@ -1,15 +1,16 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "GASAttachEditorCommands.h"
-
-#define LOCTEXT_NAMESPACE "FGASAttachEditorModule"
-
-void FGASAttachEditorCommands::RegisterCommands()
-{
-	UI_COMMAND(ShowGASAttachEditorViewer, /*"查看角色携带GA"*/"GAS Debug", "Open the Debug Gameplay Ability System tab", EUserInterfaceActionType::Check, FInputChord());
-#if WITH_EDITOR
-	UI_COMMAND(ShowGASTagLookAssetViewer, /*"查看可Tag调用的GA"*/"View CallByTag Abilities", "Open the GASTagLookAsset tab", EUserInterfaceActionType::Check, FInputChord());
-#endif
-}
-
-#undef LOCTEXT_NAMESPACE
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GASAttachEditorCommands.h"
+
+#define LOCTEXT_NAMESPACE "FGASAttachEditorModule"
+
+void FGASAttachEditorCommands::RegisterCommands()
+{
+	UI_COMMAND(ShowGASAttachEditorViewer, /*"查看角色携带GA"*/"GAS Debug", "Open the Debug Gameplay Ability System tab", EUserInterfaceActionType::Check, FInputChord());
+	UI_COMMAND(TakeFreezeFrame, /*"冻结帧快照"*/"Freeze Frame", "Snapshot every ASC of the world shown in the Debug Gameplay Ability System tab", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control, EKeys::End));
+#if WITH_EDITOR
+	UI_COMMAND(ShowGASTagLookAssetViewer, /*"查看可Tag调用的GA"*/"View CallByTag Abilities", "Open the GASTagLookAsset tab", EUserInterfaceActionType::Check, FInputChord());
+#endif
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,83 @@
+#include "GASAttachEditorStats.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_STAT(STAT_GASAttachEditor_UpdateListItems);
+DEFINE_STAT(STAT_GASAttachEditor_UpDataPlayerComp);
+DEFINE_STAT(STAT_GASAttachEditor_GetDebugTarget);
+DEFINE_STAT(STAT_GASAttachEditor_CreateNodes);
+DEFINE_STAT(STAT_GASAttachEditor_RequestSort);
+DEFINE_STAT(STAT_GASAttachEditor_RebuildTagsView);
+DEFINE_STAT(STAT_GASAttachEditor_SetGraphRootIdentifiers);
+DEFINE_STAT(STAT_GASAttachEditor_MonitorTick);
+DEFINE_STAT(STAT_GASAttachEditor_MonitorEvents);
+DEFINE_STAT(STAT_GASAttachEditor_CaptureSample);
+DEFINE_STAT(STAT_GASAttachEditor_CaptureRecord);
+DEFINE_STAT(STAT_GASAttachEditor_CaptureWrite);
+DEFINE_STAT(STAT_GASAttachEditor_FreezeFrame);
+DEFINE_STAT(STAT_GASAttachEditor_BuildSnapshotTree);
+DEFINE_STAT(STAT_GASAttachEditor_CaptureQuery);
+DEFINE_STAT(STAT_GASAttachEditor_SnapshotDiff);
+DEFINE_STAT(STAT_GASAttachEditor_CaptureExport);
+DEFINE_STAT(STAT_GASAttachEditor_PanelExport);
+DEFINE_STAT(STAT_GASAttachEditor_TagSourceIndex);
+DEFINE_STAT(STAT_GASAttachEditor_TagChurn);
+DEFINE_STAT(STAT_GASAttachEditor_TagHolderIndex);
+DEFINE_STAT(STAT_GASAttachEditor_AbilityBlockers);
+DEFINE_STAT(STAT_GASAttachEditor_AbilityMatrix);
+DEFINE_STAT(STAT_GASAttachEditor_TagLeaks);
+DEFINE_STAT(STAT_GASAttachEditor_TagUsageScan);
+DEFINE_STAT(STAT_GASAttachEditor_QueryTagUsage);
+
+DEFINE_STAT(STAT_GASAttachEditor_LiveAbilityNodes);
+DEFINE_STAT(STAT_GASAttachEditor_LiveAttributeNodes);
+DEFINE_STAT(STAT_GASAttachEditor_LiveEffectNodes);
+DEFINE_STAT(STAT_GASAttachEditor_LiveTagItems);
+DEFINE_STAT(STAT_GASAttachEditor_LiveSnapshotNodes);
+DEFINE_STAT(STAT_GASAttachEditor_NodeMemory);
+
+uint64 FGASAttachEditorFrameCost::CurrentFrame = 0;
+uint64 FGASAttachEditorFrameCost::CurrentFrameCycles = 0;
+double FGASAttachEditorFrameCost::LastFrameMs = 0.0;
+
+int32 FGASAttachEditorCostScope::ScopeDepth = 0;
+
+void FGASAttachEditorFrameCost::AddCycles(uint64 InCycles)
+{
+	if (CurrentFrame != GFrameCounter)
+	{
+		// 上一帧若与当前帧不连续，说明中间的帧没有开销
+		// If the previous frame is not adjacent to this one, the frames in between cost nothing
+		LastFrameMs = CurrentFrame + 1 == GFrameCounter ? FPlatformTime::ToMilliseconds64(CurrentFrameCycles) : 0.0;
+		CurrentFrame = GFrameCounter;
+		CurrentFrameCycles = 0;
+	}
+
+	CurrentFrameCycles += InCycles;
+}
+
+double FGASAttachEditorFrameCost::GetLastFrameMs()
+{
+	if (CurrentFrame == GFrameCounter)
+	{
+		return LastFrameMs;
+	}
+
+	return CurrentFrame + 1 == GFrameCounter ? FPlatformTime::ToMilliseconds64(CurrentFrameCycles) : 0.0;
+}
+
+FGASAttachEditorCostScope::FGASAttachEditorCostScope()
+	:StartCycles(0)
+{
+	if (IsInGameThread() && ScopeDepth++ == 0)
+	{
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+FGASAttachEditorCostScope::~FGASAttachEditorCostScope()
+{
+	if (IsInGameThread() && --ScopeDepth == 0)
+	{
+		FGASAttachEditorFrameCost::AddCycles(FPlatformTime::Cycles64() - StartCycles);
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// 插件自身的性能统计，使用 "stat GASAttachEditor" 查看
+// The plugin's own cost, shown with "stat GASAttachEditor"
+DECLARE_STATS_GROUP(TEXT("GASAttachEditor"), STATGROUP_GASAttachEditor, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateGameplayCueListItems"), STAT_GASAttachEditor_UpdateListItems, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpDataPlayerComp"), STAT_GASAttachEditor_UpDataPlayerComp, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetDebugTarget"), STAT_GASAttachEditor_GetDebugTarget, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Nodes"), STAT_GASAttachEditor_CreateNodes, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RequestSort"), STAT_GASAttachEditor_RequestSort, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rebuild Tags View"), STAT_GASAttachEditor_RebuildTagsView, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SetGraphRootIdentifiers"), STAT_GASAttachEditor_SetGraphRootIdentifiers, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Monitor Tick"), STAT_GASAttachEditor_MonitorTick, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Monitor Events"), STAT_GASAttachEditor_MonitorEvents, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Sample"), STAT_GASAttachEditor_CaptureSample, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Record"), STAT_GASAttachEditor_CaptureRecord, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Write"), STAT_GASAttachEditor_CaptureWrite, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Freeze Frame"), STAT_GASAttachEditor_FreezeFrame, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Snapshot Tree"), STAT_GASAttachEditor_BuildSnapshotTree, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Query"), STAT_GASAttachEditor_CaptureQuery, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snapshot Diff"), STAT_GASAttachEditor_SnapshotDiff, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Export"), STAT_GASAttachEditor_CaptureExport, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Panel Export"), STAT_GASAttachEditor_PanelExport, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Tag Source Index"), STAT_GASAttachEditor_TagSourceIndex, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tag Churn"), STAT_GASAttachEditor_TagChurn, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tag Holder Index"), STAT_GASAttachEditor_TagHolderIndex, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Explain Blocked Abilities"), STAT_GASAttachEditor_AbilityBlockers, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ability Matrix"), STAT_GASAttachEditor_AbilityMatrix, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tag Leak Detector"), STAT_GASAttachEditor_TagLeaks, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scan Tag Usage"), STAT_GASAttachEditor_TagUsageScan, STATGROUP_GASAttachEditor, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Query Tag Usage Index"), STAT_GASAttachEditor_QueryTagUsage, STATGROUP_GASAttachEditor, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Ability Nodes"), STAT_GASAttachEditor_LiveAbilityNodes, STATGROUP_GASAttachEditor, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Attribute Nodes"), STAT_GASAttachEditor_LiveAttributeNodes, STATGROUP_GASAttachEditor, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live GameplayEffect Nodes"), STAT_GASAttachEditor_LiveEffectNodes, STATGROUP_GASAttachEditor, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Tag Items"), STAT_GASAttachEditor_LiveTagItems, STATGROUP_GASAttachEditor, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Snapshot Nodes"), STAT_GASAttachEditor_LiveSnapshotNodes, STATGROUP_GASAttachEditor, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Node Memory"), STAT_GASAttachEditor_NodeMemory, STATGROUP_GASAttachEditor, );
+
+// 统计插件每帧在游戏线程上的总耗时，用于面板上的开销显示
+// Sums the plugin's game thread time per frame for the cost overlay in the panel header
+class FGASAttachEditorFrameCost
+{
+public:
+
+	// 累加本帧耗时
+	// Add time spent during the current frame
+	static void AddCycles(uint64 InCycles);
+
+	// 上一个完整帧的耗时(毫秒)
+	// Time spent during the last complete frame, in milliseconds
+	static double GetLastFrameMs();
+
+private:
+
+	static uint64 CurrentFrame;
+
+	static uint64 CurrentFrameCycles;
+
+	static double LastFrameMs;
+};
+
+// 只计算最外层的作用域，避免嵌套的计数器重复计时
+// Only the outermost scope is timed so nested counters are not counted twice
+class FGASAttachEditorCostScope
+{
+public:
+	FGASAttachEditorCostScope();
+	~FGASAttachEditorCostScope();
+
+private:
+	uint64 StartCycles;
+
+	static int32 ScopeDepth;
+};
+
+#define GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	FGASAttachEditorCostScope ANONYMOUS_VARIABLE(GASAttachEditorCost)
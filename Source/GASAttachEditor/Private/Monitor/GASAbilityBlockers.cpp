@@ -0,0 +1,280 @@
+#include "Monitor/GASAbilityBlockers.h"
+#include "Monitor/GASTagSourceIndex.h"
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "GASAttachEditorStats.h"
+
+TMap<FGameplayTag, int32> FGASAbilityBlockers::TagIndices;
+TArray<FGameplayTag> FGASAbilityBlockers::IndexedTags;
+TMap<TWeakObjectPtr<const UClass>, FGASAbilityBlockers::FAbilityBits> FGASAbilityBlockers::AbilityBits;
+
+void FGASAbilityBlockers::FTagBits::Set(int32 InIndex)
+{
+	const int32 Word = InIndex >> 6;
+	if (Words.Num() <= Word)
+	{
+		Words.SetNumZeroed(Word + 1);
+	}
+	Words[Word] |= 1ull << (InIndex & 63);
+}
+
+bool FGASAbilityBlockers::FTagBits::Combine(const FTagBits& A, const FTagBits& B, bool bInvertB)
+{
+	const int32 NumWords = bInvertB ? A.Words.Num() : FMath::Min(A.Words.Num(), B.Words.Num());
+	Words.SetNumUninitialized(NumWords);
+
+	uint64 Any = 0;
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		const uint64 BWord = B.Words.IsValidIndex(Word) ? B.Words[Word] : 0;
+		Words[Word] = A.Words[Word] & (bInvertB ? ~BWord : BWord);
+		Any |= Words[Word];
+	}
+
+	return Any != 0;
+}
+
+bool FGASAbilityBlockers::FTagBits::Intersects(const FTagBits& Other) const
+{
+	const int32 NumWords = FMath::Min(Words.Num(), Other.Words.Num());
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		if (Words[Word] & Other.Words[Word])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FGASAbilityBlockers::FTagBits::ToContainer(FGameplayTagContainer& OutTags) const
+{
+	for (int32 Word = 0; Word < Words.Num(); ++Word)
+	{
+		uint64 Bits = Words[Word];
+		while (Bits)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+			OutTags.AddTag(IndexedTags[(Word << 6) + Bit]);
+			Bits &= Bits - 1;
+		}
+	}
+}
+
+FGASAbilityBlockers::FGASAbilityBlockers(const UAbilitySystemComponent* InASC)
+	:AbilitySystem(InASC)
+	,NumIndicesBuilt(0)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_AbilityBlockers);
+
+	// 先给ASC上所有技能分配下标，避免解释时再重建ASC的位集
+	// Index every ability of the ASC first so its bitsets need not be rebuilt while explaining
+	if (InASC)
+	{
+		for (const FGameplayAbilitySpec& AbilitySpec : InASC->GetActivatableAbilities())
+		{
+			if (AbilitySpec.Ability)
+			{
+				FindOrAddAbilityBits(AbilitySpec.Ability);
+			}
+		}
+	}
+
+	BuildAbilitySystemBits();
+}
+
+void FGASAbilityBlockers::Reset()
+{
+	TagIndices.Reset();
+	IndexedTags.Reset();
+	AbilityBits.Reset();
+}
+
+void FGASAbilityBlockers::BuildAbilitySystemBits()
+{
+	OwnedTags.Words.Reset();
+	BlockedAbilityTags.Words.Reset();
+	NumIndicesBuilt = IndexedTags.Num();
+
+	const UAbilitySystemComponent* ASC = AbilitySystem.Get();
+	if (!ASC)
+	{
+		return;
+	}
+
+	// ASC的标签计数包括父标签，拥有子标签即满足父标签
+	// The ASC's tag counts include parents, so owning a child satisfies its parent
+	FGameplayTagContainer Owned;
+	ASC->GetOwnedGameplayTags(Owned);
+	for (const FGameplayTag& Tag : Owned.GetGameplayTagParents())
+	{
+		if (const int32* Index = TagIndices.Find(Tag))
+		{
+			OwnedTags.Set(*Index);
+		}
+	}
+
+	// 只关心某个技能的 AbilityTags 用到的标签，其余的不会命中
+	// Only tags used by some ability's AbilityTags matter; the others cannot match
+	FGameplayTagContainer Blocked;
+	ASC->GetBlockedAbilityTags(Blocked);
+	for (const FGameplayTag& Tag : Blocked)
+	{
+		if (const int32* Index = TagIndices.Find(Tag))
+		{
+			BlockedAbilityTags.Set(*Index);
+		}
+	}
+}
+
+bool FGASAbilityBlockers::Explain(const UGameplayAbility* InAbility, FGASAbilityBlockReasons& OutReasons)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_AbilityBlockers);
+
+	OutReasons = FGASAbilityBlockReasons();
+	if (!InAbility || !AbilitySystem.IsValid())
+	{
+		return false;
+	}
+
+	const FAbilityBits& Bits = FindOrAddAbilityBits(InAbility);
+	if (NumIndicesBuilt != IndexedTags.Num())
+	{
+		BuildAbilitySystemBits();
+	}
+
+	FTagBits Result;
+	if (Result.Combine(Bits.BlockedTags, OwnedTags, false))
+	{
+		Result.ToContainer(OutReasons.OwnedBlockedTags);
+	}
+	if (Result.Combine(Bits.RequiredTags, OwnedTags, true))
+	{
+		Result.ToContainer(OutReasons.MissingRequiredTags);
+	}
+	if (Result.Combine(Bits.AbilityTags, BlockedAbilityTags, false))
+	{
+		Result.ToContainer(OutReasons.BlockedAbilityTags);
+	}
+
+	return OutReasons.IsBlocked();
+}
+
+FString FGASAbilityBlockers::Describe(const FGASAbilityBlockReasons& InReasons) const
+{
+	FString Description;
+
+	if (!InReasons.OwnedBlockedTags.IsEmpty())
+	{
+		Description += FString::Printf(TEXT("Owned ActivationBlockedTags: %s"), *InReasons.OwnedBlockedTags.ToStringSimple());
+	}
+
+	if (!InReasons.MissingRequiredTags.IsEmpty())
+	{
+		Description += Description.IsEmpty() ? TEXT("") : TEXT("\n");
+		Description += FString::Printf(TEXT("Missing ActivationRequiredTags: %s"), *InReasons.MissingRequiredTags.ToStringSimple());
+	}
+
+	if (!InReasons.BlockedAbilityTags.IsEmpty())
+	{
+		const UAbilitySystemComponent* ASC = AbilitySystem.Get();
+		TSharedPtr<FGASTagSourceIndex> SourceIndex = FGASTagSourceIndex::FindOrCreate(ASC);
+
+		for (const FGameplayTag& Tag : InReasons.BlockedAbilityTags)
+		{
+			Description += Description.IsEmpty() ? TEXT("") : TEXT("\n");
+			Description += FString::Printf(TEXT("BlockAbilitiesWithTag: %s"), *Tag.ToString());
+
+			const TArray<FGASTagSource>* Sources = SourceIndex.IsValid() ? SourceIndex->FindSources(ASC, Tag, true) : nullptr;
+			if (Sources && Sources->Num() > 0)
+			{
+				FString Names;
+				for (const FGASTagSource& Source : *Sources)
+				{
+					Names += Names.IsEmpty() ? Source.Name.ToString() : TEXT(", ") + Source.Name.ToString();
+				}
+				Description += FString::Printf(TEXT(" (from %s)"), *Names);
+			}
+		}
+	}
+
+	return Description;
+}
+
+const FGASAbilityBlockers::FAbilityBits& FGASAbilityBlockers::FindOrAddAbilityBits(const UGameplayAbility* InAbility)
+{
+	const TWeakObjectPtr<const UClass> Class(InAbility->GetClass());
+	if (const FAbilityBits* Found = AbilityBits.Find(Class))
+	{
+		return *Found;
+	}
+
+	// 重新编译过的蓝图类已经失效，顺便清理
+	// Classes of recompiled blueprints are stale; drop them on the way
+	for (auto It = AbilityBits.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FAbilityBits& Bits = AbilityBits.Add(Class);
+
+	if (const FGameplayTagContainer* Tags = GetAbilityTagContainer(InAbility, TEXT("ActivationBlockedTags")))
+	{
+		AddTags(*Tags, Bits.BlockedTags);
+	}
+	if (const FGameplayTagContainer* Tags = GetAbilityTagContainer(InAbility, TEXT("ActivationRequiredTags")))
+	{
+		AddTags(*Tags, Bits.RequiredTags);
+	}
+	if (const FGameplayTagContainer* Tags = GetAbilityTagContainer(InAbility, TEXT("ActivationOwnedTags")))
+	{
+		AddTags(Tags->GetGameplayTagParents(), Bits.OwnedTags);
+	}
+	if (const FGameplayTagContainer* Tags = GetAbilityTagContainer(InAbility, TEXT("CancelAbilitiesWithTag")))
+	{
+		AddTags(*Tags, Bits.CancelAbilitiesTags);
+	}
+	if (const FGameplayTagContainer* Tags = GetAbilityTagContainer(InAbility, TEXT("BlockAbilitiesWithTag")))
+	{
+		AddTags(*Tags, Bits.BlockAbilitiesTags);
+	}
+	AddTags(InAbility->AbilityTags.GetGameplayTagParents(), Bits.AbilityTags);
+
+	return Bits;
+}
+
+int32 FGASAbilityBlockers::FindOrAddTagIndex(const FGameplayTag& InTag)
+{
+	if (const int32* Index = TagIndices.Find(InTag))
+	{
+		return *Index;
+	}
+
+	const int32 Index = IndexedTags.Add(InTag);
+	TagIndices.Add(InTag, Index);
+	return Index;
+}
+
+void FGASAbilityBlockers::AddTags(const FGameplayTagContainer& InTags, FTagBits& OutBits)
+{
+	for (const FGameplayTag& Tag : InTags)
+	{
+		OutBits.Set(FindOrAddTagIndex(Tag));
+	}
+}
+
+const FGameplayTagContainer* FGASAbilityBlockers::GetAbilityTagContainer(const UGameplayAbility* InAbility, const TCHAR* InPropertyName)
+{
+	// 只在技能类第一次出现时调用，不需要缓存属性
+	// Only called the first time an ability class is seen, so the property is not cached
+	FStructProperty* Property = FindFProperty<FStructProperty>(UGameplayAbility::StaticClass(), InPropertyName);
+	if (!Property || Property->Struct != FGameplayTagContainer::StaticStruct() || !InAbility)
+	{
+		return nullptr;
+	}
+
+	return Property->ContainerPtrToValuePtr<FGameplayTagContainer>(InAbility);
+}
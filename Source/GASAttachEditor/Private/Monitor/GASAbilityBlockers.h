@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+
+// 一个技能为什么被标签阻止
+// Why an ability is blocked by tags
+struct FGASAbilityBlockReasons
+{
+	// 拥有的、出现在 ActivationBlockedTags 里的标签
+	// Owned tags listed in ActivationBlockedTags
+	FGameplayTagContainer OwnedBlockedTags;
+
+	// 缺少的 ActivationRequiredTags
+	// ActivationRequiredTags that are not owned
+	FGameplayTagContainer MissingRequiredTags;
+
+	// 其他激活技能的 BlockAbilitiesWithTag 命中了这个技能的 AbilityTags
+	// BlockAbilitiesWithTag of other active abilities matching this ability's AbilityTags
+	FGameplayTagContainer BlockedAbilityTags;
+
+	bool IsBlocked() const { return !OwnedBlockedTags.IsEmpty() || !MissingRequiredTags.IsEmpty() || !BlockedAbilityTags.IsEmpty(); }
+};
+
+// 用位集解释技能被阻止的原因
+// 所有技能用到的标签映射到全局的稠密下标，每个技能类的三组标签缓存成位集
+// 每个ASC只建立一次拥有标签和被阻止技能标签的位集，之后每个技能只是几次按字求与
+//
+// Explains blocked abilities with bitsets
+// Every tag used by an ability maps to a global dense index, and the three tag groups of each ability class are cached as bitsets
+// The owned and blocked-ability bitsets are built once per ASC; each ability then costs a few word-wise ANDs
+class FGASAbilityBlockers
+{
+public:
+
+	explicit FGASAbilityBlockers(const UAbilitySystemComponent* InASC);
+
+	// 返回是否有标签阻止了这个技能
+	// Returns whether any tag blocks the ability
+	bool Explain(const UGameplayAbility* InAbility, FGASAbilityBlockReasons& OutReasons);
+
+	// 多行描述，BlockAbilitiesWithTag 附带来源技能
+	// Multi-line description; BlockAbilitiesWithTag lists the abilities it comes from
+	FString Describe(const FGASAbilityBlockReasons& InReasons) const;
+
+	// 模块关闭时调用
+	// Called on module shutdown
+	static void Reset();
+
+public:
+
+	struct FTagBits
+	{
+		void Set(int32 InIndex);
+
+		// 结果写到自身: A & B，bInvertB 时为 A & ~B
+		// Writes A & B into this, or A & ~B with bInvertB
+		bool Combine(const FTagBits& A, const FTagBits& B, bool bInvertB);
+
+		bool Intersects(const FTagBits& Other) const;
+
+		void ToContainer(FGameplayTagContainer& OutTags) const;
+
+		TArray<uint64, TInlineAllocator<4>> Words;
+	};
+
+	// 一个技能类的各组标签，按类缓存
+	// The tag groups of one ability class, cached per class
+	struct FAbilityBits
+	{
+		FTagBits BlockedTags;
+
+		FTagBits RequiredTags;
+
+		// 包括父标签，因为阻止父标签也阻止子标签
+		// Parents included, as blocking a parent blocks its children
+		FTagBits AbilityTags;
+
+		// 包括父标签，拥有子标签即满足父标签
+		// Parents included, as owning a child satisfies its parent
+		FTagBits OwnedTags;
+
+		FTagBits CancelAbilitiesTags;
+
+		FTagBits BlockAbilitiesTags;
+	};
+
+	static const FAbilityBits& FindOrAddAbilityBits(const UGameplayAbility* InAbility);
+
+private:
+
+	static int32 FindOrAddTagIndex(const FGameplayTag& InTag);
+
+	static void AddTags(const FGameplayTagContainer& InTags, FTagBits& OutBits);
+
+	// ActivationBlockedTags 等大多是 protected 的，通过反射访问
+	// ActivationBlockedTags and most of the others are protected and are reached through reflection
+	static const FGameplayTagContainer* GetAbilityTagContainer(const UGameplayAbility* InAbility, const TCHAR* InPropertyName);
+
+	// 下标是在ASC位集建立后新增的时重新建立
+	// Rebuilt when indices were added after the ASC bitsets were built
+	void BuildAbilitySystemBits();
+
+private:
+
+	TWeakObjectPtr<const UAbilitySystemComponent> AbilitySystem;
+
+	FTagBits OwnedTags;
+
+	FTagBits BlockedAbilityTags;
+
+	int32 NumIndicesBuilt;
+
+	static TMap<FGameplayTag, int32> TagIndices;
+
+	static TArray<FGameplayTag> IndexedTags;
+
+	static TMap<TWeakObjectPtr<const UClass>, FAbilityBits> AbilityBits;
+};
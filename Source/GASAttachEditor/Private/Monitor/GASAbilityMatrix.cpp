@@ -0,0 +1,156 @@
+#include "Monitor/GASAbilityMatrix.h"
+#include "Monitor/GASAbilityBlockers.h"
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "GASAttachEditorStats.h"
+
+FGASAbilityMatrix::FGASAbilityMatrix()
+	:GrantSignature(0)
+{
+	FMemory::Memzero(RelationCounts);
+}
+
+bool FGASAbilityMatrix::Update(const UAbilitySystemComponent* InASC)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_AbilityMatrix);
+
+	// 同一个技能类授予多次也只占一行
+	// An ability class granted several times still takes one row
+	TArray<const UGameplayAbility*> Granted;
+	if (InASC)
+	{
+		for (const FGameplayAbilitySpec& AbilitySpec : InASC->GetActivatableAbilities())
+		{
+			if (AbilitySpec.Ability)
+			{
+				Granted.AddUnique(AbilitySpec.Ability);
+			}
+		}
+	}
+
+	Granted.Sort([](const UGameplayAbility& A, const UGameplayAbility& B)
+	{
+		return A.GetClass()->GetFName().LexicalLess(B.GetClass()->GetFName());
+	});
+
+	uint32 Signature = GetTypeHash(InASC);
+	for (const UGameplayAbility* Ability : Granted)
+	{
+		Signature = HashCombineFast(Signature, GetTypeHash(Ability));
+	}
+
+	if (AbilitySystem.Get() == InASC && Signature == GrantSignature && Abilities.Num() == Granted.Num())
+	{
+		return false;
+	}
+
+	AbilitySystem = InASC;
+	GrantSignature = Signature;
+
+	const int32 NumAbilities = Granted.Num();
+	Abilities.Reset(NumAbilities);
+	Names.Reset(NumAbilities);
+
+	// 先让所有技能类都进缓存，再取指针，避免缓存扩容使前面的指针失效
+	// Put every class into the cache before taking pointers, so growing the cache cannot invalidate them
+	for (const UGameplayAbility* Ability : Granted)
+	{
+		FGASAbilityBlockers::FindOrAddAbilityBits(Ability);
+	}
+
+	TArray<const FGASAbilityBlockers::FAbilityBits*> Bits;
+	Bits.Reserve(NumAbilities);
+	for (const UGameplayAbility* Ability : Granted)
+	{
+		Abilities.Add(Ability);
+		Names.Add(Ability->GetClass()->GetFName());
+		Bits.Add(&FGASAbilityBlockers::FindOrAddAbilityBits(Ability));
+	}
+
+	Relations.Reset(NumAbilities * NumAbilities);
+	Relations.AddZeroed(NumAbilities * NumAbilities);
+	FMemory::Memzero(RelationCounts);
+
+	for (int32 Row = 0; Row < NumAbilities; ++Row)
+	{
+		const FGASAbilityBlockers::FAbilityBits& From = *Bits[Row];
+		for (int32 Column = 0; Column < NumAbilities; ++Column)
+		{
+			const FGASAbilityBlockers::FAbilityBits& To = *Bits[Column];
+
+			EGASAbilityRelation Relation = EGASAbilityRelation::None;
+			if (From.CancelAbilitiesTags.Intersects(To.AbilityTags))
+			{
+				Relation |= EGASAbilityRelation::Cancels;
+			}
+			if (From.BlockAbilitiesTags.Intersects(To.AbilityTags))
+			{
+				Relation |= EGASAbilityRelation::Blocks;
+			}
+			if (From.OwnedTags.Intersects(To.BlockedTags))
+			{
+				Relation |= EGASAbilityRelation::BlocksByOwnedTags;
+			}
+			if (From.OwnedTags.Intersects(To.RequiredTags))
+			{
+				Relation |= EGASAbilityRelation::Enables;
+			}
+
+			Relations[Row * NumAbilities + Column] = Relation;
+
+			for (int32 Bit = 0; Bit < NumRelations; ++Bit)
+			{
+				RelationCounts[Bit] += (static_cast<uint8>(Relation) >> Bit) & 1;
+			}
+		}
+	}
+
+	return true;
+}
+
+int32 FGASAbilityMatrix::CountRelations(EGASAbilityRelation InRelation) const
+{
+	const int32 Bit = FMath::CountTrailingZeros(static_cast<uint32>(InRelation));
+	return Bit < NumRelations ? RelationCounts[Bit] : 0;
+}
+
+FString FGASAbilityMatrix::DescribeCell(int32 InRow, int32 InColumn) const
+{
+	if (!Names.IsValidIndex(InRow) || !Names.IsValidIndex(InColumn))
+	{
+		return FString();
+	}
+
+	FString Description = FString::Printf(TEXT("%s -> %s"), *Names[InRow].ToString(), *Names[InColumn].ToString());
+
+	const UGameplayAbility* FromAbility = Abilities[InRow].Get();
+	const UGameplayAbility* ToAbility = Abilities[InColumn].Get();
+	const EGASAbilityRelation Relation = GetRelation(InRow, InColumn);
+	if (!FromAbility || !ToAbility || Relation == EGASAbilityRelation::None)
+	{
+		return Description;
+	}
+
+	// 复制一份，第二次查找可能让缓存扩容
+	// Copied, as the second lookup may grow the cache
+	const FGASAbilityBlockers::FAbilityBits From = FGASAbilityBlockers::FindOrAddAbilityBits(FromAbility);
+	const FGASAbilityBlockers::FAbilityBits& To = FGASAbilityBlockers::FindOrAddAbilityBits(ToAbility);
+
+	auto AppendTags = [&Description](const TCHAR* InLabel, const FGASAbilityBlockers::FTagBits& A, const FGASAbilityBlockers::FTagBits& B)
+	{
+		FGASAbilityBlockers::FTagBits Result;
+		if (Result.Combine(A, B, false))
+		{
+			FGameplayTagContainer Tags;
+			Result.ToContainer(Tags);
+			Description += FString::Printf(TEXT("\n%s: %s"), InLabel, *Tags.ToStringSimple());
+		}
+	};
+
+	AppendTags(TEXT("Cancels (CancelAbilitiesWithTag)"), From.CancelAbilitiesTags, To.AbilityTags);
+	AppendTags(TEXT("Blocks (BlockAbilitiesWithTag)"), From.BlockAbilitiesTags, To.AbilityTags);
+	AppendTags(TEXT("Blocks (ActivationOwnedTags in ActivationBlockedTags)"), From.OwnedTags, To.BlockedTags);
+	AppendTags(TEXT("Required by (ActivationOwnedTags in ActivationRequiredTags)"), From.OwnedTags, To.RequiredTags);
+
+	return Description;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+
+// 行技能对列技能的影响
+// Effect of the row ability on the column ability
+enum class EGASAbilityRelation : uint8
+{
+	None = 0,
+
+	// CancelAbilitiesWithTag 命中列技能的 AbilityTags
+	// CancelAbilitiesWithTag matches the column's AbilityTags
+	Cancels = 1 << 0,
+
+	// BlockAbilitiesWithTag 命中列技能的 AbilityTags
+	// BlockAbilitiesWithTag matches the column's AbilityTags
+	Blocks = 1 << 1,
+
+	// ActivationOwnedTags 命中列技能的 ActivationBlockedTags
+	// ActivationOwnedTags match the column's ActivationBlockedTags
+	BlocksByOwnedTags = 1 << 2,
+
+	// ActivationOwnedTags 满足列技能的 ActivationRequiredTags
+	// ActivationOwnedTags satisfy the column's ActivationRequiredTags
+	Enables = 1 << 3,
+};
+ENUM_CLASS_FLAGS(EGASAbilityRelation)
+
+// 一个ASC上所有授予技能两两之间的关系，用标签位集计算
+// 授予的技能没有变化时不重新计算
+//
+// Relations between every pair of abilities granted to one ASC, computed with tag bitsets
+// Not recomputed while the granted abilities stay the same
+class FGASAbilityMatrix
+{
+public:
+
+	static constexpr int32 NumRelations = 4;
+
+	FGASAbilityMatrix();
+
+	// 授予的技能有变化时重新计算并返回 true
+	// Recomputes and returns true when the granted abilities changed
+	bool Update(const UAbilitySystemComponent* InASC);
+
+	int32 Num() const { return Names.Num(); }
+
+	FName GetAbilityName(int32 InIndex) const { return Names[InIndex]; }
+
+	EGASAbilityRelation GetRelation(int32 InRow, int32 InColumn) const { return Relations[InRow * Names.Num() + InColumn]; }
+
+	// 有这种关系的格子数，在计算时统计
+	// Number of cells with the relation, counted while computing
+	int32 CountRelations(EGASAbilityRelation InRelation) const;
+
+	// 格子的说明，只在需要时计算涉及的标签
+	// Description of a cell; the tags involved are only worked out when asked
+	FString DescribeCell(int32 InRow, int32 InColumn) const;
+
+private:
+
+	TWeakObjectPtr<const UAbilitySystemComponent> AbilitySystem;
+
+	// 授予的技能类的哈希，用来判断是否需要重新计算
+	// Hash of the granted ability classes, used to tell whether to recompute
+	uint32 GrantSignature;
+
+	// 按名字排序，每个技能类一次
+	// Sorted by name, once per ability class
+	TArray<TWeakObjectPtr<const UGameplayAbility>> Abilities;
+
+	TArray<FName> Names;
+
+	TArray<EGASAbilityRelation> Relations;
+
+	// 每种关系一个
+	// One per relation
+	int32 RelationCounts[NumRelations];
+};
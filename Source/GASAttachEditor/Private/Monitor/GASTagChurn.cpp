@@ -0,0 +1,235 @@
+#include "Monitor/GASTagChurn.h"
+#include "Monitor/GASWorldMonitor.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorTagStormThreshold(
+	TEXT("GASAttachEditor.TagChurn.StormThreshold"),
+	20,
+	TEXT("Adds plus removes of one tag within one game second above which the tag churn view flags the tag and a warning is logged."),
+	ECVF_Default);
+
+TArray<TSharedRef<FGASTagChurnTracker>> FGASTagChurnTracker::Trackers;
+
+FGASTagChurnCounters::FGASTagChurnCounters()
+	:bStorm(false)
+{
+	FMemory::Memzero(Adds);
+	FMemory::Memzero(Removes);
+}
+
+int32 FGASTagChurnCounters::GetEvents(int32 InCurrentBucket, int32 InAge) const
+{
+	const int32 Bucket = (InCurrentBucket - InAge + NumBuckets) % NumBuckets;
+	return Adds[Bucket] + Removes[Bucket];
+}
+
+int32 FGASTagChurnCounters::GetTotal(int32 InCurrentBucket) const
+{
+	int32 Total = 0;
+	for (int32 Age = 1; Age < NumBuckets; ++Age)
+	{
+		Total += GetEvents(InCurrentBucket, Age);
+	}
+	return Total;
+}
+
+int32 FGASTagChurnCounters::GetPeak(int32 InCurrentBucket) const
+{
+	int32 Peak = 0;
+	for (int32 Age = 1; Age < NumBuckets; ++Age)
+	{
+		Peak = FMath::Max(Peak, GetEvents(InCurrentBucket, Age));
+	}
+	return Peak;
+}
+
+FGASTagChurnTable::FGASTagChurnTable()
+	:CurrentBucket(0)
+{
+}
+
+void FGASTagChurnTable::Record(const FGameplayTag& InTag, bool bAdded, const UAbilitySystemComponent* InASC)
+{
+	FGASTagChurnCounters& Tag = Counters.FindOrAdd(InTag);
+
+	uint16& Count = bAdded ? Tag.Adds[CurrentBucket] : Tag.Removes[CurrentBucket];
+	if (Count < MAX_uint16)
+	{
+		++Count;
+	}
+
+	Tag.LastAbilitySystem = InASC;
+}
+
+void FGASTagChurnTable::Roll(int32 InThreshold, TArray<FGameplayTag>* OutNewStorms)
+{
+	const int32 NextBucket = (CurrentBucket + 1) % FGASTagChurnCounters::NumBuckets;
+
+	for (auto It = Counters.CreateIterator(); It; ++It)
+	{
+		FGASTagChurnCounters& Tag = It.Value();
+
+		const bool bStorm = InThreshold > 0 && Tag.Adds[CurrentBucket] + Tag.Removes[CurrentBucket] > InThreshold;
+		if (bStorm && !Tag.bStorm && OutNewStorms)
+		{
+			OutNewStorms->Add(It.Key());
+		}
+		Tag.bStorm = bStorm;
+
+		// 最旧的一秒变成新的当前秒
+		// The oldest second becomes the new current one
+		Tag.Adds[NextBucket] = 0;
+		Tag.Removes[NextBucket] = 0;
+
+		if (Tag.GetTotal(NextBucket) == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	CurrentBucket = NextBucket;
+}
+
+void FGASTagChurnTable::Reset()
+{
+	Counters.Reset();
+	CurrentBucket = 0;
+}
+
+TSharedRef<FGASTagChurnTracker> FGASTagChurnTracker::FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor)
+{
+	Trackers.RemoveAll([](const TSharedRef<FGASTagChurnTracker>& Tracker)
+	{
+		return !Tracker->Monitor.IsValid();
+	});
+
+	for (const TSharedRef<FGASTagChurnTracker>& Tracker : Trackers)
+	{
+		if (Tracker->Monitor.Pin() == InMonitor)
+		{
+			return Tracker;
+		}
+	}
+
+	TSharedRef<FGASTagChurnTracker> NewTracker = MakeShareable(new FGASTagChurnTracker(InMonitor));
+	NewTracker->Bind();
+	Trackers.Add(NewTracker);
+	return NewTracker;
+}
+
+TSharedPtr<FGASTagChurnTracker> FGASTagChurnTracker::FindOrCreate(UWorld* InWorld)
+{
+	if (!InWorld)
+	{
+		return nullptr;
+	}
+
+	return FindOrCreate(FGASWorldMonitor::FindOrCreate(InWorld));
+}
+
+void FGASTagChurnTracker::Reset()
+{
+	Trackers.Reset();
+}
+
+int32 FGASTagChurnTracker::GetStormThreshold()
+{
+	return CVarGASAttachEditorTagStormThreshold.GetValueOnGameThread();
+}
+
+FGASTagChurnTracker::FGASTagChurnTracker(const TSharedRef<FGASWorldMonitor>& InMonitor)
+	:Monitor(InMonitor)
+	,SecondTime(0.f)
+{
+}
+
+FGASTagChurnTracker::~FGASTagChurnTracker()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	LocalMonitor->OnTagChanged.Remove(TagChangedHandle);
+	LocalMonitor->OnTick.Remove(TickHandle);
+}
+
+void FGASTagChurnTracker::Bind()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	TagChangedHandle = LocalMonitor->OnTagChanged.AddSP(this, &FGASTagChurnTracker::HandleTagChanged);
+	TickHandle = LocalMonitor->OnTick.AddSP(this, &FGASTagChurnTracker::HandleTick);
+}
+
+void FGASTagChurnTracker::SetFocus(const UAbilitySystemComponent* InASC)
+{
+	if (Focus.Get() != InASC)
+	{
+		Focus = InASC;
+		FocusTable.Reset();
+	}
+}
+
+void FGASTagChurnTracker::HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 InNewCount)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagChurn);
+
+	// 通用标签事件只在数量从 0 变为正数或变回 0 时广播
+	// The generic tag event only fires when the count leaves or returns to 0
+	const bool bAdded = InNewCount > 0;
+
+	WorldTable.Record(InTag, bAdded, InASC);
+
+	if (InASC && Focus.Get() == InASC)
+	{
+		FocusTable.Record(InTag, bAdded, InASC);
+	}
+}
+
+void FGASTagChurnTracker::HandleTick(float InDeltaSeconds)
+{
+	SecondTime += InDeltaSeconds;
+	if (SecondTime < 1.f)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagChurn);
+
+	// 卡顿时长的一帧只算一秒，避免把同一批事件分摊到多个桶
+	// A long hitch counts as one second so the same events are not spread over several buckets
+	SecondTime = FMath::Fmod(SecondTime, 1.f);
+
+	const int32 Threshold = GetStormThreshold();
+
+	TArray<FGameplayTag> NewStorms;
+	const int32 ClosedBucket = WorldTable.GetCurrentBucket();
+	WorldTable.Roll(Threshold, &NewStorms);
+	FocusTable.Roll(Threshold, nullptr);
+
+	for (const FGameplayTag& Tag : NewStorms)
+	{
+		const FGASTagChurnCounters& Counters = WorldTable.GetCounters().FindChecked(Tag);
+		const UAbilitySystemComponent* LastASC = Counters.LastAbilitySystem.Get();
+		const AActor* LastActor = LastASC ? LastASC->GetAvatarActor_Direct() : nullptr;
+		if (!LastActor && LastASC)
+		{
+			LastActor = LastASC->GetOwnerActor();
+		}
+
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Tag storm: %s was added %d and removed %d times in the last second (threshold %d, last change on %s)"),
+			*Tag.ToString(), Counters.Adds[ClosedBucket], Counters.Removes[ClosedBucket], Threshold, *GetNameSafe(LastActor));
+	}
+
+	OnSecond.Broadcast();
+}
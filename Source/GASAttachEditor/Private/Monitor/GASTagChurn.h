@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class FGASWorldMonitor;
+class UAbilitySystemComponent;
+class UWorld;
+
+// 一个标签最近几秒的增删次数，每秒一个桶，环形使用，内存大小固定
+// Add/remove counts of one tag over the last seconds; one bucket per second used as a ring, so the size is fixed
+struct FGASTagChurnCounters
+{
+	static constexpr int32 NumBuckets = 16;
+
+	FGASTagChurnCounters();
+
+	// InAge 为 0 是还没结束的这一秒，1 是刚结束的一秒
+	// InAge 0 is the second still running, 1 the second that just ended
+	int32 GetEvents(int32 InCurrentBucket, int32 InAge) const;
+
+	// 已经结束的各秒的总数和最大值
+	// Total and peak over the seconds that have ended
+	int32 GetTotal(int32 InCurrentBucket) const;
+
+	int32 GetPeak(int32 InCurrentBucket) const;
+
+	uint16 Adds[NumBuckets];
+
+	uint16 Removes[NumBuckets];
+
+	// 最后一次改变这个标签的ASC，世界统计里用来找出是谁在抖动
+	// Last ASC that changed the tag; used in the world table to tell who is flapping
+	TWeakObjectPtr<const UAbilitySystemComponent> LastAbilitySystem;
+
+	// 刚结束的一秒超过了阈值
+	// The second that just ended went over the threshold
+	bool bStorm;
+};
+
+// 标签 -> 计数，窗口内没有任何变化的标签会被移除
+// Tag -> counters; tags without any change in the window are dropped
+class FGASTagChurnTable
+{
+public:
+
+	FGASTagChurnTable();
+
+	void Record(const FGameplayTag& InTag, bool bAdded, const UAbilitySystemComponent* InASC);
+
+	// 结束当前这一秒，刚超过阈值的标签写到 OutNewStorms
+	// Ends the current second; tags that just went over the threshold are written to OutNewStorms
+	void Roll(int32 InThreshold, TArray<FGameplayTag>* OutNewStorms);
+
+	void Reset();
+
+	const TMap<FGameplayTag, FGASTagChurnCounters>& GetCounters() const { return Counters; }
+
+	int32 GetCurrentBucket() const { return CurrentBucket; }
+
+private:
+
+	TMap<FGameplayTag, FGASTagChurnCounters> Counters;
+
+	int32 CurrentBucket;
+};
+
+DECLARE_MULTICAST_DELEGATE(FOnGASTagChurnSecond)
+
+// 统计一个世界里标签每秒的增删次数，标签抖动会触发大量标签委托和技能的重新判断
+// 挂在监听器的 OnTagChanged 上 (RegisterGenericGameplayTagEvent)，只在标签出现或消失时计数
+//
+// Counts tag adds/removes per second in one world; flapping tags fire cascades of tag delegates and ability re-evaluation
+// Hangs off the monitor's OnTagChanged (RegisterGenericGameplayTagEvent), so only a tag appearing or going away counts
+class FGASTagChurnTracker : public TSharedFromThis<FGASTagChurnTracker>
+{
+public:
+
+	~FGASTagChurnTracker();
+
+	// 每个世界监听器一个，创建之后开始统计
+	// One per world monitor; counting starts once created
+	static TSharedRef<FGASTagChurnTracker> FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	static TSharedPtr<FGASTagChurnTracker> FindOrCreate(UWorld* InWorld);
+
+	// 模块关闭时调用
+	// Called on module shutdown
+	static void Reset();
+
+	// 每秒超过这个次数的标签会被标记并输出警告
+	// Tags changing more often than this per second are flagged and logged
+	static int32 GetStormThreshold();
+
+public:
+
+	// 整个世界的统计
+	// Counters of the whole world
+	const FGASTagChurnTable& GetWorldTable() const { return WorldTable; }
+
+	// 只统计选中的ASC，换ASC时清零
+	// Counters of the focused ASC only, cleared when the focus changes
+	const FGASTagChurnTable& GetFocusTable() const { return FocusTable; }
+
+	void SetFocus(const UAbilitySystemComponent* InASC);
+
+	// 每过一秒游戏时间广播
+	// Broadcast every game second
+	FOnGASTagChurnSecond OnSecond;
+
+private:
+
+	explicit FGASTagChurnTracker(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	void Bind();
+
+	void HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 InNewCount);
+
+	void HandleTick(float InDeltaSeconds);
+
+private:
+
+	TWeakPtr<FGASWorldMonitor> Monitor;
+
+	FGASTagChurnTable WorldTable;
+
+	FGASTagChurnTable FocusTable;
+
+	TWeakObjectPtr<const UAbilitySystemComponent> Focus;
+
+	float SecondTime;
+
+	FDelegateHandle TagChangedHandle;
+
+	FDelegateHandle TickHandle;
+
+	static TArray<TSharedRef<FGASTagChurnTracker>> Trackers;
+};
@@ -0,0 +1,300 @@
+#include "Monitor/GASTagHolderIndex.h"
+#include "Monitor/GASWorldMonitor.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/Actor.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+namespace GASTagHolderIndex
+{
+	// 接受 Status.Debuff、Status.Debuff.* 或 Status.Debuff*
+	// Accepts Status.Debuff, Status.Debuff.* or Status.Debuff*
+	FGameplayTag ParseTag(FString InText)
+	{
+		InText.RemoveFromEnd(TEXT("*"));
+		InText.RemoveFromEnd(TEXT("."));
+		return UGameplayTagsManager::Get().RequestGameplayTag(FName(*InText), false);
+	}
+
+	void WhoHasTag(const TArray<FString>& Args, UWorld* InWorld)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Usage: GASAttachEditor.WhoHasTag <Tag>[.*]"));
+			return;
+		}
+
+		const FGameplayTag Tag = ParseTag(Args[0]);
+		if (!Tag.IsValid())
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Unknown gameplay tag %s"), *Args[0]);
+			return;
+		}
+
+		TSharedPtr<FGASTagHolderIndex> Index = FGASTagHolderIndex::FindOrCreate(InWorld);
+		if (!Index.IsValid())
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("No world to search"));
+			return;
+		}
+
+		TArray<FString> Lines;
+		Index->DescribeHolders(Tag, Lines);
+
+		UE_LOG(LogGASAttachEditor, Display, TEXT("%d ASCs in %s hold %s or one of its children"), Lines.Num(), *GetNameSafe(InWorld), *Tag.ToString());
+		for (const FString& Line : Lines)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("  %s"), *Line);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GASAttachEditorWhoHasTagCmd(
+	TEXT("GASAttachEditor.WhoHasTag"),
+	TEXT("Lists every ASC of the world holding a tag or any of its children, e.g. GASAttachEditor.WhoHasTag Status.Debuff.*"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GASTagHolderIndex::WhoHasTag));
+
+TArray<TSharedRef<FGASTagHolderIndex>> FGASTagHolderIndex::Indices;
+
+TSharedRef<FGASTagHolderIndex> FGASTagHolderIndex::FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor)
+{
+	Indices.RemoveAll([](const TSharedRef<FGASTagHolderIndex>& Index)
+	{
+		return !Index->Monitor.IsValid();
+	});
+
+	for (const TSharedRef<FGASTagHolderIndex>& Index : Indices)
+	{
+		if (Index->Monitor.Pin() == InMonitor)
+		{
+			return Index;
+		}
+	}
+
+	TSharedRef<FGASTagHolderIndex> NewIndex = MakeShareable(new FGASTagHolderIndex(InMonitor));
+	NewIndex->Bind();
+	Indices.Add(NewIndex);
+	return NewIndex;
+}
+
+TSharedPtr<FGASTagHolderIndex> FGASTagHolderIndex::FindOrCreate(UWorld* InWorld)
+{
+	if (!InWorld)
+	{
+		return nullptr;
+	}
+
+	return FindOrCreate(FGASWorldMonitor::FindOrCreate(InWorld));
+}
+
+void FGASTagHolderIndex::Reset()
+{
+	Indices.Reset();
+}
+
+FGASTagHolderIndex::FGASTagHolderIndex(const TSharedRef<FGASWorldMonitor>& InMonitor)
+	:Monitor(InMonitor)
+{
+}
+
+FGASTagHolderIndex::~FGASTagHolderIndex()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	LocalMonitor->OnTagChanged.Remove(TagChangedHandle);
+	LocalMonitor->OnAbilitySystemChanged.Remove(AbilitySystemChangedHandle);
+}
+
+void FGASTagHolderIndex::Bind()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	TagChangedHandle = LocalMonitor->OnTagChanged.AddSP(this, &FGASTagHolderIndex::HandleTagChanged);
+	AbilitySystemChangedHandle = LocalMonitor->OnAbilitySystemChanged.AddSP(this, &FGASTagHolderIndex::HandleAbilitySystemChanged);
+
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagHolderIndex);
+
+	// 之后绑定的ASC会通过 OnAbilitySystemChanged 加进来
+	// ASCs bound later come in through OnAbilitySystemChanged
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : LocalMonitor->GetAbilitySystems())
+	{
+		AddAbilitySystem(WeakASC.Get());
+	}
+}
+
+const TSet<TWeakObjectPtr<UAbilitySystemComponent>>* FGASTagHolderIndex::FindHolders(const FGameplayTag& InTag) const
+{
+	return Holders.Find(InTag);
+}
+
+int32 FGASTagHolderIndex::GetNumHolders(const FGameplayTag& InTag) const
+{
+	const TSet<TWeakObjectPtr<UAbilitySystemComponent>>* Found = Holders.Find(InTag);
+	return Found ? Found->Num() : 0;
+}
+
+void FGASTagHolderIndex::DescribeHolders(const FGameplayTag& InTag, TArray<FString>& OutLines) const
+{
+	const TSet<TWeakObjectPtr<UAbilitySystemComponent>>* Found = Holders.Find(InTag);
+	if (!Found)
+	{
+		return;
+	}
+
+	OutLines.Reserve(OutLines.Num() + Found->Num());
+
+	FGameplayTagContainer OwnedTags;
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : *Found)
+	{
+		const UAbilitySystemComponent* ASC = WeakASC.Get();
+		if (!ASC)
+		{
+			continue;
+		}
+
+		const AActor* Actor = ASC->GetAvatarActor_Direct() ? ASC->GetAvatarActor_Direct() : ASC->GetOwnerActor();
+
+		// 只取持有者自己的标签，代价和结果数量成正比
+		// Only the holders' own tags are read, so the cost follows the number of results
+		OwnedTags.Reset();
+		ASC->GetOwnedGameplayTags(OwnedTags);
+
+		FString Matched;
+		for (const FGameplayTag& OwnedTag : OwnedTags)
+		{
+			if (OwnedTag.MatchesTag(InTag))
+			{
+				Matched += Matched.IsEmpty() ? OwnedTag.ToString() : TEXT(", ") + OwnedTag.ToString();
+			}
+		}
+
+		OutLines.Add(FString::Printf(TEXT("%s [%s]  %s"), *GetNameSafe(Actor), *GetNameSafe(Actor ? Actor->GetClass() : nullptr), *Matched));
+	}
+
+	OutLines.Sort();
+}
+
+void FGASTagHolderIndex::AddAbilitySystem(UAbilitySystemComponent* InASC)
+{
+	if (!InASC)
+	{
+		return;
+	}
+
+	FGameplayTagContainer OwnedTags;
+	InASC->GetOwnedGameplayTags(OwnedTags);
+
+	const TWeakObjectPtr<UAbilitySystemComponent> WeakASC(InASC);
+	for (const FGameplayTag& Tag : OwnedTags.GetGameplayTagParents())
+	{
+		AddHolder(Tag, WeakASC);
+	}
+}
+
+void FGASTagHolderIndex::RemoveAbilitySystem(const TWeakObjectPtr<UAbilitySystemComponent>& InASC)
+{
+	TArray<FGameplayTag> Tags;
+	if (!HeldTags.RemoveAndCopyValue(InASC, Tags))
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (TSet<TWeakObjectPtr<UAbilitySystemComponent>>* Found = Holders.Find(Tag))
+		{
+			Found->Remove(InASC);
+			if (Found->IsEmpty())
+			{
+				Holders.Remove(Tag);
+			}
+		}
+	}
+}
+
+void FGASTagHolderIndex::AddHolder(const FGameplayTag& InTag, const TWeakObjectPtr<UAbilitySystemComponent>& InASC)
+{
+	bool bAlreadyHeld = false;
+	Holders.FindOrAdd(InTag).Add(InASC, &bAlreadyHeld);
+	if (!bAlreadyHeld)
+	{
+		HeldTags.FindOrAdd(InASC).Add(InTag);
+	}
+}
+
+void FGASTagHolderIndex::RemoveHolder(const FGameplayTag& InTag, const TWeakObjectPtr<UAbilitySystemComponent>& InASC)
+{
+	TSet<TWeakObjectPtr<UAbilitySystemComponent>>* Found = Holders.Find(InTag);
+	if (!Found || Found->Remove(InASC) == 0)
+	{
+		return;
+	}
+
+	if (Found->IsEmpty())
+	{
+		Holders.Remove(InTag);
+	}
+
+	if (TArray<FGameplayTag>* Tags = HeldTags.Find(InASC))
+	{
+		Tags->RemoveSingleSwap(InTag);
+	}
+}
+
+void FGASTagHolderIndex::HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 InNewCount)
+{
+	if (!InASC)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagHolderIndex);
+
+	// 父标签的计数变化也会单独广播，这里不需要再展开层级
+	// Count changes of the parent tags are broadcast on their own, so the hierarchy need not be expanded here
+	if (InNewCount > 0)
+	{
+		AddHolder(InTag, InASC);
+	}
+	else
+	{
+		RemoveHolder(InTag, InASC);
+	}
+}
+
+void FGASTagHolderIndex::HandleAbilitySystemChanged(UAbilitySystemComponent* InASC, bool bAdded)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagHolderIndex);
+
+	if (bAdded)
+	{
+		AddAbilitySystem(InASC);
+		return;
+	}
+
+	// 被销毁的ASC以空指针广播，找出已经失效的键
+	// A destroyed ASC is broadcast as null, so the stale keys are looked up
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> Stale;
+	for (const TPair<TWeakObjectPtr<UAbilitySystemComponent>, TArray<FGameplayTag>>& Pair : HeldTags)
+	{
+		if (!Pair.Key.IsValid())
+		{
+			Stale.Add(Pair.Key);
+		}
+	}
+
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : Stale)
+	{
+		RemoveAbilitySystem(WeakASC);
+	}
+}
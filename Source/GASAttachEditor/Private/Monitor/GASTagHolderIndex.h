@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class FGASWorldMonitor;
+class UAbilitySystemComponent;
+class UWorld;
+
+// 一个世界里 标签 -> 持有它的ASC 的索引，回答 "谁身上有标签X"
+// ASC的标签计数本身包含父标签，所以查询父标签就能得到持有任一子标签的ASC
+// 创建时从当前状态建立一次，之后由监听器的标签事件维护，查询不遍历ASC
+//
+// Index from tag to the ASCs holding it in one world; answers "who has tag X"
+// An ASC's tag counts include the parent tags, so querying a parent returns the ASCs holding any of its children
+// Built once from the current state when created, then maintained from the monitor's tag events; queries do not walk the ASCs
+class FGASTagHolderIndex : public TSharedFromThis<FGASTagHolderIndex>
+{
+public:
+
+	~FGASTagHolderIndex();
+
+	// 每个世界监听器一个
+	// One per world monitor
+	static TSharedRef<FGASTagHolderIndex> FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	static TSharedPtr<FGASTagHolderIndex> FindOrCreate(UWorld* InWorld);
+
+	// 模块关闭时调用
+	// Called on module shutdown
+	static void Reset();
+
+public:
+
+	// 持有这个标签或者它任一子标签的ASC
+	// ASCs holding the tag or any of its children
+	const TSet<TWeakObjectPtr<UAbilitySystemComponent>>* FindHolders(const FGameplayTag& InTag) const;
+
+	int32 GetNumHolders(const FGameplayTag& InTag) const;
+
+	// 每个持有者一行: 角色名和匹配到的具体标签，按角色名排序
+	// One line per holder with the actor name and the exact tags that matched, sorted by actor name
+	void DescribeHolders(const FGameplayTag& InTag, TArray<FString>& OutLines) const;
+
+private:
+
+	explicit FGASTagHolderIndex(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	void Bind();
+
+	// 记录ASC当前的所有标签(包括父标签)
+	// Records every current tag of the ASC, parents included
+	void AddAbilitySystem(UAbilitySystemComponent* InASC);
+
+	void RemoveAbilitySystem(const TWeakObjectPtr<UAbilitySystemComponent>& InASC);
+
+	void AddHolder(const FGameplayTag& InTag, const TWeakObjectPtr<UAbilitySystemComponent>& InASC);
+
+	void RemoveHolder(const FGameplayTag& InTag, const TWeakObjectPtr<UAbilitySystemComponent>& InASC);
+
+	void HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 InNewCount);
+
+	void HandleAbilitySystemChanged(UAbilitySystemComponent* InASC, bool bAdded);
+
+private:
+
+	TWeakPtr<FGASWorldMonitor> Monitor;
+
+	TMap<FGameplayTag, TSet<TWeakObjectPtr<UAbilitySystemComponent>>> Holders;
+
+	// ASC -> 它持有的标签，ASC被销毁时用来移除
+	// ASC -> the tags it holds, used to remove it once destroyed
+	TMap<TWeakObjectPtr<UAbilitySystemComponent>, TArray<FGameplayTag>> HeldTags;
+
+	FDelegateHandle TagChangedHandle;
+
+	FDelegateHandle AbilitySystemChangedHandle;
+
+	static TArray<TSharedRef<FGASTagHolderIndex>> Indices;
+};
@@ -0,0 +1,504 @@
+#include "Monitor/GASTagLeaks.h"
+#include "Monitor/GASWorldMonitor.h"
+#include "Monitor/GASTagSourceIndex.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+static TAutoConsoleVariable<float> CVarGASAttachEditorTagLeaksSampleInterval(
+	TEXT("GASAttachEditor.TagLeaks.SampleInterval"),
+	1.f,
+	TEXT("Game seconds between two samples of every ASC's tag counts by the tag leak detector."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarGASAttachEditorTagLeaksBucketSeconds(
+	TEXT("GASAttachEditor.TagLeaks.BucketSeconds"),
+	30.f,
+	TEXT("Game seconds covered by one min/max bucket of the tag leak detector. 16 buckets are kept per tag."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorTagLeaksGrowBuckets(
+	TEXT("GASAttachEditor.TagLeaks.GrowBuckets"),
+	4,
+	TEXT("Number of consecutive buckets whose minimum tag count must never drop, and must rise overall, for the count to be flagged as growing."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarGASAttachEditorTagLeaksLooseSeconds(
+	TEXT("GASAttachEditor.TagLeaks.LooseSeconds"),
+	60.f,
+	TEXT("Game seconds a tag count not explained by any active ability or effect may stay above zero before it is flagged as a loose tag leak. Only loose counts that grew or whose tag count kept changing meanwhile are flagged; a tag held loosely and steadily by design is not."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorTagLeaksHighCount(
+	TEXT("GASAttachEditor.TagLeaks.HighCount"),
+	100,
+	TEXT("Tag counts at or above this are flagged as implausibly high."),
+	ECVF_Default);
+
+namespace GASTagLeaks
+{
+	const FName AutoCreateOwner(TEXT("TagLeaks"));
+
+	FString GetActorName(const UAbilitySystemComponent* InASC)
+	{
+		const AActor* Actor = InASC ? (InASC->GetAvatarActor_Direct() ? InASC->GetAvatarActor_Direct() : InASC->GetOwnerActor()) : nullptr;
+		return GetNameSafe(Actor);
+	}
+
+	void Report(const TArray<FString>& Args, UWorld* InWorld)
+	{
+		TSharedPtr<FGASTagLeakDetector> Detector = FGASTagLeakDetector::Find(InWorld);
+		if (!Detector.IsValid())
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("The tag leak detector is not running in %s, use GASAttachEditor.TagLeaks.Start"), *GetNameSafe(InWorld));
+			return;
+		}
+
+		TArray<FGASTagLeakSuspect> Suspects;
+		Detector->GetSuspects(Suspects);
+
+		UE_LOG(LogGASAttachEditor, Display, TEXT("%d tag leak suspects in %s after %.0fs"), Suspects.Num(), *GetNameSafe(InWorld), Detector->GetElapsedTime());
+		for (const FGASTagLeakSuspect& Suspect : Suspects)
+		{
+			UE_LOG(LogGASAttachEditor, Display, TEXT("  %s"), *Suspect.Description);
+		}
+	}
+}
+
+static FAutoConsoleCommand GASAttachEditorTagLeaksStartCmd(
+	TEXT("GASAttachEditor.TagLeaks.Start"),
+	TEXT("Starts sampling the tag counts of every ASC in every game world to detect leaked tag counts."),
+	FConsoleCommandDelegate::CreateStatic(&FGASTagLeakDetector::Start));
+
+static FAutoConsoleCommand GASAttachEditorTagLeaksStopCmd(
+	TEXT("GASAttachEditor.TagLeaks.Stop"),
+	TEXT("Stops the tag leak detector and drops its statistics."),
+	FConsoleCommandDelegate::CreateStatic(&FGASTagLeakDetector::Stop));
+
+static FAutoConsoleCommandWithWorldAndArgs GASAttachEditorTagLeaksReportCmd(
+	TEXT("GASAttachEditor.TagLeaks.Report"),
+	TEXT("Lists the tags of the world whose counts grow, stay loose after their source ended, or are implausibly high. Needs GASAttachEditor.TagLeaks.Start first."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GASTagLeaks::Report));
+
+FGASTagCountStats::FGASTagCountStats()
+	:NumEndedBuckets(0)
+	,Count(0)
+	,LooseCount(0)
+	,LooseSince(-1.0)
+	,LooseStartCount(0)
+	,bLooseChurned(false)
+	,Leaks(EGASTagLeak::None)
+	,ReportedLeaks(EGASTagLeak::None)
+{
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		MinCounts[Bucket] = MAX_uint16;
+		MaxCounts[Bucket] = 0;
+	}
+}
+
+void FGASTagCountStats::Sample(int32 InCount, int32 InLooseCount, int32 InCurrentBucket, double InTime)
+{
+	const int32 PreviousCount = Count;
+	Count = InCount;
+	LooseCount = InLooseCount;
+
+	const uint16 Clamped = static_cast<uint16>(FMath::Clamp(InCount, 0, static_cast<int32>(MAX_uint16)));
+	MinCounts[InCurrentBucket] = FMath::Min(MinCounts[InCurrentBucket], Clamped);
+	MaxCounts[InCurrentBucket] = FMath::Max(MaxCounts[InCurrentBucket], Clamped);
+
+	if (InLooseCount <= 0)
+	{
+		LooseSince = -1.0;
+	}
+	else if (LooseSince < 0.0)
+	{
+		LooseSince = InTime;
+		LooseStartCount = InLooseCount;
+		bLooseChurned = false;
+	}
+	else if (InCount != PreviousCount)
+	{
+		bLooseChurned = true;
+	}
+}
+
+bool FGASTagCountStats::IsLooseLeak(double InTime, double InLooseSeconds) const
+{
+	return LooseSince >= 0.0 && InTime - LooseSince >= InLooseSeconds && (LooseCount > LooseStartCount || bLooseChurned);
+}
+
+void FGASTagCountStats::Roll(int32 InNewBucket)
+{
+	const uint16 Clamped = static_cast<uint16>(FMath::Clamp(Count, 0, static_cast<int32>(MAX_uint16)));
+	MinCounts[InNewBucket] = Clamped;
+	MaxCounts[InNewBucket] = Clamped;
+	NumEndedBuckets = FMath::Min(NumEndedBuckets + 1, NumBuckets - 1);
+}
+
+bool FGASTagCountStats::IsGrowing(int32 InCurrentBucket, int32 InNumBuckets) const
+{
+	const int32 NumChecked = FMath::Clamp(InNumBuckets, 2, NumBuckets - 1);
+	if (NumEndedBuckets < NumChecked)
+	{
+		return false;
+	}
+
+	const int32 Oldest = (InCurrentBucket - NumChecked + NumBuckets) % NumBuckets;
+	uint16 Previous = MinCounts[Oldest];
+	for (int32 Age = NumChecked - 1; Age >= 1; --Age)
+	{
+		const uint16 Min = MinCounts[(InCurrentBucket - Age + NumBuckets) % NumBuckets];
+		if (Min < Previous)
+		{
+			return false;
+		}
+		Previous = Min;
+	}
+
+	return Previous > MinCounts[Oldest];
+}
+
+FString FGASTagCountStats::ToString(int32 InCurrentBucket) const
+{
+	FString History;
+	for (int32 Age = NumEndedBuckets; Age >= 1; --Age)
+	{
+		const int32 Bucket = (InCurrentBucket - Age + NumBuckets) % NumBuckets;
+		History += FString::Printf(TEXT("%d-%d "), MinCounts[Bucket], MaxCounts[Bucket]);
+	}
+
+	return History.IsEmpty() ? TEXT("-") : History.TrimEnd();
+}
+
+TArray<TSharedRef<FGASTagLeakDetector>> FGASTagLeakDetector::Detectors;
+FDelegateHandle FGASTagLeakDetector::MonitorCreatedHandle;
+bool FGASTagLeakDetector::bWatching = false;
+
+TSharedRef<FGASTagLeakDetector> FGASTagLeakDetector::FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor)
+{
+	Detectors.RemoveAll([](const TSharedRef<FGASTagLeakDetector>& Detector)
+	{
+		return !Detector->Monitor.IsValid();
+	});
+
+	for (const TSharedRef<FGASTagLeakDetector>& Detector : Detectors)
+	{
+		if (Detector->Monitor.Pin() == InMonitor)
+		{
+			return Detector;
+		}
+	}
+
+	TSharedRef<FGASTagLeakDetector> NewDetector = MakeShareable(new FGASTagLeakDetector(InMonitor));
+	NewDetector->Bind();
+	Detectors.Add(NewDetector);
+	return NewDetector;
+}
+
+TSharedPtr<FGASTagLeakDetector> FGASTagLeakDetector::FindOrCreate(UWorld* InWorld)
+{
+	if (!InWorld)
+	{
+		return nullptr;
+	}
+
+	return FindOrCreate(FGASWorldMonitor::FindOrCreate(InWorld));
+}
+
+TSharedPtr<FGASTagLeakDetector> FGASTagLeakDetector::Find(const UWorld* InWorld)
+{
+	TSharedPtr<FGASWorldMonitor> WorldMonitor = FGASWorldMonitor::Find(InWorld);
+	if (!WorldMonitor.IsValid())
+	{
+		return nullptr;
+	}
+
+	for (const TSharedRef<FGASTagLeakDetector>& Detector : Detectors)
+	{
+		if (Detector->Monitor.Pin() == WorldMonitor)
+		{
+			return Detector;
+		}
+	}
+
+	return nullptr;
+}
+
+void FGASTagLeakDetector::Start()
+{
+	if (bWatching)
+	{
+		return;
+	}
+
+	bWatching = true;
+
+	FGASWorldMonitor::SetAutoCreate(GASTagLeaks::AutoCreateOwner, true);
+	MonitorCreatedHandle = FGASWorldMonitor::OnMonitorCreated.AddStatic(&FGASTagLeakDetector::HandleMonitorCreated);
+
+	for (const TSharedRef<FGASWorldMonitor>& ExistingMonitor : FGASWorldMonitor::GetMonitors())
+	{
+		HandleMonitorCreated(ExistingMonitor);
+	}
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("Tag leak detector started, see GASAttachEditor.TagLeaks.Report"));
+}
+
+void FGASTagLeakDetector::Stop()
+{
+	Detectors.Reset();
+
+	if (!bWatching)
+	{
+		return;
+	}
+
+	bWatching = false;
+
+	FGASWorldMonitor::OnMonitorCreated.Remove(MonitorCreatedHandle);
+	FGASWorldMonitor::SetAutoCreate(GASTagLeaks::AutoCreateOwner, false);
+}
+
+void FGASTagLeakDetector::Reset()
+{
+	Stop();
+}
+
+void FGASTagLeakDetector::HandleMonitorCreated(const TSharedRef<FGASWorldMonitor>& InMonitor)
+{
+	FindOrCreate(InMonitor);
+}
+
+FGASTagLeakDetector::FGASTagLeakDetector(const TSharedRef<FGASWorldMonitor>& InMonitor)
+	:Monitor(InMonitor)
+	,CurrentBucket(0)
+	,ElapsedTime(0.0)
+	,SampleTime(0.f)
+	,BucketTime(0.f)
+{
+}
+
+FGASTagLeakDetector::~FGASTagLeakDetector()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	LocalMonitor->OnTick.Remove(TickHandle);
+	LocalMonitor->OnAbilitySystemChanged.Remove(AbilitySystemChangedHandle);
+}
+
+void FGASTagLeakDetector::Bind()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	TickHandle = LocalMonitor->OnTick.AddSP(this, &FGASTagLeakDetector::HandleTick);
+	AbilitySystemChangedHandle = LocalMonitor->OnAbilitySystemChanged.AddSP(this, &FGASTagLeakDetector::HandleAbilitySystemChanged);
+}
+
+void FGASTagLeakDetector::GetSuspects(TArray<FGASTagLeakSuspect>& OutSuspects) const
+{
+	for (const TPair<TWeakObjectPtr<const UAbilitySystemComponent>, TMap<FGameplayTag, FGASTagCountStats>>& AbilitySystemPair : Stats)
+	{
+		const UAbilitySystemComponent* ASC = AbilitySystemPair.Key.Get();
+		if (!ASC)
+		{
+			continue;
+		}
+
+		const FString ActorName = GASTagLeaks::GetActorName(ASC);
+		for (const TPair<FGameplayTag, FGASTagCountStats>& TagPair : AbilitySystemPair.Value)
+		{
+			const FGASTagCountStats& TagStats = TagPair.Value;
+			if (TagStats.Leaks == EGASTagLeak::None)
+			{
+				continue;
+			}
+
+			FGASTagLeakSuspect& Suspect = OutSuspects.AddDefaulted_GetRef();
+			Suspect.AbilitySystem = ASC;
+			Suspect.Tag = TagPair.Key;
+			Suspect.Leaks = TagStats.Leaks;
+			Suspect.Description = FString::Printf(TEXT("%s  %s  [%s]  count %d, loose %d, min-max per bucket: %s"),
+				*ActorName, *TagPair.Key.ToString(), *DescribeLeaks(TagStats.Leaks), TagStats.Count, TagStats.LooseCount, *TagStats.ToString(CurrentBucket));
+		}
+	}
+
+	OutSuspects.Sort([](const FGASTagLeakSuspect& A, const FGASTagLeakSuspect& B)
+	{
+		return A.Description < B.Description;
+	});
+}
+
+const FGASTagCountStats* FGASTagLeakDetector::FindStats(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag) const
+{
+	const TMap<FGameplayTag, FGASTagCountStats>* TagStats = Stats.Find(InASC);
+	return TagStats ? TagStats->Find(InTag) : nullptr;
+}
+
+FString FGASTagLeakDetector::DescribeLeaks(EGASTagLeak InLeaks)
+{
+	FString Description;
+	if (EnumHasAnyFlags(InLeaks, EGASTagLeak::Growing))
+	{
+		Description += TEXT("growing");
+	}
+	if (EnumHasAnyFlags(InLeaks, EGASTagLeak::Loose))
+	{
+		Description += Description.IsEmpty() ? TEXT("loose") : TEXT(", loose");
+	}
+	if (EnumHasAnyFlags(InLeaks, EGASTagLeak::HighCount))
+	{
+		Description += Description.IsEmpty() ? TEXT("high count") : TEXT(", high count");
+	}
+	return Description;
+}
+
+void FGASTagLeakDetector::SampleAbilitySystem(UAbilitySystemComponent* InASC)
+{
+	if (!InASC)
+	{
+		return;
+	}
+
+	// 只看显式标签，父标签的计数由子标签带来
+	// Only explicit tags are looked at; the parents' counts come from their children
+	FGameplayTagContainer OwnedTags;
+	InASC->GetOwnedGameplayTags(OwnedTags);
+
+	TMap<FGameplayTag, FGASTagCountStats>& TagStats = Stats.FindOrAdd(InASC);
+
+	// 计数归零的标签不会泄漏，直接删除
+	// Tags whose count reached zero cannot leak and are dropped
+	for (auto It = TagStats.CreateIterator(); It; ++It)
+	{
+		if (!OwnedTags.HasTagExact(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (OwnedTags.IsEmpty())
+	{
+		Stats.Remove(InASC);
+		return;
+	}
+
+	TSharedPtr<FGASTagSourceIndex> SourceIndex = FGASTagSourceIndex::FindOrCreate(InASC);
+
+	// 子标签计数每次采样只算一次，所有标签共用
+	// Child counts are computed once per sample and shared by every tag
+	TMap<FGameplayTag, int32> ChildCounts;
+	FGASTagSourceIndex::GetChildCounts(InASC, OwnedTags, ChildCounts);
+
+	const int32 GrowBuckets = CVarGASAttachEditorTagLeaksGrowBuckets.GetValueOnGameThread();
+	const double LooseSeconds = CVarGASAttachEditorTagLeaksLooseSeconds.GetValueOnGameThread();
+	const int32 HighCount = CVarGASAttachEditorTagLeaksHighCount.GetValueOnGameThread();
+
+	for (const FGameplayTag& Tag : OwnedTags)
+	{
+		const int32 Count = InASC->GetTagCount(Tag);
+		// 来自子标签的计数不算松散
+		// Counts that come from child tags are not loose
+		const FGASTagUnexplainedCount Unexplained = SourceIndex.IsValid() ? SourceIndex->GetUnexplainedCount(InASC, Tag, ChildCounts) : FGASTagUnexplainedCount();
+		const int32 LooseCount = Unexplained.Loose + Unexplained.Replicated;
+
+		FGASTagCountStats& TagStat = TagStats.FindOrAdd(Tag);
+		TagStat.Sample(Count, LooseCount, CurrentBucket, ElapsedTime);
+
+		TagStat.Leaks = EGASTagLeak::None;
+		if (TagStat.IsGrowing(CurrentBucket, GrowBuckets))
+		{
+			TagStat.Leaks |= EGASTagLeak::Growing;
+		}
+		if (TagStat.IsLooseLeak(ElapsedTime, LooseSeconds))
+		{
+			TagStat.Leaks |= EGASTagLeak::Loose;
+		}
+		if (HighCount > 0 && Count >= HighCount)
+		{
+			TagStat.Leaks |= EGASTagLeak::HighCount;
+		}
+
+		const EGASTagLeak NewLeaks = TagStat.Leaks & ~TagStat.ReportedLeaks;
+		if (NewLeaks != EGASTagLeak::None)
+		{
+			TagStat.ReportedLeaks |= NewLeaks;
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("Tag leak suspect on %s: %s [%s], count %d, loose %d"),
+				*GASTagLeaks::GetActorName(InASC), *Tag.ToString(), *DescribeLeaks(NewLeaks), Count, LooseCount);
+		}
+	}
+}
+
+void FGASTagLeakDetector::RollBuckets()
+{
+	CurrentBucket = (CurrentBucket + 1) % FGASTagCountStats::NumBuckets;
+
+	for (TPair<TWeakObjectPtr<const UAbilitySystemComponent>, TMap<FGameplayTag, FGASTagCountStats>>& AbilitySystemPair : Stats)
+	{
+		for (TPair<FGameplayTag, FGASTagCountStats>& TagPair : AbilitySystemPair.Value)
+		{
+			TagPair.Value.Roll(CurrentBucket);
+		}
+	}
+}
+
+void FGASTagLeakDetector::HandleTick(float InDeltaSeconds)
+{
+	ElapsedTime += InDeltaSeconds;
+	SampleTime += InDeltaSeconds;
+	BucketTime += InDeltaSeconds;
+
+	const float BucketSeconds = FMath::Max(1.f, CVarGASAttachEditorTagLeaksBucketSeconds.GetValueOnGameThread());
+	if (BucketTime >= BucketSeconds)
+	{
+		BucketTime = FMath::Fmod(BucketTime, BucketSeconds);
+		RollBuckets();
+	}
+
+	if (SampleTime < CVarGASAttachEditorTagLeaksSampleInterval.GetValueOnGameThread())
+	{
+		return;
+	}
+	SampleTime = 0.f;
+
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagLeaks);
+
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : LocalMonitor->GetAbilitySystems())
+	{
+		SampleAbilitySystem(WeakASC.Get());
+	}
+}
+
+void FGASTagLeakDetector::HandleAbilitySystemChanged(UAbilitySystemComponent* InASC, bool bAdded)
+{
+	if (bAdded)
+	{
+		return;
+	}
+
+	// 被销毁的ASC以空指针广播，删除已经失效的键
+	// A destroyed ASC is broadcast as null, so the stale keys are dropped
+	for (auto It = Stats.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class FGASWorldMonitor;
+class UAbilitySystemComponent;
+class UWorld;
+
+// 疑似泄漏的原因
+// Why a tag count is suspected of leaking
+enum class EGASTagLeak : uint8
+{
+	None = 0,
+
+	// 连续几个时间段的最小计数只增不减
+	// The minimum count kept rising over consecutive time buckets
+	Growing = 1 << 0,
+
+	// 技能和效果解释不了的计数一直没有归零，期间还在增加或者标签计数一直在变
+	// A count no ability or effect explains never went back to zero while it grew or the tag count kept changing
+	Loose = 1 << 1,
+
+	// 计数高得不合理
+	// Implausibly high count
+	HighCount = 1 << 2,
+};
+ENUM_CLASS_FLAGS(EGASTagLeak)
+
+// 一个ASC上一个标签的计数统计，每个时间段只记最小值和最大值，环形使用，内存大小固定
+// 标签计数归零时整条记录删除，所以只有还在的标签占内存
+//
+// Count statistics of one tag on one ASC; each time bucket only keeps its min and max and the buckets are used as a ring, so the size is fixed
+// The whole entry is dropped once the count reaches zero, so only tags still held take memory
+struct FGASTagCountStats
+{
+	static constexpr int32 NumBuckets = 16;
+
+	FGASTagCountStats();
+
+	void Sample(int32 InCount, int32 InLooseCount, int32 InCurrentBucket, double InTime);
+
+	// 开始新的时间段，用上一次的采样填充
+	// Starts a new bucket, seeded with the last sample
+	void Roll(int32 InNewBucket);
+
+	// 最近的 InNumBuckets 个已结束时间段里最小计数只增不减，并且确实增加了
+	// The minimum count never dropped and did rise over the last InNumBuckets ended buckets
+	bool IsGrowing(int32 InCurrentBucket, int32 InNumBuckets) const;
+
+	// 松散计数持续了 InLooseSeconds 以上，并且比开始时多，或者期间标签计数变过
+	// 设计上一直松散持有、计数不变的标签不算
+	// The loose count lasted InLooseSeconds or longer and either rose above its starting value or the tag count changed meanwhile
+	// Tags held loosely and steadily by design do not count
+	bool IsLooseLeak(double InTime, double InLooseSeconds) const;
+
+	FString ToString(int32 InCurrentBucket) const;
+
+	uint16 MinCounts[NumBuckets];
+
+	uint16 MaxCounts[NumBuckets];
+
+	// 已结束的时间段数，最多 NumBuckets - 1
+	// Number of ended buckets, at most NumBuckets - 1
+	int32 NumEndedBuckets;
+
+	int32 Count;
+
+	int32 LooseCount;
+
+	// 松散计数开始大于零的时间，没有时为负数
+	// Time the loose count went above zero, negative while there is none
+	double LooseSince;
+
+	// 松散计数开始大于零时的值
+	// Loose count when it went above zero
+	int32 LooseStartCount;
+
+	// 松散期间标签计数变过
+	// The tag count changed while loose
+	bool bLooseChurned;
+
+	EGASTagLeak Leaks;
+
+	// 已经输出过警告的原因，只在新增原因时再警告
+	// Reasons already logged; a warning is only logged again for a new reason
+	EGASTagLeak ReportedLeaks;
+};
+
+// 一个疑似泄漏的标签
+// One tag suspected of leaking
+struct FGASTagLeakSuspect
+{
+	TWeakObjectPtr<const UAbilitySystemComponent> AbilitySystem;
+
+	FGameplayTag Tag;
+
+	EGASTagLeak Leaks = EGASTagLeak::None;
+
+	FString Description;
+};
+
+// 长时间运行的标签计数泄漏检测，定期用 GetTagCount 采样一个世界里所有ASC的显式标签
+// 标记计数只增不减的标签、技能或效果结束后没有归零的松散标签，以及计数过高的标签
+// 采样间隔、时间段长度和阈值都是控制台变量，GASAttachEditor.TagLeaks.Start 之后自动挂到每个游戏世界上
+//
+// Long-running tag count leak detection; periodically samples the explicit tags of every ASC of one world with GetTagCount
+// Flags counts that only grow, loose tags that never went back to zero after the ability or effect that added them ended, and implausibly high counts
+// The sample interval, bucket length and thresholds are console variables; after GASAttachEditor.TagLeaks.Start it attaches to every game world
+class FGASTagLeakDetector : public TSharedFromThis<FGASTagLeakDetector>
+{
+public:
+
+	~FGASTagLeakDetector();
+
+	// 每个世界监听器一个，创建之后开始采样
+	// One per world monitor; sampling starts once created
+	static TSharedRef<FGASTagLeakDetector> FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	static TSharedPtr<FGASTagLeakDetector> FindOrCreate(UWorld* InWorld);
+
+	// 不创建，没有在检测时返回空
+	// Does not create; null while the world is not being watched
+	static TSharedPtr<FGASTagLeakDetector> Find(const UWorld* InWorld);
+
+	// 为每个游戏世界创建检测，直到停止
+	// Watches every game world until stopped
+	static void Start();
+	static void Stop();
+
+	static bool IsWatching() { return bWatching; }
+
+	// 模块关闭时调用
+	// Called on module shutdown
+	static void Reset();
+
+public:
+
+	// 按ASC和标签排序
+	// Sorted by ASC and tag
+	void GetSuspects(TArray<FGASTagLeakSuspect>& OutSuspects) const;
+
+	const FGASTagCountStats* FindStats(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag) const;
+
+	int32 GetCurrentBucket() const { return CurrentBucket; }
+
+	// 开始检测后经过的游戏时间
+	// Game time since watching started
+	double GetElapsedTime() const { return ElapsedTime; }
+
+	static FString DescribeLeaks(EGASTagLeak InLeaks);
+
+private:
+
+	explicit FGASTagLeakDetector(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	void Bind();
+
+	void SampleAbilitySystem(UAbilitySystemComponent* InASC);
+
+	void RollBuckets();
+
+	void HandleTick(float InDeltaSeconds);
+
+	void HandleAbilitySystemChanged(UAbilitySystemComponent* InASC, bool bAdded);
+
+	static void HandleMonitorCreated(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+private:
+
+	TWeakPtr<FGASWorldMonitor> Monitor;
+
+	TMap<TWeakObjectPtr<const UAbilitySystemComponent>, TMap<FGameplayTag, FGASTagCountStats>> Stats;
+
+	int32 CurrentBucket;
+
+	double ElapsedTime;
+
+	float SampleTime;
+
+	float BucketTime;
+
+	FDelegateHandle TickHandle;
+
+	FDelegateHandle AbilitySystemChangedHandle;
+
+	static TArray<TSharedRef<FGASTagLeakDetector>> Detectors;
+
+	static FDelegateHandle MonitorCreatedHandle;
+
+	static bool bWatching;
+};
@@ -0,0 +1,442 @@
+#include "Monitor/GASTagSourceIndex.h"
+#include "Monitor/GASWorldMonitor.h"
+#include "Capture/GASCaptureSampler.h"
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "GASAttachEditorStats.h"
+
+TArray<TSharedRef<FGASTagSourceIndex>> FGASTagSourceIndex::Indices;
+
+namespace GASTagSourceIndex
+{
+	// 复制来的松散标签；服务器上的最小复制标签由效果授予，已经算在效果里了
+	// Replicated loose tags; on the server the minimal replication tags are granted by effects and already counted with them
+	int32 GetReplicatedCount(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag)
+	{
+		int32 Count = InASC->GetReplicatedLooseTags().TagMap.FindRef(InTag);
+		if (!InASC->IsOwnerActorAuthoritative())
+		{
+			Count += InASC->GetMinimalReplicationTags().TagMap.FindRef(InTag);
+		}
+		return Count;
+	}
+}
+
+TSharedRef<FGASTagSourceIndex> FGASTagSourceIndex::FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor)
+{
+	Indices.RemoveAll([](const TSharedRef<FGASTagSourceIndex>& Index)
+	{
+		return !Index->Monitor.IsValid();
+	});
+
+	for (const TSharedRef<FGASTagSourceIndex>& Index : Indices)
+	{
+		if (Index->Monitor.Pin() == InMonitor)
+		{
+			return Index;
+		}
+	}
+
+	TSharedRef<FGASTagSourceIndex> NewIndex = MakeShareable(new FGASTagSourceIndex(InMonitor));
+	NewIndex->Bind();
+	Indices.Add(NewIndex);
+	return NewIndex;
+}
+
+TSharedPtr<FGASTagSourceIndex> FGASTagSourceIndex::FindOrCreate(const UAbilitySystemComponent* InASC)
+{
+	UWorld* World = InASC ? InASC->GetWorld() : nullptr;
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	return FindOrCreate(FGASWorldMonitor::FindOrCreate(World));
+}
+
+void FGASTagSourceIndex::Reset()
+{
+	Indices.Reset();
+}
+
+FGASTagSourceIndex::FGASTagSourceIndex(const TSharedRef<FGASWorldMonitor>& InMonitor)
+	:Monitor(InMonitor)
+{
+}
+
+FGASTagSourceIndex::~FGASTagSourceIndex()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	LocalMonitor->OnEffectChanged.Remove(EffectChangedHandle);
+	LocalMonitor->OnAbilityEvent.Remove(AbilityEventHandle);
+	LocalMonitor->OnAbilitySystemChanged.Remove(AbilitySystemChangedHandle);
+	LocalMonitor->OnTagChanged.Remove(TagChangedHandle);
+}
+
+void FGASTagSourceIndex::Bind()
+{
+	TSharedPtr<FGASWorldMonitor> LocalMonitor = Monitor.Pin();
+	if (!LocalMonitor.IsValid())
+	{
+		return;
+	}
+
+	EffectChangedHandle = LocalMonitor->OnEffectChanged.AddSP(this, &FGASTagSourceIndex::HandleEffectChanged);
+	AbilityEventHandle = LocalMonitor->OnAbilityEvent.AddSP(this, &FGASTagSourceIndex::HandleAbilityEvent);
+	AbilitySystemChangedHandle = LocalMonitor->OnAbilitySystemChanged.AddSP(this, &FGASTagSourceIndex::HandleAbilitySystemChanged);
+	TagChangedHandle = LocalMonitor->OnTagChanged.AddSP(this, &FGASTagSourceIndex::HandleTagChanged);
+}
+
+const TArray<FGASTagSource>* FGASTagSourceIndex::FindSources(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag, bool bBlocked)
+{
+	if (!InASC)
+	{
+		return nullptr;
+	}
+
+	FAbilitySystemIndex& Index = FindOrBuild(InASC);
+	return bBlocked ? Index.BlockedSources.Find(InTag) : Index.OwnedSources.Find(InTag);
+}
+
+void FGASTagSourceIndex::GetChildCounts(const UAbilitySystemComponent* InASC, const FGameplayTagContainer& InOwnedTags, TMap<FGameplayTag, int32>& OutChildCounts)
+{
+	OutChildCounts.Reset();
+	if (!InASC)
+	{
+		return;
+	}
+
+	// 从每个持有的标签往上走，每个直接子标签只在它的父标签上加一次计数；走到已经处理过的子标签时上面的祖先也都处理过了
+	// Walks up from every held tag and adds each direct child's count to its parent once; once a child was handled its ancestors were too
+	TSet<FGameplayTag> HandledChildren;
+	for (const FGameplayTag& Tag : InOwnedTags)
+	{
+		FGameplayTag Child = Tag;
+		for (FGameplayTag Parent = Child.RequestDirectParent(); Parent.IsValid(); Parent = Parent.RequestDirectParent())
+		{
+			bool bAlreadyHandled = false;
+			HandledChildren.Add(Child, &bAlreadyHandled);
+			if (bAlreadyHandled)
+			{
+				break;
+			}
+
+			OutChildCounts.FindOrAdd(Parent) += InASC->GetTagCount(Child);
+			Child = Parent;
+		}
+	}
+}
+
+uint32 FGASTagSourceIndex::GetSerial(const UAbilitySystemComponent* InASC) const
+{
+	const FAbilitySystemIndex* Index = AbilitySystems.Find(InASC);
+	return Index ? Index->Serial : 0;
+}
+
+FGASTagUnexplainedCount FGASTagSourceIndex::GetUnexplainedCount(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag)
+{
+	if (!InASC)
+	{
+		return FGASTagUnexplainedCount();
+	}
+
+	FGameplayTagContainer OwnedTags;
+	InASC->GetOwnedGameplayTags(OwnedTags);
+
+	TMap<FGameplayTag, int32> ChildCounts;
+	GetChildCounts(InASC, OwnedTags, ChildCounts);
+
+	return GetUnexplainedCount(InASC, InTag, ChildCounts);
+}
+
+FGASTagUnexplainedCount FGASTagSourceIndex::GetUnexplainedCount(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag, const TMap<FGameplayTag, int32>& InChildCounts)
+{
+	FGASTagUnexplainedCount Unexplained;
+	if (!InASC)
+	{
+		return Unexplained;
+	}
+
+	// 计数包括子标签，先去掉它们得到这个标签的显式计数
+	// The count includes child tags; removing them leaves the explicit count of this tag
+	Unexplained.Child = FMath::Min(InChildCounts.FindRef(InTag), InASC->GetTagCount(InTag));
+
+	int32 Count = InASC->GetTagCount(InTag) - Unexplained.Child;
+	if (const TArray<FGASTagSource>* Sources = FindSources(InASC, InTag))
+	{
+		for (const FGASTagSource& Source : *Sources)
+		{
+			// 效果无论多少层只授予一次标签
+			// An effect grants its tags once whatever its stack count
+			Count -= Source.Type == EGASTagSourceType::Effect ? 1 : Source.Count;
+		}
+	}
+
+	Count = FMath::Max(0, Count);
+	Unexplained.Replicated = FMath::Min(Count, GASTagSourceIndex::GetReplicatedCount(InASC, InTag));
+	Unexplained.Loose = Count - Unexplained.Replicated;
+	return Unexplained;
+}
+
+FString FGASTagSourceIndex::DescribeSources(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag, bool bBlocked)
+{
+	FString Description;
+
+	if (const TArray<FGASTagSource>* Sources = FindSources(InASC, InTag, bBlocked))
+	{
+		for (const FGASTagSource& Source : *Sources)
+		{
+			if (Source.Type == EGASTagSourceType::Ability)
+			{
+				Description += FString::Printf(TEXT("\n  Ability  %s"), *Source.Name.ToString());
+				if (Source.Count > 1)
+				{
+					Description += FString::Printf(TEXT(" x%d"), Source.Count);
+				}
+			}
+			else
+			{
+				Description += FString::Printf(TEXT("\n  Effect  %s  (handle %d)"), *Source.Name.ToString(), Source.Handle);
+			}
+		}
+	}
+
+	if (!bBlocked)
+	{
+		const FGASTagUnexplainedCount Unexplained = GetUnexplainedCount(InASC, InTag);
+		if (Unexplained.Replicated > 0)
+		{
+			Description += FString::Printf(TEXT("\n  Replicated  x%d"), Unexplained.Replicated);
+		}
+		if (Unexplained.Loose > 0)
+		{
+			Description += FString::Printf(TEXT("\n  Loose  x%d"), Unexplained.Loose);
+		}
+		if (Unexplained.Child > 0)
+		{
+			Description += FString::Printf(TEXT("\n  Child tags  x%d"), Unexplained.Child);
+		}
+	}
+
+	return Description;
+}
+
+FGASTagSourceIndex::FAbilitySystemIndex& FGASTagSourceIndex::FindOrBuild(const UAbilitySystemComponent* InASC)
+{
+	if (FAbilitySystemIndex* Found = AbilitySystems.Find(InASC))
+	{
+		return *Found;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagSourceIndex);
+
+	FAbilitySystemIndex& Index = AbilitySystems.Add(InASC);
+	Index.Serial = ++NextSerial;
+
+	if (const FActiveGameplayEffectsContainer* ActiveGameplayEffects = FGASCaptureSampler::GetActiveGameplayEffects(InASC))
+	{
+		for (const FActiveGameplayEffect& ActiveGE : ActiveGameplayEffects)
+		{
+			FGameplayTagContainer GrantedTags;
+			ActiveGE.Spec.GetAllGrantedTags(GrantedTags);
+			if (GrantedTags.IsEmpty())
+			{
+				continue;
+			}
+
+			const int32 Handle = GetTypeHash(ActiveGE.Handle);
+			AddSource(Index.OwnedSources, GrantedTags, EGASTagSourceType::Effect, ActiveGE.Spec.Def ? ActiveGE.Spec.Def->GetClass()->GetFName() : NAME_None, Handle, 1);
+			Index.EffectTags.Add(Handle, MoveTemp(GrantedTags));
+		}
+	}
+
+	for (const FGameplayAbilitySpec& AbilitySpec : InASC->GetActivatableAbilities())
+	{
+		if (!AbilitySpec.Ability || !AbilitySpec.IsActive())
+		{
+			continue;
+		}
+
+		const FName AbilityName = AbilitySpec.Ability->GetClass()->GetFName();
+		if (const FGameplayTagContainer* OwnedTags = GetAbilityTags(AbilitySpec.Ability, false))
+		{
+			AddSource(Index.OwnedSources, *OwnedTags, EGASTagSourceType::Ability, AbilityName, INDEX_NONE, AbilitySpec.ActiveCount);
+		}
+		if (const FGameplayTagContainer* BlockedTags = GetAbilityTags(AbilitySpec.Ability, true))
+		{
+			AddSource(Index.BlockedSources, *BlockedTags, EGASTagSourceType::Ability, AbilityName, INDEX_NONE, AbilitySpec.ActiveCount);
+		}
+	}
+
+	return Index;
+}
+
+void FGASTagSourceIndex::AddSource(TMap<FGameplayTag, TArray<FGASTagSource>>& InOutSources, const FGameplayTagContainer& InTags, EGASTagSourceType InType, FName InName, int32 InHandle, int32 InCount)
+{
+	for (const FGameplayTag& Tag : InTags)
+	{
+		TArray<FGASTagSource>& Sources = InOutSources.FindOrAdd(Tag);
+
+		FGASTagSource* Source = Sources.FindByPredicate([InType, InName, InHandle](const FGASTagSource& Item)
+		{
+			return Item.Type == InType && Item.Name == InName && Item.Handle == InHandle;
+		});
+
+		if (!Source)
+		{
+			Source = &Sources.AddDefaulted_GetRef();
+			Source->Type = InType;
+			Source->Name = InName;
+			Source->Handle = InHandle;
+		}
+
+		Source->Count += InCount;
+	}
+}
+
+void FGASTagSourceIndex::RemoveSource(TMap<FGameplayTag, TArray<FGASTagSource>>& InOutSources, const FGameplayTagContainer& InTags, EGASTagSourceType InType, FName InName, int32 InHandle)
+{
+	for (const FGameplayTag& Tag : InTags)
+	{
+		TArray<FGASTagSource>* Sources = InOutSources.Find(Tag);
+		if (!Sources)
+		{
+			continue;
+		}
+
+		const int32 SourceIndex = Sources->IndexOfByPredicate([InType, InName, InHandle](const FGASTagSource& Item)
+		{
+			return Item.Type == InType && Item.Name == InName && Item.Handle == InHandle;
+		});
+
+		if (SourceIndex != INDEX_NONE && --(*Sources)[SourceIndex].Count <= 0)
+		{
+			Sources->RemoveAtSwap(SourceIndex, 1, false);
+		}
+
+		if (Sources->Num() == 0)
+		{
+			InOutSources.Remove(Tag);
+		}
+	}
+}
+
+const FGameplayTagContainer* FGASTagSourceIndex::GetAbilityTags(const UGameplayAbility* InAbility, bool bBlocked)
+{
+	static FProperty* OwnedTagsProperty = FindFProperty<FProperty>(UGameplayAbility::StaticClass(), TEXT("ActivationOwnedTags"));
+	static FProperty* BlockedTagsProperty = FindFProperty<FProperty>(UGameplayAbility::StaticClass(), TEXT("BlockAbilitiesWithTag"));
+
+	FProperty* Property = bBlocked ? BlockedTagsProperty : OwnedTagsProperty;
+	if (!Property || !InAbility)
+	{
+		return nullptr;
+	}
+
+	const FGameplayTagContainer* Tags = Property->ContainerPtrToValuePtr<FGameplayTagContainer>(InAbility);
+	return Tags && !Tags->IsEmpty() ? Tags : nullptr;
+}
+
+void FGASTagSourceIndex::HandleEffectChanged(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle, bool bApplied)
+{
+	FAbilitySystemIndex* Index = AbilitySystems.Find(InASC);
+	if (!Index)
+	{
+		return;
+	}
+
+	Index->Serial = ++NextSerial;
+
+	const int32 Handle = GetTypeHash(InHandle);
+	const FName EffectName = InSpec.Def ? InSpec.Def->GetClass()->GetFName() : NAME_None;
+
+	if (bApplied)
+	{
+		FGameplayTagContainer GrantedTags;
+		InSpec.GetAllGrantedTags(GrantedTags);
+		if (!GrantedTags.IsEmpty() && !Index->EffectTags.Contains(Handle))
+		{
+			AddSource(Index->OwnedSources, GrantedTags, EGASTagSourceType::Effect, EffectName, Handle, 1);
+			Index->EffectTags.Add(Handle, MoveTemp(GrantedTags));
+		}
+	}
+	else
+	{
+		FGameplayTagContainer GrantedTags;
+		if (Index->EffectTags.RemoveAndCopyValue(Handle, GrantedTags))
+		{
+			RemoveSource(Index->OwnedSources, GrantedTags, EGASTagSourceType::Effect, EffectName, Handle);
+		}
+	}
+}
+
+void FGASTagSourceIndex::HandleAbilityEvent(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, EGASMonitorAbilityEvent InEvent, const FGameplayTagContainer& InFailureTags)
+{
+	FAbilitySystemIndex* Index = AbilitySystems.Find(InASC);
+	if (!Index || !InAbility || InEvent == EGASMonitorAbilityEvent::Failed)
+	{
+		return;
+	}
+
+	Index->Serial = ++NextSerial;
+
+	const FName AbilityName = InAbility->GetClass()->GetFName();
+	const FGameplayTagContainer* OwnedTags = GetAbilityTags(InAbility, false);
+	const FGameplayTagContainer* BlockedTags = GetAbilityTags(InAbility, true);
+
+	if (InEvent == EGASMonitorAbilityEvent::Activated)
+	{
+		if (OwnedTags)
+		{
+			AddSource(Index->OwnedSources, *OwnedTags, EGASTagSourceType::Ability, AbilityName, INDEX_NONE, 1);
+		}
+		if (BlockedTags)
+		{
+			AddSource(Index->BlockedSources, *BlockedTags, EGASTagSourceType::Ability, AbilityName, INDEX_NONE, 1);
+		}
+	}
+	else
+	{
+		if (OwnedTags)
+		{
+			RemoveSource(Index->OwnedSources, *OwnedTags, EGASTagSourceType::Ability, AbilityName, INDEX_NONE);
+		}
+		if (BlockedTags)
+		{
+			RemoveSource(Index->BlockedSources, *BlockedTags, EGASTagSourceType::Ability, AbilityName, INDEX_NONE);
+		}
+	}
+}
+
+void FGASTagSourceIndex::HandleAbilitySystemChanged(UAbilitySystemComponent* InASC, bool bAdded)
+{
+	if (!bAdded)
+	{
+		AbilitySystems.Remove(InASC);
+	}
+
+	// 顺便清理已经销毁的ASC
+	// Also drops ASCs that were destroyed
+	for (auto It = AbilitySystems.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FGASTagSourceIndex::HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 NewCount)
+{
+	// 松散标签和复制的标签没有单独的事件，计数变了描述就可能变
+	// Loose and replicated tags have no event of their own; the description may change whenever a count does
+	if (FAbilitySystemIndex* Index = AbilitySystems.Find(InASC))
+	{
+		Index->Serial = ++NextSerial;
+	}
+}
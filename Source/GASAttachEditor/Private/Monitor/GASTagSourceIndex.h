@@ -0,0 +1,167 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "GameplayEffectTypes.h"
+
+class FGASWorldMonitor;
+class UAbilitySystemComponent;
+class UGameplayAbility;
+struct FGameplayEffectSpec;
+enum class EGASMonitorAbilityEvent : uint8;
+
+enum class EGASTagSourceType : uint8
+{
+	// 激活中的技能 (ActivationOwnedTags / BlockAbilitiesWithTag)
+	// Active ability (ActivationOwnedTags / BlockAbilitiesWithTag)
+	Ability,
+
+	// 持续效果授予的标签
+	// Granted by an active effect
+	Effect,
+};
+
+// 一个标签的一个来源
+// One source of one tag
+struct FGASTagSource
+{
+	EGASTagSourceType Type = EGASTagSourceType::Ability;
+
+	// 技能类 / 效果类
+	// Ability class / effect class
+	FName Name;
+
+	// 效果句柄，技能为 INDEX_NONE
+	// Effect handle, INDEX_NONE for abilities
+	int32 Handle = INDEX_NONE;
+
+	// 同一个技能同时激活的次数
+	// Number of concurrent activations of the same ability
+	int32 Count = 0;
+};
+
+// 技能和效果解释不了的数量，按来源拆开
+// Count not explained by abilities and effects, split by where it comes from
+struct FGASTagUnexplainedCount
+{
+	// 复制来的松散标签 (ReplicatedLooseTags)，客户端上还包括最小复制模式的标签
+	// Replicated loose tags (ReplicatedLooseTags), plus the minimal replication tags on clients
+	int32 Replicated = 0;
+
+	// 显式计数里剩下的部分，代码直接添加的松散标签
+	// What is left of the explicit count, loose tags added directly by code
+	int32 Loose = 0;
+
+	// 父标签的计数里来自更具体的子标签的部分
+	// Part of a parent tag's count that comes from a more specific tag
+	int32 Child = 0;
+};
+
+// 每个ASC一份 标签 -> 来源 的倒排索引
+// 第一次查询某个ASC时从它当前的状态建立，之后由监听器的事件维护，查询是一次哈希查找
+//
+// Per-ASC inverted index from tag to its sources
+// Built from the ASC's current state on its first query, then maintained from the monitor's events; a query is one hash lookup
+class FGASTagSourceIndex : public TSharedFromThis<FGASTagSourceIndex>
+{
+public:
+
+	~FGASTagSourceIndex();
+
+	// 每个世界监听器一个
+	// One per world monitor
+	static TSharedRef<FGASTagSourceIndex> FindOrCreate(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	// 查找ASC所在世界的索引，需要时创建
+	// Finds the index of the ASC's world, creating it when needed
+	static TSharedPtr<FGASTagSourceIndex> FindOrCreate(const UAbilitySystemComponent* InASC);
+
+	// 模块关闭时调用
+	// Called on module shutdown
+	static void Reset();
+
+public:
+
+	// bBlocked 为真时查找阻止技能的标签 (GetBlockedAbilityTags) 的来源
+	// With bBlocked, looks up the sources of a blocked ability tag (GetBlockedAbilityTags)
+	const TArray<FGASTagSource>* FindSources(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag, bool bBlocked = false);
+
+	// 技能和效果解释不了的数量: 复制的标签、松散标签，或者来自子标签
+	// Count not explained by abilities and effects: replicated tags, loose tags, or counted through a child tag
+	FGASTagUnexplainedCount GetUnexplainedCount(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag);
+
+	// 同上，子标签计数来自 GetChildCounts，一次采样里查询很多标签时只算一次
+	// Same as above with the child counts from GetChildCounts, computed once when a sample queries many tags
+	FGASTagUnexplainedCount GetUnexplainedCount(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag, const TMap<FGameplayTag, int32>& InChildCounts);
+
+	// 父标签 -> 它的计数里来自更具体的持有标签的部分，遍历一次持有的标签
+	// Parent tag -> the part of its count that comes from more specific held tags, in one pass over the held tags
+	static void GetChildCounts(const UAbilitySystemComponent* InASC, const FGameplayTagContainer& InOwnedTags, TMap<FGameplayTag, int32>& OutChildCounts);
+
+	// 多行文字描述，提示和 "标签来源" 面板共用
+	// Multi-line description shared by the tooltip and the "Tag Sources" panel
+	FString DescribeSources(const UAbilitySystemComponent* InASC, const FGameplayTag& InTag, bool bBlocked = false);
+
+	// 这个ASC的来源或者标签计数变化时改变，界面用它判断缓存的描述是否过期；没有建立索引的ASC为0
+	// Changes when this ASC's sources or tag counts change; the UI uses it to tell whether a cached description is stale. 0 for ASCs not indexed
+	uint32 GetSerial(const UAbilitySystemComponent* InASC) const;
+
+private:
+
+	explicit FGASTagSourceIndex(const TSharedRef<FGASWorldMonitor>& InMonitor);
+
+	void Bind();
+
+	struct FAbilitySystemIndex
+	{
+		TMap<FGameplayTag, TArray<FGASTagSource>> OwnedSources;
+
+		TMap<FGameplayTag, TArray<FGASTagSource>> BlockedSources;
+
+		// 效果句柄 -> 它授予的标签，移除时用
+		// Effect handle -> the tags it granted, used on removal
+		TMap<int32, FGameplayTagContainer> EffectTags;
+
+		// 取自 NextSerial，重新建立的索引也不会和旧值相同
+		// Taken from NextSerial so a rebuilt index never repeats an old value
+		uint32 Serial = 0;
+	};
+
+	FAbilitySystemIndex& FindOrBuild(const UAbilitySystemComponent* InASC);
+
+	static void AddSource(TMap<FGameplayTag, TArray<FGASTagSource>>& InOutSources, const FGameplayTagContainer& InTags, EGASTagSourceType InType, FName InName, int32 InHandle, int32 InCount);
+
+	static void RemoveSource(TMap<FGameplayTag, TArray<FGASTagSource>>& InOutSources, const FGameplayTagContainer& InTags, EGASTagSourceType InType, FName InName, int32 InHandle);
+
+	// ActivationOwnedTags 和 BlockAbilitiesWithTag 是 protected 的，通过反射访问
+	// ActivationOwnedTags and BlockAbilitiesWithTag are protected and are reached through reflection
+	static const FGameplayTagContainer* GetAbilityTags(const UGameplayAbility* InAbility, bool bBlocked);
+
+	void HandleEffectChanged(UAbilitySystemComponent* InASC, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InHandle, bool bApplied);
+
+	void HandleAbilityEvent(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, EGASMonitorAbilityEvent InEvent, const FGameplayTagContainer& InFailureTags);
+
+	void HandleAbilitySystemChanged(UAbilitySystemComponent* InASC, bool bAdded);
+
+	void HandleTagChanged(UAbilitySystemComponent* InASC, const FGameplayTag& InTag, int32 NewCount);
+
+private:
+
+	TWeakPtr<FGASWorldMonitor> Monitor;
+
+	// 只有查询过的ASC才建立和维护
+	// Only ASCs that were queried are built and maintained
+	TMap<TWeakObjectPtr<const UAbilitySystemComponent>, FAbilitySystemIndex> AbilitySystems;
+
+	FDelegateHandle EffectChangedHandle;
+
+	FDelegateHandle AbilityEventHandle;
+
+	FDelegateHandle AbilitySystemChangedHandle;
+
+	FDelegateHandle TagChangedHandle;
+
+	uint32 NextSerial = 0;
+
+	static TArray<TSharedRef<FGASTagSourceIndex>> Indices;
+};
@@ -0,0 +1,416 @@
+#include "Monitor/GASWorldMonitor.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayTasksComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "UObject/UObjectHash.h"
+#include "GASAttachEditorStats.h"
+
+CSV_DEFINE_CATEGORY(GASAttachEditor, true);
+
+static TAutoConsoleVariable<int32> CVarGASAttachEditorCsvEnable(
+	TEXT("GASAttachEditor.Csv.Enable"),
+	0,
+	TEXT("When non-zero and a CSV profile is being captured, every game world is monitored and per-frame GAS metrics are written to the GASAttachEditor CSV category."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarGASAttachEditorRescanInterval(
+	TEXT("GASAttachEditor.Monitor.RescanInterval"),
+	5.f,
+	TEXT("Game seconds between safety rescans for ASCs that were added to already spawned actors. 0 disables the rescan."),
+	ECVF_Default);
+
+TArray<TSharedRef<FGASWorldMonitor>> FGASWorldMonitor::Monitors;
+FDelegateHandle FGASWorldMonitor::PostActorTickHandle;
+FDelegateHandle FGASWorldMonitor::WorldCleanupHandle;
+TSet<FName> FGASWorldMonitor::AutoCreateOwners;
+FOnGASMonitorCreated FGASWorldMonitor::OnMonitorCreated;
+
+namespace GASWorldMonitor
+{
+	// KnownTasks 是 protected 的，但它是带反射的 UPROPERTY
+	// KnownTasks is protected, but it is a reflected UPROPERTY
+	int32 GetLiveTaskCount(const UAbilitySystemComponent* InASC)
+	{
+		static FArrayProperty* KnownTasksProperty = FindFProperty<FArrayProperty>(UGameplayTasksComponent::StaticClass(), TEXT("KnownTasks"));
+		if (!KnownTasksProperty || !InASC)
+		{
+			return 0;
+		}
+
+		FScriptArrayHelper KnownTasks(KnownTasksProperty, KnownTasksProperty->ContainerPtrToValuePtr<void>(InASC));
+		return KnownTasks.Num();
+	}
+}
+
+void FGASWorldMonitor::Startup()
+{
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&FGASWorldMonitor::HandleWorldPostActorTick);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FGASWorldMonitor::HandleWorldCleanup);
+}
+
+void FGASWorldMonitor::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+	Monitors.Reset();
+	AutoCreateOwners.Reset();
+}
+
+TSharedPtr<FGASWorldMonitor> FGASWorldMonitor::Find(const UWorld* InWorld)
+{
+	for (const TSharedRef<FGASWorldMonitor>& Monitor : Monitors)
+	{
+		if (Monitor->World.Get() == InWorld)
+		{
+			return Monitor;
+		}
+	}
+	return nullptr;
+}
+
+TSharedRef<FGASWorldMonitor> FGASWorldMonitor::FindOrCreate(UWorld* InWorld)
+{
+	check(InWorld);
+
+	if (TSharedPtr<FGASWorldMonitor> Monitor = Find(InWorld))
+	{
+		return Monitor.ToSharedRef();
+	}
+
+	TSharedRef<FGASWorldMonitor> NewMonitor = MakeShareable(new FGASWorldMonitor(InWorld));
+	Monitors.Add(NewMonitor);
+
+	NewMonitor->ScanAbilitySystems();
+
+	OnMonitorCreated.Broadcast(NewMonitor);
+
+	return NewMonitor;
+}
+
+void FGASWorldMonitor::SetAutoCreate(FName InOwner, bool bEnabled)
+{
+	if (bEnabled)
+	{
+		AutoCreateOwners.Add(InOwner);
+	}
+	else
+	{
+		AutoCreateOwners.Remove(InOwner);
+	}
+}
+
+FGASWorldMonitor::FGASWorldMonitor(UWorld* InWorld)
+	:World(InWorld)
+	,FrameNumber(GFrameCounter)
+	,TimeSinceScan(0.f)
+{
+	ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FGASWorldMonitor::HandleActorSpawned));
+}
+
+FGASWorldMonitor::~FGASWorldMonitor()
+{
+	if (UWorld* LocalWorld = World.Get())
+	{
+		LocalWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	for (FBoundAbilitySystem& Bound : BoundAbilitySystems)
+	{
+		UAbilitySystemComponent* ASC = Bound.ASC.Get();
+		if (!ASC)
+		{
+			continue;
+		}
+
+		ASC->OnGameplayEffectAppliedDelegateToSelf.Remove(Bound.EffectAppliedHandle);
+		ASC->OnActiveGameplayEffectAddedDelegateToSelf.Remove(Bound.EffectAddedHandle);
+		ASC->OnAnyGameplayEffectRemovedDelegate().Remove(Bound.EffectRemovedHandle);
+		ASC->RegisterGenericGameplayTagEvent().Remove(Bound.TagChangedHandle);
+		ASC->AbilityActivatedCallbacks.Remove(Bound.AbilityActivatedHandle);
+		ASC->AbilityEndedCallbacks.Remove(Bound.AbilityEndedHandle);
+		ASC->AbilityFailedCallbacks.Remove(Bound.AbilityFailedHandle);
+	}
+}
+
+UWorld* FGASWorldMonitor::GetWorld() const
+{
+	return World.Get();
+}
+
+const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& FGASWorldMonitor::GetAbilitySystems() const
+{
+	return AbilitySystems;
+}
+
+void FGASWorldMonitor::Tick(float DeltaSeconds)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorTick);
+
+	FrameNumber = GFrameCounter;
+
+	const float RescanInterval = CVarGASAttachEditorRescanInterval.GetValueOnGameThread();
+	TimeSinceScan += DeltaSeconds;
+	if (RescanInterval > 0.f && TimeSinceScan >= RescanInterval)
+	{
+		ScanAbilitySystems();
+	}
+	else
+	{
+		ResolvePendingActors();
+	}
+
+	PruneAbilitySystems();
+
+	EmitCsvStats();
+
+	OnTick.Broadcast(DeltaSeconds);
+
+	FrameCounters = FGASMonitorFrameCounters();
+}
+
+void FGASWorldMonitor::ScanAbilitySystems()
+{
+	TimeSinceScan = 0.f;
+	PendingActors.Reset();
+
+	UWorld* LocalWorld = World.Get();
+	if (!LocalWorld)
+	{
+		return;
+	}
+
+	TArray<UObject*> Objects;
+	GetObjectsOfClass(UAbilitySystemComponent::StaticClass(), Objects, true, RF_ClassDefaultObject, EInternalObjectFlags::Garbage);
+
+	for (UObject* Object : Objects)
+	{
+		UAbilitySystemComponent* ASC = static_cast<UAbilitySystemComponent*>(Object);
+		if (ASC->GetWorld() == LocalWorld)
+		{
+			BindAbilitySystem(ASC);
+		}
+	}
+}
+
+void FGASWorldMonitor::ResolvePendingActors()
+{
+	if (PendingActors.IsEmpty())
+	{
+		return;
+	}
+
+	// 组件在生成的那一帧可能还没有创建好，所以延后到世界Tick结束再找
+	// Components may not exist yet on the spawning frame, so they are looked up after the world tick
+	TArray<UAbilitySystemComponent*> Components;
+	for (const TWeakObjectPtr<AActor>& WeakActor : PendingActors)
+	{
+		if (AActor* Actor = WeakActor.Get())
+		{
+			Actor->GetComponents(Components);
+			for (UAbilitySystemComponent* ASC : Components)
+			{
+				BindAbilitySystem(ASC);
+			}
+		}
+	}
+
+	PendingActors.Reset();
+}
+
+void FGASWorldMonitor::PruneAbilitySystems()
+{
+	for (int32 Index = BoundAbilitySystems.Num() - 1; Index >= 0; --Index)
+	{
+		if (BoundAbilitySystems[Index].ASC.IsValid())
+		{
+			continue;
+		}
+
+		// 组件已被销毁，委托随之失效
+		// The component is gone and its delegates with it
+		BoundKeys.Remove(BoundAbilitySystems[Index].ASC);
+		BoundAbilitySystems.RemoveAtSwap(Index);
+		AbilitySystems.RemoveAtSwap(Index);
+
+		OnAbilitySystemChanged.Broadcast(nullptr, false);
+	}
+}
+
+void FGASWorldMonitor::BindAbilitySystem(UAbilitySystemComponent* InASC)
+{
+	if (!IsValid(InASC) || BoundKeys.Contains(TWeakObjectPtr<UAbilitySystemComponent>(InASC)))
+	{
+		return;
+	}
+
+	TWeakObjectPtr<UAbilitySystemComponent> WeakASC(InASC);
+
+	FBoundAbilitySystem& Bound = BoundAbilitySystems.AddDefaulted_GetRef();
+	Bound.ASC = WeakASC;
+	// 只有持续和无限效果会加入激活列表，应用次数要从 OnGameplayEffectAppliedDelegateToSelf 数
+	// Only duration and infinite effects become active, so applications are counted from OnGameplayEffectAppliedDelegateToSelf
+	Bound.EffectAppliedHandle = InASC->OnGameplayEffectAppliedDelegateToSelf.AddRaw(this, &FGASWorldMonitor::HandleEffectApplied, WeakASC);
+	Bound.EffectAddedHandle = InASC->OnActiveGameplayEffectAddedDelegateToSelf.AddRaw(this, &FGASWorldMonitor::HandleEffectAdded, WeakASC);
+	Bound.EffectRemovedHandle = InASC->OnAnyGameplayEffectRemovedDelegate().AddRaw(this, &FGASWorldMonitor::HandleEffectRemoved, WeakASC);
+	Bound.TagChangedHandle = InASC->RegisterGenericGameplayTagEvent().AddRaw(this, &FGASWorldMonitor::HandleTagChanged, WeakASC);
+	Bound.AbilityActivatedHandle = InASC->AbilityActivatedCallbacks.AddRaw(this, &FGASWorldMonitor::HandleAbilityActivated, WeakASC);
+	Bound.AbilityEndedHandle = InASC->AbilityEndedCallbacks.AddRaw(this, &FGASWorldMonitor::HandleAbilityEnded, WeakASC);
+	Bound.AbilityFailedHandle = InASC->AbilityFailedCallbacks.AddRaw(this, &FGASWorldMonitor::HandleAbilityFailed, WeakASC);
+
+	BoundKeys.Add(WeakASC);
+	AbilitySystems.Add(WeakASC);
+
+	OnAbilitySystemChanged.Broadcast(InASC, true);
+}
+
+void FGASWorldMonitor::EmitCsvStats() const
+{
+#if CSV_PROFILER
+	if (!CVarGASAttachEditorCsvEnable.GetValueOnGameThread() || !FCsvProfiler::Get()->IsCapturing())
+	{
+		return;
+	}
+
+	int32 ActiveAbilities = 0;
+	int32 ActiveEffects = 0;
+	int32 LiveTasks = 0;
+
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& WeakASC : AbilitySystems)
+	{
+		const UAbilitySystemComponent* ASC = WeakASC.Get();
+		if (!ASC)
+		{
+			continue;
+		}
+
+		for (const FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
+		{
+			if (AbilitySpec.IsActive())
+			{
+				++ActiveAbilities;
+			}
+		}
+
+		ActiveEffects += ASC->GetNumActiveGameplayEffects();
+		LiveTasks += GASWorldMonitor::GetLiveTaskCount(ASC);
+	}
+
+	// PIE 中多个世界在同一帧 Tick，使用 Accumulate 汇总
+	// Several PIE worlds tick in the same frame, so the values are accumulated
+	CSV_CUSTOM_STAT(GASAttachEditor, AbilitySystems, AbilitySystems.Num(), ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, ActiveAbilities, ActiveAbilities, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, ActiveEffects, ActiveEffects, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, EffectsApplied, FrameCounters.EffectsApplied, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, EffectsRemoved, FrameCounters.EffectsRemoved, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, TagChanges, FrameCounters.TagChanges, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, AbilitiesActivated, FrameCounters.AbilitiesActivated, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, AbilitiesFailed, FrameCounters.AbilitiesFailed, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(GASAttachEditor, LiveGameplayTasks, LiveTasks, ECsvCustomStatOp::Accumulate);
+#endif
+}
+
+void FGASWorldMonitor::HandleActorSpawned(AActor* InActor)
+{
+	PendingActors.Add(InActor);
+}
+
+void FGASWorldMonitor::HandleEffectApplied(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle, TWeakObjectPtr<UAbilitySystemComponent> WeakASC)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorEvents);
+
+	++FrameCounters.EffectsApplied;
+	OnEffectApplied.Broadcast(WeakASC.Get(), Spec, Handle);
+}
+
+void FGASWorldMonitor::HandleEffectAdded(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle, TWeakObjectPtr<UAbilitySystemComponent> WeakASC)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorEvents);
+
+	OnEffectChanged.Broadcast(WeakASC.Get(), Spec, Handle, true);
+}
+
+void FGASWorldMonitor::HandleEffectRemoved(const FActiveGameplayEffect& Effect, TWeakObjectPtr<UAbilitySystemComponent> WeakASC)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorEvents);
+
+	++FrameCounters.EffectsRemoved;
+	OnEffectChanged.Broadcast(WeakASC.Get(), Effect.Spec, Effect.Handle, false);
+}
+
+void FGASWorldMonitor::HandleTagChanged(const FGameplayTag Tag, int32 NewCount, TWeakObjectPtr<UAbilitySystemComponent> WeakASC)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorEvents);
+
+	++FrameCounters.TagChanges;
+	OnTagChanged.Broadcast(WeakASC.Get(), Tag, NewCount);
+}
+
+void FGASWorldMonitor::HandleAbilityActivated(UGameplayAbility* Ability, TWeakObjectPtr<UAbilitySystemComponent> WeakASC)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorEvents);
+
+	++FrameCounters.AbilitiesActivated;
+	OnAbilityEvent.Broadcast(WeakASC.Get(), Ability, EGASMonitorAbilityEvent::Activated, FGameplayTagContainer::EmptyContainer);
+}
+
+void FGASWorldMonitor::HandleAbilityEnded(UGameplayAbility* Ability, TWeakObjectPtr<UAbilitySystemComponent> WeakASC)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorEvents);
+
+	++FrameCounters.AbilitiesEnded;
+	OnAbilityEvent.Broadcast(WeakASC.Get(), Ability, EGASMonitorAbilityEvent::Ended, FGameplayTagContainer::EmptyContainer);
+}
+
+void FGASWorldMonitor::HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureTags, TWeakObjectPtr<UAbilitySystemComponent> WeakASC)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_MonitorEvents);
+
+	++FrameCounters.AbilitiesFailed;
+	OnAbilityEvent.Broadcast(WeakASC.Get(), Ability, EGASMonitorAbilityEvent::Failed, FailureTags);
+}
+
+bool FGASWorldMonitor::ShouldAutoCreate()
+{
+	if (AutoCreateOwners.Num() > 0)
+	{
+		return true;
+	}
+
+#if CSV_PROFILER
+	return CVarGASAttachEditorCsvEnable.GetValueOnGameThread() && FCsvProfiler::Get()->IsCapturing();
+#else
+	return false;
+#endif
+}
+
+void FGASWorldMonitor::HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!InWorld || !InWorld->IsGameWorld())
+	{
+		return;
+	}
+
+	TSharedPtr<FGASWorldMonitor> Monitor = Find(InWorld);
+	if (!Monitor.IsValid() && ShouldAutoCreate())
+	{
+		Monitor = FindOrCreate(InWorld);
+	}
+
+	if (Monitor.IsValid())
+	{
+		Monitor->Tick(DeltaSeconds);
+	}
+}
+
+void FGASWorldMonitor::HandleWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	Monitors.RemoveAll([InWorld](const TSharedRef<FGASWorldMonitor>& Monitor)
+	{
+		return !Monitor->World.IsValid() || Monitor->World.Get() == InWorld;
+	});
+}
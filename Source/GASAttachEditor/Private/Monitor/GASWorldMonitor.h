@@ -0,0 +1,201 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "GameplayEffectTypes.h"
+#include "Engine/EngineBaseTypes.h"
+
+class AActor;
+class UAbilitySystemComponent;
+class UGameplayAbility;
+class UWorld;
+struct FActiveGameplayEffect;
+struct FGameplayEffectSpec;
+
+// 监听器转发的技能事件
+// Ability events forwarded by the monitor
+enum class EGASMonitorAbilityEvent : uint8
+{
+	// 激活
+	Activated,
+
+	// 结束
+	Ended,
+
+	// 激活失败
+	Failed,
+};
+
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnGASMonitorTagChanged, UAbilitySystemComponent*, const FGameplayTag&, int32 /*NewCount*/)
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnGASMonitorEffectChanged, UAbilitySystemComponent*, const FGameplayEffectSpec&, FActiveGameplayEffectHandle, bool /*bAdded*/)
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnGASMonitorEffectApplied, UAbilitySystemComponent*, const FGameplayEffectSpec&, FActiveGameplayEffectHandle)
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnGASMonitorAbilityEvent, UAbilitySystemComponent*, const UGameplayAbility*, EGASMonitorAbilityEvent, const FGameplayTagContainer& /*FailureTags*/)
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnGASMonitorAbilitySystem, UAbilitySystemComponent*, bool /*bAdded*/)
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnGASMonitorTick, float /*DeltaSeconds*/)
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnGASMonitorCreated, const TSharedRef<class FGASWorldMonitor>&)
+
+// 一帧内累计的事件数量，在世界Tick结束时清零
+// Events counted during one world frame, reset after the world's post actor tick
+struct FGASMonitorFrameCounters
+{
+	int32 EffectsApplied = 0;
+
+	int32 EffectsRemoved = 0;
+
+	int32 TagChanges = 0;
+
+	int32 AbilitiesActivated = 0;
+
+	int32 AbilitiesEnded = 0;
+
+	int32 AbilitiesFailed = 0;
+};
+
+// 监听一个世界内所有ASC的事件，其他调试功能都挂在它的委托上
+// Watches every ASC of one world and forwards their events; the other debugging features hang off its delegates
+class FGASWorldMonitor : public TSharedFromThis<FGASWorldMonitor>
+{
+public:
+
+	~FGASWorldMonitor();
+
+	// 模块启动/关闭时调用
+	// Called on module startup/shutdown
+	static void Startup();
+	static void Shutdown();
+
+	static TSharedPtr<FGASWorldMonitor> Find(const UWorld* InWorld);
+
+	static const TArray<TSharedRef<FGASWorldMonitor>>& GetMonitors() { return Monitors; }
+
+	// 第一次请求时创建，世界清理时销毁
+	// Created on first request, destroyed when the world is cleaned up
+	static TSharedRef<FGASWorldMonitor> FindOrCreate(UWorld* InWorld);
+
+	// 只要有一个拥有者请求，就为每个Tick的游戏世界自动创建监听器
+	// While any owner requests it, a monitor is created for every game world that ticks
+	static void SetAutoCreate(FName InOwner, bool bEnabled);
+
+	// 新的监听器创建后广播
+	// Broadcast after a new monitor is created
+	static FOnGASMonitorCreated OnMonitorCreated;
+
+public:
+
+	UWorld* GetWorld() const;
+
+	// 当前世界里已绑定的ASC
+	// ASCs of the world that are currently bound
+	const TArray<TWeakObjectPtr<UAbilitySystemComponent>>& GetAbilitySystems() const;
+
+	// 最近一次世界Tick时的帧号
+	// Frame number of the last world tick
+	uint64 GetFrameNumber() const { return FrameNumber; }
+
+	const FGASMonitorFrameCounters& GetFrameCounters() const { return FrameCounters; }
+
+public:
+
+	FOnGASMonitorTagChanged OnTagChanged;
+
+	// 激活的效果加入或者移除，瞬时效果不会广播
+	// An active effect was added or removed; instant effects are never broadcast
+	FOnGASMonitorEffectChanged OnEffectChanged;
+
+	// 每次应用效果都广播，包括瞬时效果和叠层，瞬时效果的句柄无效
+	// Broadcast for every effect application, instant effects and stacking included; the handle is invalid for instant effects
+	FOnGASMonitorEffectApplied OnEffectApplied;
+
+	FOnGASMonitorAbilityEvent OnAbilityEvent;
+
+	FOnGASMonitorAbilitySystem OnAbilitySystemChanged;
+
+	// 在世界的 OnWorldPostActorTick 中广播
+	// Broadcast from the world's OnWorldPostActorTick
+	FOnGASMonitorTick OnTick;
+
+private:
+
+	explicit FGASWorldMonitor(UWorld* InWorld);
+
+	void Tick(float DeltaSeconds);
+
+	// 用类哈希查找世界里的ASC，不遍历所有对象
+	// Finds the world's ASCs through the class hash instead of walking every object
+	void ScanAbilitySystems();
+
+	void ResolvePendingActors();
+
+	void PruneAbilitySystems();
+
+	void BindAbilitySystem(UAbilitySystemComponent* InASC);
+
+	void EmitCsvStats() const;
+
+private:
+
+	void HandleActorSpawned(AActor* InActor);
+
+	void HandleEffectApplied(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle, TWeakObjectPtr<UAbilitySystemComponent> WeakASC);
+
+	void HandleEffectAdded(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle, TWeakObjectPtr<UAbilitySystemComponent> WeakASC);
+
+	void HandleEffectRemoved(const FActiveGameplayEffect& Effect, TWeakObjectPtr<UAbilitySystemComponent> WeakASC);
+
+	void HandleTagChanged(const FGameplayTag Tag, int32 NewCount, TWeakObjectPtr<UAbilitySystemComponent> WeakASC);
+
+	void HandleAbilityActivated(UGameplayAbility* Ability, TWeakObjectPtr<UAbilitySystemComponent> WeakASC);
+
+	void HandleAbilityEnded(UGameplayAbility* Ability, TWeakObjectPtr<UAbilitySystemComponent> WeakASC);
+
+	void HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureTags, TWeakObjectPtr<UAbilitySystemComponent> WeakASC);
+
+	static bool ShouldAutoCreate();
+
+	static void HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	static void HandleWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
+
+private:
+
+	struct FBoundAbilitySystem
+	{
+		TWeakObjectPtr<UAbilitySystemComponent> ASC;
+
+		FDelegateHandle EffectAppliedHandle;
+		FDelegateHandle EffectAddedHandle;
+		FDelegateHandle EffectRemovedHandle;
+		FDelegateHandle TagChangedHandle;
+		FDelegateHandle AbilityActivatedHandle;
+		FDelegateHandle AbilityEndedHandle;
+		FDelegateHandle AbilityFailedHandle;
+	};
+
+	TWeakObjectPtr<UWorld> World;
+
+	TArray<FBoundAbilitySystem> BoundAbilitySystems;
+
+	TSet<TWeakObjectPtr<UAbilitySystemComponent>> BoundKeys;
+
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> AbilitySystems;
+
+	TArray<TWeakObjectPtr<AActor>> PendingActors;
+
+	FDelegateHandle ActorSpawnedHandle;
+
+	FGASMonitorFrameCounters FrameCounters;
+
+	uint64 FrameNumber;
+
+	float TimeSinceScan;
+
+private:
+
+	static TArray<TSharedRef<FGASWorldMonitor>> Monitors;
+
+	static FDelegateHandle PostActorTickHandle;
+
+	static FDelegateHandle WorldCleanupHandle;
+
+	static TSet<FName> AutoCreateOwners;
+};
@@ -1,1860 +1,3442 @@
-#include "SGASAttachEditor.h"
-#include "Widgets/SBoxPanel.h"
-#include "GASAttachEditor/SGASReflectorNodeBase.h"
-#include "AbilitySystemComponent.h"
-#include "Engine/Engine.h"
-#include "GameplayAbilitySpec.h"
-#include "../Public/GASAttachEditorStyle.h"
-#include "Widgets/Views/STreeView.h"
-#include "GASAttachEditor/SGASCharacterTagsBase.h"
-#include "GASAttachEditor/SGASAttributesNodeBase.h"
-#include "Widgets/Layout/SWrapBox.h"
-#include "Widgets/SToolTip.h"
-#include "Widgets/Input/SComboButton.h"
-#include "Framework/Application/SlateApplication.h"
-#include "GameplayTagsManager.h"
-#if WITH_EDITOR
-#include "SGameplayTagWidget.h"
-#include "EditorStyleSet.h"
-#endif
-#include "Widgets/Docking/SDockTab.h"
-#include "Widgets/Layout/SBorder.h"
-#include "GASAttachEditor/SGASGameplayEffectNodeBase.h"
-#include "Misc/ConfigCacheIni.h"
-#include "Widgets/SWidget.h"
-#include "Framework/Docking/TabManager.h"
-#include "Widgets/Input/SCheckBox.h"
-#include "Framework/MultiBox/MultiBoxBuilder.h"
-#include "Framework/Commands/UIAction.h"
-#include "HAL/ExceptionHandling.h"
-#include "Widgets/Input/SButton.h"
-#include "UObject/UObjectIterator.h"
-#include "GameFramework/Pawn.h"
-
-#define LOCTEXT_NAMESPACE "SGASAttachEditor"
-
-const FName GAActivationColumnName("GAActivation");
-
-struct FASCDebugTargetInfo
-{
-	FASCDebugTargetInfo()
-	{
-		DebugCategoryIndex = 0;
-		DebugCategories.Add(TEXT("Attributes"));
-		DebugCategories.Add(TEXT("GameplayEffects"));
-		DebugCategories.Add(TEXT("Ability"));
-	}
-
-	TArray<FName> DebugCategories;
-	int32 DebugCategoryIndex;
-
-	TWeakObjectPtr<UWorld>	TargetWorld;
-	TWeakObjectPtr<UAbilitySystemComponent>	LastDebugTarget;
-};
-
-TArray<FASCDebugTargetInfo>	AbilitySystemAttachDebugInfoList;
-
-FASCDebugTargetInfo* GetASCDebugTargetInfo(UWorld* World)
-{
-	FASCDebugTargetInfo* TargetInfo = nullptr;
-	for (FASCDebugTargetInfo& Info : AbilitySystemAttachDebugInfoList)
-	{
-		if (Info.TargetWorld.Get() == World)
-		{
-			TargetInfo = &Info;
-			break;
-		}
-	}
-	if (TargetInfo == nullptr)
-	{
-		TargetInfo = &AbilitySystemAttachDebugInfoList[AbilitySystemAttachDebugInfoList.AddDefaulted()];
-		TargetInfo->TargetWorld = World;
-	}
-	return TargetInfo;
-}
-
-TArray<TWeakObjectPtr< UAbilitySystemComponent>> PlayerComp;
-
-void UpDataPlayerComp(UWorld* World)
-{
-	PlayerComp.Reset();
-
-	if (!World)
-	{
-		return;
-	}
-
-	for (TObjectIterator<UAbilitySystemComponent> It; It; ++It)
-	{
-		if (UAbilitySystemComponent* ASC = *It)
-		{
-			if (ASC->GetWorld() != World)
-			{
-				continue;
-			}
-			if (!MakeWeakObjectPtr(ASC).Get())
-			{
-				continue;
-			}
-			PlayerComp.Add(ASC);
-		}
-	}
-}
-
-AActor* GetGASActor(const TWeakObjectPtr<UAbilitySystemComponent>& InASC)
-{
-	if (!InASC.IsValid())
-	{
-		return nullptr;
-	}
-
-	;
-	if (AActor* LocalAvatarActor = InASC->GetAvatarActor_Direct())
-	{
-		return LocalAvatarActor;
-	}
-
- 	if (AActor* LocalOwnerActor = InASC->GetOwnerActor())
-	{
-		return LocalOwnerActor;
-	}
-
-	return nullptr;
-}
-
-UAbilitySystemComponent* GetDebugTarget(FASCDebugTargetInfo* Info, const UAbilitySystemComponent* InSelectComponent, FName& SelectActorName)
-{
-	// Return target if we already have one
-	if (UAbilitySystemComponent* ASC = Info->LastDebugTarget.Get())
-	{
-		if (ASC == InSelectComponent)
-		{
-			return ASC;
-		}
-	}
-
-	// Find one
-	bool bIsSelect = false;
-
-	for (TWeakObjectPtr<UAbilitySystemComponent>& ASC : PlayerComp)
-	{
-		if (!ASC.IsValid())
-		{
-			continue;
-		}
-
-		if (InSelectComponent == ASC.Get() && !bIsSelect)
-		{
-			SelectActorName = GetGASActor(ASC)->GetFName();
-			Info->LastDebugTarget = ASC;
-			bIsSelect = true;
-			break;
-		}
-	}
-
-	if (!bIsSelect)
-	{
-		if (!PlayerComp.IsValidIndex(0))
-		{
-			// 刷新世界中的ASComp;
-			// Refresh ascomp in the world;
-			UpDataPlayerComp(Info->TargetWorld.Get());
-		}
-
-		// 如果筛选框里面有筛选的名字，则直接用那个名字的角色
-		// If there is a filtered name in the filter box, the role with that name will be used directly
-		if (SelectActorName.IsNone())
-		{
-			if (PlayerComp.IsValidIndex(0))
-			{
-				Info->LastDebugTarget = PlayerComp[0];
-				SelectActorName = GetGASActor(Info->LastDebugTarget)->GetFName();
-			}
-			else
-			{
-				Info->LastDebugTarget = nullptr;
-			}
-		}
-		else
-		{
-			bool bIsSelectActorName = false;
-			for (TWeakObjectPtr<UAbilitySystemComponent>& ASC : PlayerComp)
-			{
-				if (!ASC.IsValid()) continue;
-
-				if (GetGASActor(ASC)->GetFName() == SelectActorName)
-				{
-					Info->LastDebugTarget = ASC;
-					bIsSelectActorName = true;
-					break;
-				}
-
-			}
-
-			if (!bIsSelectActorName)
-			{
-				if (PlayerComp.IsValidIndex(0) && PlayerComp[0] != nullptr)
-				{
-					Info->LastDebugTarget = PlayerComp[0];
-					SelectActorName = GetGASActor(PlayerComp[0])->GetFName();
-				}
-				else
-				{
-					Info->LastDebugTarget = nullptr;
-				}
-			}
-		}
-
-	}
-
-	if (Info->LastDebugTarget.IsValid())
-	{
-		return Info->LastDebugTarget.Get();
-	}
-
-	return nullptr;
-}
-
-class SGASAttachEditorImpl : public SGASAttachEditor
-{
-	typedef STreeView<TSharedRef<FGASAbilitieNodeBase>> SAbilitieTree;
-	typedef STreeView<TSharedRef<FGASAttributesNodeBase>> SAttributesTree;
-	typedef STreeView<TSharedRef<FGASGameplayEffectNodeBase>> SGameplayEffectTree;
-
-public:
-	virtual void Construct(const FArguments& InArgs) override;
-
-	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
-
-public:
-	virtual ~SGASAttachEditorImpl() override;
-
-
-protected:
-	// 当前筛选世界场景
-	// Current filter world scene
-	TSharedRef<SWidget>	OnGetShowWorldTypeMenu();
-
-	// 选中世界场景
-	// Select the world scene
-	void HandleShowWorldTypeChange(FWorldContext InWorldContext);
-
-private:
-	// 当期选择的世界场景句柄
-	// Current selected world scene handle
-	FName SelectWorldSceneConetextHandle;
-
-	FText SelectWorldSceneText;
-
-protected:
-
-	FText GenerateToolTipForText(TSharedRef<FGASAbilitieNodeBase> InReflectorNode) const;
-
-protected:
-	/** 树视图生成树的回调 */
-	/** Callback for tree view spanning tree */
-	TSharedRef<ITableRow> OnGenerateWidgetForFilterListView(TSharedRef< FGASAbilitieNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable);
-
-	/** 用于获取给定反射树节点的子项的回调 */
-	/** Callback to get children of a given reflection tree node */
-	void HandleReflectorTreeGetChildren( TSharedRef<FGASAbilitieNodeBase> InReflectorNode, TArray<TSharedRef<FGASAbilitieNodeBase>>& OutChildren );
-
-	/** 当反射树中的选择发生更改时的回调 */
-	/** Callback when the selection in the reflection tree changes */
-	void HandleReflectorTreeSelectionChanged(TSharedPtr<FGASAbilitieNodeBase>, ESelectInfo::Type /*SelectInfo*/);
-
-	// 提示小部件
-	// Prompt widget
-	TSharedPtr<IToolTip> GenerateToolTipForReflectorNode( TSharedRef<FGASAbilitieNodeBase> InReflectorNode );
-
-	// 当请求反射器树中的上下文菜单时的回调
-	// Callback when a context menu in the reflector tree is requested
-	TSharedPtr<SWidget> HandleReflectorTreeContextMenuPtr();
-
-	/** 反射树头列表更改时的回调. */
-	/** A callback that reflects changes to the tree header list */
-	void HandleReflectorTreeHiddenColumnsListChanged();
-
-	// GA排序
-	// sorting
-	EColumnSortMode::Type GetColumnSortMode(const FName ColumnId) const;
-
-	// 排序更改响应
-	// Sort change response
-	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode);
-
-	// 更改排序
-	// Change sort
-	void RequestSort();
-
-private:
-	// GA排序模式
-	// GA sorting mode
-	EColumnSortMode::Type SortMode;
-
-protected:
-	/** 树视图生成树的回调 */
-	/** Callback for tree view spanning tree */
-	TSharedRef<ITableRow> HandleAttributesWidgetForFilterListView(TSharedRef< FGASAttributesNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable);
-
-	void HandleAttributesTreeGetChildren( TSharedRef<FGASAttributesNodeBase> InReflectorNode, TArray<TSharedRef<FGASAttributesNodeBase>>& OutChildren );
-
-protected:
-	// 当前筛选的角色
-	// Player currently filtered
-	TSharedRef<SWidget>	OnGetShowOverrideTypeMenu();
-
-	// 当前选择的角色
-	// Currently Selected Player
-	FText GetOverrideTypeDropDownText() const;
-
-	// 选中的GAS组件
-	// Selected GAS components
-	void HandleOverrideTypeChange(TWeakObjectPtr<UAbilitySystemComponent> InComp);
-
-protected:
-	// 是否被选中
-	// Is it selected
-	ECheckBoxState HandleGetPickingButtonChecked() const;
-
-	// 选中状态更改
-	// Check status change
-	void HandlePickingModeStateChanged(ECheckBoxState NewValue);
-
-	// 设置状态改变的东东
-	// Set the status change
-	virtual void SetPickingMode(bool bTick) override;
-
-	// 设置单选框名称
-	// Set radio box name
-	FText HandleGetPickingModeText() const;
-
-protected:
-
-	/** Called when the user clicks the "Expand All" button; Expands the entire tag tree */
-	FReply OnExpandAllClicked();
-
-	/** Called when the user clicks the "Collapse All" button; Collapses the entire tag tree */
-	FReply OnCollapseAllClicked();
-
-
-	void SetGASTreeItemExpansion(bool bExpand);
-
-	bool bGASTreeExpand;
-
-public:
-
-	FORCEINLINE bool HasGASTreeExpand(){ return bGASTreeExpand; }
-
-private:
-
-	void SaveSettings();
-	void LoadSettings();
-
-	// 刷新树状表
-	// Refresh tree table
-	void UpdateGameplayCueListItems();
-	FReply UpdateGameplayCueListItemsButtom();
-
-	// 创建查看Categories类型的筛选框
-	// Create a filter box to view categories types
-	TSharedRef<SWidget> OnGetShowDebugAbilitieCategories();
-
-	// 当前选择的Categories类型
-	// Currently selected categories type
-	FText GetShowDebugAbilitieCategoriesDropDownText() const;
-
-	// 选中查看的Categories类型
-	// Select the categories type to view
-	void HandleShowDebugAbilitieCategories(EDebugAbilitieCategories InType);
-
-	FORCEINLINE FName GetAbilitieCategoriesName(EDebugAbilitieCategories InType) const;
-
-	FORCEINLINE FText GetAbilitieCategoriesText(EDebugAbilitieCategories InType) const;
-
-	// 创建Categories查看控件
-	// Create categories view control
-	void CreateDebugAbilitieCategories(EDebugAbilitieCategories InType);
-
-private:
-	// Categories查看Tool的Slot控件
-	// Categories view the slot control of the tool
-	TSharedPtr<SOverlay> CategoriesToolSlot;
-
-private:
-	// 当前选择Categories类型
-	// Currently selected categories type
-	EDebugAbilitieCategories SelectAbilitieCategories;
-
-	// 按键监听指针
-	// Key monitor pointer
-	TSharedPtr<IInputProcessor> InputPtr;
-
-protected: 
-	
-	FORCEINLINE UWorld* GetWorld();
-
-private:
-
-	TSharedPtr<SWrapBox> FilteredOwnedTagsView;
-
-	TSharedPtr<SWrapBox> FilteredBlockedTagsView;
-
-	FGameplayTagContainer OldOwnerTags;
-
-	FGameplayTagContainer OldBlockedTags;
-
-protected:
-
-	TSharedPtr<SWidget> CreateAbilityTagWidget();
-
-protected:
-	void OnApplicationPreInputKeyDownListener(const FKeyEvent& InKeyEvent);
-
-#if WITH_EDITOR
-	// <tag控件的监听
-	// Monitoring of tag control
-	FReply OnMouseButtonUpTags(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent, FName TagsName);
-
-	// <Tag控件选择
-	// Tag control selection
-	void RefreshTagList(FName TagsName);
-#endif
-
-public:
-	// 筛选激活状态图表Tree
-	// Filter activation status chart tree
-	void HandleScreenModeStateChanged(ECheckBoxState NewValue, EScreenGAModeState InState);
-
-protected:
-	// 是否被选中
-	// Is it selected
-	ECheckBoxState HandleGetScreenButtonChecked(EScreenGAModeState InState) const;
-
-	// 创建选中框
-	// Create check box
-	TSharedPtr<SCheckBox> CreateScreenCheckBox(EScreenGAModeState InState);
-
-	// 设置筛选名称
-	// Set filter name
-	FText HandleGeScreenModeText(EScreenGAModeState InState) const;
-
-	// 创建Ability查看控件
-	// Create ability view control
-	TSharedPtr<SWidget> CreateAbilityToolWidget();
-
-protected:
-
-	// 创建Attributes查看控件
-	// Create attributes view control
-	TSharedPtr<SWidget> CreateAttributesToolWidget();
-
-
-protected:
-	// 创建GameplayEffects查看控件
-	// Create gameplay effects view
-	TSharedPtr<SWidget> CreateGameplayEffectToolWidget();
-
-	TSharedRef<ITableRow> OneGameplayEffecGenerateWidgetForFilterListView(TSharedRef< FGASGameplayEffectNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable);
-
-	void HandleGameplayEffectTreeGetChildren(TSharedRef<FGASGameplayEffectNodeBase> InReflectorNode, TArray<TSharedRef<FGASGameplayEffectNodeBase>>& OutChildren);
-
-	void HandleGameplayEffectTreeHiddenColumnsListChanged();
-
-	void HandleGameplayEffectTreeSelectionChanged(TSharedPtr<FGASGameplayEffectNodeBase>, ESelectInfo::Type /*SelectInfo*/);
-
-private:
-
-	uint8 ScreenModeState;
-
-private:
-	TSharedPtr<SAbilitieTree> AbilitieReflectorTree;
-
-	TArray<FString> HiddenReflectorTreeColumns;
-
-	TArray<TSharedRef<FGASAbilitieNodeBase>> SelectedNodes;
-
-	TArray<TSharedRef<FGASAbilitieNodeBase>> AbilitieFilteredTreeRoot;
-
-	TWeakObjectPtr<UAbilitySystemComponent> SelectAbilitySystemComponent;
-
-	FName SelectAbilitySystemComponentForActorName;
-
-	bool bPickingTick;
-
-private:
-
-	TSharedPtr<SAttributesTree> AttributesReflectorTree;
-
-	TArray<TSharedRef<FGASAttributesNodeBase>> AttributesFilteredTreeRoot;
-
-#if WITH_EDITOR
-	TArray<SGameplayTagWidget::FEditableGameplayTagContainerDatum> EditableOwnerContainers;
-	FGameplayTagContainer OwnweTagContainer;
-	FGameplayTagContainer OldOwnweTagContainer;
-
-	TArray<SGameplayTagWidget::FEditableGameplayTagContainerDatum> EditableBlockedContainers;
-	FGameplayTagContainer BlockedTagContainer;
-	FGameplayTagContainer OldBlockedTagContainer;
-
-#endif
-
-private:
-	TSharedPtr<SGameplayEffectTree> GameplayEffectTree;
-
-	TArray<TSharedRef<FGASGameplayEffectNodeBase>> GameplayEffectTreeRoot;
-
-	TArray<FString> HiddenGameplayEffectTreeColumns;
-};
-
-TSharedRef<SGASAttachEditor> SGASAttachEditor::New()
-{
-	return MakeShareable(new SGASAttachEditorImpl());
-}
-
-FName SGASAttachEditor::GetTabName()
-{
-	return "GAAttachEditorApp";
-}
-
-void SGASAttachEditor::RegisterTabSpawner(FTabManager& TabManager)
-{
-	const auto SpawnCallStackViewTab = [](const FSpawnTabArgs& Args)
-	{
-		return SNew(SDockTab)
-			.TabRole(ETabRole::PanelTab)
-			//.Label(LOCTEXT("TabTitle", "游戏中GAS查看器"))
-			.Label(LOCTEXT("TabTitle", "Runtime Debug"))
-			[
-				SNew(SBorder)
-#if WITH_EDITOR
-				.BorderImage(FAppStyle::GetBrush("Docking.Tab.ContentAreaBrush"))
-#endif
-				.BorderBackgroundColor(FSlateColor(FLinearColor(0.2f,0.2f,0.2f,1.f)))
-				[
-					SNew(SGASAttachEditor)
-				]
-			];
-	};
-
-	TabManager.RegisterTabSpawner(SGASAttachEditor::GetTabName(), FOnSpawnTab::CreateStatic(SpawnCallStackViewTab))
-		//.SetDisplayName(LOCTEXT("TabTitle", "游戏中GAS查看器"));
-		.SetDisplayName(LOCTEXT("TabTitle", "Runtime Debug"));
-}
-
-void SGASAttachEditorImpl::Construct(const FArguments& InArgs)
-{
-	bGASTreeExpand = false;
-	bPickingTick = false;
-	SelectAbilitySystemComponentForActorName = FName();
-	SelectAbilitieCategories = Ability;
-
-	ScreenModeState = EScreenGAModeState::Active | EScreenGAModeState::Blocked | EScreenGAModeState::NoActive;
-
-	SortMode = EColumnSortMode::Ascending;
-
-	LoadSettings();
-
-
-	ChildSlot
-		[
-			SNew(SVerticalBox)
-
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			//.HAlign(HAlign_Left)
-			[
-				SNew(SHorizontalBox)
-
-				+ SHorizontalBox::Slot()
-				.AutoWidth()
-				[
-					SNew(SButton)
-					.HAlign(HAlign_Left)
-					//.Text(LOCTEXT("Refresh", "刷新查看"))
-					.Text(LOCTEXT("Refresh", "Update"))
-					.OnClicked(this, &SGASAttachEditorImpl::UpdateGameplayCueListItemsButtom)
-				]
-				
-				+ SHorizontalBox::Slot() 
-				.FillWidth(1.f)
-				.HAlign(HAlign_Right)
-				[
-					SNew(SComboButton)
-					.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetShowWorldTypeMenu)
-					.VAlign(VAlign_Center)
-					.ContentPadding(2)
-					.ButtonContent()
-					[
-						SNew(STextBlock)
-						//.ToolTipText(LOCTEXT("ShowWorldTypeType", "选择需要查看场景"))
-						.ToolTipText(LOCTEXT("ShowWorldTypeType", "Select World Scene"))
-						.Text_Lambda([this]{return SelectWorldSceneText;})
-					]
-				]
-
-			]
-
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			[
-				SNew(SHorizontalBox)
-				+ SHorizontalBox::Slot()
-				.Padding(2.0f)
-				.AutoWidth()
-				[
-					SNew(SCheckBox)
-					.Padding(FMargin(4, 0))
-					.IsChecked(this, &SGASAttachEditorImpl::HandleGetPickingButtonChecked)
-					.OnCheckStateChanged(this, &SGASAttachEditorImpl::HandlePickingModeStateChanged)
-					[
-						SNew(SBox)
-						.MinDesiredWidth(125)
-						.VAlign(VAlign_Center)
-						[
-							SNew(STextBlock)
-							.Text(this, &SGASAttachEditorImpl::HandleGetPickingModeText)
-						]
-
-					]
-				]
-				+ SHorizontalBox::Slot()
-				.Padding(2.f, 2.f)
-				.AutoWidth()
-				[
-					SNew(SComboButton)
-					.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetShowOverrideTypeMenu)
-					.VAlign( VAlign_Center )
-					.ContentPadding(2)
-					.ButtonContent()
-					[
-						SNew( STextBlock )
-						//.ToolTipText(LOCTEXT("ShowOverrideType", "选择需要查看的角色的GA"))
-						.ToolTipText(LOCTEXT("ShowOverrideType", "Select Player GA"))
-						.Text(this, &SGASAttachEditorImpl::GetOverrideTypeDropDownText )
-					]
-				]
-			]
-
-			+ SVerticalBox::Slot()
-			.FillHeight(1.f)
-			[
-				SNew(SVerticalBox)
-
-				+ SVerticalBox::Slot()
-				.Padding(2.f, 2.f)
-				.AutoHeight()
-				.HAlign(HAlign_Left)
-				[
-					SNew(SComboButton)
-					.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetShowDebugAbilitieCategories)
-					.VAlign(VAlign_Center)
-					.ContentPadding(2)
-					.ButtonContent()
-					[
-						SNew(STextBlock)
-						//.ToolTipText(LOCTEXT("ShowCharactAbilitieType", "选择需要查看角色身上的效果类型"))
-						.ToolTipText(LOCTEXT("ShowCharactAbilitieType", "Select Player Look Up Type"))
-						.Text(this, &SGASAttachEditorImpl::GetShowDebugAbilitieCategoriesDropDownText)
-					]
-				]
-
-				+ SVerticalBox::Slot()
-				.FillHeight(1.f)
-				[
-					//CreateAbilityToolWidget()
-					SAssignNew(CategoriesToolSlot, SOverlay)
-				]
-				
-			]
-
-		];
-
-	HandleShowDebugAbilitieCategories(Ability);
-
-	UpdateGameplayCueListItemsButtom();
-	InputPtr = MakeShareable(new FAttachInputProcessor(this));
-	FSlateApplication::Get().RegisterInputPreProcessor(InputPtr);
-
-#if WITH_EDITOR
-	//TagKeyDownHandle = FSlateApplication::Get().OnApplicationPreInputKeyDownListener().AddRaw(this, &SGASAttachEditorImpl::OnApplicationPreInputKeyDownListener);
-
-	EditableOwnerContainers.Empty();
-	EditableBlockedContainers.Empty();
-
-	EditableOwnerContainers.Add(SGameplayTagWidget::FEditableGameplayTagContainerDatum(nullptr,&OwnweTagContainer));
-	EditableBlockedContainers.Add(SGameplayTagWidget::FEditableGameplayTagContainerDatum(nullptr,&BlockedTagContainer));
-#endif
-}
-
-
-void SGASAttachEditorImpl::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
-{
-	if (bPickingTick)
-	{
-		UpdateGameplayCueListItems();
-	}
-}
-
-
-SGASAttachEditorImpl::~SGASAttachEditorImpl()
-{
-	FSlateApplication::Get().UnregisterInputPreProcessor(InputPtr);
-	InputPtr = nullptr;
-}
-
-TSharedRef<SWidget> SGASAttachEditorImpl::OnGetShowWorldTypeMenu()
-{
-	FMenuBuilder MenuBuilder( true, NULL );
-
-	const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
-
-	for (auto& Item : WorldList)
-	{
-		if (Item.WorldType == EWorldType::Type::PIE || Item.WorldType == EWorldType::Type::Game)
-		{
-			FUIAction NoAction( FExecuteAction::CreateSP( this, &SGASAttachEditorImpl::HandleShowWorldTypeChange, Item ) );
-
-			FText ShowName;
-			if (Item.RunAsDedicated)
-			{
-				//ShowName = LOCTEXT("Dedicated","专用服务器");
-				ShowName = LOCTEXT("Dedicated","Dedicated");
-			}
-			else
-			{
-				if (Item.WorldType == EWorldType::Type::Game)
-				{
-					ShowName = LOCTEXT("Client",/*"客户端"*/"Client");
-				}
-				else
-				{
-					ShowName = FText::Format(FText::FromString("{0}  [{1}]"), LOCTEXT("Client",/*"客户端"*/"Client"), FText::AsNumber(Item.PIEInstance));
-				}
-				
-			}
-
-			MenuBuilder.AddMenuEntry(ShowName, FText(), FSlateIcon(), NoAction);
-		}
-	}
-
-	return MenuBuilder.MakeWidget();
-}
-
-
-void SGASAttachEditorImpl::HandleShowWorldTypeChange(FWorldContext InWorldContext)
-{
-	SelectWorldSceneConetextHandle = InWorldContext.ContextHandle;
-
-
-	if (InWorldContext.RunAsDedicated)
-	{
-		SelectWorldSceneText = LOCTEXT("Dedicated", "专用服务器");
-	}
-	else
-	{
-		if (InWorldContext.WorldType == EWorldType::Type::Game)
-		{
-			SelectWorldSceneText = LOCTEXT("Client",/*"客户端"*/"Client");
-		}
-		else
-		{
-			SelectWorldSceneText = FText::Format(FText::FromString("{0}  [{1}]"), LOCTEXT("Client",/*"客户端"*/"Client"), FText::AsNumber(InWorldContext.PIEInstance));
-		}
-	}
-
-	UpdateGameplayCueListItemsButtom();
-}
-
-FText SGASAttachEditorImpl::GenerateToolTipForText(TSharedRef<FGASAbilitieNodeBase> InReflectorNode) const
-{
-	return InReflectorNode->GetAbilitieHasTag();
-}
-
-TSharedRef<ITableRow> SGASAttachEditorImpl::OnGenerateWidgetForFilterListView(TSharedRef< FGASAbilitieNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable)
-{
-	return SNew(SGASAbilitieTreeItem, OwnerTable)
-		.WidgetInfoToVisualize(InItem)
-		.ToolTip(GenerateToolTipForReflectorNode(InItem));
-}
-
-
-void SGASAttachEditorImpl::HandleReflectorTreeGetChildren(TSharedRef<FGASAbilitieNodeBase> InReflectorNode, TArray<TSharedRef<FGASAbilitieNodeBase>>& OutChildren)
-{
-	OutChildren = InReflectorNode->GetChildNodes();
-}
-
-void SGASAttachEditorImpl::HandleReflectorTreeSelectionChanged(TSharedPtr<FGASAbilitieNodeBase>, ESelectInfo::Type /*SelectInfo*/)
-{
-	SelectedNodes = AbilitieReflectorTree->GetSelectedItems();
-
-}
-
-TSharedPtr<IToolTip> SGASAttachEditorImpl::GenerateToolTipForReflectorNode(TSharedRef<FGASAbilitieNodeBase> InReflectorNode)
-{
-	return SNew(SToolTip)
-			.Text(this, &SGASAttachEditorImpl::GenerateToolTipForText, InReflectorNode);
-}
-
-TSharedPtr<SWidget> SGASAttachEditorImpl::HandleReflectorTreeContextMenuPtr()
-{
-	const bool bShouldCloseWindowAfterMenuSelection = true;
-	FMenuBuilder MenuBuilder(bShouldCloseWindowAfterMenuSelection, nullptr);
-
-	MenuBuilder.AddMenuEntry(
-		LOCTEXT("NotFunction", "NotFunction"),
-		LOCTEXT("NotFunctionTooltip", "Null"),
-		FSlateIcon(),
-		FUIAction()
-	);
-
-	return MenuBuilder.MakeWidget();
-}
-
-void SGASAttachEditorImpl::HandleReflectorTreeHiddenColumnsListChanged()
-{
-#if WITH_EDITOR
-	if (AbilitieReflectorTree && AbilitieReflectorTree->GetHeaderRow())
-	{
-		const TArray<FName> HiddenColumnIds = AbilitieReflectorTree->GetHeaderRow()->GetHiddenColumnIds();
-		HiddenReflectorTreeColumns.Reset(HiddenColumnIds.Num());
-		for (const FName Id : HiddenColumnIds)
-		{
-			HiddenReflectorTreeColumns.Add(Id.ToString());
-		}
-		SaveSettings();
-	}
-#endif
-}
-
-EColumnSortMode::Type SGASAttachEditorImpl::GetColumnSortMode(const FName ColumnId) const
-{
-	if (NAME_AbilitietName != ColumnId) return EColumnSortMode::None;
-
-	return SortMode;
-}
-
-void SGASAttachEditorImpl::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode)
-{
-	SortMode = InSortMode;
-	RequestSort();
-}
-
-void SGASAttachEditorImpl::RequestSort()
-{
-	if (SortMode == EColumnSortMode::Ascending)
-	{
-		AbilitieFilteredTreeRoot.Sort([](TSharedRef<FGASAbilitieNodeBase> A, TSharedRef<FGASAbilitieNodeBase> B)
-		{
-			return A->GetGAName().ToString() < B->GetGAName().ToString();
-		});
-	}
-	else if (SortMode == EColumnSortMode::Descending)
-	{
-		AbilitieFilteredTreeRoot.Sort([](TSharedRef<FGASAbilitieNodeBase> A, TSharedRef<FGASAbilitieNodeBase> B)
-		{
-			return A->GetGAName().ToString() >= B->GetGAName().ToString();
-		});
-	}
-
-	AbilitieReflectorTree->RequestTreeRefresh();
-}
-
-TSharedRef<ITableRow> SGASAttachEditorImpl::HandleAttributesWidgetForFilterListView(TSharedRef< FGASAttributesNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable)
-{
-	return SNew(SGASAttributesTreeItem, OwnerTable)
-		.WidgetInfoToVisualize(InItem);
-}
-
-void SGASAttachEditorImpl::HandleAttributesTreeGetChildren(TSharedRef<FGASAttributesNodeBase> InReflectorNode, TArray<TSharedRef<FGASAttributesNodeBase>>& OutChildren)
-{
-}
-
-FText GetLocalRoleText(ENetRole InRole)
-{
-	FText RoleText;
-	switch (InRole)
-	{
-	case ROLE_Authority:
-		// RoleText = LOCTEXT("Authority", "权威");
-		RoleText = LOCTEXT("Authority", "Authority");
-		break;
-	case ROLE_AutonomousProxy:
-		// RoleText = LOCTEXT("AutonomousProxy", "本地");
-		RoleText = LOCTEXT("AutonomousProxy", "AutonomousProxy");
-		break;
-	case ROLE_SimulatedProxy:
-		// RoleText = LOCTEXT("SimulatedProxy", "模拟");
-		RoleText = LOCTEXT("SimulatedProxy", "SimulatedProxy");
-		break;
-	}
-
-	return RoleText;
-}
-
-FText GetOverrideTypeDropDownText_Explicit(const TWeakObjectPtr<UAbilitySystemComponent>& InComp)
-{
-	if (!InComp.IsValid())
-	{
-		return FText();
-	}
-
-	AActor* LocalAvatarActor = InComp->GetAvatarActor_Direct();
-	AActor* LocalOwnerActor = InComp->GetOwnerActor();
-	APawn* AvatarAsPawn = LocalAvatarActor ? Cast<APawn>(LocalAvatarActor) : nullptr;
-	APawn* OwnerAsPawn = LocalOwnerActor ? Cast<APawn>(LocalOwnerActor) : nullptr;
-
-	FText OutName = FText::FromString(LocalAvatarActor == nullptr ? LocalOwnerActor->GetName() : LocalAvatarActor->GetName());
-	bool IsPlayer = (IsValid(AvatarAsPawn) ? AvatarAsPawn->IsPlayerControlled() : false) || (IsValid(OwnerAsPawn) ? OwnerAsPawn->IsPlayerControlled() : false);
-	bool IsSelected =  (LocalAvatarActor ? LocalAvatarActor->IsSelected() : false) || (LocalOwnerActor ? LocalOwnerActor->IsSelected() : false);
-
-	if (LocalOwnerActor)
-	{
-		OutName = FText::Format(FText::FromString(TEXT("{0} [{2}] [{1}]{3}{4}")), OutName, GetLocalRoleText(LocalAvatarActor == nullptr ? LocalOwnerActor->GetLocalRole() : LocalAvatarActor->GetLocalRole()), FText::FromString(LocalOwnerActor->GetName()), FText::FromString(IsPlayer ? " (Player)" : ""), FText::FromString(IsSelected ? " (Selected)" : ""));
-	}
-
-	return OutName;
-}
-
-TSharedRef<SWidget> SGASAttachEditorImpl::OnGetShowOverrideTypeMenu()
-{
-	FMenuBuilder MenuBuilder( true, NULL );
-
-	for (TWeakObjectPtr<UAbilitySystemComponent>& Comp :PlayerComp)
-	{
-		FUIAction NoAction( FExecuteAction::CreateSP( this, &SGASAttachEditorImpl::HandleOverrideTypeChange, Comp ) );
-		MenuBuilder.AddMenuEntry(GetOverrideTypeDropDownText_Explicit(Comp),FText(),FSlateIcon(),NoAction);
-	}
-	return MenuBuilder.MakeWidget();
-}
-
-FText SGASAttachEditorImpl::GetOverrideTypeDropDownText() const
-{
-	if (SelectAbilitySystemComponent.IsValid())
-	{
-		if (AActor* LocalGASActor = GetGASActor(SelectAbilitySystemComponent))
-		{
-			return FText::Format(FText::FromString(TEXT("{0}[{1}]")), FText::FromString(LocalGASActor->GetName()), GetLocalRoleText(LocalGASActor->GetLocalRole()));
-		}
-	}
-
-	return FText();
-}
-
-void SGASAttachEditorImpl::HandleOverrideTypeChange(TWeakObjectPtr<UAbilitySystemComponent> InComp)
-{
-	if (!InComp.IsValid())
-	{
-		return;
-	}
-
-	SelectAbilitySystemComponent = InComp;
-	
-	UpdateGameplayCueListItems();
-}
-
-ECheckBoxState SGASAttachEditorImpl::HandleGetPickingButtonChecked() const
-{
-	return bPickingTick ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
-}
-
-void SGASAttachEditorImpl::HandlePickingModeStateChanged(ECheckBoxState NewValue)
-{
-	SetPickingMode(!bPickingTick);
-}
-
-void SGASAttachEditorImpl::SetPickingMode(bool bTick)
-{
-/*
-#if WITH_SLATE_DEBUGGING
-	static auto CVarSlateGlobalInvalidation = IConsoleManager::Get().FindConsoleVariable(TEXT("Slate.EnableGlobalInvalidation"));
-#endif*/
-
-	bPickingTick = bTick;
-}
-
-FText SGASAttachEditorImpl::HandleGetPickingModeText() const
-{
-	//return bPickingTick ? LOCTEXT("bPickingTickYes", "按 END 键停止刷新") : LOCTEXT("bPickingTickNo", "持续更新") ;
-	return bPickingTick ? LOCTEXT("bPickingTickYes", "Press 'END' to interrupt") : LOCTEXT("bPickingTickNo", "Continuous Update") ;
-}
-
-FReply SGASAttachEditorImpl::OnExpandAllClicked()
-{
-	SetGASTreeItemExpansion(true);
-	return FReply::Handled();
-}
-
-FReply SGASAttachEditorImpl::OnCollapseAllClicked()
-{
-	SetGASTreeItemExpansion(false);
-	return FReply::Handled();
-}
-
-void SGASAttachEditorImpl::SetGASTreeItemExpansion(bool bExpand)
-{
-	bGASTreeExpand = bExpand;
-	if (SelectAbilitieCategories == EDebugAbilitieCategories::Ability && AbilitieReflectorTree.IsValid())
-	{
-		for (TSharedRef<FGASAbilitieNodeBase> Item : AbilitieFilteredTreeRoot)
-		{
-			AbilitieReflectorTree->SetItemExpansion(Item, bExpand);
-		}
-	}
-	else if (SelectAbilitieCategories == EDebugAbilitieCategories::GameplayEffects && GameplayEffectTree.IsValid())
-	{
-		for (TSharedRef<FGASGameplayEffectNodeBase> Item : GameplayEffectTreeRoot)
-		{
-			GameplayEffectTree->SetItemExpansion(Item, bExpand);
-		}
-	}
-}
-
-void SGASAttachEditorImpl::SaveSettings()
-{
-	GConfig->SetArray(TEXT("GASAttachEditor"), TEXT("HiddenReflectorTreeColumns"), HiddenReflectorTreeColumns, *GEditorPerProjectIni);
-	GConfig->SetArray(TEXT("GASAttachEditor"), TEXT("HiddenGameplayEffectTreeColumns"), HiddenGameplayEffectTreeColumns, *GEditorPerProjectIni);
-}
-
-void SGASAttachEditorImpl::LoadSettings()
-{
-	GConfig->GetArray(TEXT("GASAttachEditor"), TEXT("HiddenReflectorTreeColumns"), HiddenReflectorTreeColumns, *GEditorPerProjectIni);
-	GConfig->GetArray(TEXT("GASAttachEditor"), TEXT("HiddenGameplayEffectTreeColumns"), HiddenGameplayEffectTreeColumns, *GEditorPerProjectIni);
-}
-
-void SGASAttachEditorImpl::UpdateGameplayCueListItems()
-{
-
-	FASCDebugTargetInfo* TargetInfo = GetASCDebugTargetInfo(GetWorld());
-
-	if (UAbilitySystemComponent* ASC = GetDebugTarget(TargetInfo, SelectAbilitySystemComponent.Get(), SelectAbilitySystemComponentForActorName))
-	{
-		SelectAbilitySystemComponent = ASC;
-
-		// 标签组
-		// Tag group
-		if (SelectAbilitieCategories == EDebugAbilitieCategories::Tags && FilteredOwnedTagsView.IsValid())
-		{
-			FGameplayTagContainer OwnerTags;
-			SelectAbilitySystemComponent->GetOwnedGameplayTags(OwnerTags);
-			if (OldOwnerTags != OwnerTags)
-			{
-				OldOwnerTags = OwnerTags;
-				FilteredOwnedTagsView->ClearChildren();
-#if WITH_EDITOR
-				OwnweTagContainer.Reset();
-#endif
-				
-				for (FGameplayTag InTag : OwnerTags)
-				{
-					FilteredOwnedTagsView->AddSlot()
-						[
-							SNew(SCharacterTagsViewItem)
-							.TagsItem(FGASCharacterTags::Create(ASC, InTag, "ActivationOwnedTags"))
-						];
-#if WITH_EDITOR
-					OwnweTagContainer.AddTag(InTag);
-#endif
-				}
-
-			}
-			
-
-			FGameplayTagContainer BlockTags;
-			ASC->GetBlockedAbilityTags(BlockTags);
-
-			if (BlockTags != OldBlockedTags)
-			{
-				FilteredBlockedTagsView->ClearChildren();
-#if WITH_EDITOR
-				BlockedTagContainer.Reset();
-#endif
-				for (FGameplayTag InTag : BlockTags)
-				{
-					FilteredBlockedTagsView->AddSlot()
-						[
-							SNew(SCharacterTagsViewItem)
-							.TagsItem(FGASCharacterTags::Create(ASC, InTag, "ActivationBlockedTags"))
-						];
-#if WITH_EDITOR
-					BlockedTagContainer.AddTag(InTag);
-#endif
-				}
-
-			}
-		}
-
-		/*TArray<FName> LocalDisplayNames;
-		LocalDisplayNames.Add(TargetInfo->DebugCategories[TargetInfo->DebugCategoryIndex]);*/
-
-		// 技能组
-		// Ability group
-		if (SelectAbilitieCategories == EDebugAbilitieCategories::Ability && AbilitieReflectorTree.IsValid())
-		{
-			AbilitieFilteredTreeRoot.Reset();
-
-			for (FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
-			{
-				if (!AbilitySpec.Ability) continue;
-				TSharedRef<FGASAbilitieNode> NewItem = FGASAbilitieNode::Create(ASC, AbilitySpec);
-
-				NewItem->SetItemVisility(NewItem->ScreenGAMode & ScreenModeState);
-
-				AbilitieFilteredTreeRoot.Add(NewItem);
-
-				AbilitieReflectorTree->SetItemExpansion(AbilitieFilteredTreeRoot.Top(), bGASTreeExpand);
-			}
-
-			RequestSort();
-
-
-		}
-
-		// 属性组
-		// Attribute group
-		if (SelectAbilitieCategories == EDebugAbilitieCategories::Attributes &&  AttributesReflectorTree.IsValid())
-		{
-			AttributesFilteredTreeRoot.Reset();
-			for (UAttributeSet* Set : ASC->GetSpawnedAttributes())
-			{
-				if (!Set)
-				{
-					continue;
-				}
-
-				for (TFieldIterator<FStructProperty> It(Set->GetClass()); It; ++It)
-				{
-					if ((*It)->Struct == FGameplayAttributeData::StaticStruct())
-					{
-						FGameplayAttribute	Attribute(*It);
-						TSharedRef<FGASAttributesNode> NewItem = FGASAttributesNode::Create(ASC, Attribute);
-
-						AttributesFilteredTreeRoot.Add(NewItem);
-					}
-				}
-			}
-			AttributesReflectorTree->RequestTreeRefresh();
-
-		}
-
-		// 游戏效果组
-		// GameplayEffect group
-		if (SelectAbilitieCategories == EDebugAbilitieCategories::GameplayEffects && GameplayEffectTree.IsValid())
-		{
-			GameplayEffectTreeRoot.Reset();
-
-			FProperty* GameplayEffectsPtr = FindFProperty<FProperty>(ASC->GetClass(), "ActiveGameplayEffects");
-
-			if (!GameplayEffectsPtr) return;
-			FActiveGameplayEffectsContainer* ActiveGameplayEffectsPtr = GameplayEffectsPtr->ContainerPtrToValuePtr<FActiveGameplayEffectsContainer>(ASC);
-			if (!ActiveGameplayEffectsPtr) return;
-
-			for (FActiveGameplayEffect& ActiveGE : ActiveGameplayEffectsPtr)
-			{
-				GameplayEffectTreeRoot.Add(FGASGameplayEffectNode::Create(GetWorld(), ActiveGE));
-
-				GameplayEffectTree->SetItemExpansion(GameplayEffectTreeRoot.Top(), bGASTreeExpand);
-			}
-
-			GameplayEffectTree->RequestTreeRefresh();
-		}
-	}
-}
-
-FReply SGASAttachEditorImpl::UpdateGameplayCueListItemsButtom()
-{
-	UpDataPlayerComp(GetWorld());
-
-	UpdateGameplayCueListItems();
-
-	return FReply::Handled();
-}
-
-TSharedRef<SWidget> SGASAttachEditorImpl::OnGetShowDebugAbilitieCategories()
-{
-	FMenuBuilder MenuBuilder(true, NULL);
-
-	TArray<EDebugAbilitieCategories> Categories({ EDebugAbilitieCategories::Ability,EDebugAbilitieCategories::Attributes,EDebugAbilitieCategories::GameplayEffects, EDebugAbilitieCategories::Tags });
-
-	for (EDebugAbilitieCategories& Type : Categories)
-	{
-
-		FUIAction NoAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::HandleShowDebugAbilitieCategories, Type));
-		MenuBuilder.AddMenuEntry(FText::FromName(GetAbilitieCategoriesName(Type)), GetAbilitieCategoriesText(Type), FSlateIcon(), NoAction);
-	}
-
-
-	return MenuBuilder.MakeWidget();
-}
-
-FText SGASAttachEditorImpl::GetShowDebugAbilitieCategoriesDropDownText() const
-{
-	return FText::FromName(GetAbilitieCategoriesName(SelectAbilitieCategories));
-}
-
-void SGASAttachEditorImpl::HandleShowDebugAbilitieCategories(EDebugAbilitieCategories InType)
-{
-	SelectAbilitieCategories = InType;
-
-	CreateDebugAbilitieCategories(InType);
-}
-
-FORCEINLINE FName SGASAttachEditorImpl::GetAbilitieCategoriesName(EDebugAbilitieCategories InType) const
-{
-	FName TypeName;
-	switch (InType)
-	{
-	case EDebugAbilitieCategories::Tags:
-		TypeName = "Tags";
-		break;
-	case EDebugAbilitieCategories::Ability:
-		TypeName = "Ability";
-		break;
-	case EDebugAbilitieCategories::Attributes:
-		TypeName = "Attributes";
-		break;
-	case EDebugAbilitieCategories::GameplayEffects:
-		TypeName = "GameplayEffects";
-		break;
-	}
-
-	return TypeName;
-}
-
-FORCEINLINE FText SGASAttachEditorImpl::GetAbilitieCategoriesText(EDebugAbilitieCategories InType) const
-{
-	FText TypeText;
-	switch (InType)
-	{
-	case EDebugAbilitieCategories::Tags:
-		//TypeText = LOCTEXT("Categories_Tigs", "标签");
-		TypeText = LOCTEXT("Categories_Tigs", "Tigs");
-		break;
-	case EDebugAbilitieCategories::Ability:
-		//TypeText = LOCTEXT("Categories_Ability", "技能");
-		TypeText = LOCTEXT("Categories_Ability", "Ability");
-		break;
-	case EDebugAbilitieCategories::Attributes:
-		//TypeText = LOCTEXT("Categories_Attributes", "属性");
-		TypeText = LOCTEXT("Categories_Attributes", "Attributes");
-		break;
-	case EDebugAbilitieCategories::GameplayEffects:
-		//TypeText = LOCTEXT("Categories_GameplayEffects", "效果");
-		TypeText = LOCTEXT("Categories_GameplayEffects", "GameplayEffects");
-		break;
-	}
-
-	return TypeText;
-}
-
-void SGASAttachEditorImpl::CreateDebugAbilitieCategories(EDebugAbilitieCategories InType)
-{
-	if (!CategoriesToolSlot.IsValid())
-	{
-		return;
-	}
-
-	CategoriesToolSlot->ClearChildren();
-
-	TSharedPtr<SWidget> CategoriesWidget;
-
-	switch (InType)
-	{
-	case EDebugAbilitieCategories::Attributes:
-		CategoriesWidget = CreateAttributesToolWidget();
-		break;
-	case EDebugAbilitieCategories::GameplayEffects:
-		CategoriesWidget = CreateGameplayEffectToolWidget();
-		break;
-	case EDebugAbilitieCategories::Ability:
-		CategoriesWidget = CreateAbilityToolWidget();
-		break;
-	case EDebugAbilitieCategories::Tags:
-		CategoriesWidget = CreateAbilityTagWidget();
-		break;
-	}
-
-	if (!CategoriesWidget.IsValid())
-	{
-		return;
-	}
-	
-	CategoriesToolSlot->AddSlot()
-		[
-			CategoriesWidget.ToSharedRef()
-		];
-}
-
-UWorld* SGASAttachEditorImpl::GetWorld()
-{
-
-	UWorld* World = nullptr;
-
-	const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
-
-	TArray<FWorldContext> NewWorldList;
-
-	for (auto& Item : WorldList)
-	{
-		if (Item.WorldType == EWorldType::Type::PIE || Item.WorldType == EWorldType::Type::Game)
-		{
-			NewWorldList.Add(Item);
-			if (Item.ContextHandle == SelectWorldSceneConetextHandle)
-			{
-				return Item.World();
-			}
-		}
-	}
-
-	if (NewWorldList.Num())
-	{
-		SelectWorldSceneConetextHandle = NewWorldList[0].ContextHandle;
-
-		if (NewWorldList[0].RunAsDedicated)
-		{
-			//SelectWorldSceneText = LOCTEXT("Dedicated", "专用服务器");
-			SelectWorldSceneText = LOCTEXT("Dedicated", "Dedicated");
-		}
-		else
-		{
-			if (NewWorldList[0].WorldType == EWorldType::Type::Game)
-			{
-				SelectWorldSceneText = LOCTEXT("Client","Client");
-			}
-			else
-			{
-				SelectWorldSceneText = FText::Format(FText::FromString("{0}  [{1}]"), LOCTEXT("Client", "Client"), FText::AsNumber(NewWorldList[0].PIEInstance));
-			}
-			
-		}
-
-		return NewWorldList[0].World();
-	}
-
-	return nullptr;
-
-}
-
-TSharedPtr<SWidget> SGASAttachEditorImpl::CreateAbilityTagWidget()
-{
-	return SNew(SSplitter)
-		.Orientation(Orient_Vertical)
-		+ SSplitter::Slot()
-		.Value(0.7f)
-		[
-			SNew(SVerticalBox)
-
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			.HAlign(HAlign_Left)
-			.Padding(2.f)
-			[
-				SNew(STextBlock)
-				//.Text(LOCTEXT("CharacterHasOwnTags", "当前角色拥有的Tags"))
-				.Text(LOCTEXT("CharacterHasOwnTags", "Player Owned Tags"))
-			]
-
-			+ SVerticalBox::Slot()
-			.FillHeight(1.f)
-			[
-				SNew(SBorder)
-				.Padding(2.f)
-#if WITH_EDITOR
-				.OnMouseButtonUp(this, &SGASAttachEditorImpl::OnMouseButtonUpTags, FName("OwnTags"))
-#endif
-				[
-					SAssignNew(FilteredOwnedTagsView, SWrapBox)
-					.Orientation(EOrientation::Orient_Horizontal)
-					.UseAllottedSize(true)
-					.InnerSlotPadding(FVector2D(5.f))
-				]
-			]
-		]
-
-		+ SSplitter::Slot()
-		.Value(0.3f)
-		[
-			SNew(SVerticalBox)
-
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			.HAlign(HAlign_Left)
-			.Padding(2.f)
-			[
-				SNew(STextBlock)
-				//.Text(LOCTEXT("CharacterHasBlaTags", "当前角色阻止的Tags"))
-			.Text(LOCTEXT("CharacterHasBlaTags", "Player Back Tags"))
-			]
-
-			+ SVerticalBox::Slot()
-			.FillHeight(1.f)
-			[
-				SNew(SBorder)
-#if WITH_EDITOR
-				.OnMouseButtonUp(this, &SGASAttachEditorImpl::OnMouseButtonUpTags, FName("BlaTags"))
-#endif
-				.Padding(2.f)
-				[
-					SAssignNew(FilteredBlockedTagsView, SWrapBox)
-					.Orientation(EOrientation::Orient_Horizontal)
-					.UseAllottedSize(true)
-					.InnerSlotPadding(FVector2D(5.f))
-				]
-			]
-	];
-}
-
-void SGASAttachEditorImpl::OnApplicationPreInputKeyDownListener(const FKeyEvent& InKeyEvent)
-{
-	if (InKeyEvent.GetKey() == EKeys::End)
-	{
-		SetPickingMode(false);
-	}
-}
-#if WITH_EDITOR
-FReply SGASAttachEditorImpl::OnMouseButtonUpTags(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent, FName TagsName)
-{
-	if (MouseEvent.GetEffectingButton() == EKeys::RightMouseButton)
-	{
-		TSharedPtr<SGameplayTagWidget> TagWidget = 
-			SNew(SGameplayTagWidget, TagsName == "OwnTags" ? EditableOwnerContainers : EditableBlockedContainers)
-			.GameplayTagUIMode(EGameplayTagUIMode::SelectionMode)
-			.ReadOnly(false)
-			.OnTagChanged(this, &SGASAttachEditorImpl::RefreshTagList, TagsName);
-
-		if (TagWidget.IsValid())
-		{
-			if (TagsName == "OwnTags")
-			{
-				OldOwnweTagContainer = OwnweTagContainer;
-			}
-			else
-			{
-				OldBlockedTagContainer = BlockedTagContainer;
-			}
-
-			FWidgetPath WidgetPath = MouseEvent.GetEventPath() != nullptr ? *MouseEvent.GetEventPath() : FWidgetPath();
-			FSlateApplication::Get().PushMenu(AsShared(), WidgetPath, TagWidget.ToSharedRef(), MouseEvent.GetScreenSpacePosition(), FPopupTransitionEffect(FPopupTransitionEffect::ContextMenu));
-		}
-
-	}
-	return FReply::Handled();
-}
-
-
-void SGASAttachEditorImpl::RefreshTagList(FName TagsName)
-{
-	bool bIsOwnTag = TagsName == "OwnTags";
-
-	FGameplayTagContainer* NewTagContainer =  bIsOwnTag ? &OwnweTagContainer : &BlockedTagContainer;
-	FGameplayTagContainer* OldTagContainer = bIsOwnTag ? &OldOwnweTagContainer : &OldBlockedTagContainer;
-
-	if (!SelectAbilitySystemComponent.IsValid() || !NewTagContainer || !OldTagContainer) return;
-
-	if (NewTagContainer->Num() > OldTagContainer->Num())
-	{
-		TArray<FGameplayTag> NewGameplayTagArr;
-		NewTagContainer->GetGameplayTagArray(NewGameplayTagArr);
-
-		// 是否增加
-		// Is Add
-		for (const FGameplayTag& Item : NewGameplayTagArr)
-		{
-			if (OldTagContainer->HasTag(Item)) continue;
-
-			if (bIsOwnTag)
-			{
-				SelectAbilitySystemComponent->AddLooseGameplayTag(Item);
-			}
-			else
-			{
-
-			}
-		}
-	}
-	else
-	{
-		TArray<FGameplayTag> OldGameplayTagArr;
-		OldTagContainer->GetGameplayTagArray(OldGameplayTagArr);
-		
-		// 是否是减少
-		// Is Reduce
-		for (const FGameplayTag& Item : OldGameplayTagArr)
-		{
-			if (NewTagContainer->HasTag(Item)) continue;
-
-			if (bIsOwnTag)
-			{
-				SelectAbilitySystemComponent->RemoveLooseGameplayTag(Item);
-			}
-			else
-			{
-
-			}
-		}
-	}
-	
-	*OldTagContainer = *NewTagContainer;
-}
-#endif
-void SGASAttachEditorImpl::HandleScreenModeStateChanged(ECheckBoxState NewValue, EScreenGAModeState InState)
-{
-	switch (NewValue)
-	{
-	case ECheckBoxState::Unchecked:
-		ScreenModeState ^= InState;
-		break;
-	case ECheckBoxState::Checked:
-		ScreenModeState |= InState;
-		break;
-	case ECheckBoxState::Undetermined:
-		break;
-	default:
-		break;
-	}
-
-	for (TSharedRef<FGASAbilitieNodeBase>& Item : AbilitieFilteredTreeRoot)
-	{
-		Item->SetItemVisility(Item->ScreenGAMode & ScreenModeState);
-	}
-}
-
-ECheckBoxState SGASAttachEditorImpl::HandleGetScreenButtonChecked(EScreenGAModeState InState) const
-{
-	return ScreenModeState & InState ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
-}
-
-TSharedPtr<SCheckBox> SGASAttachEditorImpl::CreateScreenCheckBox(EScreenGAModeState InModeState)
-{
-	return SNew(SCheckBox)
-			.Padding(FMargin(4, 0))
-			.IsChecked(this, &SGASAttachEditorImpl::HandleGetScreenButtonChecked, InModeState)
-			.OnCheckStateChanged_Lambda([this,InModeState](ECheckBoxState NewValue){ HandleScreenModeStateChanged(NewValue,InModeState);})
-			[
-				SNew(SBox)
-				.MinDesiredWidth(80.f)
-				.VAlign(VAlign_Center)
-				[
-					SNew(STextBlock)
-					.Text(this, &SGASAttachEditorImpl::HandleGeScreenModeText, InModeState)
-				]
-			];
-}
-
-FText SGASAttachEditorImpl::HandleGeScreenModeText(EScreenGAModeState InState) const
-{
-	FText StateText;
-	switch (InState)
-	{
-	case Active:
-		//StateText = LOCTEXT("ActiveScreen","激活");
-		StateText = LOCTEXT("ActiveScreen","Active");
-		break;
-	case Blocked:
-		//StateText = LOCTEXT("BlockedScreen","阻止");
-		StateText = LOCTEXT("BlockedScreen","Blocked");
-		break;
-	case NoActive:
-		//StateText = LOCTEXT("NoActive","未激活");
-		StateText = LOCTEXT("NoActive","Inactive");
-		break;
-	default:
-		break;
-	}
-
-	return StateText;
-}
-
-TSharedPtr<SWidget> SGASAttachEditorImpl::CreateAbilityToolWidget()
-{
-
-	TArray<FName> HiddenColumnsList;
-	HiddenColumnsList.Reserve(HiddenReflectorTreeColumns.Num());
-	for (const FString& Item : HiddenReflectorTreeColumns)
-	{
-		HiddenColumnsList.Add(*Item);
-	}
-
-	TSharedPtr<SVerticalBox> Widget = 
-			SNew(SVerticalBox)
-			+ SVerticalBox::Slot()
-			.Padding(2.f, 2.f)
-			.AutoHeight()
-			.HAlign(HAlign_Left)
-			[
-				SNew(SHorizontalBox)
-
-				+ SHorizontalBox::Slot()
-				.Padding(FMargin(8.f, 0.f))
-				.AutoWidth()
-				[
-					SNew(SButton)
-					.OnClicked(this, &SGASAttachEditorImpl::OnExpandAllClicked)
-					.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_ExpandAll", "Expand All"))
-				]
-
-				+ SHorizontalBox::Slot()
-				.AutoWidth()
-				[
-					SNew(SButton)
-					.OnClicked(this, &SGASAttachEditorImpl::OnCollapseAllClicked)
-					.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_CollapseAll", "Collapse All"))
-				]
-			]
-
-			+ SVerticalBox::Slot()
-			.Padding(2.f, 2.f)
-			.AutoHeight()
-			.HAlign(HAlign_Left)
-			[
-				SNew(SHorizontalBox)
-
-				+ SHorizontalBox::Slot()
-				[
-					CreateScreenCheckBox(Active).ToSharedRef()
-				]
-
-				+ SHorizontalBox::Slot()
-				[
-					CreateScreenCheckBox(Blocked).ToSharedRef()
-				]
-
-				+ SHorizontalBox::Slot()
-				[
-					CreateScreenCheckBox(NoActive).ToSharedRef()
-				]
-			]
-
-		+ SVerticalBox::Slot()
-		.FillHeight(1.f)
-		[
-			SNew(SBorder)
-			.Padding(0)
-			[
-				SAssignNew(AbilitieReflectorTree, SAbilitieTree)
-				.ItemHeight(24.f)
-				.TreeItemsSource(&AbilitieFilteredTreeRoot)
-				.OnGenerateRow(this, &SGASAttachEditorImpl::OnGenerateWidgetForFilterListView)
-				.OnGetChildren(this, &SGASAttachEditorImpl::HandleReflectorTreeGetChildren)
-				.OnSelectionChanged(this, &SGASAttachEditorImpl::HandleReflectorTreeSelectionChanged)
-				.OnContextMenuOpening(this, &SGASAttachEditorImpl::HandleReflectorTreeContextMenuPtr)
-				.HighlightParentNodesForSelection(true)
-				.HeaderRow
-				(
-					SNew(SHeaderRow)
-					.CanSelectGeneratedColumn(true)
-					.HiddenColumnsList(HiddenColumnsList)
-					.OnHiddenColumnsListChanged(this, &SGASAttachEditorImpl::HandleReflectorTreeHiddenColumnsListChanged)
-
-					+ SHeaderRow::Column(NAME_AbilitietName)
-					.SortMode(this,&SGASAttachEditorImpl::GetColumnSortMode, NAME_AbilitietName)
-					.OnSort(this, &SGASAttachEditorImpl::OnColumnSortModeChanged)
-					//.DefaultLabel(LOCTEXT("AbilitietName", "名称"))
-					.DefaultLabel(LOCTEXT("AbilitietName", "Ability Name"))
-					//.DefaultTooltip(LOCTEXT("AbilitietNameToolTip", "技能名称/任务名称/调试名称"))
-					.DefaultTooltip(LOCTEXT("AbilitietNameToolTip", "Ability/Task name"))
-					.FillWidth(0.6f)
-					.ShouldGenerateWidget(true)
-
-					+ SHeaderRow::Column(NAME_GAStateType)
-					/*.DefaultLabel(LOCTEXT("GAAbilitietStateType", "当前状态"))
-					.DefaultTooltip(LOCTEXT("GAStateTypeToolTip", "当前状态是否激活，或者是可以被激活但是因为某些原因被拦截"))*/
-					.DefaultLabel(LOCTEXT("GAAbilitietStateType", "State"))
-					.DefaultTooltip(LOCTEXT("GAStateTypeToolTip", "Whether the ability is active, inactive or blocked"))
-					.FillWidth(0.2f)
-
-					+ SHeaderRow::Column(NAME_GAIsActive)
-					//.DefaultLabel(LOCTEXT("GAIsActive", "是否激活"))
-					.DefaultLabel(LOCTEXT("GAIsActive", "Active"))
-					.FixedWidth(60.f)
-
-					+ SHeaderRow::Column(NAME_GAAbilityTriggers)
-					//.DefaultLabel(LOCTEXT("GAAbilityTriggers", "存在的激活Tag"))
-					.DefaultLabel(LOCTEXT("GAAbilityTriggers", "Triggers"))
-					.HAlignHeader(EHorizontalAlignment::HAlign_Center)
-					.FillWidth(0.2)
-				)
-			]
-		];
-
-
-	return Widget;
-}
-
-TSharedPtr<SWidget> SGASAttachEditorImpl::CreateAttributesToolWidget()
-{
-	return SNew(SBorder)
-			.Padding(0)
-			[
-				SAssignNew(AttributesReflectorTree,SAttributesTree)
-				.ItemHeight(32.f)
-				.TreeItemsSource(&AttributesFilteredTreeRoot) 
-				.OnGenerateRow(this, &SGASAttachEditorImpl::HandleAttributesWidgetForFilterListView)
-				.OnGetChildren(this, &SGASAttachEditorImpl::HandleAttributesTreeGetChildren)
-				.HighlightParentNodesForSelection(true)
-				.HeaderRow
-				(
-					SNew(SHeaderRow)
-					.CanSelectGeneratedColumn(true)
-
-					+ SHeaderRow::Column(NAME_AttributesName)
-					//.DefaultLabel(LOCTEXT("AttributesName", "属性名称"))
-					.DefaultLabel(LOCTEXT("AttributesName", "AttributesName"))
-					.FillWidth(0.4f)
-					.ShouldGenerateWidget(true)
-
-					+ SHeaderRow::Column(NAME_GANumericAttribute)
-					//.DefaultLabel(LOCTEXT("GAAttributeStateType", "当前属性值"))
-					.DefaultLabel(LOCTEXT("GAAttributeStateType", "Attribute Value"))
-					.FillWidth(0.6f)
-
-				)
-			];
-}
-
-TSharedPtr<SWidget> SGASAttachEditorImpl::CreateGameplayEffectToolWidget()
-{
-	TArray<FName> HiddenColumnsList;
-	HiddenColumnsList.Reserve(HiddenGameplayEffectTreeColumns.Num());
-	for (const FString& Item : HiddenGameplayEffectTreeColumns)
-	{
-		HiddenColumnsList.Add(*Item);
-	}
-
-	TSharedPtr<SVerticalBox> Widget =
-		SNew(SVerticalBox)
-		+ SVerticalBox::Slot()
-		.Padding(2.f, 2.f)
-		.AutoHeight()
-		.HAlign(HAlign_Left)
-		[
-			SNew(SHorizontalBox)
-
-			+ SHorizontalBox::Slot()
-			.Padding(FMargin(8.f, 0.f))
-			.AutoWidth()
-			[
-				SNew(SButton)
-				.OnClicked(this, &SGASAttachEditorImpl::OnExpandAllClicked)
-				.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_ExpandAll", "Expand All"))
-			]
-
-			+ SHorizontalBox::Slot()
-			.AutoWidth()
-			[
-				SNew(SButton)
-				.OnClicked(this, &SGASAttachEditorImpl::OnCollapseAllClicked)
-				.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_CollapseAll", "Collapse All"))
-			]
-		]
-
-		+ SVerticalBox::Slot()
-		.FillHeight(1.f)
-		[
-			SNew(SBorder)
-			.Padding(0.f)
-			[
-				SAssignNew(GameplayEffectTree, SGameplayEffectTree)
-				.ItemHeight(24.f)
-				.TreeItemsSource(&GameplayEffectTreeRoot)
-				.OnGenerateRow(this, &SGASAttachEditorImpl::OneGameplayEffecGenerateWidgetForFilterListView)
-				.OnGetChildren(this, &SGASAttachEditorImpl::HandleGameplayEffectTreeGetChildren)
-				.OnSelectionChanged(this, &SGASAttachEditorImpl::HandleGameplayEffectTreeSelectionChanged)
-				.HighlightParentNodesForSelection(true)
-				.HeaderRow
-				(
-					SNew(SHeaderRow)
-					.CanSelectGeneratedColumn(true)
-					.HiddenColumnsList(HiddenColumnsList)
-					.OnHiddenColumnsListChanged(this, &SGASAttachEditorImpl::HandleGameplayEffectTreeHiddenColumnsListChanged)
-
-				+ SHeaderRow::Column(NAME_GAGameplayEffectName)
-				//.DefaultLabel(LOCTEXT("GAGameplayEffectName", "名称"))
-				.DefaultLabel(LOCTEXT("GAGameplayEffectName", "GameplayEffectName"))
-				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
-				//.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "GE名称 / 加成属性"))
-				.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "GameplayEffect Name / Bonus Attribute"))
-				.FillWidth(0.2f)
-
-				+ SHeaderRow::Column(NAME_GAGameplayEffectDuration)
-				//.DefaultLabel(LOCTEXT("GAGameplayEffectDuration", "时间"))
-				.DefaultLabel(LOCTEXT("GAGameplayEffectDuration", "Time"))
-				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
-				//.DefaultTooltip(LOCTEXT("GAGameplayEffectDurationToolTip", "GE时间详细叙述"))
-				.DefaultTooltip(LOCTEXT("GAGameplayEffectDurationToolTip", "GameplayEffect Time"))
-				.FillWidth(0.4f)
-
-				+ SHeaderRow::Column(NAME_GAGameplayEffectStack)
-				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
-				//.DefaultLabel(LOCTEXT("GAGameplayEffectStack", "堆栈信息"))
-				.DefaultLabel(LOCTEXT("GAGameplayEffectStack", "GameplayEffectStack"))
-				.FillWidth(0.1f)
-
-				+ SHeaderRow::Column(NAME_GAGameplayEffectLevel)
-				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
-				//.DefaultLabel(LOCTEXT("GAGameplayEffectLevel", "等级"))
-				.DefaultLabel(LOCTEXT("GAGameplayEffectLevel", "Level"))
-				.FillWidth(0.1f)
-
-				+ SHeaderRow::Column(NAME_GAGameplayEffectGrantedTags)
-				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
-				//.DefaultLabel(LOCTEXT("GAGameplayEffectGrantedTags", "标签"))
-				//.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "含有的所有标签"))
-				.DefaultLabel(LOCTEXT("GAGameplayEffectGrantedTags", "Tags"))
-				.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "GameplayEffect Own Tags"))
-				.FillWidth(0.2f)
-			)
-			]
-		];
-
-	return Widget;
-}
-
-TSharedRef<ITableRow> SGASAttachEditorImpl::OneGameplayEffecGenerateWidgetForFilterListView(TSharedRef< FGASGameplayEffectNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable)
-{
-	return SNew(SGASGameplayEffectTreeItem, OwnerTable)
-		.WidgetInfoToVisualize(InItem);
-}
-
-void SGASAttachEditorImpl::HandleGameplayEffectTreeGetChildren(TSharedRef<FGASGameplayEffectNodeBase> InReflectorNode, TArray<TSharedRef<FGASGameplayEffectNodeBase>>& OutChildren)
-{
-	OutChildren = InReflectorNode->GetChildNodes();
-}
-
-void SGASAttachEditorImpl::HandleGameplayEffectTreeHiddenColumnsListChanged()
-{
-#if WITH_EDITOR
-	if (GameplayEffectTree && GameplayEffectTree->GetHeaderRow())
-	{
-		const TArray<FName> HiddenColumnIds = GameplayEffectTree->GetHeaderRow()->GetHiddenColumnIds();
-		HiddenGameplayEffectTreeColumns.Reset(HiddenColumnIds.Num());
-		for (const FName Id : HiddenColumnIds)
-		{
-			HiddenGameplayEffectTreeColumns.Add(Id.ToString());
-		}
-		SaveSettings();
-	}
-#endif
-}
-
-void SGASAttachEditorImpl::HandleGameplayEffectTreeSelectionChanged(TSharedPtr<FGASGameplayEffectNodeBase>, ESelectInfo::Type /*SelectInfo*/)
-{
-
-}
-
-FAttachInputProcessor::FAttachInputProcessor(SGASAttachEditor* InWidgetPtr)
-	:GASAttachEditorWidgetPtr(InWidgetPtr)
-{
-}
-
-bool FAttachInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
-{
-	if (InKeyEvent.GetKey() == EKeys::End && GASAttachEditorWidgetPtr)
-	{
-		GASAttachEditorWidgetPtr->SetPickingMode(false);
-	}
-
-	return false;
-}
-
-#undef LOCTEXT_NAMESPACE
+#include "SGASAttachEditor.h"
+#include "Widgets/SBoxPanel.h"
+#include "GASAttachEditor/SGASReflectorNodeBase.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/Engine.h"
+#include "GameplayAbilitySpec.h"
+#include "../Public/GASAttachEditorStyle.h"
+#include "Widgets/Views/STreeView.h"
+#include "GASAttachEditor/SGASCharacterTagsBase.h"
+#include "GASAttachEditor/SGASAttributesNodeBase.h"
+#include "Widgets/SToolTip.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameplayTagsManager.h"
+#if WITH_EDITOR
+#include "SGameplayTagWidget.h"
+#include "EditorStyleSet.h"
+#endif
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Layout/SBorder.h"
+#include "GASAttachEditor/SGASGameplayEffectNodeBase.h"
+#include "GASAttachEditor/SGASSnapshotNodeBase.h"
+#include "GASAttachEditor/SGASTagChurnNodeBase.h"
+#include "GASAttachEditor/SGASAbilityMatrix.h"
+#include "Capture/GASFreezeFrame.h"
+#include "Capture/GASCaptureDiff.h"
+#include "Capture/GASCaptureSampler.h"
+#include "Export/GASStreamingExport.h"
+#include "Monitor/GASTagSourceIndex.h"
+#include "Monitor/GASTagChurn.h"
+#include "Monitor/GASTagHolderIndex.h"
+#include "Monitor/GASAbilityBlockers.h"
+#include "Monitor/GASAbilityMatrix.h"
+#include "Monitor/GASTagLeaks.h"
+#include "HAL/PlatformApplicationMisc.h"
+#include "Misc/Paths.h"
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorCommands.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Widgets/SWidget.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Framework/Commands/UIAction.h"
+#include "HAL/ExceptionHandling.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/UObjectIterator.h"
+#include "GameFramework/Pawn.h"
+#include "GASAttachEditorStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Widgets/Images/SImage.h"
+#include "Styling/CoreStyle.h"
+
+#define LOCTEXT_NAMESPACE "SGASAttachEditor"
+
+static TAutoConsoleVariable<float> CVarGASAttachEditorSampleInterval(
+	TEXT("GASAttachEditor.SampleInterval"),
+	0.f,
+	TEXT("Game time in seconds between two samples of the inspected world while continuous update is on. 0 samples on every world tick."),
+	ECVF_Default);
+
+const FName GAActivationColumnName("GAActivation");
+
+struct FASCDebugTargetInfo
+{
+	FASCDebugTargetInfo()
+	{
+		DebugCategoryIndex = 0;
+		DebugCategories.Add(TEXT("Attributes"));
+		DebugCategories.Add(TEXT("GameplayEffects"));
+		DebugCategories.Add(TEXT("Ability"));
+	}
+
+	TArray<FName> DebugCategories;
+	int32 DebugCategoryIndex;
+
+	TWeakObjectPtr<UWorld>	TargetWorld;
+	TWeakObjectPtr<UAbilitySystemComponent>	LastDebugTarget;
+};
+
+TArray<FASCDebugTargetInfo>	AbilitySystemAttachDebugInfoList;
+
+FASCDebugTargetInfo* GetASCDebugTargetInfo(UWorld* World)
+{
+	FASCDebugTargetInfo* TargetInfo = nullptr;
+	for (FASCDebugTargetInfo& Info : AbilitySystemAttachDebugInfoList)
+	{
+		if (Info.TargetWorld.Get() == World)
+		{
+			TargetInfo = &Info;
+			break;
+		}
+	}
+	if (TargetInfo == nullptr)
+	{
+		TargetInfo = &AbilitySystemAttachDebugInfoList[AbilitySystemAttachDebugInfoList.AddDefaulted()];
+		TargetInfo->TargetWorld = World;
+	}
+	return TargetInfo;
+}
+
+TArray<TWeakObjectPtr< UAbilitySystemComponent>> PlayerComp;
+
+void UpDataPlayerComp(UWorld* World)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_UpDataPlayerComp);
+
+	PlayerComp.Reset();
+
+	if (!World)
+	{
+		return;
+	}
+
+	for (TObjectIterator<UAbilitySystemComponent> It; It; ++It)
+	{
+		if (UAbilitySystemComponent* ASC = *It)
+		{
+			if (ASC->GetWorld() != World)
+			{
+				continue;
+			}
+			if (!MakeWeakObjectPtr(ASC).Get())
+			{
+				continue;
+			}
+			PlayerComp.Add(ASC);
+		}
+	}
+}
+
+AActor* GetGASActor(const TWeakObjectPtr<UAbilitySystemComponent>& InASC)
+{
+	if (!InASC.IsValid())
+	{
+		return nullptr;
+	}
+
+	;
+	if (AActor* LocalAvatarActor = InASC->GetAvatarActor_Direct())
+	{
+		return LocalAvatarActor;
+	}
+
+ 	if (AActor* LocalOwnerActor = InASC->GetOwnerActor())
+	{
+		return LocalOwnerActor;
+	}
+
+	return nullptr;
+}
+
+UAbilitySystemComponent* GetDebugTarget(FASCDebugTargetInfo* Info, const UAbilitySystemComponent* InSelectComponent, FName& SelectActorName)
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_GetDebugTarget);
+
+	// Return target if we already have one
+	if (UAbilitySystemComponent* ASC = Info->LastDebugTarget.Get())
+	{
+		if (ASC == InSelectComponent)
+		{
+			return ASC;
+		}
+	}
+
+	// Find one
+	bool bIsSelect = false;
+
+	for (TWeakObjectPtr<UAbilitySystemComponent>& ASC : PlayerComp)
+	{
+		if (!ASC.IsValid())
+		{
+			continue;
+		}
+
+		if (InSelectComponent == ASC.Get() && !bIsSelect)
+		{
+			SelectActorName = GetGASActor(ASC)->GetFName();
+			Info->LastDebugTarget = ASC;
+			bIsSelect = true;
+			break;
+		}
+	}
+
+	if (!bIsSelect)
+	{
+		if (!PlayerComp.IsValidIndex(0))
+		{
+			// 刷新世界中的ASComp;
+			// Refresh ascomp in the world;
+			UpDataPlayerComp(Info->TargetWorld.Get());
+		}
+
+		// 如果筛选框里面有筛选的名字，则直接用那个名字的角色
+		// If there is a filtered name in the filter box, the role with that name will be used directly
+		if (SelectActorName.IsNone())
+		{
+			if (PlayerComp.IsValidIndex(0))
+			{
+				Info->LastDebugTarget = PlayerComp[0];
+				SelectActorName = GetGASActor(Info->LastDebugTarget)->GetFName();
+			}
+			else
+			{
+				Info->LastDebugTarget = nullptr;
+			}
+		}
+		else
+		{
+			bool bIsSelectActorName = false;
+			for (TWeakObjectPtr<UAbilitySystemComponent>& ASC : PlayerComp)
+			{
+				if (!ASC.IsValid()) continue;
+
+				if (GetGASActor(ASC)->GetFName() == SelectActorName)
+				{
+					Info->LastDebugTarget = ASC;
+					bIsSelectActorName = true;
+					break;
+				}
+
+			}
+
+			if (!bIsSelectActorName)
+			{
+				if (PlayerComp.IsValidIndex(0) && PlayerComp[0] != nullptr)
+				{
+					Info->LastDebugTarget = PlayerComp[0];
+					SelectActorName = GetGASActor(PlayerComp[0])->GetFName();
+				}
+				else
+				{
+					Info->LastDebugTarget = nullptr;
+				}
+			}
+		}
+
+	}
+
+	if (Info->LastDebugTarget.IsValid())
+	{
+		return Info->LastDebugTarget.Get();
+	}
+
+	return nullptr;
+}
+
+class SGASAttachEditorImpl : public SGASAttachEditor
+{
+	typedef STreeView<TSharedRef<FGASAbilitieNodeBase>> SAbilitieTree;
+	typedef STreeView<TSharedRef<FGASAttributesNodeBase>> SAttributesTree;
+	typedef STreeView<TSharedRef<FGASGameplayEffectNodeBase>> SGameplayEffectTree;
+	typedef STreeView<TSharedRef<FGASSnapshotNodeBase>> SSnapshotTree;
+
+public:
+	virtual void Construct(const FArguments& InArgs) override;
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+public:
+	virtual ~SGASAttachEditorImpl() override;
+
+
+protected:
+	// 当前筛选世界场景
+	// Current filter world scene
+	TSharedRef<SWidget>	OnGetShowWorldTypeMenu();
+
+	// 选中世界场景
+	// Select the world scene
+	void HandleShowWorldTypeChange(FWorldContext InWorldContext);
+
+private:
+	// 当期选择的世界场景句柄
+	// Current selected world scene handle
+	FName SelectWorldSceneConetextHandle;
+
+	FText SelectWorldSceneText;
+
+protected:
+
+	FText GenerateToolTipForText(TSharedRef<FGASAbilitieNodeBase> InReflectorNode) const;
+
+protected:
+	/** 树视图生成树的回调 */
+	/** Callback for tree view spanning tree */
+	TSharedRef<ITableRow> OnGenerateWidgetForFilterListView(TSharedRef< FGASAbilitieNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable);
+
+	/** 用于获取给定反射树节点的子项的回调 */
+	/** Callback to get children of a given reflection tree node */
+	void HandleReflectorTreeGetChildren( TSharedRef<FGASAbilitieNodeBase> InReflectorNode, TArray<TSharedRef<FGASAbilitieNodeBase>>& OutChildren );
+
+	/** 当反射树中的选择发生更改时的回调 */
+	/** Callback when the selection in the reflection tree changes */
+	void HandleReflectorTreeSelectionChanged(TSharedPtr<FGASAbilitieNodeBase>, ESelectInfo::Type /*SelectInfo*/);
+
+	// 提示小部件
+	// Prompt widget
+	TSharedPtr<IToolTip> GenerateToolTipForReflectorNode( TSharedRef<FGASAbilitieNodeBase> InReflectorNode );
+
+	// 当请求反射器树中的上下文菜单时的回调
+	// Callback when a context menu in the reflector tree is requested
+	TSharedPtr<SWidget> HandleReflectorTreeContextMenuPtr();
+
+	/** 反射树头列表更改时的回调. */
+	/** A callback that reflects changes to the tree header list */
+	void HandleReflectorTreeHiddenColumnsListChanged();
+
+	// GA排序
+	// sorting
+	EColumnSortMode::Type GetColumnSortMode(const FName ColumnId) const;
+
+	// 排序更改响应
+	// Sort change response
+	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode);
+
+	// 更改排序
+	// Change sort
+	void RequestSort();
+
+private:
+	// GA排序模式
+	// GA sorting mode
+	EColumnSortMode::Type SortMode;
+
+protected:
+	/** 树视图生成树的回调 */
+	/** Callback for tree view spanning tree */
+	TSharedRef<ITableRow> HandleAttributesWidgetForFilterListView(TSharedRef< FGASAttributesNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable);
+
+	void HandleAttributesTreeGetChildren( TSharedRef<FGASAttributesNodeBase> InReflectorNode, TArray<TSharedRef<FGASAttributesNodeBase>>& OutChildren );
+
+protected:
+	// 当前筛选的角色
+	// Player currently filtered
+	TSharedRef<SWidget>	OnGetShowOverrideTypeMenu();
+
+	// 当前选择的角色
+	// Currently Selected Player
+	FText GetOverrideTypeDropDownText() const;
+
+	// 选中的GAS组件
+	// Selected GAS components
+	void HandleOverrideTypeChange(TWeakObjectPtr<UAbilitySystemComponent> InComp);
+
+protected:
+	// 是否被选中
+	// Is it selected
+	ECheckBoxState HandleGetPickingButtonChecked() const;
+
+	// 选中状态更改
+	// Check status change
+	void HandlePickingModeStateChanged(ECheckBoxState NewValue);
+
+	// 设置状态改变的东东
+	// Set the status change
+	virtual void SetPickingMode(bool bTick) override;
+
+	virtual void TakeFreezeFrame() override;
+
+	// 设置单选框名称
+	// Set radio box name
+	FText HandleGetPickingModeText() const;
+
+	// 插件自身每帧的耗时
+	// The plugin's own cost per frame
+	FText HandleGetPluginCostText() const;
+
+	// 最近一次采样的帧号与游戏时间
+	// Frame number and game time of the last sample
+	FText HandleGetSampleText() const;
+
+	// 在查看的世界Tick结束后采样，和Slate的刷新频率无关
+	// Samples after the inspected world's actor tick, independent of the Slate tick rate
+	void HandleWorldPostActorTick(UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds);
+
+protected:
+
+	/** Called when the user clicks the "Expand All" button; Expands the entire tag tree */
+	FReply OnExpandAllClicked();
+
+	/** Called when the user clicks the "Collapse All" button; Collapses the entire tag tree */
+	FReply OnCollapseAllClicked();
+
+
+	void SetGASTreeItemExpansion(bool bExpand);
+
+	bool bGASTreeExpand;
+
+public:
+
+	FORCEINLINE bool HasGASTreeExpand(){ return bGASTreeExpand; }
+
+private:
+
+	void SaveSettings();
+	void LoadSettings();
+
+	// 刷新树状表
+	// Refresh tree table
+	void UpdateGameplayCueListItems();
+	FReply UpdateGameplayCueListItemsButtom();
+
+	// 创建查看Categories类型的筛选框
+	// Create a filter box to view categories types
+	TSharedRef<SWidget> OnGetShowDebugAbilitieCategories();
+
+	// 当前选择的Categories类型
+	// Currently selected categories type
+	FText GetShowDebugAbilitieCategoriesDropDownText() const;
+
+	// 选中查看的Categories类型
+	// Select the categories type to view
+	void HandleShowDebugAbilitieCategories(EDebugAbilitieCategories InType);
+
+	FORCEINLINE FName GetAbilitieCategoriesName(EDebugAbilitieCategories InType) const;
+
+	FORCEINLINE FText GetAbilitieCategoriesText(EDebugAbilitieCategories InType) const;
+
+	// 创建Categories查看控件
+	// Create categories view control
+	void CreateDebugAbilitieCategories(EDebugAbilitieCategories InType);
+
+private:
+	// Categories查看Tool的Slot控件
+	// Categories view the slot control of the tool
+	TSharedPtr<SOverlay> CategoriesToolSlot;
+
+private:
+	// 当前选择Categories类型
+	// Currently selected categories type
+	EDebugAbilitieCategories SelectAbilitieCategories;
+
+	// 按键监听指针
+	// Key monitor pointer
+	TSharedPtr<IInputProcessor> InputPtr;
+
+protected: 
+	
+	FORCEINLINE UWorld* GetWorld();
+
+private:
+
+	TSharedPtr<SCharacterTagsView> FilteredOwnedTagsView;
+
+	TSharedPtr<SCharacterTagsView> FilteredBlockedTagsView;
+
+	FGameplayTagContainer OldOwnerTags;
+
+	FGameplayTagContainer OldBlockedTags;
+
+	// 标签 -> 条目，只增删变化的标签
+	// Tag -> item; only the tags that changed are added or removed
+	TMap<FGameplayTag, TSharedPtr<FGASCharacterTagsBase>> OwnedTagItems;
+
+	TMap<FGameplayTag, TSharedPtr<FGASCharacterTagsBase>> BlockedTagItems;
+
+	// 通过筛选的条目，按名字排序，是平铺视图的数据源
+	// Items passing the filter sorted by name; the source of the tile views
+	TArray<TSharedPtr<FGASCharacterTagsBase>> FilteredOwnedTags;
+
+	TArray<TSharedPtr<FGASCharacterTagsBase>> FilteredBlockedTags;
+
+	FString TagsFilterText;
+
+	// "标签来源" 面板显示的标签
+	// Tag shown in the "Tag Sources" pane
+	TSharedPtr<FGASCharacterTagsBase> SelectedTagItem;
+
+	bool bSelectedTagBlocked;
+
+	// "标签来源" 面板的文字，只在选中的标签或者索引变化时重建，不在每次绘制时重建
+	// Text of the "Tag Sources" pane; rebuilt only when the selected tag or the index changes, not on every paint
+	FText SelectedTagSourcesText;
+
+	// 建立上面文字时选中ASC的来源序号、持有者数量和泄漏检测的时间桶
+	// Source serial of the selected ASC, holder count and leak detector bucket the text above was built from
+	uint32 SelectedTagSourcesSerial;
+
+	int32 SelectedTagSourcesHolders;
+
+	int32 SelectedTagSourcesBucket;
+
+	// 标签控件所属的ASC，换了ASC整个重建
+	// ASC the tag widgets belong to; everything is rebuilt when it changes
+	TWeakObjectPtr<UAbilitySystemComponent> TagsViewAbilitySystem;
+
+protected:
+
+	TSharedPtr<SWidget> CreateAbilityTagWidget();
+
+	// 删除消失的标签、添加新出现的标签，已有标签的数量由显示中的控件自己更新
+	// Removes the tags that went away and adds the new ones; widgets on screen update the count of the others themselves
+	void SyncTagsView(SCharacterTagsView& InView, TMap<FGameplayTag, TSharedPtr<FGASCharacterTagsBase>>& InOutItems, TArray<TSharedPtr<FGASCharacterTagsBase>>& InOutFiltered,
+		const FGameplayTagContainer& InTags, FGameplayTagContainer& InOutOldTags, FName InWidgetName, FGameplayTagContainer* OutEditableTags);
+
+	void ResetTagsView();
+
+	TSharedRef<ITableRow> HandleGenerateTagTile(TSharedPtr<FGASCharacterTagsBase> InItem, const TSharedRef<STableViewBase>& OwnerTable);
+
+	bool PassesTagsFilter(const TSharedPtr<FGASCharacterTagsBase>& InItem) const;
+
+	// 输入变长时只在当前结果里继续筛选
+	// When the text only grows, filtering continues from the current results
+	void HandleTagsFilterTextChanged(const FText& InText);
+
+	void FilterTags(const TMap<FGameplayTag, TSharedPtr<FGASCharacterTagsBase>>& InItems, TArray<TSharedPtr<FGASCharacterTagsBase>>& InOutFiltered, bool bNarrow) const;
+
+	void HandleTagSelectionChanged(TSharedPtr<FGASCharacterTagsBase> InItem, ESelectInfo::Type SelectInfo, bool bBlocked);
+
+	// 选中标签的来源，来自倒排索引
+	// Sources of the selected tag, taken from the inverted index
+	FText GetSelectedTagSourcesText() const { return SelectedTagSourcesText; }
+
+	// bForce 为假时只在索引或者泄漏检测的时间桶变化时重建
+	// Without bForce it is only rebuilt when the index or the leak detector bucket changed
+	void UpdateSelectedTagSourcesText(bool bForce);
+
+	FText BuildSelectedTagSourcesText() const;
+
+protected:
+	void OnApplicationPreInputKeyDownListener(const FKeyEvent& InKeyEvent);
+
+#if WITH_EDITOR
+	// <tag控件的监听
+	// Monitoring of tag control
+	FReply OnMouseButtonUpTags(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent, FName TagsName);
+
+	// <Tag控件选择
+	// Tag control selection
+	void RefreshTagList(FName TagsName);
+#endif
+
+public:
+	// 筛选激活状态图表Tree
+	// Filter activation status chart tree
+	void HandleScreenModeStateChanged(ECheckBoxState NewValue, EScreenGAModeState InState);
+
+protected:
+	// 是否被选中
+	// Is it selected
+	ECheckBoxState HandleGetScreenButtonChecked(EScreenGAModeState InState) const;
+
+	// 创建选中框
+	// Create check box
+	TSharedPtr<SCheckBox> CreateScreenCheckBox(EScreenGAModeState InState);
+
+	// 设置筛选名称
+	// Set filter name
+	FText HandleGeScreenModeText(EScreenGAModeState InState) const;
+
+	// 创建Ability查看控件
+	// Create ability view control
+	TSharedPtr<SWidget> CreateAbilityToolWidget();
+
+protected:
+
+	// 创建Attributes查看控件
+	// Create attributes view control
+	TSharedPtr<SWidget> CreateAttributesToolWidget();
+
+
+protected:
+	// 创建GameplayEffects查看控件
+	// Create gameplay effects view
+	TSharedPtr<SWidget> CreateGameplayEffectToolWidget();
+
+	TSharedRef<ITableRow> OneGameplayEffecGenerateWidgetForFilterListView(TSharedRef< FGASGameplayEffectNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable);
+
+	void HandleGameplayEffectTreeGetChildren(TSharedRef<FGASGameplayEffectNodeBase> InReflectorNode, TArray<TSharedRef<FGASGameplayEffectNodeBase>>& OutChildren);
+
+	void HandleGameplayEffectTreeHiddenColumnsListChanged();
+
+	void HandleGameplayEffectTreeSelectionChanged(TSharedPtr<FGASGameplayEffectNodeBase>, ESelectInfo::Type /*SelectInfo*/);
+
+protected:
+	// 创建冻结帧快照查看控件
+	// Create freeze frame snapshot view
+	TSharedPtr<SWidget> CreateSnapshotToolWidget();
+
+	TSharedRef<ITableRow> HandleSnapshotWidgetForFilterListView(TSharedRef<FGASSnapshotNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable);
+
+	void HandleSnapshotTreeGetChildren(TSharedRef<FGASSnapshotNodeBase> InReflectorNode, TArray<TSharedRef<FGASSnapshotNodeBase>>& OutChildren);
+
+	// 可选择的冻结帧
+	// Freeze frames to pick from
+	TSharedRef<SWidget> OnGetFreezeFrameMenu();
+
+	FText GetFreezeFrameText() const;
+
+	void HandleSelectFreezeFrame(TSharedRef<const FGASFreezeFrame> InFreezeFrame);
+
+	// 选择对比的冻结帧，为空时只显示当前快照
+	// Picks the freeze frame to compare with; none shows the selected snapshot only
+	TSharedRef<SWidget> OnGetCompareFreezeFrameMenu();
+
+	FText GetCompareFreezeFrameText() const;
+
+	void HandleSelectCompareFreezeFrame(TSharedPtr<const FGASFreezeFrame> InFreezeFrame);
+
+	// 显示选中的快照，或者它与对比快照的差异
+	// Shows the selected snapshot, or its differences from the compared one
+	void RefreshSnapshotTree();
+
+	// 后台整理完成后调用
+	// Called once the background tree build is done
+	void HandleFreezeFrameReady(const TSharedRef<const FGASFreezeFrame>& InFreezeFrame);
+
+	FReply OnTakeFreezeFrameClicked();
+
+protected:
+	// 创建标签抖动热力图
+	// Create the tag churn heatmap
+	TSharedPtr<SWidget> CreateTagChurnToolWidget();
+
+	TSharedRef<ITableRow> HandleTagChurnWidgetForFilterListView(TSharedPtr<FGASTagChurnNode> InItem, const TSharedRef<STableViewBase>& OwnerTable);
+
+	// 绑定到选中世界的统计，只统计选中ASC时同步焦点
+	// Binds to the tracker of the selected world and keeps its focus on the selected ASC when only that ASC is counted
+	void BindTagChurnTracker();
+
+	// 每过一秒游戏时间从统计表重建
+	// Rebuilt from the counters every game second
+	void RefreshTagChurnList();
+
+	void HandleTagChurnScopeChanged(ECheckBoxState NewValue);
+
+	FText GetTagChurnSummaryText() const;
+
+protected:
+	// 创建技能关系矩阵
+	// Create the ability relation matrix
+	TSharedPtr<SWidget> CreateAbilityMatrixToolWidget();
+
+	// 授予的技能没有变化时不重新计算
+	// Not recomputed while the granted abilities stay the same
+	void RefreshAbilityMatrix();
+
+	FText GetAbilityMatrixSummaryText() const;
+
+	// 导出菜单: 当前分类或世界里所有ASC
+	// Export menu: the current category or every ASC of the world
+	TSharedRef<SWidget> OnGetExportMenu();
+
+	// 按面板当前显示的内容导出，隐藏的列不导出
+	// Exports what the panel currently shows, hidden columns are left out
+	void ExportCategory(bool bCsv);
+
+	// 导出选中世界里所有ASC
+	// Exports every ASC of the selected world
+	void ExportWorld(bool bCsv);
+
+	FString MakeExportFilename(const FString& InName, bool bCsv);
+
+	// 关闭导出文件并把路径复制到剪贴板
+	// Closes the export and copies its path to the clipboard
+	void FinishExport(FGASExportWriter& Writer);
+
+private:
+
+	uint8 ScreenModeState;
+
+private:
+	TSharedPtr<SAbilitieTree> AbilitieReflectorTree;
+
+	TArray<FString> HiddenReflectorTreeColumns;
+
+	TArray<TSharedRef<FGASAbilitieNodeBase>> SelectedNodes;
+
+	TArray<TSharedRef<FGASAbilitieNodeBase>> AbilitieFilteredTreeRoot;
+
+	TWeakObjectPtr<UAbilitySystemComponent> SelectAbilitySystemComponent;
+
+	FName SelectAbilitySystemComponentForActorName;
+
+	bool bPickingTick;
+
+	// 采样的世界，在Slate Tick里更新
+	// World being sampled, refreshed in the Slate tick
+	TWeakObjectPtr<UWorld> SampleWorld;
+
+	FDelegateHandle WorldPostActorTickHandle;
+
+	uint64 SampleFrame;
+
+	double SampleWorldTime;
+
+private:
+
+	TSharedPtr<SAttributesTree> AttributesReflectorTree;
+
+	TArray<TSharedRef<FGASAttributesNodeBase>> AttributesFilteredTreeRoot;
+
+#if WITH_EDITOR
+	TArray<SGameplayTagWidget::FEditableGameplayTagContainerDatum> EditableOwnerContainers;
+	FGameplayTagContainer OwnweTagContainer;
+	FGameplayTagContainer OldOwnweTagContainer;
+
+	TArray<SGameplayTagWidget::FEditableGameplayTagContainerDatum> EditableBlockedContainers;
+	FGameplayTagContainer BlockedTagContainer;
+	FGameplayTagContainer OldBlockedTagContainer;
+
+#endif
+
+private:
+	TSharedPtr<SGameplayEffectTree> GameplayEffectTree;
+
+	TArray<TSharedRef<FGASGameplayEffectNodeBase>> GameplayEffectTreeRoot;
+
+	TArray<FString> HiddenGameplayEffectTreeColumns;
+
+private:
+	TSharedPtr<SSnapshotTree> SnapshotTree;
+
+	TArray<TSharedRef<FGASSnapshotNodeBase>> SnapshotTreeRoot;
+
+	TSharedPtr<const FGASFreezeFrame> SelectedFreezeFrame;
+
+	TSharedPtr<const FGASFreezeFrame> CompareFreezeFrame;
+
+	FDelegateHandle FreezeFrameReadyHandle;
+
+private:
+	TSharedPtr<SListView<TSharedPtr<FGASTagChurnNode>>> TagChurnList;
+
+	TArray<TSharedPtr<FGASTagChurnNode>> TagChurnRows;
+
+	TWeakPtr<FGASTagChurnTracker> TagChurnTracker;
+
+	FDelegateHandle TagChurnSecondHandle;
+
+	// 只统计选中的ASC，否则统计整个世界
+	// Count the selected ASC only instead of the whole world
+	bool bTagChurnSelectedOnly;
+
+private:
+	TSharedPtr<SGASAbilityMatrixGrid> AbilityMatrixGrid;
+
+	TSharedPtr<FGASAbilityMatrix> AbilityMatrix;
+};
+
+TSharedRef<SGASAttachEditor> SGASAttachEditor::New()
+{
+	return MakeShareable(new SGASAttachEditorImpl());
+}
+
+FName SGASAttachEditor::GetTabName()
+{
+	return "GAAttachEditorApp";
+}
+
+void SGASAttachEditor::RegisterTabSpawner(FTabManager& TabManager)
+{
+	const auto SpawnCallStackViewTab = [](const FSpawnTabArgs& Args)
+	{
+		return SNew(SDockTab)
+			.TabRole(ETabRole::PanelTab)
+			//.Label(LOCTEXT("TabTitle", "游戏中GAS查看器"))
+			.Label(LOCTEXT("TabTitle", "Runtime Debug"))
+			[
+				SNew(SBorder)
+#if WITH_EDITOR
+				.BorderImage(FAppStyle::GetBrush("Docking.Tab.ContentAreaBrush"))
+#endif
+				.BorderBackgroundColor(FSlateColor(FLinearColor(0.2f,0.2f,0.2f,1.f)))
+				[
+					SNew(SGASAttachEditor)
+				]
+			];
+	};
+
+	TabManager.RegisterTabSpawner(SGASAttachEditor::GetTabName(), FOnSpawnTab::CreateStatic(SpawnCallStackViewTab))
+		//.SetDisplayName(LOCTEXT("TabTitle", "游戏中GAS查看器"));
+		.SetDisplayName(LOCTEXT("TabTitle", "Runtime Debug"));
+}
+
+void SGASAttachEditorImpl::Construct(const FArguments& InArgs)
+{
+	bGASTreeExpand = false;
+	bPickingTick = false;
+	SampleFrame = 0;
+	SampleWorldTime = -1.0;
+	SelectAbilitySystemComponentForActorName = FName();
+	SelectAbilitieCategories = Ability;
+
+	bSelectedTagBlocked = false;
+	SelectedTagSourcesSerial = 0;
+	SelectedTagSourcesHolders = INDEX_NONE;
+	SelectedTagSourcesBucket = INDEX_NONE;
+	SelectedTagSourcesText = BuildSelectedTagSourcesText();
+	bTagChurnSelectedOnly = false;
+
+	ScreenModeState = EScreenGAModeState::Active | EScreenGAModeState::Blocked | EScreenGAModeState::NoActive;
+
+	SortMode = EColumnSortMode::Ascending;
+
+	LoadSettings();
+
+
+	ChildSlot
+		[
+			SNew(SVerticalBox)
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			//.HAlign(HAlign_Left)
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.HAlign(HAlign_Left)
+					//.Text(LOCTEXT("Refresh", "刷新查看"))
+					.Text(LOCTEXT("Refresh", "Update"))
+					.OnClicked(this, &SGASAttachEditorImpl::UpdateGameplayCueListItemsButtom)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4.f, 0.f)
+				[
+					SNew(SComboButton)
+					.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetExportMenu)
+					.VAlign(VAlign_Center)
+					.ContentPadding(2)
+					.ButtonContent()
+					[
+						SNew(STextBlock)
+						//.ToolTipText(LOCTEXT("ExportToolTip", "导出到 Saved/GASAttachEditor/Exports，路径会复制到剪贴板"))
+						.ToolTipText(LOCTEXT("ExportToolTip", "Export to Saved/GASAttachEditor/Exports; the path is copied to the clipboard"))
+						.Text(LOCTEXT("Export", "Export"))
+					]
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(8.f, 0.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					//.ToolTipText(LOCTEXT("PluginCostToolTip", "调试器自身在游戏线程上每帧的耗时"))
+					.ToolTipText(LOCTEXT("PluginCostToolTip", "Game thread time spent by the debugger itself last frame. Use 'stat GASAttachEditor' for details"))
+					.Text(this, &SGASAttachEditorImpl::HandleGetPluginCostText)
+					.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(8.f, 0.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					//.ToolTipText(LOCTEXT("SampleFrameToolTip", "最近一次持续更新采样时的帧号与游戏时间"))
+					.ToolTipText(LOCTEXT("SampleFrameToolTip", "Frame number and game time of the last continuous update sample. The interval is set by GASAttachEditor.SampleInterval"))
+					.Text(this, &SGASAttachEditorImpl::HandleGetSampleText)
+					.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				]
+				
+				+ SHorizontalBox::Slot() 
+				.FillWidth(1.f)
+				.HAlign(HAlign_Right)
+				[
+					SNew(SComboButton)
+					.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetShowWorldTypeMenu)
+					.VAlign(VAlign_Center)
+					.ContentPadding(2)
+					.ButtonContent()
+					[
+						SNew(STextBlock)
+						//.ToolTipText(LOCTEXT("ShowWorldTypeType", "选择需要查看场景"))
+						.ToolTipText(LOCTEXT("ShowWorldTypeType", "Select World Scene"))
+						.Text_Lambda([this]{return SelectWorldSceneText;})
+					]
+				]
+
+			]
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.Padding(2.0f)
+				.AutoWidth()
+				[
+					SNew(SCheckBox)
+					.Padding(FMargin(4, 0))
+					.IsChecked(this, &SGASAttachEditorImpl::HandleGetPickingButtonChecked)
+					.OnCheckStateChanged(this, &SGASAttachEditorImpl::HandlePickingModeStateChanged)
+					[
+						SNew(SBox)
+						.MinDesiredWidth(125)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+							.Text(this, &SGASAttachEditorImpl::HandleGetPickingModeText)
+						]
+
+					]
+				]
+				+ SHorizontalBox::Slot()
+				.Padding(2.f, 2.f)
+				.AutoWidth()
+				[
+					SNew(SComboButton)
+					.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetShowOverrideTypeMenu)
+					.VAlign( VAlign_Center )
+					.ContentPadding(2)
+					.ButtonContent()
+					[
+						SNew( STextBlock )
+						//.ToolTipText(LOCTEXT("ShowOverrideType", "选择需要查看的角色的GA"))
+						.ToolTipText(LOCTEXT("ShowOverrideType", "Select Player GA"))
+						.Text(this, &SGASAttachEditorImpl::GetOverrideTypeDropDownText )
+					]
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.FillHeight(1.f)
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot()
+				.Padding(2.f, 2.f)
+				.AutoHeight()
+				.HAlign(HAlign_Left)
+				[
+					SNew(SComboButton)
+					.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetShowDebugAbilitieCategories)
+					.VAlign(VAlign_Center)
+					.ContentPadding(2)
+					.ButtonContent()
+					[
+						SNew(STextBlock)
+						//.ToolTipText(LOCTEXT("ShowCharactAbilitieType", "选择需要查看角色身上的效果类型"))
+						.ToolTipText(LOCTEXT("ShowCharactAbilitieType", "Select Player Look Up Type"))
+						.Text(this, &SGASAttachEditorImpl::GetShowDebugAbilitieCategoriesDropDownText)
+					]
+				]
+
+				+ SVerticalBox::Slot()
+				.FillHeight(1.f)
+				[
+					//CreateAbilityToolWidget()
+					SAssignNew(CategoriesToolSlot, SOverlay)
+				]
+				
+			]
+
+		];
+
+	HandleShowDebugAbilitieCategories(Ability);
+
+	UpdateGameplayCueListItemsButtom();
+	InputPtr = MakeShareable(new FAttachInputProcessor(this));
+	FSlateApplication::Get().RegisterInputPreProcessor(InputPtr);
+
+	FreezeFrameReadyHandle = FGASFreezeFrames::OnReady.AddSP(this, &SGASAttachEditorImpl::HandleFreezeFrameReady);
+
+	WorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddSP(this, &SGASAttachEditorImpl::HandleWorldPostActorTick);
+
+#if WITH_EDITOR
+	//TagKeyDownHandle = FSlateApplication::Get().OnApplicationPreInputKeyDownListener().AddRaw(this, &SGASAttachEditorImpl::OnApplicationPreInputKeyDownListener);
+
+	EditableOwnerContainers.Empty();
+	EditableBlockedContainers.Empty();
+
+	EditableOwnerContainers.Add(SGameplayTagWidget::FEditableGameplayTagContainerDatum(nullptr,&OwnweTagContainer));
+	EditableBlockedContainers.Add(SGameplayTagWidget::FEditableGameplayTagContainerDatum(nullptr,&BlockedTagContainer));
+#endif
+}
+
+
+void SGASAttachEditorImpl::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	// 采样在世界Tick里进行，这里只记录要查看哪个世界
+	// Sampling happens in the world tick; only remember which world is inspected here
+	if (bPickingTick)
+	{
+		SampleWorld = GetWorld();
+	}
+}
+
+void SGASAttachEditorImpl::HandleWorldPostActorTick(UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds)
+{
+	if (!bPickingTick || InWorld != SampleWorld.Get())
+	{
+		return;
+	}
+
+	// 按游戏时间间隔采样，暂停或者时间膨胀时随世界一起变化
+	// Sample on a game time interval so pausing and time dilation follow the world
+	const double WorldTime = InWorld->GetTimeSeconds();
+	const float SampleInterval = CVarGASAttachEditorSampleInterval.GetValueOnGameThread();
+	if (SampleInterval > 0.f && WorldTime >= SampleWorldTime && WorldTime - SampleWorldTime < SampleInterval)
+	{
+		return;
+	}
+
+	SampleFrame = GFrameCounter;
+	SampleWorldTime = WorldTime;
+
+	UpdateGameplayCueListItems();
+}
+
+
+SGASAttachEditorImpl::~SGASAttachEditorImpl()
+{
+	FSlateApplication::Get().UnregisterInputPreProcessor(InputPtr);
+	InputPtr = nullptr;
+
+	FGASFreezeFrames::OnReady.Remove(FreezeFrameReadyHandle);
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickHandle);
+
+	if (TSharedPtr<FGASTagChurnTracker> Tracker = TagChurnTracker.Pin())
+	{
+		Tracker->OnSecond.Remove(TagChurnSecondHandle);
+	}
+}
+
+TSharedRef<SWidget> SGASAttachEditorImpl::OnGetShowWorldTypeMenu()
+{
+	FMenuBuilder MenuBuilder( true, NULL );
+
+	const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
+
+	for (auto& Item : WorldList)
+	{
+		if (Item.WorldType == EWorldType::Type::PIE || Item.WorldType == EWorldType::Type::Game)
+		{
+			FUIAction NoAction( FExecuteAction::CreateSP( this, &SGASAttachEditorImpl::HandleShowWorldTypeChange, Item ) );
+
+			FText ShowName;
+			if (Item.RunAsDedicated)
+			{
+				//ShowName = LOCTEXT("Dedicated","专用服务器");
+				ShowName = LOCTEXT("Dedicated","Dedicated");
+			}
+			else
+			{
+				if (Item.WorldType == EWorldType::Type::Game)
+				{
+					ShowName = LOCTEXT("Client",/*"客户端"*/"Client");
+				}
+				else
+				{
+					ShowName = FText::Format(FText::FromString("{0}  [{1}]"), LOCTEXT("Client",/*"客户端"*/"Client"), FText::AsNumber(Item.PIEInstance));
+				}
+				
+			}
+
+			MenuBuilder.AddMenuEntry(ShowName, FText(), FSlateIcon(), NoAction);
+		}
+	}
+
+	return MenuBuilder.MakeWidget();
+}
+
+
+void SGASAttachEditorImpl::HandleShowWorldTypeChange(FWorldContext InWorldContext)
+{
+	SelectWorldSceneConetextHandle = InWorldContext.ContextHandle;
+
+
+	if (InWorldContext.RunAsDedicated)
+	{
+		SelectWorldSceneText = LOCTEXT("Dedicated", "专用服务器");
+	}
+	else
+	{
+		if (InWorldContext.WorldType == EWorldType::Type::Game)
+		{
+			SelectWorldSceneText = LOCTEXT("Client",/*"客户端"*/"Client");
+		}
+		else
+		{
+			SelectWorldSceneText = FText::Format(FText::FromString("{0}  [{1}]"), LOCTEXT("Client",/*"客户端"*/"Client"), FText::AsNumber(InWorldContext.PIEInstance));
+		}
+	}
+
+	UpdateGameplayCueListItemsButtom();
+}
+
+FText SGASAttachEditorImpl::GenerateToolTipForText(TSharedRef<FGASAbilitieNodeBase> InReflectorNode) const
+{
+	return InReflectorNode->GetAbilitieHasTag();
+}
+
+TSharedRef<ITableRow> SGASAttachEditorImpl::OnGenerateWidgetForFilterListView(TSharedRef< FGASAbilitieNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SGASAbilitieTreeItem, OwnerTable)
+		.WidgetInfoToVisualize(InItem)
+		.ToolTip(GenerateToolTipForReflectorNode(InItem));
+}
+
+
+void SGASAttachEditorImpl::HandleReflectorTreeGetChildren(TSharedRef<FGASAbilitieNodeBase> InReflectorNode, TArray<TSharedRef<FGASAbilitieNodeBase>>& OutChildren)
+{
+	OutChildren = InReflectorNode->GetChildNodes();
+}
+
+void SGASAttachEditorImpl::HandleReflectorTreeSelectionChanged(TSharedPtr<FGASAbilitieNodeBase>, ESelectInfo::Type /*SelectInfo*/)
+{
+	SelectedNodes = AbilitieReflectorTree->GetSelectedItems();
+
+}
+
+TSharedPtr<IToolTip> SGASAttachEditorImpl::GenerateToolTipForReflectorNode(TSharedRef<FGASAbilitieNodeBase> InReflectorNode)
+{
+	return SNew(SToolTip)
+			.Text(this, &SGASAttachEditorImpl::GenerateToolTipForText, InReflectorNode);
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::HandleReflectorTreeContextMenuPtr()
+{
+	const bool bShouldCloseWindowAfterMenuSelection = true;
+	FMenuBuilder MenuBuilder(bShouldCloseWindowAfterMenuSelection, nullptr);
+
+	MenuBuilder.AddMenuEntry(
+		LOCTEXT("NotFunction", "NotFunction"),
+		LOCTEXT("NotFunctionTooltip", "Null"),
+		FSlateIcon(),
+		FUIAction()
+	);
+
+	return MenuBuilder.MakeWidget();
+}
+
+void SGASAttachEditorImpl::HandleReflectorTreeHiddenColumnsListChanged()
+{
+#if WITH_EDITOR
+	if (AbilitieReflectorTree && AbilitieReflectorTree->GetHeaderRow())
+	{
+		const TArray<FName> HiddenColumnIds = AbilitieReflectorTree->GetHeaderRow()->GetHiddenColumnIds();
+		HiddenReflectorTreeColumns.Reset(HiddenColumnIds.Num());
+		for (const FName Id : HiddenColumnIds)
+		{
+			HiddenReflectorTreeColumns.Add(Id.ToString());
+		}
+		SaveSettings();
+	}
+#endif
+}
+
+EColumnSortMode::Type SGASAttachEditorImpl::GetColumnSortMode(const FName ColumnId) const
+{
+	if (NAME_AbilitietName != ColumnId) return EColumnSortMode::None;
+
+	return SortMode;
+}
+
+void SGASAttachEditorImpl::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode)
+{
+	SortMode = InSortMode;
+	RequestSort();
+}
+
+void SGASAttachEditorImpl::RequestSort()
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_RequestSort);
+
+	if (SortMode == EColumnSortMode::Ascending)
+	{
+		AbilitieFilteredTreeRoot.Sort([](TSharedRef<FGASAbilitieNodeBase> A, TSharedRef<FGASAbilitieNodeBase> B)
+		{
+			return A->GetGAName().ToString() < B->GetGAName().ToString();
+		});
+	}
+	else if (SortMode == EColumnSortMode::Descending)
+	{
+		AbilitieFilteredTreeRoot.Sort([](TSharedRef<FGASAbilitieNodeBase> A, TSharedRef<FGASAbilitieNodeBase> B)
+		{
+			return A->GetGAName().ToString() >= B->GetGAName().ToString();
+		});
+	}
+
+	AbilitieReflectorTree->RequestTreeRefresh();
+}
+
+TSharedRef<ITableRow> SGASAttachEditorImpl::HandleAttributesWidgetForFilterListView(TSharedRef< FGASAttributesNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SGASAttributesTreeItem, OwnerTable)
+		.WidgetInfoToVisualize(InItem);
+}
+
+void SGASAttachEditorImpl::HandleAttributesTreeGetChildren(TSharedRef<FGASAttributesNodeBase> InReflectorNode, TArray<TSharedRef<FGASAttributesNodeBase>>& OutChildren)
+{
+}
+
+FText GetLocalRoleText(ENetRole InRole)
+{
+	FText RoleText;
+	switch (InRole)
+	{
+	case ROLE_Authority:
+		// RoleText = LOCTEXT("Authority", "权威");
+		RoleText = LOCTEXT("Authority", "Authority");
+		break;
+	case ROLE_AutonomousProxy:
+		// RoleText = LOCTEXT("AutonomousProxy", "本地");
+		RoleText = LOCTEXT("AutonomousProxy", "AutonomousProxy");
+		break;
+	case ROLE_SimulatedProxy:
+		// RoleText = LOCTEXT("SimulatedProxy", "模拟");
+		RoleText = LOCTEXT("SimulatedProxy", "SimulatedProxy");
+		break;
+	}
+
+	return RoleText;
+}
+
+FText GetOverrideTypeDropDownText_Explicit(const TWeakObjectPtr<UAbilitySystemComponent>& InComp)
+{
+	if (!InComp.IsValid())
+	{
+		return FText();
+	}
+
+	AActor* LocalAvatarActor = InComp->GetAvatarActor_Direct();
+	AActor* LocalOwnerActor = InComp->GetOwnerActor();
+	APawn* AvatarAsPawn = LocalAvatarActor ? Cast<APawn>(LocalAvatarActor) : nullptr;
+	APawn* OwnerAsPawn = LocalOwnerActor ? Cast<APawn>(LocalOwnerActor) : nullptr;
+
+	FText OutName = FText::FromString(LocalAvatarActor == nullptr ? LocalOwnerActor->GetName() : LocalAvatarActor->GetName());
+	bool IsPlayer = (IsValid(AvatarAsPawn) ? AvatarAsPawn->IsPlayerControlled() : false) || (IsValid(OwnerAsPawn) ? OwnerAsPawn->IsPlayerControlled() : false);
+	bool IsSelected =  (LocalAvatarActor ? LocalAvatarActor->IsSelected() : false) || (LocalOwnerActor ? LocalOwnerActor->IsSelected() : false);
+
+	if (LocalOwnerActor)
+	{
+		OutName = FText::Format(FText::FromString(TEXT("{0} [{2}] [{1}]{3}{4}")), OutName, GetLocalRoleText(LocalAvatarActor == nullptr ? LocalOwnerActor->GetLocalRole() : LocalAvatarActor->GetLocalRole()), FText::FromString(LocalOwnerActor->GetName()), FText::FromString(IsPlayer ? " (Player)" : ""), FText::FromString(IsSelected ? " (Selected)" : ""));
+	}
+
+	return OutName;
+}
+
+TSharedRef<SWidget> SGASAttachEditorImpl::OnGetShowOverrideTypeMenu()
+{
+	FMenuBuilder MenuBuilder( true, NULL );
+
+	for (TWeakObjectPtr<UAbilitySystemComponent>& Comp :PlayerComp)
+	{
+		FUIAction NoAction( FExecuteAction::CreateSP( this, &SGASAttachEditorImpl::HandleOverrideTypeChange, Comp ) );
+		MenuBuilder.AddMenuEntry(GetOverrideTypeDropDownText_Explicit(Comp),FText(),FSlateIcon(),NoAction);
+	}
+	return MenuBuilder.MakeWidget();
+}
+
+FText SGASAttachEditorImpl::GetOverrideTypeDropDownText() const
+{
+	if (SelectAbilitySystemComponent.IsValid())
+	{
+		if (AActor* LocalGASActor = GetGASActor(SelectAbilitySystemComponent))
+		{
+			return FText::Format(FText::FromString(TEXT("{0}[{1}]")), FText::FromString(LocalGASActor->GetName()), GetLocalRoleText(LocalGASActor->GetLocalRole()));
+		}
+	}
+
+	return FText();
+}
+
+void SGASAttachEditorImpl::HandleOverrideTypeChange(TWeakObjectPtr<UAbilitySystemComponent> InComp)
+{
+	if (!InComp.IsValid())
+	{
+		return;
+	}
+
+	SelectAbilitySystemComponent = InComp;
+	
+	UpdateGameplayCueListItems();
+}
+
+ECheckBoxState SGASAttachEditorImpl::HandleGetPickingButtonChecked() const
+{
+	return bPickingTick ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SGASAttachEditorImpl::HandlePickingModeStateChanged(ECheckBoxState NewValue)
+{
+	SetPickingMode(!bPickingTick);
+}
+
+void SGASAttachEditorImpl::SetPickingMode(bool bTick)
+{
+	if (bTick && !bPickingTick)
+	{
+		SampleWorld = GetWorld();
+		SampleWorldTime = -1.0;
+	}
+
+/*
+#if WITH_SLATE_DEBUGGING
+	static auto CVarSlateGlobalInvalidation = IConsoleManager::Get().FindConsoleVariable(TEXT("Slate.EnableGlobalInvalidation"));
+#endif*/
+
+	bPickingTick = bTick;
+}
+
+FText SGASAttachEditorImpl::HandleGetPickingModeText() const
+{
+	//return bPickingTick ? LOCTEXT("bPickingTickYes", "按 END 键停止刷新") : LOCTEXT("bPickingTickNo", "持续更新") ;
+	return bPickingTick ? LOCTEXT("bPickingTickYes", "Press 'END' to interrupt") : LOCTEXT("bPickingTickNo", "Continuous Update") ;
+}
+
+FText SGASAttachEditorImpl::HandleGetSampleText() const
+{
+	if (SampleWorldTime < 0.0)
+	{
+		return FText::GetEmpty();
+	}
+
+	FNumberFormattingOptions NumberFormatOptions;
+	NumberFormatOptions.MinimumFractionalDigits = 2;
+	NumberFormatOptions.MaximumFractionalDigits = 2;
+
+	return FText::Format(LOCTEXT("SampleFrame", "Frame {0} @ {1}s"), FText::AsNumber(SampleFrame, &FNumberFormattingOptions::DefaultNoGrouping()), FText::AsNumber(SampleWorldTime, &NumberFormatOptions));
+}
+
+FText SGASAttachEditorImpl::HandleGetPluginCostText() const
+{
+	FNumberFormattingOptions NumberFormatOptions;
+	NumberFormatOptions.MinimumFractionalDigits = 2;
+	NumberFormatOptions.MaximumFractionalDigits = 2;
+	return FText::Format(LOCTEXT("PluginCost", "Debugger: {0} ms"), FText::AsNumber(FGASAttachEditorFrameCost::GetLastFrameMs(), &NumberFormatOptions));
+}
+
+FReply SGASAttachEditorImpl::OnExpandAllClicked()
+{
+	SetGASTreeItemExpansion(true);
+	return FReply::Handled();
+}
+
+FReply SGASAttachEditorImpl::OnCollapseAllClicked()
+{
+	SetGASTreeItemExpansion(false);
+	return FReply::Handled();
+}
+
+void SGASAttachEditorImpl::SetGASTreeItemExpansion(bool bExpand)
+{
+	bGASTreeExpand = bExpand;
+	if (SelectAbilitieCategories == EDebugAbilitieCategories::Ability && AbilitieReflectorTree.IsValid())
+	{
+		for (TSharedRef<FGASAbilitieNodeBase> Item : AbilitieFilteredTreeRoot)
+		{
+			AbilitieReflectorTree->SetItemExpansion(Item, bExpand);
+		}
+	}
+	else if (SelectAbilitieCategories == EDebugAbilitieCategories::GameplayEffects && GameplayEffectTree.IsValid())
+	{
+		for (TSharedRef<FGASGameplayEffectNodeBase> Item : GameplayEffectTreeRoot)
+		{
+			GameplayEffectTree->SetItemExpansion(Item, bExpand);
+		}
+	}
+	else if (SelectAbilitieCategories == EDebugAbilitieCategories::Snapshot && SnapshotTree.IsValid())
+	{
+		for (TSharedRef<FGASSnapshotNodeBase> Item : SnapshotTreeRoot)
+		{
+			SnapshotTree->SetItemExpansion(Item, bExpand);
+		}
+	}
+}
+
+void SGASAttachEditorImpl::SaveSettings()
+{
+	GConfig->SetArray(TEXT("GASAttachEditor"), TEXT("HiddenReflectorTreeColumns"), HiddenReflectorTreeColumns, *GEditorPerProjectIni);
+	GConfig->SetArray(TEXT("GASAttachEditor"), TEXT("HiddenGameplayEffectTreeColumns"), HiddenGameplayEffectTreeColumns, *GEditorPerProjectIni);
+}
+
+void SGASAttachEditorImpl::LoadSettings()
+{
+	GConfig->GetArray(TEXT("GASAttachEditor"), TEXT("HiddenReflectorTreeColumns"), HiddenReflectorTreeColumns, *GEditorPerProjectIni);
+	GConfig->GetArray(TEXT("GASAttachEditor"), TEXT("HiddenGameplayEffectTreeColumns"), HiddenGameplayEffectTreeColumns, *GEditorPerProjectIni);
+}
+
+void SGASAttachEditorImpl::UpdateGameplayCueListItems()
+{
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_UpdateListItems);
+
+	FASCDebugTargetInfo* TargetInfo = GetASCDebugTargetInfo(GetWorld());
+
+	if (UAbilitySystemComponent* ASC = GetDebugTarget(TargetInfo, SelectAbilitySystemComponent.Get(), SelectAbilitySystemComponentForActorName))
+	{
+		SelectAbilitySystemComponent = ASC;
+
+		// 标签组
+		// Tag group
+		if (SelectAbilitieCategories == EDebugAbilitieCategories::Tags && FilteredOwnedTagsView.IsValid())
+		{
+			GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_RebuildTagsView);
+
+			if (TagsViewAbilitySystem != SelectAbilitySystemComponent)
+			{
+				ResetTagsView();
+				TagsViewAbilitySystem = SelectAbilitySystemComponent;
+			}
+
+			FGameplayTagContainer OwnerTags;
+			SelectAbilitySystemComponent->GetOwnedGameplayTags(OwnerTags);
+
+			FGameplayTagContainer BlockTags;
+			ASC->GetBlockedAbilityTags(BlockTags);
+
+#if WITH_EDITOR
+			SyncTagsView(*FilteredOwnedTagsView, OwnedTagItems, FilteredOwnedTags, OwnerTags, OldOwnerTags, "ActivationOwnedTags", &OwnweTagContainer);
+			SyncTagsView(*FilteredBlockedTagsView, BlockedTagItems, FilteredBlockedTags, BlockTags, OldBlockedTags, "ActivationBlockedTags", &BlockedTagContainer);
+#else
+			SyncTagsView(*FilteredOwnedTagsView, OwnedTagItems, FilteredOwnedTags, OwnerTags, OldOwnerTags, "ActivationOwnedTags", nullptr);
+			SyncTagsView(*FilteredBlockedTagsView, BlockedTagItems, FilteredBlockedTags, BlockTags, OldBlockedTags, "ActivationBlockedTags", nullptr);
+#endif
+
+			UpdateSelectedTagSourcesText(false);
+		}
+
+		/*TArray<FName> LocalDisplayNames;
+		LocalDisplayNames.Add(TargetInfo->DebugCategories[TargetInfo->DebugCategoryIndex]);*/
+
+		// 技能组
+		// Ability group
+		if (SelectAbilitieCategories == EDebugAbilitieCategories::Ability && AbilitieReflectorTree.IsValid())
+		{
+			AbilitieFilteredTreeRoot.Reset();
+
+			// 拥有标签的位集每次刷新只建立一次，所有技能共用
+			// The owned tag bitsets are built once per refresh and shared by every ability
+			FGASAbilityBlockers Blockers(ASC);
+
+			for (FGameplayAbilitySpec& AbilitySpec : ASC->GetActivatableAbilities())
+			{
+				if (!AbilitySpec.Ability) continue;
+				TSharedRef<FGASAbilitieNode> NewItem = FGASAbilitieNode::Create(ASC, AbilitySpec, &Blockers);
+
+				NewItem->SetItemVisility(NewItem->ScreenGAMode & ScreenModeState);
+
+				AbilitieFilteredTreeRoot.Add(NewItem);
+
+				AbilitieReflectorTree->SetItemExpansion(AbilitieFilteredTreeRoot.Top(), bGASTreeExpand);
+			}
+
+			RequestSort();
+
+
+		}
+
+		// 属性组
+		// Attribute group
+		if (SelectAbilitieCategories == EDebugAbilitieCategories::Attributes &&  AttributesReflectorTree.IsValid())
+		{
+			AttributesFilteredTreeRoot.Reset();
+			for (UAttributeSet* Set : ASC->GetSpawnedAttributes())
+			{
+				if (!Set)
+				{
+					continue;
+				}
+
+				for (TFieldIterator<FStructProperty> It(Set->GetClass()); It; ++It)
+				{
+					if ((*It)->Struct == FGameplayAttributeData::StaticStruct())
+					{
+						FGameplayAttribute	Attribute(*It);
+						TSharedRef<FGASAttributesNode> NewItem = FGASAttributesNode::Create(ASC, Attribute);
+
+						AttributesFilteredTreeRoot.Add(NewItem);
+					}
+				}
+			}
+			AttributesReflectorTree->RequestTreeRefresh();
+
+		}
+
+		// 游戏效果组
+		// GameplayEffect group
+		if (SelectAbilitieCategories == EDebugAbilitieCategories::GameplayEffects && GameplayEffectTree.IsValid())
+		{
+			GameplayEffectTreeRoot.Reset();
+
+			FProperty* GameplayEffectsPtr = FindFProperty<FProperty>(ASC->GetClass(), "ActiveGameplayEffects");
+
+			if (!GameplayEffectsPtr) return;
+			FActiveGameplayEffectsContainer* ActiveGameplayEffectsPtr = GameplayEffectsPtr->ContainerPtrToValuePtr<FActiveGameplayEffectsContainer>(ASC);
+			if (!ActiveGameplayEffectsPtr) return;
+
+			for (FActiveGameplayEffect& ActiveGE : ActiveGameplayEffectsPtr)
+			{
+				GameplayEffectTreeRoot.Add(FGASGameplayEffectNode::Create(GetWorld(), ActiveGE));
+
+				GameplayEffectTree->SetItemExpansion(GameplayEffectTreeRoot.Top(), bGASTreeExpand);
+			}
+
+			GameplayEffectTree->RequestTreeRefresh();
+		}
+	}
+
+	// 标签抖动组，世界或者选中的ASC变了时重新绑定
+	// Tag churn group; rebinds when the world or the selected ASC changed
+	if (SelectAbilitieCategories == EDebugAbilitieCategories::TagChurn && TagChurnList.IsValid())
+	{
+		BindTagChurnTracker();
+	}
+
+	// 技能关系矩阵组
+	// Ability matrix group
+	if (SelectAbilitieCategories == EDebugAbilitieCategories::AbilityMatrix && AbilityMatrixGrid.IsValid())
+	{
+		RefreshAbilityMatrix();
+	}
+}
+
+FReply SGASAttachEditorImpl::UpdateGameplayCueListItemsButtom()
+{
+	UpDataPlayerComp(GetWorld());
+
+	UpdateGameplayCueListItems();
+
+	return FReply::Handled();
+}
+
+TSharedRef<SWidget> SGASAttachEditorImpl::OnGetShowDebugAbilitieCategories()
+{
+	FMenuBuilder MenuBuilder(true, NULL);
+
+	TArray<EDebugAbilitieCategories> Categories({ EDebugAbilitieCategories::Ability,EDebugAbilitieCategories::Attributes,EDebugAbilitieCategories::GameplayEffects, EDebugAbilitieCategories::Tags, EDebugAbilitieCategories::Snapshot, EDebugAbilitieCategories::TagChurn, EDebugAbilitieCategories::AbilityMatrix });
+
+	for (EDebugAbilitieCategories& Type : Categories)
+	{
+
+		FUIAction NoAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::HandleShowDebugAbilitieCategories, Type));
+		MenuBuilder.AddMenuEntry(FText::FromName(GetAbilitieCategoriesName(Type)), GetAbilitieCategoriesText(Type), FSlateIcon(), NoAction);
+	}
+
+
+	return MenuBuilder.MakeWidget();
+}
+
+FText SGASAttachEditorImpl::GetShowDebugAbilitieCategoriesDropDownText() const
+{
+	return FText::FromName(GetAbilitieCategoriesName(SelectAbilitieCategories));
+}
+
+void SGASAttachEditorImpl::HandleShowDebugAbilitieCategories(EDebugAbilitieCategories InType)
+{
+	SelectAbilitieCategories = InType;
+
+	CreateDebugAbilitieCategories(InType);
+}
+
+FORCEINLINE FName SGASAttachEditorImpl::GetAbilitieCategoriesName(EDebugAbilitieCategories InType) const
+{
+	FName TypeName;
+	switch (InType)
+	{
+	case EDebugAbilitieCategories::Tags:
+		TypeName = "Tags";
+		break;
+	case EDebugAbilitieCategories::Ability:
+		TypeName = "Ability";
+		break;
+	case EDebugAbilitieCategories::Attributes:
+		TypeName = "Attributes";
+		break;
+	case EDebugAbilitieCategories::GameplayEffects:
+		TypeName = "GameplayEffects";
+		break;
+	case EDebugAbilitieCategories::Snapshot:
+		TypeName = "Snapshot";
+		break;
+	case EDebugAbilitieCategories::TagChurn:
+		TypeName = "TagChurn";
+		break;
+	case EDebugAbilitieCategories::AbilityMatrix:
+		TypeName = "AbilityMatrix";
+		break;
+	}
+
+	return TypeName;
+}
+
+FORCEINLINE FText SGASAttachEditorImpl::GetAbilitieCategoriesText(EDebugAbilitieCategories InType) const
+{
+	FText TypeText;
+	switch (InType)
+	{
+	case EDebugAbilitieCategories::Tags:
+		//TypeText = LOCTEXT("Categories_Tigs", "标签");
+		TypeText = LOCTEXT("Categories_Tigs", "Tigs");
+		break;
+	case EDebugAbilitieCategories::Ability:
+		//TypeText = LOCTEXT("Categories_Ability", "技能");
+		TypeText = LOCTEXT("Categories_Ability", "Ability");
+		break;
+	case EDebugAbilitieCategories::Attributes:
+		//TypeText = LOCTEXT("Categories_Attributes", "属性");
+		TypeText = LOCTEXT("Categories_Attributes", "Attributes");
+		break;
+	case EDebugAbilitieCategories::GameplayEffects:
+		//TypeText = LOCTEXT("Categories_GameplayEffects", "效果");
+		TypeText = LOCTEXT("Categories_GameplayEffects", "GameplayEffects");
+		break;
+	case EDebugAbilitieCategories::Snapshot:
+		//TypeText = LOCTEXT("Categories_Snapshot", "冻结帧快照");
+		TypeText = LOCTEXT("Categories_Snapshot", "Freeze frame snapshots of every ASC in the world");
+		break;
+	case EDebugAbilitieCategories::TagChurn:
+		//TypeText = LOCTEXT("Categories_TagChurn", "标签每秒增删次数热力图");
+		TypeText = LOCTEXT("Categories_TagChurn", "Heatmap of tag adds/removes per second, flagging tag storms");
+		break;
+	case EDebugAbilitieCategories::AbilityMatrix:
+		//TypeText = LOCTEXT("Categories_AbilityMatrix", "技能之间的取消、阻止和依赖关系");
+		TypeText = LOCTEXT("Categories_AbilityMatrix", "Which granted ability cancels, blocks or is required by which");
+		break;
+	}
+
+	return TypeText;
+}
+
+void SGASAttachEditorImpl::CreateDebugAbilitieCategories(EDebugAbilitieCategories InType)
+{
+	if (!CategoriesToolSlot.IsValid())
+	{
+		return;
+	}
+
+	CategoriesToolSlot->ClearChildren();
+
+	TSharedPtr<SWidget> CategoriesWidget;
+
+	switch (InType)
+	{
+	case EDebugAbilitieCategories::Attributes:
+		CategoriesWidget = CreateAttributesToolWidget();
+		break;
+	case EDebugAbilitieCategories::GameplayEffects:
+		CategoriesWidget = CreateGameplayEffectToolWidget();
+		break;
+	case EDebugAbilitieCategories::Ability:
+		CategoriesWidget = CreateAbilityToolWidget();
+		break;
+	case EDebugAbilitieCategories::Tags:
+		CategoriesWidget = CreateAbilityTagWidget();
+		break;
+	case EDebugAbilitieCategories::Snapshot:
+		CategoriesWidget = CreateSnapshotToolWidget();
+		break;
+	case EDebugAbilitieCategories::TagChurn:
+		CategoriesWidget = CreateTagChurnToolWidget();
+		break;
+	case EDebugAbilitieCategories::AbilityMatrix:
+		CategoriesWidget = CreateAbilityMatrixToolWidget();
+		break;
+	}
+
+	if (!CategoriesWidget.IsValid())
+	{
+		return;
+	}
+	
+	CategoriesToolSlot->AddSlot()
+		[
+			CategoriesWidget.ToSharedRef()
+		];
+}
+
+UWorld* SGASAttachEditorImpl::GetWorld()
+{
+
+	UWorld* World = nullptr;
+
+	const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
+
+	TArray<FWorldContext> NewWorldList;
+
+	for (auto& Item : WorldList)
+	{
+		if (Item.WorldType == EWorldType::Type::PIE || Item.WorldType == EWorldType::Type::Game)
+		{
+			NewWorldList.Add(Item);
+			if (Item.ContextHandle == SelectWorldSceneConetextHandle)
+			{
+				return Item.World();
+			}
+		}
+	}
+
+	if (NewWorldList.Num())
+	{
+		SelectWorldSceneConetextHandle = NewWorldList[0].ContextHandle;
+
+		if (NewWorldList[0].RunAsDedicated)
+		{
+			//SelectWorldSceneText = LOCTEXT("Dedicated", "专用服务器");
+			SelectWorldSceneText = LOCTEXT("Dedicated", "Dedicated");
+		}
+		else
+		{
+			if (NewWorldList[0].WorldType == EWorldType::Type::Game)
+			{
+				SelectWorldSceneText = LOCTEXT("Client","Client");
+			}
+			else
+			{
+				SelectWorldSceneText = FText::Format(FText::FromString("{0}  [{1}]"), LOCTEXT("Client", "Client"), FText::AsNumber(NewWorldList[0].PIEInstance));
+			}
+			
+		}
+
+		return NewWorldList[0].World();
+	}
+
+	return nullptr;
+
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::CreateAbilityTagWidget()
+{
+	// 新的控件是空的，下次刷新时全部添加
+	// The new widgets start empty, every tag is added on the next refresh
+	ResetTagsView();
+
+	return SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(2.f)
+		[
+			SNew(SSearchBox)
+			//.HintText(LOCTEXT("TagsFilterHint", "筛选标签"))
+			.HintText(LOCTEXT("TagsFilterHint", "Filter tags"))
+			.InitialText(FText::FromString(TagsFilterText))
+			.OnTextChanged(this, &SGASAttachEditorImpl::HandleTagsFilterTextChanged)
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SSplitter)
+			.Orientation(Orient_Vertical)
+			+ SSplitter::Slot()
+			.Value(0.55f)
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.HAlign(HAlign_Left)
+				.Padding(2.f)
+				[
+					SNew(STextBlock)
+					//.Text(LOCTEXT("CharacterHasOwnTags", "当前角色拥有的Tags"))
+					.Text(LOCTEXT("CharacterHasOwnTags", "Player Owned Tags"))
+				]
+
+				+ SVerticalBox::Slot()
+				.FillHeight(1.f)
+				[
+					SNew(SBorder)
+					.Padding(2.f)
+#if WITH_EDITOR
+					.OnMouseButtonUp(this, &SGASAttachEditorImpl::OnMouseButtonUpTags, FName("OwnTags"))
+#endif
+					[
+						SAssignNew(FilteredOwnedTagsView, SCharacterTagsView)
+						.ListItemsSource(&FilteredOwnedTags)
+						.OnGenerateTile(this, &SGASAttachEditorImpl::HandleGenerateTagTile)
+						.OnSelectionChanged(this, &SGASAttachEditorImpl::HandleTagSelectionChanged, false)
+						.SelectionMode(ESelectionMode::Single)
+						.ItemWidth(260.f)
+						.ItemHeight(24.f)
+					]
+				]
+			]
+
+			+ SSplitter::Slot()
+			.Value(0.25f)
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.HAlign(HAlign_Left)
+				.Padding(2.f)
+				[
+					SNew(STextBlock)
+					//.Text(LOCTEXT("CharacterHasBlaTags", "当前角色阻止的Tags"))
+				.Text(LOCTEXT("CharacterHasBlaTags", "Player Back Tags"))
+				]
+
+				+ SVerticalBox::Slot()
+				.FillHeight(1.f)
+				[
+					SNew(SBorder)
+#if WITH_EDITOR
+					.OnMouseButtonUp(this, &SGASAttachEditorImpl::OnMouseButtonUpTags, FName("BlaTags"))
+#endif
+					.Padding(2.f)
+					[
+						SAssignNew(FilteredBlockedTagsView, SCharacterTagsView)
+						.ListItemsSource(&FilteredBlockedTags)
+						.OnGenerateTile(this, &SGASAttachEditorImpl::HandleGenerateTagTile)
+						.OnSelectionChanged(this, &SGASAttachEditorImpl::HandleTagSelectionChanged, true)
+						.SelectionMode(ESelectionMode::Single)
+						.ItemWidth(260.f)
+						.ItemHeight(24.f)
+					]
+				]
+			]
+
+			+ SSplitter::Slot()
+			.Value(0.2f)
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.HAlign(HAlign_Left)
+				.Padding(2.f)
+				[
+					SNew(STextBlock)
+					//.Text(LOCTEXT("TagSources", "标签来源"))
+					.Text(LOCTEXT("TagSources", "Tag Sources"))
+				]
+
+				+ SVerticalBox::Slot()
+				.FillHeight(1.f)
+				[
+					SNew(SBorder)
+					.Padding(4.f)
+					[
+						SNew(SScrollBox)
+						+ SScrollBox::Slot()
+						[
+							SNew(STextBlock)
+							.Text(this, &SGASAttachEditorImpl::GetSelectedTagSourcesText)
+						]
+					]
+				]
+			]
+		];
+}
+
+TSharedRef<ITableRow> SGASAttachEditorImpl::HandleGenerateTagTile(TSharedPtr<FGASCharacterTagsBase> InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<TSharedPtr<FGASCharacterTagsBase>>, OwnerTable)
+		[
+			SNew(SCharacterTagsViewItem)
+			.TagsItem(InItem)
+		];
+}
+
+namespace GASAttachEditorTags
+{
+	// 平铺视图按标签名排序
+	// Tile views are sorted by tag name
+	struct FItemNameLess
+	{
+		bool operator()(const TSharedPtr<FGASCharacterTagsBase>& A, const TSharedPtr<FGASCharacterTagsBase>& B) const
+		{
+			return A->GetGameplayTag().GetTagName().LexicalLess(B->GetGameplayTag().GetTagName());
+		}
+	};
+}
+
+void SGASAttachEditorImpl::SyncTagsView(SCharacterTagsView& InView, TMap<FGameplayTag, TSharedPtr<FGASCharacterTagsBase>>& InOutItems, TArray<TSharedPtr<FGASCharacterTagsBase>>& InOutFiltered,
+	const FGameplayTagContainer& InTags, FGameplayTagContainer& InOutOldTags, FName InWidgetName, FGameplayTagContainer* OutEditableTags)
+{
+	if (InTags == InOutOldTags)
+	{
+		return;
+	}
+
+	for (auto It = InOutItems.CreateIterator(); It; ++It)
+	{
+		if (!InTags.HasTagExact(It.Key()))
+		{
+			InOutFiltered.RemoveSingle(It.Value());
+			if (OutEditableTags)
+			{
+				OutEditableTags->RemoveTag(It.Key());
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FGameplayTag& InTag : InTags)
+	{
+		if (InOutItems.Contains(InTag))
+		{
+			continue;
+		}
+
+		TSharedPtr<FGASCharacterTagsBase> Item = FGASCharacterTags::Create(SelectAbilitySystemComponent, InTag, InWidgetName);
+		InOutItems.Add(InTag, Item);
+
+		if (PassesTagsFilter(Item))
+		{
+			InOutFiltered.Insert(Item, Algo::LowerBound(InOutFiltered, Item, GASAttachEditorTags::FItemNameLess()));
+		}
+
+		if (OutEditableTags)
+		{
+			OutEditableTags->AddTag(InTag);
+		}
+	}
+
+	InOutOldTags = InTags;
+	InView.RequestListRefresh();
+}
+
+void SGASAttachEditorImpl::ResetTagsView()
+{
+	SelectedTagItem.Reset();
+	UpdateSelectedTagSourcesText(true);
+	OwnedTagItems.Reset();
+	BlockedTagItems.Reset();
+	FilteredOwnedTags.Reset();
+	FilteredBlockedTags.Reset();
+	OldOwnerTags.Reset();
+	OldBlockedTags.Reset();
+
+	if (FilteredOwnedTagsView.IsValid())
+	{
+		FilteredOwnedTagsView->RequestListRefresh();
+	}
+
+	if (FilteredBlockedTagsView.IsValid())
+	{
+		FilteredBlockedTagsView->RequestListRefresh();
+	}
+
+#if WITH_EDITOR
+	OwnweTagContainer.Reset();
+	BlockedTagContainer.Reset();
+#endif
+}
+
+bool SGASAttachEditorImpl::PassesTagsFilter(const TSharedPtr<FGASCharacterTagsBase>& InItem) const
+{
+	return TagsFilterText.IsEmpty() || InItem->GetGameplayTag().ToString().Contains(TagsFilterText);
+}
+
+void SGASAttachEditorImpl::HandleTagsFilterTextChanged(const FText& InText)
+{
+	const FString NewFilterText = InText.ToString().TrimStartAndEnd();
+	if (NewFilterText == TagsFilterText)
+	{
+		return;
+	}
+
+	const bool bNarrow = !TagsFilterText.IsEmpty() && NewFilterText.Contains(TagsFilterText);
+	TagsFilterText = NewFilterText;
+
+	FilterTags(OwnedTagItems, FilteredOwnedTags, bNarrow);
+	FilterTags(BlockedTagItems, FilteredBlockedTags, bNarrow);
+
+	if (FilteredOwnedTagsView.IsValid())
+	{
+		FilteredOwnedTagsView->RequestListRefresh();
+	}
+
+	if (FilteredBlockedTagsView.IsValid())
+	{
+		FilteredBlockedTagsView->RequestListRefresh();
+	}
+}
+
+void SGASAttachEditorImpl::HandleTagSelectionChanged(TSharedPtr<FGASCharacterTagsBase> InItem, ESelectInfo::Type SelectInfo, bool bBlocked)
+{
+	if (!InItem.IsValid())
+	{
+		return;
+	}
+
+	SelectedTagItem = InItem;
+	bSelectedTagBlocked = bBlocked;
+	UpdateSelectedTagSourcesText(true);
+
+	// 两个视图只保留一个选中
+	// Only one of the two views keeps a selection
+	TSharedPtr<SCharacterTagsView> OtherView = bBlocked ? FilteredOwnedTagsView : FilteredBlockedTagsView;
+	if (OtherView.IsValid())
+	{
+		OtherView->ClearSelection();
+	}
+}
+
+void SGASAttachEditorImpl::UpdateSelectedTagSourcesText(bool bForce)
+{
+	UAbilitySystemComponent* ASC = SelectAbilitySystemComponent.Get();
+	UWorld* World = ASC ? ASC->GetWorld() : nullptr;
+
+	TSharedPtr<FGASTagSourceIndex> SourceIndex = SelectedTagItem.IsValid() ? FGASTagSourceIndex::FindOrCreate(ASC) : nullptr;
+	TSharedPtr<FGASTagHolderIndex> HolderIndex = SelectedTagItem.IsValid() ? FGASTagHolderIndex::FindOrCreate(World) : nullptr;
+	TSharedPtr<FGASTagLeakDetector> LeakDetector = FGASTagLeakDetector::Find(World);
+
+	// 只看选中的ASC自己的序号，世界里其他ASC的标签变化不会让文字重建
+	// Only the selected ASC's own serial is compared, so tag changes on other ASCs of the world do not rebuild the text
+	const uint32 Serial = SourceIndex.IsValid() ? SourceIndex->GetSerial(ASC) : 0;
+	const int32 Holders = HolderIndex.IsValid() ? HolderIndex->GetNumHolders(SelectedTagItem->GetGameplayTag()) : INDEX_NONE;
+	const int32 Bucket = LeakDetector.IsValid() ? LeakDetector->GetCurrentBucket() : INDEX_NONE;
+	if (!bForce && Serial == SelectedTagSourcesSerial && Holders == SelectedTagSourcesHolders && Bucket == SelectedTagSourcesBucket)
+	{
+		return;
+	}
+
+	SelectedTagSourcesText = BuildSelectedTagSourcesText();
+
+	// 第一次描述时才建立这个ASC的索引，序号在描述之后读取
+	// The ASC's index is only built by the first description, so the serial is read afterwards
+	SelectedTagSourcesSerial = SourceIndex.IsValid() ? SourceIndex->GetSerial(ASC) : 0;
+	SelectedTagSourcesHolders = Holders;
+	SelectedTagSourcesBucket = Bucket;
+}
+
+FText SGASAttachEditorImpl::BuildSelectedTagSourcesText() const
+{
+	if (!SelectedTagItem.IsValid())
+	{
+		//return LOCTEXT("NoTagSelected", "选择一个标签查看它的来源");
+		return LOCTEXT("NoTagSelected", "Select a tag to see where it comes from");
+	}
+
+	const FGameplayTag Tag = SelectedTagItem->GetGameplayTag();
+	UAbilitySystemComponent* ASC = SelectAbilitySystemComponent.Get();
+	TSharedPtr<FGASTagSourceIndex> SourceIndex = FGASTagSourceIndex::FindOrCreate(ASC);
+	if (!SourceIndex.IsValid())
+	{
+		return FText::FromString(Tag.ToString());
+	}
+
+	FString Sources = SourceIndex->DescribeSources(ASC, Tag, bSelectedTagBlocked);
+	if (Sources.IsEmpty())
+	{
+		//Sources = TEXT("\n  没有技能或效果来源");
+		Sources = TEXT("\n  No ability or effect source");
+	}
+
+	// 世界里还有谁持有它，详细列表用 GASAttachEditor.WhoHasTag
+	// Who else in the world holds it; GASAttachEditor.WhoHasTag prints the list
+	if (!bSelectedTagBlocked)
+	{
+		if (TSharedPtr<FGASTagHolderIndex> HolderIndex = FGASTagHolderIndex::FindOrCreate(ASC ? ASC->GetWorld() : nullptr))
+		{
+			Sources += FString::Printf(TEXT("\n\nHeld by %d ASCs in this world (GASAttachEditor.WhoHasTag %s)"), HolderIndex->GetNumHolders(Tag), *Tag.ToString());
+		}
+
+		// 只在泄漏检测已经运行时显示，不在这里启动
+		// Only shown while the leak detector already runs; it is not started from here
+		TSharedPtr<FGASTagLeakDetector> LeakDetector = FGASTagLeakDetector::Find(ASC ? ASC->GetWorld() : nullptr);
+		if (const FGASTagCountStats* CountStats = LeakDetector.IsValid() ? LeakDetector->FindStats(ASC, Tag) : nullptr)
+		{
+			Sources += FString::Printf(TEXT("\nCount min-max per bucket: %s"), *CountStats->ToString(LeakDetector->GetCurrentBucket()));
+			if (CountStats->Leaks != EGASTagLeak::None)
+			{
+				Sources += FString::Printf(TEXT("\nLeak suspect: %s"), *FGASTagLeakDetector::DescribeLeaks(CountStats->Leaks));
+			}
+		}
+	}
+
+	return FText::FromString(Tag.ToString() + Sources);
+}
+
+void SGASAttachEditorImpl::FilterTags(const TMap<FGameplayTag, TSharedPtr<FGASCharacterTagsBase>>& InItems, TArray<TSharedPtr<FGASCharacterTagsBase>>& InOutFiltered, bool bNarrow) const
+{
+	// 新的筛选包含旧的筛选时，结果一定是当前结果的子集
+	// When the new filter contains the old one, the result is a subset of the current one
+	if (bNarrow)
+	{
+		InOutFiltered.RemoveAll([this](const TSharedPtr<FGASCharacterTagsBase>& Item) { return !PassesTagsFilter(Item); });
+		return;
+	}
+
+	InOutFiltered.Reset();
+	for (const TPair<FGameplayTag, TSharedPtr<FGASCharacterTagsBase>>& Pair : InItems)
+	{
+		if (PassesTagsFilter(Pair.Value))
+		{
+			InOutFiltered.Add(Pair.Value);
+		}
+	}
+	InOutFiltered.Sort(GASAttachEditorTags::FItemNameLess());
+}
+
+void SGASAttachEditorImpl::OnApplicationPreInputKeyDownListener(const FKeyEvent& InKeyEvent)
+{
+	if (InKeyEvent.GetKey() == EKeys::End)
+	{
+		SetPickingMode(false);
+	}
+}
+#if WITH_EDITOR
+FReply SGASAttachEditorImpl::OnMouseButtonUpTags(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent, FName TagsName)
+{
+	if (MouseEvent.GetEffectingButton() == EKeys::RightMouseButton)
+	{
+		TSharedPtr<SGameplayTagWidget> TagWidget = 
+			SNew(SGameplayTagWidget, TagsName == "OwnTags" ? EditableOwnerContainers : EditableBlockedContainers)
+			.GameplayTagUIMode(EGameplayTagUIMode::SelectionMode)
+			.ReadOnly(false)
+			.OnTagChanged(this, &SGASAttachEditorImpl::RefreshTagList, TagsName);
+
+		if (TagWidget.IsValid())
+		{
+			if (TagsName == "OwnTags")
+			{
+				OldOwnweTagContainer = OwnweTagContainer;
+			}
+			else
+			{
+				OldBlockedTagContainer = BlockedTagContainer;
+			}
+
+			FWidgetPath WidgetPath = MouseEvent.GetEventPath() != nullptr ? *MouseEvent.GetEventPath() : FWidgetPath();
+			FSlateApplication::Get().PushMenu(AsShared(), WidgetPath, TagWidget.ToSharedRef(), MouseEvent.GetScreenSpacePosition(), FPopupTransitionEffect(FPopupTransitionEffect::ContextMenu));
+		}
+
+	}
+	return FReply::Handled();
+}
+
+
+void SGASAttachEditorImpl::RefreshTagList(FName TagsName)
+{
+	bool bIsOwnTag = TagsName == "OwnTags";
+
+	FGameplayTagContainer* NewTagContainer =  bIsOwnTag ? &OwnweTagContainer : &BlockedTagContainer;
+	FGameplayTagContainer* OldTagContainer = bIsOwnTag ? &OldOwnweTagContainer : &OldBlockedTagContainer;
+
+	if (!SelectAbilitySystemComponent.IsValid() || !NewTagContainer || !OldTagContainer) return;
+
+	if (NewTagContainer->Num() > OldTagContainer->Num())
+	{
+		TArray<FGameplayTag> NewGameplayTagArr;
+		NewTagContainer->GetGameplayTagArray(NewGameplayTagArr);
+
+		// 是否增加
+		// Is Add
+		for (const FGameplayTag& Item : NewGameplayTagArr)
+		{
+			if (OldTagContainer->HasTag(Item)) continue;
+
+			if (bIsOwnTag)
+			{
+				SelectAbilitySystemComponent->AddLooseGameplayTag(Item);
+			}
+			else
+			{
+
+			}
+		}
+	}
+	else
+	{
+		TArray<FGameplayTag> OldGameplayTagArr;
+		OldTagContainer->GetGameplayTagArray(OldGameplayTagArr);
+		
+		// 是否是减少
+		// Is Reduce
+		for (const FGameplayTag& Item : OldGameplayTagArr)
+		{
+			if (NewTagContainer->HasTag(Item)) continue;
+
+			if (bIsOwnTag)
+			{
+				SelectAbilitySystemComponent->RemoveLooseGameplayTag(Item);
+			}
+			else
+			{
+
+			}
+		}
+	}
+	
+	*OldTagContainer = *NewTagContainer;
+}
+#endif
+void SGASAttachEditorImpl::HandleScreenModeStateChanged(ECheckBoxState NewValue, EScreenGAModeState InState)
+{
+	switch (NewValue)
+	{
+	case ECheckBoxState::Unchecked:
+		ScreenModeState ^= InState;
+		break;
+	case ECheckBoxState::Checked:
+		ScreenModeState |= InState;
+		break;
+	case ECheckBoxState::Undetermined:
+		break;
+	default:
+		break;
+	}
+
+	for (TSharedRef<FGASAbilitieNodeBase>& Item : AbilitieFilteredTreeRoot)
+	{
+		Item->SetItemVisility(Item->ScreenGAMode & ScreenModeState);
+	}
+}
+
+ECheckBoxState SGASAttachEditorImpl::HandleGetScreenButtonChecked(EScreenGAModeState InState) const
+{
+	return ScreenModeState & InState ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+TSharedPtr<SCheckBox> SGASAttachEditorImpl::CreateScreenCheckBox(EScreenGAModeState InModeState)
+{
+	return SNew(SCheckBox)
+			.Padding(FMargin(4, 0))
+			.IsChecked(this, &SGASAttachEditorImpl::HandleGetScreenButtonChecked, InModeState)
+			.OnCheckStateChanged_Lambda([this,InModeState](ECheckBoxState NewValue){ HandleScreenModeStateChanged(NewValue,InModeState);})
+			[
+				SNew(SBox)
+				.MinDesiredWidth(80.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(this, &SGASAttachEditorImpl::HandleGeScreenModeText, InModeState)
+				]
+			];
+}
+
+FText SGASAttachEditorImpl::HandleGeScreenModeText(EScreenGAModeState InState) const
+{
+	FText StateText;
+	switch (InState)
+	{
+	case Active:
+		//StateText = LOCTEXT("ActiveScreen","激活");
+		StateText = LOCTEXT("ActiveScreen","Active");
+		break;
+	case Blocked:
+		//StateText = LOCTEXT("BlockedScreen","阻止");
+		StateText = LOCTEXT("BlockedScreen","Blocked");
+		break;
+	case NoActive:
+		//StateText = LOCTEXT("NoActive","未激活");
+		StateText = LOCTEXT("NoActive","Inactive");
+		break;
+	default:
+		break;
+	}
+
+	return StateText;
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::CreateAbilityToolWidget()
+{
+
+	TArray<FName> HiddenColumnsList;
+	HiddenColumnsList.Reserve(HiddenReflectorTreeColumns.Num());
+	for (const FString& Item : HiddenReflectorTreeColumns)
+	{
+		HiddenColumnsList.Add(*Item);
+	}
+
+	TSharedPtr<SVerticalBox> Widget = 
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.Padding(2.f, 2.f)
+			.AutoHeight()
+			.HAlign(HAlign_Left)
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.Padding(FMargin(8.f, 0.f))
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.OnClicked(this, &SGASAttachEditorImpl::OnExpandAllClicked)
+					.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_ExpandAll", "Expand All"))
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.OnClicked(this, &SGASAttachEditorImpl::OnCollapseAllClicked)
+					.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_CollapseAll", "Collapse All"))
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.Padding(2.f, 2.f)
+			.AutoHeight()
+			.HAlign(HAlign_Left)
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				[
+					CreateScreenCheckBox(Active).ToSharedRef()
+				]
+
+				+ SHorizontalBox::Slot()
+				[
+					CreateScreenCheckBox(Blocked).ToSharedRef()
+				]
+
+				+ SHorizontalBox::Slot()
+				[
+					CreateScreenCheckBox(NoActive).ToSharedRef()
+				]
+			]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SBorder)
+			.Padding(0)
+			[
+				SAssignNew(AbilitieReflectorTree, SAbilitieTree)
+				.ItemHeight(24.f)
+				.TreeItemsSource(&AbilitieFilteredTreeRoot)
+				.OnGenerateRow(this, &SGASAttachEditorImpl::OnGenerateWidgetForFilterListView)
+				.OnGetChildren(this, &SGASAttachEditorImpl::HandleReflectorTreeGetChildren)
+				.OnSelectionChanged(this, &SGASAttachEditorImpl::HandleReflectorTreeSelectionChanged)
+				.OnContextMenuOpening(this, &SGASAttachEditorImpl::HandleReflectorTreeContextMenuPtr)
+				.HighlightParentNodesForSelection(true)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					.CanSelectGeneratedColumn(true)
+					.HiddenColumnsList(HiddenColumnsList)
+					.OnHiddenColumnsListChanged(this, &SGASAttachEditorImpl::HandleReflectorTreeHiddenColumnsListChanged)
+
+					+ SHeaderRow::Column(NAME_AbilitietName)
+					.SortMode(this,&SGASAttachEditorImpl::GetColumnSortMode, NAME_AbilitietName)
+					.OnSort(this, &SGASAttachEditorImpl::OnColumnSortModeChanged)
+					//.DefaultLabel(LOCTEXT("AbilitietName", "名称"))
+					.DefaultLabel(LOCTEXT("AbilitietName", "Ability Name"))
+					//.DefaultTooltip(LOCTEXT("AbilitietNameToolTip", "技能名称/任务名称/调试名称"))
+					.DefaultTooltip(LOCTEXT("AbilitietNameToolTip", "Ability/Task name"))
+					.FillWidth(0.6f)
+					.ShouldGenerateWidget(true)
+
+					+ SHeaderRow::Column(NAME_GAStateType)
+					/*.DefaultLabel(LOCTEXT("GAAbilitietStateType", "当前状态"))
+					.DefaultTooltip(LOCTEXT("GAStateTypeToolTip", "当前状态是否激活，或者是可以被激活但是因为某些原因被拦截"))*/
+					.DefaultLabel(LOCTEXT("GAAbilitietStateType", "State"))
+					.DefaultTooltip(LOCTEXT("GAStateTypeToolTip", "Whether the ability is active, inactive or blocked"))
+					.FillWidth(0.2f)
+
+					+ SHeaderRow::Column(NAME_GAIsActive)
+					//.DefaultLabel(LOCTEXT("GAIsActive", "是否激活"))
+					.DefaultLabel(LOCTEXT("GAIsActive", "Active"))
+					.FixedWidth(60.f)
+
+					+ SHeaderRow::Column(NAME_GAAbilityTriggers)
+					//.DefaultLabel(LOCTEXT("GAAbilityTriggers", "存在的激活Tag"))
+					.DefaultLabel(LOCTEXT("GAAbilityTriggers", "Triggers"))
+					.HAlignHeader(EHorizontalAlignment::HAlign_Center)
+					.FillWidth(0.2)
+				)
+			]
+		];
+
+
+	return Widget;
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::CreateAttributesToolWidget()
+{
+	return SNew(SBorder)
+			.Padding(0)
+			[
+				SAssignNew(AttributesReflectorTree,SAttributesTree)
+				.ItemHeight(32.f)
+				.TreeItemsSource(&AttributesFilteredTreeRoot) 
+				.OnGenerateRow(this, &SGASAttachEditorImpl::HandleAttributesWidgetForFilterListView)
+				.OnGetChildren(this, &SGASAttachEditorImpl::HandleAttributesTreeGetChildren)
+				.HighlightParentNodesForSelection(true)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					.CanSelectGeneratedColumn(true)
+
+					+ SHeaderRow::Column(NAME_AttributesName)
+					//.DefaultLabel(LOCTEXT("AttributesName", "属性名称"))
+					.DefaultLabel(LOCTEXT("AttributesName", "AttributesName"))
+					.FillWidth(0.4f)
+					.ShouldGenerateWidget(true)
+
+					+ SHeaderRow::Column(NAME_GANumericAttribute)
+					//.DefaultLabel(LOCTEXT("GAAttributeStateType", "当前属性值"))
+					.DefaultLabel(LOCTEXT("GAAttributeStateType", "Attribute Value"))
+					.FillWidth(0.6f)
+
+				)
+			];
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::CreateGameplayEffectToolWidget()
+{
+	TArray<FName> HiddenColumnsList;
+	HiddenColumnsList.Reserve(HiddenGameplayEffectTreeColumns.Num());
+	for (const FString& Item : HiddenGameplayEffectTreeColumns)
+	{
+		HiddenColumnsList.Add(*Item);
+	}
+
+	TSharedPtr<SVerticalBox> Widget =
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.Padding(2.f, 2.f)
+		.AutoHeight()
+		.HAlign(HAlign_Left)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f))
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.OnClicked(this, &SGASAttachEditorImpl::OnExpandAllClicked)
+				.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_ExpandAll", "Expand All"))
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.OnClicked(this, &SGASAttachEditorImpl::OnCollapseAllClicked)
+				.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_CollapseAll", "Collapse All"))
+			]
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SBorder)
+			.Padding(0.f)
+			[
+				SAssignNew(GameplayEffectTree, SGameplayEffectTree)
+				.ItemHeight(24.f)
+				.TreeItemsSource(&GameplayEffectTreeRoot)
+				.OnGenerateRow(this, &SGASAttachEditorImpl::OneGameplayEffecGenerateWidgetForFilterListView)
+				.OnGetChildren(this, &SGASAttachEditorImpl::HandleGameplayEffectTreeGetChildren)
+				.OnSelectionChanged(this, &SGASAttachEditorImpl::HandleGameplayEffectTreeSelectionChanged)
+				.HighlightParentNodesForSelection(true)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					.CanSelectGeneratedColumn(true)
+					.HiddenColumnsList(HiddenColumnsList)
+					.OnHiddenColumnsListChanged(this, &SGASAttachEditorImpl::HandleGameplayEffectTreeHiddenColumnsListChanged)
+
+				+ SHeaderRow::Column(NAME_GAGameplayEffectName)
+				//.DefaultLabel(LOCTEXT("GAGameplayEffectName", "名称"))
+				.DefaultLabel(LOCTEXT("GAGameplayEffectName", "GameplayEffectName"))
+				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
+				//.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "GE名称 / 加成属性"))
+				.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "GameplayEffect Name / Bonus Attribute"))
+				.FillWidth(0.2f)
+
+				+ SHeaderRow::Column(NAME_GAGameplayEffectDuration)
+				//.DefaultLabel(LOCTEXT("GAGameplayEffectDuration", "时间"))
+				.DefaultLabel(LOCTEXT("GAGameplayEffectDuration", "Time"))
+				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
+				//.DefaultTooltip(LOCTEXT("GAGameplayEffectDurationToolTip", "GE时间详细叙述"))
+				.DefaultTooltip(LOCTEXT("GAGameplayEffectDurationToolTip", "GameplayEffect Time"))
+				.FillWidth(0.4f)
+
+				+ SHeaderRow::Column(NAME_GAGameplayEffectStack)
+				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
+				//.DefaultLabel(LOCTEXT("GAGameplayEffectStack", "堆栈信息"))
+				.DefaultLabel(LOCTEXT("GAGameplayEffectStack", "GameplayEffectStack"))
+				.FillWidth(0.1f)
+
+				+ SHeaderRow::Column(NAME_GAGameplayEffectLevel)
+				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
+				//.DefaultLabel(LOCTEXT("GAGameplayEffectLevel", "等级"))
+				.DefaultLabel(LOCTEXT("GAGameplayEffectLevel", "Level"))
+				.FillWidth(0.1f)
+
+				+ SHeaderRow::Column(NAME_GAGameplayEffectGrantedTags)
+				.HAlignHeader(EHorizontalAlignment::HAlign_Center)
+				//.DefaultLabel(LOCTEXT("GAGameplayEffectGrantedTags", "标签"))
+				//.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "含有的所有标签"))
+				.DefaultLabel(LOCTEXT("GAGameplayEffectGrantedTags", "Tags"))
+				.DefaultTooltip(LOCTEXT("GAGameplayEffectToolTip", "GameplayEffect Own Tags"))
+				.FillWidth(0.2f)
+			)
+			]
+		];
+
+	return Widget;
+}
+
+TSharedRef<ITableRow> SGASAttachEditorImpl::OneGameplayEffecGenerateWidgetForFilterListView(TSharedRef< FGASGameplayEffectNodeBase > InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SGASGameplayEffectTreeItem, OwnerTable)
+		.WidgetInfoToVisualize(InItem);
+}
+
+void SGASAttachEditorImpl::HandleGameplayEffectTreeGetChildren(TSharedRef<FGASGameplayEffectNodeBase> InReflectorNode, TArray<TSharedRef<FGASGameplayEffectNodeBase>>& OutChildren)
+{
+	OutChildren = InReflectorNode->GetChildNodes();
+}
+
+void SGASAttachEditorImpl::HandleGameplayEffectTreeHiddenColumnsListChanged()
+{
+#if WITH_EDITOR
+	if (GameplayEffectTree && GameplayEffectTree->GetHeaderRow())
+	{
+		const TArray<FName> HiddenColumnIds = GameplayEffectTree->GetHeaderRow()->GetHiddenColumnIds();
+		HiddenGameplayEffectTreeColumns.Reset(HiddenColumnIds.Num());
+		for (const FName Id : HiddenColumnIds)
+		{
+			HiddenGameplayEffectTreeColumns.Add(Id.ToString());
+		}
+		SaveSettings();
+	}
+#endif
+}
+
+void SGASAttachEditorImpl::HandleGameplayEffectTreeSelectionChanged(TSharedPtr<FGASGameplayEffectNodeBase>, ESelectInfo::Type /*SelectInfo*/)
+{
+
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::CreateSnapshotToolWidget()
+{
+	return SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.Padding(2.f, 2.f)
+		.AutoHeight()
+		.HAlign(HAlign_Left)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f))
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.OnClicked(this, &SGASAttachEditorImpl::OnTakeFreezeFrameClicked)
+				//.Text(LOCTEXT("TakeFreezeFrame", "冻结帧"))
+				.Text(LOCTEXT("TakeFreezeFrame", "Freeze Frame"))
+				.ToolTipText(FText::Format(LOCTEXT("TakeFreezeFrameToolTip", "Snapshot every ASC of the selected world ({0})"), FGASAttachEditorCommands::Get().TakeFreezeFrame->GetInputText()))
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SComboButton)
+				.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetFreezeFrameMenu)
+				.VAlign(VAlign_Center)
+				.ContentPadding(2)
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text(this, &SGASAttachEditorImpl::GetFreezeFrameText)
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f, 0.f, 0.f))
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				//.Text(LOCTEXT("CompareWith", "对比"))
+				.Text(LOCTEXT("CompareWith", "Compare with"))
+			]
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(4.f, 0.f, 0.f, 0.f))
+			.AutoWidth()
+			[
+				SNew(SComboButton)
+				.OnGetMenuContent(this, &SGASAttachEditorImpl::OnGetCompareFreezeFrameMenu)
+				.VAlign(VAlign_Center)
+				.ContentPadding(2)
+				//.ToolTipText(LOCTEXT("CompareWithToolTip", "显示从所选快照到当前快照的变化"))
+				.ToolTipText(LOCTEXT("CompareWithToolTip", "Shows what changed from the picked snapshot to the current one. Use GASAttachEditor.Diff to compare capture files from different builds"))
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text(this, &SGASAttachEditorImpl::GetCompareFreezeFrameText)
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f))
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.OnClicked(this, &SGASAttachEditorImpl::OnExpandAllClicked)
+				.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_ExpandAll", "Expand All"))
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.OnClicked(this, &SGASAttachEditorImpl::OnCollapseAllClicked)
+				.Text(NSLOCTEXT("GameplayTagWidget", "GameplayTagWidget_CollapseAll", "Collapse All"))
+			]
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SBorder)
+			.Padding(0.f)
+			[
+				SAssignNew(SnapshotTree, SSnapshotTree)
+				.ItemHeight(24.f)
+				.TreeItemsSource(&SnapshotTreeRoot)
+				.OnGenerateRow(this, &SGASAttachEditorImpl::HandleSnapshotWidgetForFilterListView)
+				.OnGetChildren(this, &SGASAttachEditorImpl::HandleSnapshotTreeGetChildren)
+				.HighlightParentNodesForSelection(true)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+
+					+ SHeaderRow::Column(NAME_SnapshotName)
+					//.DefaultLabel(LOCTEXT("SnapshotName", "名称"))
+					.DefaultLabel(LOCTEXT("SnapshotName", "Name"))
+					.FillWidth(0.5f)
+					.ShouldGenerateWidget(true)
+
+					+ SHeaderRow::Column(NAME_SnapshotValue)
+					//.DefaultLabel(LOCTEXT("SnapshotValue", "值"))
+					.DefaultLabel(LOCTEXT("SnapshotValue", "Value"))
+					.FillWidth(0.5f)
+				)
+			]
+		];
+}
+
+TSharedRef<ITableRow> SGASAttachEditorImpl::HandleSnapshotWidgetForFilterListView(TSharedRef<FGASSnapshotNodeBase> InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SGASSnapshotTreeItem, OwnerTable)
+		.WidgetInfoToVisualize(InItem);
+}
+
+void SGASAttachEditorImpl::HandleSnapshotTreeGetChildren(TSharedRef<FGASSnapshotNodeBase> InReflectorNode, TArray<TSharedRef<FGASSnapshotNodeBase>>& OutChildren)
+{
+	OutChildren = InReflectorNode->GetChildNodes();
+}
+
+TSharedRef<SWidget> SGASAttachEditorImpl::OnGetFreezeFrameMenu()
+{
+	FMenuBuilder MenuBuilder(true, NULL);
+
+	const TArray<TSharedRef<const FGASFreezeFrame>>& FreezeFrames = FGASFreezeFrames::GetFreezeFrames();
+	for (int32 Index = FreezeFrames.Num() - 1; Index >= 0; --Index)
+	{
+		const TSharedRef<const FGASFreezeFrame>& FreezeFrame = FreezeFrames[Index];
+
+		FUIAction NoAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::HandleSelectFreezeFrame, FreezeFrame));
+		MenuBuilder.AddMenuEntry(
+			FText::Format(LOCTEXT("FreezeFrameEntry", "#{0} {1} {2}"), FText::AsNumber(FreezeFrame->Id), FText::FromString(FreezeFrame->World), FText::AsTime(FreezeFrame->Time)),
+			FText(), FSlateIcon(), NoAction);
+	}
+
+	return MenuBuilder.MakeWidget();
+}
+
+FText SGASAttachEditorImpl::GetFreezeFrameText() const
+{
+	if (!SelectedFreezeFrame.IsValid())
+	{
+		//return LOCTEXT("NoFreezeFrame", "没有快照");
+		return LOCTEXT("NoFreezeFrame", "No snapshot");
+	}
+
+	FNumberFormattingOptions NumberFormatOptions;
+	NumberFormatOptions.MaximumFractionalDigits = 3;
+
+	return FText::Format(LOCTEXT("FreezeFrameSummary", "#{0} {1}  Frame {2}  Time {3}  {4} ASCs  ({5} ms)"),
+		FText::AsNumber(SelectedFreezeFrame->Id),
+		FText::FromString(SelectedFreezeFrame->World),
+		FText::AsNumber(SelectedFreezeFrame->Snapshot->Frame, &FNumberFormattingOptions::DefaultNoGrouping()),
+		FText::AsNumber(SelectedFreezeFrame->Snapshot->WorldTime, &NumberFormatOptions),
+		FText::AsNumber(SelectedFreezeFrame->Snapshot->NumAbilitySystems),
+		FText::AsNumber(SelectedFreezeFrame->CopyMs, &NumberFormatOptions));
+}
+
+void SGASAttachEditorImpl::HandleSelectFreezeFrame(TSharedRef<const FGASFreezeFrame> InFreezeFrame)
+{
+	SelectedFreezeFrame = InFreezeFrame;
+
+	RefreshSnapshotTree();
+}
+
+TSharedRef<SWidget> SGASAttachEditorImpl::OnGetCompareFreezeFrameMenu()
+{
+	FMenuBuilder MenuBuilder(true, NULL);
+
+	//MenuBuilder.AddMenuEntry(LOCTEXT("CompareNone", "不对比"), FText(), FSlateIcon(),
+	MenuBuilder.AddMenuEntry(LOCTEXT("CompareNone", "None"), FText(), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::HandleSelectCompareFreezeFrame, TSharedPtr<const FGASFreezeFrame>())));
+
+	const TArray<TSharedRef<const FGASFreezeFrame>>& FreezeFrames = FGASFreezeFrames::GetFreezeFrames();
+	for (int32 Index = FreezeFrames.Num() - 1; Index >= 0; --Index)
+	{
+		const TSharedRef<const FGASFreezeFrame>& FreezeFrame = FreezeFrames[Index];
+
+		FUIAction NoAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::HandleSelectCompareFreezeFrame, TSharedPtr<const FGASFreezeFrame>(FreezeFrame)));
+		MenuBuilder.AddMenuEntry(
+			FText::Format(LOCTEXT("FreezeFrameEntry", "#{0} {1} {2}"), FText::AsNumber(FreezeFrame->Id), FText::FromString(FreezeFrame->World), FText::AsTime(FreezeFrame->Time)),
+			FText(), FSlateIcon(), NoAction);
+	}
+
+	return MenuBuilder.MakeWidget();
+}
+
+FText SGASAttachEditorImpl::GetCompareFreezeFrameText() const
+{
+	if (!CompareFreezeFrame.IsValid())
+	{
+		return LOCTEXT("CompareNone", "None");
+	}
+
+	return FText::Format(LOCTEXT("CompareFreezeFrame", "#{0}"), FText::AsNumber(CompareFreezeFrame->Id));
+}
+
+void SGASAttachEditorImpl::HandleSelectCompareFreezeFrame(TSharedPtr<const FGASFreezeFrame> InFreezeFrame)
+{
+	CompareFreezeFrame = InFreezeFrame;
+
+	RefreshSnapshotTree();
+}
+
+void SGASAttachEditorImpl::RefreshSnapshotTree()
+{
+	SnapshotTreeRoot.Reset();
+
+	if (!SelectedFreezeFrame.IsValid())
+	{
+		return;
+	}
+
+	if (CompareFreezeFrame.IsValid() && CompareFreezeFrame != SelectedFreezeFrame)
+	{
+		FGASCaptureSnapshotDiff Diff;
+		FGASCaptureDiff::Diff(*CompareFreezeFrame->Snapshot, *SelectedFreezeFrame->Snapshot, Diff);
+		FGASSnapshotNode::BuildDiffTree(Diff, SnapshotTreeRoot);
+	}
+	else
+	{
+		SnapshotTreeRoot = SelectedFreezeFrame->Roots;
+	}
+
+	if (SnapshotTree.IsValid())
+	{
+		for (TSharedRef<FGASSnapshotNodeBase> Item : SnapshotTreeRoot)
+		{
+			SnapshotTree->SetItemExpansion(Item, bGASTreeExpand);
+		}
+
+		SnapshotTree->RequestTreeRefresh();
+	}
+}
+
+void SGASAttachEditorImpl::HandleFreezeFrameReady(const TSharedRef<const FGASFreezeFrame>& InFreezeFrame)
+{
+	if (SelectAbilitieCategories != EDebugAbilitieCategories::Snapshot)
+	{
+		HandleShowDebugAbilitieCategories(EDebugAbilitieCategories::Snapshot);
+	}
+
+	HandleSelectFreezeFrame(InFreezeFrame);
+}
+
+FReply SGASAttachEditorImpl::OnTakeFreezeFrameClicked()
+{
+	TakeFreezeFrame();
+	return FReply::Handled();
+}
+
+void SGASAttachEditorImpl::TakeFreezeFrame()
+{
+	FGASFreezeFrames::Take(GetWorld());
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::CreateTagChurnToolWidget()
+{
+	TSharedPtr<SWidget> Widget = SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.Padding(2.f, 2.f)
+		.AutoHeight()
+		.HAlign(HAlign_Left)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f))
+			.AutoWidth()
+			[
+				SNew(SCheckBox)
+				.IsChecked_Lambda([this]() { return bTagChurnSelectedOnly ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+				.OnCheckStateChanged(this, &SGASAttachEditorImpl::HandleTagChurnScopeChanged)
+				//.ToolTipText(LOCTEXT("TagChurnSelectedOnlyToolTip", "只统计选中的角色，否则统计整个世界"))
+				.ToolTipText(LOCTEXT("TagChurnSelectedOnlyToolTip", "Count the selected ASC only instead of every ASC of the world. Its counters start when it is picked"))
+				[
+					SNew(STextBlock)
+					//.Text(LOCTEXT("TagChurnSelectedOnly", "只看选中角色"))
+					.Text(LOCTEXT("TagChurnSelectedOnly", "Selected ASC only"))
+				]
+			]
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f))
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SGASAttachEditorImpl::GetTagChurnSummaryText)
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+			]
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SBorder)
+			.Padding(0.f)
+			[
+				SAssignNew(TagChurnList, SListView<TSharedPtr<FGASTagChurnNode>>)
+				.ItemHeight(24.f)
+				.ListItemsSource(&TagChurnRows)
+				.OnGenerateRow(this, &SGASAttachEditorImpl::HandleTagChurnWidgetForFilterListView)
+				.SelectionMode(ESelectionMode::None)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+
+					+ SHeaderRow::Column(NAME_TagChurnTag)
+					//.DefaultLabel(LOCTEXT("TagChurnTag", "标签"))
+					.DefaultLabel(LOCTEXT("TagChurnTag", "Tag"))
+					.FillWidth(0.3f)
+
+					+ SHeaderRow::Column(NAME_TagChurnHeat)
+					//.DefaultLabel(LOCTEXT("TagChurnHeat", "每秒次数"))
+					.DefaultLabel(FText::Format(LOCTEXT("TagChurnHeat", "Last {0}s"), FText::AsNumber(FGASTagChurnNode::NumSeconds)))
+					.ManualWidth(FGASTagChurnNode::NumSeconds * 12.f + 8.f)
+
+					+ SHeaderRow::Column(NAME_TagChurnLastSecond)
+					//.DefaultLabel(LOCTEXT("TagChurnLastSecond", "上一秒"))
+					.DefaultLabel(LOCTEXT("TagChurnLastSecond", "Last second"))
+					.FillWidth(0.1f)
+
+					+ SHeaderRow::Column(NAME_TagChurnPeak)
+					//.DefaultLabel(LOCTEXT("TagChurnPeak", "峰值"))
+					.DefaultLabel(LOCTEXT("TagChurnPeak", "Peak/s"))
+					.FillWidth(0.1f)
+
+					+ SHeaderRow::Column(NAME_TagChurnTotal)
+					//.DefaultLabel(LOCTEXT("TagChurnTotalHeader", "总数"))
+					.DefaultLabel(LOCTEXT("TagChurnTotalHeader", "Total (+Add / -Remove)"))
+					.FillWidth(0.2f)
+
+					+ SHeaderRow::Column(NAME_TagChurnActor)
+					//.DefaultLabel(LOCTEXT("TagChurnActor", "最后改变的角色"))
+					.DefaultLabel(LOCTEXT("TagChurnActor", "Last changed on"))
+					.FillWidth(0.2f)
+				)
+			]
+		];
+
+	BindTagChurnTracker();
+
+	return Widget;
+}
+
+TSharedRef<ITableRow> SGASAttachEditorImpl::HandleTagChurnWidgetForFilterListView(TSharedPtr<FGASTagChurnNode> InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SGASTagChurnItem, OwnerTable)
+		.WidgetInfoToVisualize(InItem);
+}
+
+void SGASAttachEditorImpl::BindTagChurnTracker()
+{
+	TSharedPtr<FGASTagChurnTracker> Tracker = FGASTagChurnTracker::FindOrCreate(GetWorld());
+
+	TSharedPtr<FGASTagChurnTracker> OldTracker = TagChurnTracker.Pin();
+	if (OldTracker != Tracker)
+	{
+		if (OldTracker.IsValid())
+		{
+			OldTracker->OnSecond.Remove(TagChurnSecondHandle);
+		}
+
+		TagChurnSecondHandle.Reset();
+		TagChurnTracker = Tracker;
+
+		if (Tracker.IsValid())
+		{
+			TagChurnSecondHandle = Tracker->OnSecond.AddSP(this, &SGASAttachEditorImpl::RefreshTagChurnList);
+		}
+	}
+
+	if (Tracker.IsValid())
+	{
+		Tracker->SetFocus(bTagChurnSelectedOnly ? SelectAbilitySystemComponent.Get() : nullptr);
+	}
+
+	RefreshTagChurnList();
+}
+
+void SGASAttachEditorImpl::RefreshTagChurnList()
+{
+	if (SelectAbilitieCategories != EDebugAbilitieCategories::TagChurn || !TagChurnList.IsValid())
+	{
+		return;
+	}
+
+	TagChurnRows.Reset();
+
+	if (TSharedPtr<FGASTagChurnTracker> Tracker = TagChurnTracker.Pin())
+	{
+		const FGASTagChurnTable& Table = bTagChurnSelectedOnly ? Tracker->GetFocusTable() : Tracker->GetWorldTable();
+		const int32 Threshold = FGASTagChurnTracker::GetStormThreshold();
+
+		TagChurnRows.Reserve(Table.GetCounters().Num());
+		for (const TPair<FGameplayTag, FGASTagChurnCounters>& Pair : Table.GetCounters())
+		{
+			TagChurnRows.Add(FGASTagChurnNode::Create(Pair.Key, Pair.Value, Table.GetCurrentBucket(), Threshold));
+		}
+
+		FGASTagChurnNode::Sort(TagChurnRows);
+	}
+
+	TagChurnList->RequestListRefresh();
+}
+
+void SGASAttachEditorImpl::HandleTagChurnScopeChanged(ECheckBoxState NewValue)
+{
+	bTagChurnSelectedOnly = NewValue == ECheckBoxState::Checked;
+	BindTagChurnTracker();
+}
+
+FText SGASAttachEditorImpl::GetTagChurnSummaryText() const
+{
+	int32 Storms = 0;
+	for (const TSharedPtr<FGASTagChurnNode>& Row : TagChurnRows)
+	{
+		Storms += Row->bStorm ? 1 : 0;
+	}
+
+	return FText::Format(LOCTEXT("TagChurnSummary", "{0} tags changing, {1} over {2}/s (GASAttachEditor.TagChurn.StormThreshold)"),
+		FText::AsNumber(TagChurnRows.Num()), FText::AsNumber(Storms), FText::AsNumber(FGASTagChurnTracker::GetStormThreshold()));
+}
+
+TSharedPtr<SWidget> SGASAttachEditorImpl::CreateAbilityMatrixToolWidget()
+{
+	if (!AbilityMatrix.IsValid())
+	{
+		AbilityMatrix = MakeShareable(new FGASAbilityMatrix());
+	}
+
+	auto MakeLegend = [](const FText& InText, EGASAbilityRelation InRelation) -> TSharedRef<SWidget>
+	{
+		return SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(SImage)
+				.Image(FCoreStyle::Get().GetBrush("GenericWhiteBox"))
+				.ColorAndOpacity(SGASAbilityMatrixGrid::GetRelationColor(InRelation))
+				.DesiredSizeOverride(FVector2D(10.f, 10.f))
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(FMargin(4.f, 0.f, 12.f, 0.f))
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(InText)
+			];
+	};
+
+	TSharedPtr<SWidget> Widget = SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.Padding(2.f, 2.f)
+		.AutoHeight()
+		.HAlign(HAlign_Left)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f))
+			.AutoWidth()
+			[
+				//MakeLegend(LOCTEXT("AbilityMatrixCancels", "取消"), EGASAbilityRelation::Cancels)
+				MakeLegend(LOCTEXT("AbilityMatrixCancels", "Cancels"), EGASAbilityRelation::Cancels)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				//MakeLegend(LOCTEXT("AbilityMatrixBlocks", "阻止"), EGASAbilityRelation::Blocks)
+				MakeLegend(LOCTEXT("AbilityMatrixBlocks", "Blocks"), EGASAbilityRelation::Blocks)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				//MakeLegend(LOCTEXT("AbilityMatrixBlocksByOwnedTags", "拥有标签阻止"), EGASAbilityRelation::BlocksByOwnedTags)
+				MakeLegend(LOCTEXT("AbilityMatrixBlocksByOwnedTags", "Blocks by owned tags"), EGASAbilityRelation::BlocksByOwnedTags)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				//MakeLegend(LOCTEXT("AbilityMatrixEnables", "被依赖"), EGASAbilityRelation::Enables)
+				MakeLegend(LOCTEXT("AbilityMatrixEnables", "Required by"), EGASAbilityRelation::Enables)
+			]
+
+			+ SHorizontalBox::Slot()
+			.Padding(FMargin(8.f, 0.f))
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SGASAttachEditorImpl::GetAbilityMatrixSummaryText)
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+			]
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SBorder)
+			.Padding(0.f)
+			[
+				SNew(SScrollBox)
+				.Orientation(Orient_Horizontal)
+				+ SScrollBox::Slot()
+				[
+					SNew(SScrollBox)
+					.Orientation(Orient_Vertical)
+					+ SScrollBox::Slot()
+					[
+						SAssignNew(AbilityMatrixGrid, SGASAbilityMatrixGrid)
+						.Matrix(AbilityMatrix)
+					]
+				]
+			]
+		];
+
+	RefreshAbilityMatrix();
+
+	return Widget;
+}
+
+void SGASAttachEditorImpl::RefreshAbilityMatrix()
+{
+	if (!AbilityMatrix.IsValid() || !AbilityMatrixGrid.IsValid())
+	{
+		return;
+	}
+
+	if (AbilityMatrix->Update(SelectAbilitySystemComponent.Get()))
+	{
+		AbilityMatrixGrid->Refresh();
+	}
+}
+
+FText SGASAttachEditorImpl::GetAbilityMatrixSummaryText() const
+{
+	if (!AbilityMatrix.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	return FText::Format(LOCTEXT("AbilityMatrixSummary", "{0} abilities, row acts on column: {1} cancel, {2} block, {3} block by owned tags, {4} required by"),
+		FText::AsNumber(AbilityMatrix->Num()),
+		FText::AsNumber(AbilityMatrix->CountRelations(EGASAbilityRelation::Cancels)),
+		FText::AsNumber(AbilityMatrix->CountRelations(EGASAbilityRelation::Blocks)),
+		FText::AsNumber(AbilityMatrix->CountRelations(EGASAbilityRelation::BlocksByOwnedTags)),
+		FText::AsNumber(AbilityMatrix->CountRelations(EGASAbilityRelation::Enables)));
+}
+
+FAttachInputProcessor::FAttachInputProcessor(SGASAttachEditor* InWidgetPtr)
+	:GASAttachEditorWidgetPtr(InWidgetPtr)
+{
+}
+
+bool FAttachInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+{
+	if (!GASAttachEditorWidgetPtr)
+	{
+		return false;
+	}
+
+	// 按住快捷键时的重复事件不再拍，每次都会拷贝整个世界
+	// Key repeats while the chord is held take nothing; each freeze frame copies the whole world
+	const FInputChord KeyChord(InKeyEvent.GetKey(), EModifierKey::FromBools(InKeyEvent.IsControlDown(), InKeyEvent.IsAltDown(), InKeyEvent.IsShiftDown(), InKeyEvent.IsCommandDown()));
+	if (FGASAttachEditorCommands::Get().TakeFreezeFrame->HasActiveChord(KeyChord))
+	{
+		if (!InKeyEvent.IsRepeat())
+		{
+			GASAttachEditorWidgetPtr->TakeFreezeFrame();
+		}
+		return false;
+	}
+
+	if (InKeyEvent.GetKey() == EKeys::End)
+	{
+		GASAttachEditorWidgetPtr->SetPickingMode(false);
+	}
+
+	return false;
+}
+
+TSharedRef<SWidget> SGASAttachEditorImpl::OnGetExportMenu()
+{
+	FMenuBuilder MenuBuilder(true, NULL);
+
+	const FText Category = FText::FromName(GetAbilitieCategoriesName(SelectAbilitieCategories));
+
+	MenuBuilder.BeginSection("Category", Category);
+	MenuBuilder.AddMenuEntry(FText::Format(LOCTEXT("ExportCategoryJson", "Export {0} as JSON"), Category), FText(), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::ExportCategory, false)));
+	MenuBuilder.AddMenuEntry(FText::Format(LOCTEXT("ExportCategoryCsv", "Export {0} as CSV"), Category), FText(), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::ExportCategory, true)));
+	MenuBuilder.EndSection();
+
+	MenuBuilder.BeginSection("World", LOCTEXT("ExportWorldSection", "World"));
+	MenuBuilder.AddMenuEntry(LOCTEXT("ExportWorldJson", "Export all ASCs as JSON"), FText(), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::ExportWorld, false)));
+	MenuBuilder.AddMenuEntry(LOCTEXT("ExportWorldCsv", "Export all ASCs as CSV"), FText(), FSlateIcon(),
+		FUIAction(FExecuteAction::CreateSP(this, &SGASAttachEditorImpl::ExportWorld, true)));
+	MenuBuilder.EndSection();
+
+	return MenuBuilder.MakeWidget();
+}
+
+void SGASAttachEditorImpl::ExportCategory(bool bCsv)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_PanelExport);
+
+	auto IsVisible = [](const TArray<FString>& InHiddenColumns, const FName& InColumnId)
+	{
+		return !InHiddenColumns.Contains(InColumnId.ToString());
+	};
+
+	const FString Category = GetAbilitieCategoriesName(SelectAbilitieCategories).ToString();
+
+	TArray<FString> Row;
+
+	switch (SelectAbilitieCategories)
+	{
+	case EDebugAbilitieCategories::Ability:
+	{
+		const bool bState = IsVisible(HiddenReflectorTreeColumns, NAME_GAStateType);
+		const bool bActive = IsVisible(HiddenReflectorTreeColumns, NAME_GAIsActive);
+		const bool bTriggers = IsVisible(HiddenReflectorTreeColumns, NAME_GAAbilityTriggers);
+
+		TArray<FString> Columns({ TEXT("Name"), TEXT("Type"), TEXT("Parent") });
+		if (bState)
+		{
+			Columns.Add(TEXT("State"));
+			Columns.Add(TEXT("BlockedBy"));
+		}
+		if (bActive)
+		{
+			Columns.Add(TEXT("Active"));
+		}
+		if (bTriggers)
+		{
+			Columns.Add(TEXT("Triggers"));
+		}
+
+		TUniquePtr<FGASExportWriter> Writer = FGASExportWriter::Create(MakeExportFilename(Category, bCsv));
+		if (Writer->BeginTable(Category, Columns))
+		{
+			// 深度优先，子节点紧跟在父节点后面
+			// Depth first so children follow their parent
+			TFunction<void(const TArray<TSharedRef<FGASAbilitieNodeBase>>&, const FString&)> WriteNodes;
+			WriteNodes = [&](const TArray<TSharedRef<FGASAbilitieNodeBase>>& InNodes, const FString& InParent)
+			{
+				for (const TSharedRef<FGASAbilitieNodeBase>& Node : InNodes)
+				{
+					const FString Name = Node->GetGAName().ToString();
+
+					Row.Reset();
+					Row.Add(Name);
+					Row.Add(Node->GetNodeType() == Node_Task ? TEXT("Task") : Node->GetNodeType() == Node_Message ? TEXT("Message") : TEXT("Ability"));
+					Row.Add(InParent);
+					if (bState)
+					{
+						Row.Add(Node->GetGAStateType().ToString());
+						Row.Add(Node->GetAbilitieHasTag().ToString().Replace(TEXT("\n"), TEXT("; ")));
+					}
+					if (bActive)
+					{
+						Row.Add(LexToString(Node->GetGAIsActive()));
+					}
+					if (bTriggers)
+					{
+						Row.Add(Node->GetAbilityTriggersName());
+					}
+					Writer->AddRow(Row);
+
+					WriteNodes(Node->GetChildNodes(), Name);
+				}
+			};
+
+			WriteNodes(AbilitieFilteredTreeRoot, FString());
+			Writer->EndTable();
+		}
+
+		FinishExport(*Writer);
+		break;
+	}
+	case EDebugAbilitieCategories::Attributes:
+	{
+		TUniquePtr<FGASExportWriter> Writer = FGASExportWriter::Create(MakeExportFilename(Category, bCsv));
+		if (Writer->BeginTable(Category, { TEXT("Name"), TEXT("Value") }))
+		{
+			for (const TSharedRef<FGASAttributesNodeBase>& Node : AttributesFilteredTreeRoot)
+			{
+				Row.Reset();
+				Row.Add(Node->GetGAName().ToString());
+				Row.Add(LexToString(Node->GetNumericAttribute()));
+				Writer->AddRow(Row);
+			}
+			Writer->EndTable();
+		}
+
+		FinishExport(*Writer);
+		break;
+	}
+	case EDebugAbilitieCategories::GameplayEffects:
+	{
+		const bool bDuration = IsVisible(HiddenGameplayEffectTreeColumns, NAME_GAGameplayEffectDuration);
+		const bool bStack = IsVisible(HiddenGameplayEffectTreeColumns, NAME_GAGameplayEffectStack);
+		const bool bLevel = IsVisible(HiddenGameplayEffectTreeColumns, NAME_GAGameplayEffectLevel);
+		const bool bPrediction = IsVisible(HiddenGameplayEffectTreeColumns, NAME_GAGameplayEffectPrediction);
+		const bool bGrantedTags = IsVisible(HiddenGameplayEffectTreeColumns, NAME_GAGameplayEffectGrantedTags);
+
+		TArray<FString> Columns({ TEXT("Name") });
+		if (bDuration)
+		{
+			Columns.Add(TEXT("Duration"));
+		}
+		if (bStack)
+		{
+			Columns.Add(TEXT("Stack"));
+		}
+		if (bLevel)
+		{
+			Columns.Add(TEXT("Level"));
+		}
+		if (bPrediction)
+		{
+			Columns.Add(TEXT("Prediction"));
+		}
+		if (bGrantedTags)
+		{
+			Columns.Add(TEXT("GrantedTags"));
+		}
+
+		TUniquePtr<FGASExportWriter> Writer = FGASExportWriter::Create(MakeExportFilename(Category, bCsv));
+		if (Writer->BeginTable(Category, Columns))
+		{
+			for (const TSharedRef<FGASGameplayEffectNodeBase>& Node : GameplayEffectTreeRoot)
+			{
+				Row.Reset();
+				Row.Add(Node->GetGAName().ToString());
+				if (bDuration)
+				{
+					Row.Add(Node->GetDurationText().ToString());
+				}
+				if (bStack)
+				{
+					Row.Add(Node->GetStackText().ToString());
+				}
+				if (bLevel)
+				{
+					Row.Add(Node->GetLevelStr().ToString());
+				}
+				if (bPrediction)
+				{
+					Row.Add(Node->GetPredictedText().ToString());
+				}
+				if (bGrantedTags)
+				{
+					Row.Add(Node->GetGrantedTagsName().ToString());
+				}
+				Writer->AddRow(Row);
+			}
+			Writer->EndTable();
+		}
+
+		FinishExport(*Writer);
+		break;
+	}
+	case EDebugAbilitieCategories::Tags:
+	{
+		UAbilitySystemComponent* ASC = SelectAbilitySystemComponent.Get();
+		if (!ASC)
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("No ability system selected to export"));
+			return;
+		}
+
+		FGameplayTagContainer OwnerTags;
+		ASC->GetOwnedGameplayTags(OwnerTags);
+
+		FGameplayTagContainer BlockedTags;
+		ASC->GetBlockedAbilityTags(BlockedTags);
+
+		TUniquePtr<FGASExportWriter> Writer = FGASExportWriter::Create(MakeExportFilename(Category, bCsv));
+		if (Writer->BeginTable(Category, { TEXT("Tag"), TEXT("Count"), TEXT("Blocked") }))
+		{
+			for (const FGameplayTag& Tag : OwnerTags)
+			{
+				Row.Reset();
+				Row.Add(Tag.ToString());
+				Row.Add(LexToString(ASC->GetTagCount(Tag)));
+				Row.Add(LexToString(false));
+				Writer->AddRow(Row);
+			}
+
+			for (const FGameplayTag& Tag : BlockedTags)
+			{
+				Row.Reset();
+				Row.Add(Tag.ToString());
+				Row.Add(FString());
+				Row.Add(LexToString(true));
+				Writer->AddRow(Row);
+			}
+			Writer->EndTable();
+		}
+
+		FinishExport(*Writer);
+		break;
+	}
+	case EDebugAbilitieCategories::Snapshot:
+	{
+		if (!SelectedFreezeFrame.IsValid() || !SelectedFreezeFrame->Snapshot.IsValid())
+		{
+			UE_LOG(LogGASAttachEditor, Warning, TEXT("No snapshot selected to export"));
+			return;
+		}
+
+		TArray<FString> HiddenColumns = HiddenReflectorTreeColumns;
+		HiddenColumns.Append(HiddenGameplayEffectTreeColumns);
+
+		TUniquePtr<FGASExportWriter> Writer = FGASExportWriter::Create(MakeExportFilename(FString::Printf(TEXT("%s%d"), *Category, SelectedFreezeFrame->Id), bCsv));
+		FGASSnapshotExport::WriteSnapshot(*Writer, *SelectedFreezeFrame->Snapshot, HiddenColumns);
+
+		FinishExport(*Writer);
+		break;
+	}
+	case EDebugAbilitieCategories::TagChurn:
+	{
+		TUniquePtr<FGASExportWriter> Writer = FGASExportWriter::Create(MakeExportFilename(Category, bCsv));
+		if (Writer->BeginTable(Category, { TEXT("Tag"), TEXT("Total"), TEXT("Adds"), TEXT("Removes"), TEXT("LastSecond"), TEXT("Peak"), TEXT("Storm"), TEXT("LastActor") }))
+		{
+			for (const TSharedPtr<FGASTagChurnNode>& Node : TagChurnRows)
+			{
+				Row.Reset();
+				Row.Add(Node->Tag.ToString());
+				Row.Add(LexToString(Node->Total));
+				Row.Add(LexToString(Node->Adds));
+				Row.Add(LexToString(Node->Removes));
+				Row.Add(LexToString(Node->Events[FGASTagChurnNode::NumSeconds - 1]));
+				Row.Add(LexToString(Node->Peak));
+				Row.Add(LexToString(Node->bStorm));
+				Row.Add(Node->ActorText.ToString());
+				Writer->AddRow(Row);
+			}
+			Writer->EndTable();
+		}
+
+		FinishExport(*Writer);
+		break;
+	}
+	}
+}
+
+void SGASAttachEditorImpl::ExportWorld(bool bCsv)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_PanelExport);
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("No world selected to export"));
+		return;
+	}
+
+	// 只拷贝 FName 和数值，写出时再转成字符串
+	// Only FNames and numbers are copied; strings are made while writing
+	FGASCaptureWorldSnapshot Snapshot;
+	FGASCaptureSampler::CaptureWorld(World, Snapshot);
+
+	TArray<FString> HiddenColumns = HiddenReflectorTreeColumns;
+	HiddenColumns.Append(HiddenGameplayEffectTreeColumns);
+
+	TUniquePtr<FGASExportWriter> Writer = FGASExportWriter::Create(MakeExportFilename(TEXT("World"), bCsv));
+	FGASSnapshotExport::WriteSnapshot(*Writer, Snapshot, HiddenColumns);
+
+	FinishExport(*Writer);
+}
+
+FString SGASAttachEditorImpl::MakeExportFilename(const FString& InName, bool bCsv)
+{
+	UWorld* World = GetWorld();
+
+	return FGASExportWriter::GetExportDir() / FString::Printf(TEXT("%s_%s_%s.%s"),
+		World ? *World->GetName() : TEXT("None"), *InName, *FDateTime::Now().ToString(), bCsv ? TEXT("csv") : TEXT("json"));
+}
+
+void SGASAttachEditorImpl::FinishExport(FGASExportWriter& Writer)
+{
+	if (!Writer.Close() || Writer.GetFilenames().Num() == 0)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Export failed"));
+		return;
+	}
+
+	for (const FString& Filename : Writer.GetFilenames())
+	{
+		UE_LOG(LogGASAttachEditor, Display, TEXT("Exported %s"), *Filename);
+	}
+
+	// CSV 有多个文件时复制目录
+	// Copies the directory when the CSV export wrote several files
+	const TArray<FString>& Filenames = Writer.GetFilenames();
+	const FString CopiedPath = Filenames.Num() == 1 ? Filenames[0] : FPaths::GetPath(Filenames[0]);
+	FPlatformApplicationMisc::ClipboardCopy(*FPaths::ConvertRelativePathToFull(CopiedPath));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -1,65 +1,81 @@
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Widgets/SUserWidget.h"
-#include "Framework/Application/IInputProcessor.h"
-
-class SWidget;
-class FTabManager;
-
-enum EDebugAbilitieCategories
-{
-	// 标签
-	Tags,
-
-	// 数据
-	Attributes,
-
-	// 效果
-	GameplayEffects,
-
-	// 技能
-	Ability,
-};
-
-
-class SGASAttachEditor : public SUserWidget
-{
-public:
-
-	SLATE_USER_ARGS(SGASAttachEditor) {}
-	SLATE_END_ARGS()
-
-		
-
-public:
-	virtual void Construct(const FArguments& InArgs) = 0;
-
-	// 设置状态改变的东东
-	// Set the status change
-	virtual void SetPickingMode(bool bTick) = 0;
-
-	// 该Tab控件名字
-	// The tab control name
-	static FName GetTabName();
-
-	static void RegisterTabSpawner(FTabManager& TabManager);
-
-};
-
-class FAttachInputProcessor : public IInputProcessor
-{
-public:
-	FAttachInputProcessor(SGASAttachEditor* InWidgetPtr);
-	~FAttachInputProcessor() { GASAttachEditorWidgetPtr = nullptr; };
-
-private:
-
-	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
-	virtual const TCHAR* GetDebugName() const override { return TEXT("AttachInputProcessor"); }
-	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
-
-private:
-	SGASAttachEditor* GASAttachEditorWidgetPtr;
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SUserWidget.h"
+#include "Framework/Application/IInputProcessor.h"
+
+class SWidget;
+class FTabManager;
+
+enum EDebugAbilitieCategories
+{
+	// 标签
+	Tags,
+
+	// 数据
+	Attributes,
+
+	// 效果
+	GameplayEffects,
+
+	// 技能
+	Ability,
+
+	// 冻结帧快照
+	// Freeze frame snapshots
+	Snapshot,
+
+	// 标签抖动热力图
+	// Tag churn heatmap
+	TagChurn,
+
+	// 技能之间的取消/阻止/依赖关系矩阵
+	// Matrix of cancels/blocks/requires between abilities
+	AbilityMatrix,
+};
+
+
+class SGASAttachEditor : public SUserWidget
+{
+public:
+
+	SLATE_USER_ARGS(SGASAttachEditor) {}
+	SLATE_END_ARGS()
+
+		
+
+public:
+	virtual void Construct(const FArguments& InArgs) = 0;
+
+	// 设置状态改变的东东
+	// Set the status change
+	virtual void SetPickingMode(bool bTick) = 0;
+
+	// 对当前世界拍一张冻结帧快照
+	// Takes a freeze frame snapshot of the current world
+	virtual void TakeFreezeFrame() = 0;
+
+	// 该Tab控件名字
+	// The tab control name
+	static FName GetTabName();
+
+	static void RegisterTabSpawner(FTabManager& TabManager);
+
+};
+
+class FAttachInputProcessor : public IInputProcessor
+{
+public:
+	FAttachInputProcessor(SGASAttachEditor* InWidgetPtr);
+	~FAttachInputProcessor() { GASAttachEditorWidgetPtr = nullptr; };
+
+private:
+
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
+	virtual const TCHAR* GetDebugName() const override { return TEXT("AttachInputProcessor"); }
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+
+private:
+	SGASAttachEditor* GASAttachEditorWidgetPtr;
 };
\ No newline at end of file
@@ -1,7 +1,6 @@
 #include "SGASTagLookAsset.h"
 
 #if WITH_EDITOR
-#include "Engine/Blueprint.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Framework/Docking/TabManager.h"
 #include "GameplayTagContainer.h"
@@ -10,16 +9,16 @@
 #include "Widgets/Docking/SDockTab.h"
 #endif
 
-#include "Abilities/GameplayAbility.h"
-#include "AssetRegistry/AssetData.h"
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "Layout/Children.h"
+#include "TagLookAsset/GASTagUsageIndex.h"
 #include "TagLookAsset/SGASLookAssetBase.h"
 #include "Templates/SharedPointer.h"
 #include "UObject/UObjectGlobals.h"
+#include "Widgets/Input/SButton.h"
 #include "Widgets/Layout/SWrapBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Views/STreeView.h"
+#include "GASAttachEditorStats.h"
 
 #define LOCTEXT_NAMESPACE "FGASAttachEditorModule"
 
@@ -27,6 +26,8 @@ class SGASTagLookAssetImpl : public SGASTagLookAsset
 {
 	typedef STreeView<TSharedRef<FGASLookAssetBase>> SLookAssetTree;
 public:
+	virtual ~SGASTagLookAssetImpl() override;
+
 	virtual void Construct(const FArguments& InArgs) override;
 
 protected:
@@ -49,8 +50,21 @@ protected:
 
 	void FillLookTagAsset();
 
-	void SetGraphRootIdentifiers(const TArray<FAssetIdentifier>& NewGraphRootIdentifiers);
+#if WITH_EDITOR
+	// 标签树的一个节点: 先是这个标签自己的使用分组，然后是有使用的子标签
+	// One node of the tag tree: the usage groups of the tag itself, then the child tags that have usages
+	static TSharedRef<FGASLookAssetBase> MakeTagNode(FName InTagName, const FText& InName);
+
+	// 按使用方式分组，组的顺序和 EGASTagUsage 一致，组里按资源名排序
+	// Grouped by usage in EGASTagUsage order, sorted by asset name within a group
+	static void AddUsageGroups(FGASLookAssetBase& InParent, const TArray<FGASTagUsageEntry>& InEntries);
+#endif
+
+	EVisibility GetScanVisibility() const;
 
+	FText GetScanProgressText() const;
+
+	FReply HandleCancelScanClicked();
 
 private:
 #if WITH_EDITOR
@@ -75,8 +89,15 @@ private:
 	// Tree control root
 	TArray<TSharedRef<FGASLookAssetBase>> LookGAAssetTreeRoot;
 
+	FDelegateHandle IndexChangedHandle;
+
 };
 
+SGASTagLookAssetImpl::~SGASTagLookAssetImpl()
+{
+	FGASTagUsageIndex::OnChanged().Remove(IndexChangedHandle);
+}
+
 void SGASTagLookAssetImpl::Construct(const FArguments& InArgs)
 {
 
@@ -92,12 +113,38 @@ void SGASTagLookAssetImpl::Construct(const FArguments& InArgs)
 
 				+ SVerticalBox::Slot()
 				.AutoHeight()
-				.HAlign(HAlign_Left)
 				.Padding(2.f)
 				[
-					SNew(STextBlock)
-					//.Text(LOCTEXT("AbilityTriggersEvent", "调用GA事件的Tags"))
-					.Text(LOCTEXT("AbilityTriggersEvent", "Ability Trigger Events"))
+					SNew(SHorizontalBox)
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.f)
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock)
+						//.Text(LOCTEXT("AbilityTriggersEvent", "使用这些Tag的GA、GE和Cue"))
+						.Text(LOCTEXT("AbilityTriggersEvent", "Tag Usage (abilities, effects, cues)"))
+					]
+
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					.Padding(4.f, 0.f)
+					[
+						SNew(STextBlock)
+						.Visibility(this, &SGASTagLookAssetImpl::GetScanVisibility)
+						.Text(this, &SGASTagLookAssetImpl::GetScanProgressText)
+					]
+
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					[
+						SNew(SButton)
+						.Visibility(this, &SGASTagLookAssetImpl::GetScanVisibility)
+						//.Text(LOCTEXT("CancelScan", "取消"))
+						.Text(LOCTEXT("CancelScan", "Cancel"))
+						.OnClicked(this, &SGASTagLookAssetImpl::HandleCancelScanClicked)
+					]
 				]
 				+ SVerticalBox::Slot()
 				.FillHeight(1.f)
@@ -141,12 +188,12 @@ void SGASTagLookAssetImpl::Construct(const FArguments& InArgs)
 
 						+ SHeaderRow::Column(NAME_AbilitieAsset)
 						//.DefaultLabel(LOCTEXT("AbilitieAsset", "资源"))
-						.DefaultLabel(LOCTEXT("AbilitieAsset", "Ability Asset"))
+						.DefaultLabel(LOCTEXT("AbilitieAsset", "Asset"))
 						.FillWidth(0.5f)
 
 						+ SHeaderRow::Column(NAME_TriggerSource)
-						//.DefaultLabel(LOCTEXT("TriggerSource", "响应类型"))
-						.DefaultLabel(LOCTEXT("TriggerSource", "Trigger Source"))
+						//.DefaultLabel(LOCTEXT("TriggerSource", "响应类型 / 使用方式"))
+						.DefaultLabel(LOCTEXT("TriggerSource", "Trigger Source / Usage"))
 						.FillWidth(0.2f)
 					)
 				]
@@ -158,6 +205,11 @@ void SGASTagLookAssetImpl::Construct(const FArguments& InArgs)
 	TagContainer.Reset();
 	EditableContainers.Add(SGameplayTagWidget::FEditableGameplayTagContainerDatum(nullptr,&TagContainer));
 #endif
+
+	// 索引从磁盘读入或者后台更新完之后重新查询
+	// Query again once the index was read from disk or updated in the background
+	IndexChangedHandle = FGASTagUsageIndex::OnChanged().AddSP(this, &SGASTagLookAssetImpl::FillLookTagAsset);
+	FGASTagUsageIndex::Build();
 }
 
 #if WITH_EDITOR
@@ -256,101 +308,167 @@ TSharedRef<ITableRow> SGASTagLookAssetImpl::HandleAttributesWidgetForFilterListV
 
 void SGASTagLookAssetImpl::HandleAttributesTreeGetChildren(TSharedRef<FGASLookAssetBase> InReflectorNode, TArray<TSharedRef<FGASLookAssetBase>>& OutChildren)
 {
-
+	OutChildren = InReflectorNode->GetChildNodes();
 }
 
 void SGASTagLookAssetImpl::FillLookTagAsset()
 {
-	TArray<FGameplayTag> NewGameplayTagArr;
+	GASATTACHEDITOR_SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_SetGraphRootIdentifiers);
 
+	LookGAAssetTreeRoot.Reset();
 #if WITH_EDITOR
-	TagContainer.GetGameplayTagArray(NewGameplayTagArr);
-#endif
-
-	TArray<FAssetIdentifier> AssetIdentifiers;
-
-	for (const FGameplayTag& Item : NewGameplayTagArr)
+	// 只查内存里的索引和预先算好的标签树，不查引用也不加载资源
+	// Only the in-memory index and its precomputed tag tree are queried; no referencer lookups and no asset loads
+	TArray<FName> FilterNames;
+	for (const FGameplayTag& Tag : TagContainer)
 	{
-		AssetIdentifiers.Add(FAssetIdentifier(FGameplayTag::StaticStruct(), Item.GetTagName()));
+		FilterNames.AddUnique(Tag.GetTagName());
 	}
+	FilterNames.Sort(FNameLexicalLess());
 
-	SetGraphRootIdentifiers(AssetIdentifiers);
-}
+	TSet<FName> AddedParents;
+	for (const FName& TagName : FilterNames)
+	{
+		// 在另一个筛选标签下面的已经显示在它的子树里
+		// A filter tag below another filter tag is already shown in that tag's subtree
+		bool bUnderFilter = false;
+		for (FName Parent = FGASTagUsageIndex::GetParentTagName(TagName); !Parent.IsNone(); Parent = FGASTagUsageIndex::GetParentTagName(Parent))
+		{
+			bUnderFilter |= FilterNames.Contains(Parent);
+		}
+		if (bUnderFilter)
+		{
+			continue;
+		}
 
+		if (FGASTagUsageIndex::GetSubtreeCount(TagName) > 0)
+		{
+			TSharedRef<FGASLookAssetBase> TagNode = MakeTagNode(TagName, FText::FromName(TagName));
+			LookGAAssetTreeRoot.Add(TagNode);
+			LookGAAssetTree->SetItemExpansion(TagNode, true);
+		}
 
-void SGASTagLookAssetImpl::SetGraphRootIdentifiers(const TArray<FAssetIdentifier>& NewGraphRootIdentifiers)
-{
-	LookGAAssetTreeRoot.Reset();
-#if WITH_EDITOR
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		// 父标签的触发器也会被这个标签的事件触发，单独列出来
+		// Triggers on a parent tag also fire for events of this tag, so they are listed separately
+		for (FName Parent = FGASTagUsageIndex::GetParentTagName(TagName); !Parent.IsNone(); Parent = FGASTagUsageIndex::GetParentTagName(Parent))
+		{
+			const TArray<FGASTagUsageEntry>* Entries = FGASTagUsageIndex::FindEntries(Parent);
+			bool bAlreadyAdded = false;
+			AddedParents.Add(Parent, &bAlreadyAdded);
+			if (!Entries || bAlreadyAdded)
+			{
+				continue;
+			}
 
-	TArray<FAssetDependency> LinksToAsset;
-	for (const FAssetIdentifier& AssetId : NewGraphRootIdentifiers)
-	{
-		AssetRegistry.GetReferencers(AssetId, LinksToAsset, UE::AssetRegistry::EDependencyCategory::SearchableName, UE::AssetRegistry::EDependencyQuery::NoRequirements);
-	}
-	for (FAssetDependency& Asset : LinksToAsset)
-	{
-		FString PackStr = Asset.AssetId.PackageName.ToString();
-		int32 Index = PackStr.Find("/",ESearchCase::CaseSensitive,ESearchDir::FromEnd);
+			// 父标签的其他使用方式不会被这个标签触发，只留触发器
+			// Other usages of the parent are not fired by this tag, so only its triggers are kept
+			TArray<FGASTagUsageEntry> Triggers = Entries->FilterByPredicate([](const FGASTagUsageEntry& Entry) { return Entry.Usage == EGASTagUsage::Trigger; });
+			if (Triggers.Num() == 0)
+			{
+				continue;
+			}
 
-		FString AssPath = FString::Printf(TEXT("Blueprint'%s.%s'"), *PackStr,*PackStr.Right(PackStr.Len() - Index - 1));
+			//TSharedRef<FGASLookAssetGroup> ParentNode = FGASLookAssetGroup::Create(FText::Format(LOCTEXT("ParentTagNode", "{0} (父标签)"), FText::FromName(Parent)), Triggers.Num(), Parent);
+			TSharedRef<FGASLookAssetGroup> ParentNode = FGASLookAssetGroup::Create(FText::Format(LOCTEXT("ParentTagNode", "{0} (parent tag)"), FText::FromName(Parent)), Triggers.Num(), Parent);
+			AddUsageGroups(*ParentNode, Triggers);
+			LookGAAssetTreeRoot.Add(ParentNode);
+		}
+	}
+#endif
+	LookGAAssetTree->RequestTreeRefresh();
+}
 
-		FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(*AssPath));
+#if WITH_EDITOR
+TSharedRef<FGASLookAssetBase> SGASTagLookAssetImpl::MakeTagNode(FName InTagName, const FText& InName)
+{
+	TSharedRef<FGASLookAssetGroup> TagNode = FGASLookAssetGroup::Create(InName, FGASTagUsageIndex::GetSubtreeCount(InTagName), InTagName);
 
-		if (!AssetData.IsValid()) continue;
+	if (const TArray<FGASTagUsageEntry>* Entries = FGASTagUsageIndex::FindEntries(InTagName))
+	{
+		AddUsageGroups(*TagNode, *Entries);
+	}
 
-		UObject* AssObj = AssetData.GetAsset();
+	if (const TArray<FName>* ChildTags = FGASTagUsageIndex::GetChildTags(InTagName))
+	{
+		TArray<FName> SortedChildTags = *ChildTags;
+		SortedChildTags.Sort(FNameLexicalLess());
 
-		UGameplayAbility* GAAssObj = Cast<UGameplayAbility>(AssObj);
-		if (!GAAssObj)
+		const int32 PrefixLength = InTagName.GetStringLength() + 1;
+		for (const FName& ChildTag : SortedChildTags)
 		{
-			UBlueprint* GAAssBlue = Cast<UBlueprint>(AssObj);
-			if (!GAAssBlue) continue;
+			// 子标签只显示最后一段
+			// Child tags only show their last segment
+			TagNode->AddChildNode(MakeTagNode(ChildTag, FText::FromString(ChildTag.ToString().Mid(PrefixLength))));
+		}
+	}
 
-			//TSubclassOf<UGameplayAbility> GAAssClass = TSubclassOf<UGameplayAbility>(GAAssBlue->GeneratedClass);
+	return TagNode;
+}
 
-			GAAssObj = Cast<UGameplayAbility>(GAAssBlue->GeneratedClass->GetDefaultObject());
-			/*FSoftClassPath ClassPath(GAAssBlue->GeneratedClass.Get()->GetPathName());
-			if (UClass* Class = ClassPath.TryLoadClass<UGameplayAbility>())
-			{
-				GAAssObj = NewObject<UGameplayAbility>(Class, NAME_None, RF_Transactional);
-			}*/
+void SGASTagLookAssetImpl::AddUsageGroups(FGASLookAssetBase& InParent, const TArray<FGASTagUsageEntry>& InEntries)
+{
+	TArray<const FGASTagUsageEntry*> Groups[static_cast<int32>(EGASTagUsage::Num)];
+	for (const FGASTagUsageEntry& Entry : InEntries)
+	{
+		Groups[static_cast<int32>(Entry.Usage)].Add(&Entry);
+	}
 
-			if (!GAAssObj)	continue;
+	for (int32 UsageIndex = 0; UsageIndex < UE_ARRAY_COUNT(Groups); ++UsageIndex)
+	{
+		TArray<const FGASTagUsageEntry*>& GroupEntries = Groups[UsageIndex];
+		if (GroupEntries.Num() == 0)
+		{
+			continue;
 		}
 
-
-		FArrayProperty* ActiveTagsPtr = FindFProperty<FArrayProperty>(GAAssObj->GetClass(), "AbilityTriggers");
-		if (!ActiveTagsPtr) continue;
-		TArray<FAbilityTriggerData> ActivationTags = *ActiveTagsPtr->ContainerPtrToValuePtr<TArray<FAbilityTriggerData>>(GAAssObj);
-
-		bool bHasTag = false;
-		for (FAbilityTriggerData& Item : ActivationTags)
+		GroupEntries.Sort([](const FGASTagUsageEntry& A, const FGASTagUsageEntry& B)
 		{
-			if (TagContainer.HasTag(Item.TriggerTag))
+			const int32 Compare = A.AssetPath.GetAssetName().Compare(B.AssetPath.GetAssetName());
+			if (Compare != 0)
 			{
-				bHasTag = true;
-				LookGAAssetTreeRoot.Add(FGASLookAsset::Create(AssObj, Item));
+				return Compare < 0;
 			}
-		}
+			return A.Source < B.Source;
+		});
 
-		if (bHasTag)
+		TSharedRef<FGASLookAssetGroup> Group = FGASLookAssetGroup::Create(GASTagUsage::GetDisplayText(static_cast<EGASTagUsage>(UsageIndex)));
+		for (const FGASTagUsageEntry* Entry : GroupEntries)
 		{
+			Group->AddChildNode(FGASLookAsset::Create(*Entry));
 		}
+		InParent.AddChildNode(Group);
 	}
+}
+#endif
+
+EVisibility SGASTagLookAssetImpl::GetScanVisibility() const
+{
+	return FGASTagUsageIndex::IsBuilding() || FGASTagUsageIndex::IsLoadingOldAssets() ? EVisibility::Visible : EVisibility::Collapsed;
+}
 
-	LookGAAssetTreeRoot.Sort([](TSharedRef<FGASLookAssetBase> A,TSharedRef<FGASLookAssetBase> B)
+FText SGASTagLookAssetImpl::GetScanProgressText() const
+{
+	const TSharedPtr<FGASTagUsageScan> ActiveScan = FGASTagUsageIndex::GetActiveScan();
+	if (!ActiveScan.IsValid())
 	{
-		if (A->GetTagName() != B->GetTagName())
+		if (FGASTagUsageIndex::IsLoadingOldAssets())
 		{
-			return A->GetTagName().GetStringLength() == B->GetTagName().GetStringLength();
+			//return FText::Format(LOCTEXT("LoadOldAssetsProgress", "加载旧资源 {0}/{1}"), FGASTagUsageIndex::GetNumOldAssetsDone(), FGASTagUsageIndex::GetNumOldAssetsTotal());
+			return FText::Format(LOCTEXT("LoadOldAssetsProgress", "Loading old assets {0}/{1}"), FGASTagUsageIndex::GetNumOldAssetsDone(), FGASTagUsageIndex::GetNumOldAssetsTotal());
 		}
-		return true;
-	});
 
-#endif
-	LookGAAssetTree->RequestTreeRefresh();
+		return FText::GetEmpty();
+	}
+
+	//return FText::Format(LOCTEXT("ScanProgress", "更新索引 {0}/{1}"), ActiveScan->GetNumDone(), ActiveScan->GetNumTotal());
+	return FText::Format(LOCTEXT("ScanProgress", "Indexing {0}/{1}"), ActiveScan->GetNumDone(), ActiveScan->GetNumTotal());
+}
+
+FReply SGASTagLookAssetImpl::HandleCancelScanClicked()
+{
+	FGASTagUsageIndex::CancelBuild();
+	FGASTagUsageIndex::CancelLoadOldAssets();
+	return FReply::Handled();
 }
 
 TSharedRef<SGASTagLookAsset> SGASTagLookAsset::New()
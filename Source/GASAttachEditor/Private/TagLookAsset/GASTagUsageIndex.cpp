@@ -0,0 +1,882 @@
+#include "TagLookAsset/GASTagUsageIndex.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#endif
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+TMap<FName, FGASPackageTagUsages> FGASTagUsageIndex::Packages;
+TMap<FName, TArray<FGASTagUsageEntry>> FGASTagUsageIndex::TagEntries;
+TMap<FName, FGASTagUsageIndex::FTagNode> FGASTagUsageIndex::TagTree;
+TSharedPtr<FGASTagUsageScan> FGASTagUsageIndex::ActiveScan;
+FSimpleMulticastDelegate FGASTagUsageIndex::ChangedEvent;
+FDelegateHandle FGASTagUsageIndex::FilesLoadedHandle;
+FDelegateHandle FGASTagUsageIndex::AssetAddedHandle;
+FDelegateHandle FGASTagUsageIndex::AssetRemovedHandle;
+FDelegateHandle FGASTagUsageIndex::AssetRenamedHandle;
+FDelegateHandle FGASTagUsageIndex::AssetUpdatedHandle;
+FDelegateHandle FGASTagUsageIndex::PackageSavedHandle;
+FTSTicker::FDelegateHandle FGASTagUsageIndex::FlushTickerHandle;
+TSet<FName> FGASTagUsageIndex::QueuedPackages;
+double FGASTagUsageIndex::FirstQueuedTime = 0.0;
+double FGASTagUsageIndex::LastQueuedTime = 0.0;
+TArray<FName> FGASTagUsageIndex::OldPackages;
+int32 FGASTagUsageIndex::NextOldPackage = 0;
+int32 FGASTagUsageIndex::NumOldPackagesLoading = 0;
+int32 FGASTagUsageIndex::NumOldPackagesDone = 0;
+uint32 FGASTagUsageIndex::OldPackagesSerial = 0;
+bool FGASTagUsageIndex::bLoaded = false;
+bool FGASTagUsageIndex::bBuilt = false;
+bool FGASTagUsageIndex::bBuilding = false;
+bool FGASTagUsageIndex::bDirty = false;
+
+static TAutoConsoleVariable<float> CVarTagUsageIndexQuietSeconds(
+	TEXT("GASAttachEditor.TagUsageIndex.QuietSeconds"),
+	0.5f,
+	TEXT("Seconds without asset events before the queued packages are extracted into the Events Debug tag usage index"));
+
+static TAutoConsoleVariable<float> CVarTagUsageIndexMaxDelaySeconds(
+	TEXT("GASAttachEditor.TagUsageIndex.MaxDelaySeconds"),
+	5.f,
+	TEXT("Longest a queued package waits during a continuous burst of asset events before it is extracted anyway"));
+
+static TAutoConsoleVariable<bool> CVarTagUsageIndexLoadOldAssets(
+	TEXT("GASAttachEditor.TagUsageIndex.LoadOldAssets"),
+	true,
+	TEXT("Once the Events Debug index is built in the editor, loads the GAS assets saved before their tag usage was exported in the background so their exact usages are cached"));
+
+static TAutoConsoleVariable<int32> CVarTagUsageIndexLoadBatchSize(
+	TEXT("GASAttachEditor.TagUsageIndex.LoadBatchSize"),
+	8,
+	TEXT("Number of old GAS packages the Events Debug index loads asynchronously at a time"));
+
+namespace GASTagUsageIndexFile
+{
+	// 防止读到损坏的文件时分配过大的数组
+	// Guards against huge allocations when reading a corrupt file
+	constexpr int32 MaxEntriesPerPackage = 4096;
+
+	void SerializePackage(FArchive& Ar, FString& PackageName, FGASPackageTagUsages& Usages)
+	{
+		Ar << PackageName;
+		Ar << Usages.Hash;
+
+		int32 NumEntries = Usages.Entries.Num();
+		Ar << NumEntries;
+		if (Ar.IsLoading())
+		{
+			if (Ar.IsError() || NumEntries < 0 || NumEntries > MaxEntriesPerPackage)
+			{
+				Ar.SetError();
+				return;
+			}
+			Usages.Entries.SetNum(NumEntries);
+		}
+
+		for (FGASTagUsageEntry& Entry : Usages.Entries)
+		{
+			FString TagName = Entry.TagName.ToString();
+			FString AssetPath = Entry.AssetPath.ToString();
+			uint8 Usage = static_cast<uint8>(Entry.Usage);
+			uint8 Source = Entry.Source;
+
+			Ar << TagName;
+			Ar << AssetPath;
+			Ar << Usage;
+			Ar << Source;
+			Ar << Entry.bExact;
+
+			if (Ar.IsLoading())
+			{
+				Entry.TagName = FName(*TagName);
+				Entry.AssetPath = FSoftObjectPath(AssetPath);
+				Entry.Usage = Usage < static_cast<uint8>(EGASTagUsage::Num) ? static_cast<EGASTagUsage>(Usage) : EGASTagUsage::Other;
+				Entry.Source = static_cast<EGameplayAbilityTriggerSource::Type>(Source);
+			}
+		}
+	}
+}
+
+void FGASTagUsageIndex::Build()
+{
+	check(IsInGameThread());
+
+	if (!bLoaded)
+	{
+		bLoaded = true;
+		if (Load())
+		{
+			ChangedEvent.Broadcast();
+		}
+	}
+
+	if (bBuilt || ActiveScan.IsValid() || FilesLoadedHandle.IsValid())
+	{
+		return;
+	}
+
+	// 注册表扫描完之后再比较，不然还没发现的包会被当成删除了
+	// Compare once the registry finished scanning, otherwise packages not discovered yet would look removed
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddLambda([]()
+		{
+			IAssetRegistry::GetChecked().OnFilesLoaded().Remove(FilesLoadedHandle);
+			FilesLoadedHandle.Reset();
+			Build();
+		});
+		return;
+	}
+
+	StartScan();
+}
+
+void FGASTagUsageIndex::StartScan()
+{
+	FGASTagUsageExtractor::CacheNativeClasses();
+	BindAssetEvents();
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	TSet<FName> IndexedPackages;
+	for (const FAssetData& Asset : Assets)
+	{
+		if (FGASTagUsageExtractor::IsIndexedAsset(Asset))
+		{
+			IndexedPackages.Add(Asset.PackageName);
+		}
+	}
+
+	TArray<FName> Removed;
+	for (const TPair<FName, FGASPackageTagUsages>& Package : Packages)
+	{
+		if (!IndexedPackages.Contains(Package.Key))
+		{
+			Removed.Add(Package.Key);
+		}
+	}
+
+	for (const FName& PackageName : Removed)
+	{
+		RemovePackage(PackageName);
+	}
+
+	// 只重新提取保存哈希变了的包
+	// Only packages whose saved hash changed are extracted again
+	TArray<FName> Changed;
+	for (const FName& PackageName : IndexedPackages)
+	{
+		const FGASPackageTagUsages* Found = Packages.Find(PackageName);
+		TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		if (!Found || !PackageData.IsSet() || Found->Hash != PackageData->GetPackageSavedHash())
+		{
+			Changed.Add(PackageName);
+		}
+	}
+
+	UE_LOG(LogGASAttachEditor, Log, TEXT("Tag usage index: %d GAS packages, %d changed, %d removed"), IndexedPackages.Num(), Changed.Num(), Removed.Num());
+
+	if (Changed.Num() == 0)
+	{
+		bBuilt = true;
+		Save();
+		ChangedEvent.Broadcast();
+		return;
+	}
+
+	if (Removed.Num() > 0)
+	{
+		ChangedEvent.Broadcast();
+	}
+
+	bBuilding = true;
+	ActiveScan = FGASTagUsageScan::Start(Changed, FOnGASTagUsageScanFinished::CreateStatic(&FGASTagUsageIndex::HandleScanFinished));
+}
+
+void FGASTagUsageIndex::BindAssetEvents()
+{
+	if (AssetAddedHandle.IsValid())
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddStatic(&FGASTagUsageIndex::HandleAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddStatic(&FGASTagUsageIndex::HandleAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddStatic(&FGASTagUsageIndex::HandleAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddStatic(&FGASTagUsageIndex::HandleAssetUpdated);
+#if WITH_EDITOR
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddStatic(&FGASTagUsageIndex::HandlePackageSaved);
+#endif
+}
+
+void FGASTagUsageIndex::UnbindAssetEvents()
+{
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+#if WITH_EDITOR
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+#endif
+
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+	PackageSavedHandle.Reset();
+}
+
+// 事件里只做便宜的过滤: 现在是GAS资源的包，或者索引里已有的包(可能已经不是了)
+// Events only do a cheap filter: packages that are GAS assets now, or packages already in the index (which may no longer be)
+void FGASTagUsageIndex::HandleAssetAdded(const FAssetData& InAssetData)
+{
+	if (FGASTagUsageExtractor::IsIndexedAsset(InAssetData))
+	{
+		QueuePackage(InAssetData.PackageName);
+	}
+}
+
+void FGASTagUsageIndex::HandleAssetRemoved(const FAssetData& InAssetData)
+{
+	if (Packages.Contains(InAssetData.PackageName))
+	{
+		QueuePackage(InAssetData.PackageName);
+	}
+}
+
+void FGASTagUsageIndex::HandleAssetRenamed(const FAssetData& InAssetData, const FString& InOldObjectPath)
+{
+	const FName OldPackageName = FSoftObjectPath(InOldObjectPath).GetLongPackageFName();
+	if (Packages.Contains(OldPackageName))
+	{
+		QueuePackage(OldPackageName);
+	}
+
+	HandleAssetUpdated(InAssetData);
+}
+
+void FGASTagUsageIndex::HandleAssetUpdated(const FAssetData& InAssetData)
+{
+	if (FGASTagUsageExtractor::IsIndexedAsset(InAssetData) || Packages.Contains(InAssetData.PackageName))
+	{
+		QueuePackage(InAssetData.PackageName);
+	}
+}
+
+#if WITH_EDITOR
+void FGASTagUsageIndex::HandlePackageSaved(const FString& InFilename, UPackage* InPackage, FObjectPostSaveContext InContext)
+{
+	if (!InPackage || InContext.IsProceduralSave())
+	{
+		return;
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(InPackage->FindAssetInPackage());
+	if ((Blueprint && FGASTagUsageExtractor::IsIndexedClass(Blueprint->GeneratedClass)) || Packages.Contains(InPackage->GetFName()))
+	{
+		QueuePackage(InPackage->GetFName());
+	}
+}
+#endif
+
+void FGASTagUsageIndex::QueuePackage(FName InPackageName)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (QueuedPackages.Num() == 0)
+	{
+		FirstQueuedTime = Now;
+	}
+	LastQueuedTime = Now;
+
+	QueuedPackages.Add(InPackageName);
+
+	if (!FlushTickerHandle.IsValid())
+	{
+		FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("GASTagUsageIndexFlush"), 0.25f, &FGASTagUsageIndex::HandleFlushTicker);
+	}
+}
+
+bool FGASTagUsageIndex::HandleFlushTicker(float InDeltaTime)
+{
+	if (QueuedPackages.Num() == 0)
+	{
+		FlushTickerHandle.Reset();
+		return false;
+	}
+
+	// 一次只跑一个扫描，期间来的事件留到下一次
+	// Only one scan runs at a time; events arriving meanwhile wait for the next one
+	const double Now = FPlatformTime::Seconds();
+	const bool bQuiet = Now - LastQueuedTime >= CVarTagUsageIndexQuietSeconds.GetValueOnGameThread();
+	const bool bOverdue = Now - FirstQueuedTime >= CVarTagUsageIndexMaxDelaySeconds.GetValueOnGameThread();
+	if (ActiveScan.IsValid() || (!bQuiet && !bOverdue))
+	{
+		return true;
+	}
+
+	TArray<FName> PackageNames = QueuedPackages.Array();
+	QueuedPackages.Reset();
+
+	UE_LOG(LogGASAttachEditor, Verbose, TEXT("Tag usage index: updating %d changed packages"), PackageNames.Num());
+
+	ActiveScan = FGASTagUsageScan::Start(PackageNames, FOnGASTagUsageScanFinished::CreateStatic(&FGASTagUsageIndex::HandleScanFinished));
+
+	FlushTickerHandle.Reset();
+	return false;
+}
+
+void FGASTagUsageIndex::HandleScanFinished(FGASTagUsageScan& InScan)
+{
+	ActiveScan.Reset();
+
+	const TArray<FName>& PackageNames = InScan.GetPackageNames();
+	TArray<FGASPackageTagUsages>& Results = InScan.GetResults();
+	for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+	{
+		if (Results[Index].bFound)
+		{
+			SetPackage(PackageNames[Index], MoveTemp(Results[Index]));
+		}
+		else
+		{
+			RemovePackage(PackageNames[Index]);
+		}
+	}
+
+	// 增量更新不写盘，保存哈希保证下次启动时补上没写进去的改动
+	// Incremental updates are not written; the saved hashes make the next startup pick up whatever was not written
+	if (bBuilding)
+	{
+		bBuilding = false;
+		bBuilt = true;
+		Save();
+
+		// 命令行有自己的同步加载 (-LoadOldAssets)，不在这里异步加载
+		// Commandlets have their own synchronous load (-LoadOldAssets) and do not load asynchronously here
+		if (CVarTagUsageIndexLoadOldAssets.GetValueOnGameThread() && !IsRunningCommandlet())
+		{
+			LoadOldAssets();
+		}
+	}
+
+	ChangedEvent.Broadcast();
+}
+
+void FGASTagUsageIndex::CancelBuild()
+{
+	if (!ActiveScan.IsValid())
+	{
+		return;
+	}
+
+	ActiveScan->Cancel();
+
+	// 取消增量更新时把包放回队列，不丢改动
+	// Cancelling an incremental update puts its packages back in the queue, so no change is lost
+	if (!bBuilding)
+	{
+		for (const FName& PackageName : ActiveScan->GetPackageNames())
+		{
+			QueuePackage(PackageName);
+		}
+	}
+
+	bBuilding = false;
+	ActiveScan.Reset();
+}
+
+void FGASTagUsageIndex::Query(const FGameplayTagContainer& InTags, TArray<FGASTagUsageEntry>& OutEntries)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_QueryTagUsage);
+
+	TSet<FName> FilterNames;
+	for (const FGameplayTag& Tag : InTags)
+	{
+		FilterNames.Add(Tag.GetTagName());
+	}
+
+	TSet<FName> Visited;
+	for (const FName& TagName : FilterNames)
+	{
+		bool bUnderFilter = false;
+		for (FName Parent = GetParentTagName(TagName); !Parent.IsNone(); Parent = GetParentTagName(Parent))
+		{
+			bUnderFilter |= FilterNames.Contains(Parent);
+		}
+
+		// 筛选标签在另一个筛选标签下面时，它的子树已经查过了
+		// A filter tag below another filter tag had its subtree queried already
+		if (bUnderFilter)
+		{
+			continue;
+		}
+
+		QuerySubtree(TagName, OutEntries);
+
+		for (FName Parent = GetParentTagName(TagName); !Parent.IsNone(); Parent = GetParentTagName(Parent))
+		{
+			bool bAlreadyVisited = false;
+			Visited.Add(Parent, &bAlreadyVisited);
+			if (bAlreadyVisited)
+			{
+				break;
+			}
+
+			if (const TArray<FGASTagUsageEntry>* Entries = TagEntries.Find(Parent))
+			{
+				OutEntries.Append(*Entries);
+			}
+		}
+	}
+}
+
+void FGASTagUsageIndex::QuerySubtree(FName InTag, TArray<FGASTagUsageEntry>& OutEntries)
+{
+	const FTagNode* Node = TagTree.Find(InTag);
+	if (!Node)
+	{
+		return;
+	}
+
+	OutEntries.Reserve(OutEntries.Num() + Node->SubtreeCount);
+
+	TArray<FName, TInlineAllocator<32>> Stack;
+	Stack.Add(InTag);
+	while (Stack.Num() > 0)
+	{
+		const FName Tag = Stack.Pop(EAllowShrinking::No);
+		if (const TArray<FGASTagUsageEntry>* Entries = TagEntries.Find(Tag))
+		{
+			OutEntries.Append(*Entries);
+		}
+
+		if (const FTagNode* ChildNode = TagTree.Find(Tag))
+		{
+			Stack.Append(ChildNode->ChildTags);
+		}
+	}
+}
+
+int32 FGASTagUsageIndex::GetSubtreeCount(FName InTag)
+{
+	const FTagNode* Node = TagTree.Find(InTag);
+	return Node ? Node->SubtreeCount : 0;
+}
+
+const TArray<FName>* FGASTagUsageIndex::GetChildTags(FName InTag)
+{
+	const FTagNode* Node = TagTree.Find(InTag);
+	return Node ? &Node->ChildTags : nullptr;
+}
+
+FName FGASTagUsageIndex::GetParentTagName(FName InTag)
+{
+	const FString TagString = InTag.ToString();
+	int32 DotIndex = INDEX_NONE;
+	if (!TagString.FindLastChar(TEXT('.'), DotIndex))
+	{
+		return NAME_None;
+	}
+	return FName(*TagString.Left(DotIndex));
+}
+
+void FGASTagUsageIndex::AddLoaded(const UObject* InAsset)
+{
+	if (ExtractLoaded(InAsset))
+	{
+		ChangedEvent.Broadcast();
+	}
+}
+
+void FGASTagUsageIndex::LoadOldAssets()
+{
+	check(IsInGameThread());
+
+	if (IsLoadingOldAssets())
+	{
+		return;
+	}
+
+	for (const TPair<FName, FGASPackageTagUsages>& Package : Packages)
+	{
+		if (Package.Value.Entries.ContainsByPredicate([](const FGASTagUsageEntry& Entry) { return !Entry.bExact; }))
+		{
+			OldPackages.Add(Package.Key);
+		}
+	}
+
+	if (OldPackages.Num() == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("Loading %d GAS packages saved before their tag usage was exported, see GASAttachEditor.TagUsageIndex.LoadOldAssets"), OldPackages.Num());
+
+	NextOldPackage = 0;
+	NumOldPackagesLoading = 0;
+	NumOldPackagesDone = 0;
+	LoadNextOldAssets();
+	ChangedEvent.Broadcast();
+}
+
+void FGASTagUsageIndex::CancelLoadOldAssets()
+{
+	if (!IsLoadingOldAssets())
+	{
+		return;
+	}
+
+	// 已经提取的结果保留，下次构建之后只加载剩下的包
+	// Results already extracted are kept; after the next build only the remaining packages are loaded
+	++OldPackagesSerial;
+	OldPackages.Reset();
+	NextOldPackage = 0;
+	NumOldPackagesLoading = 0;
+	NumOldPackagesDone = 0;
+
+	Save();
+	ChangedEvent.Broadcast();
+}
+
+void FGASTagUsageIndex::LoadNextOldAssets()
+{
+	const int32 BatchSize = FMath::Max(1, CVarTagUsageIndexLoadBatchSize.GetValueOnGameThread());
+	while (NumOldPackagesLoading < BatchSize && NextOldPackage < OldPackages.Num())
+	{
+		++NumOldPackagesLoading;
+		LoadPackageAsync(OldPackages[NextOldPackage++].ToString(), FLoadPackageAsyncDelegate::CreateStatic(&FGASTagUsageIndex::HandleOldAssetLoaded, OldPackagesSerial));
+	}
+}
+
+void FGASTagUsageIndex::HandleOldAssetLoaded(const FName& InPackageName, UPackage* InPackage, EAsyncLoadingResult::Type InResult, uint32 InSerial)
+{
+	if (InSerial != OldPackagesSerial)
+	{
+		return;
+	}
+
+	--NumOldPackagesLoading;
+	++NumOldPackagesDone;
+
+	if (InPackage && InResult == EAsyncLoadingResult::Succeeded)
+	{
+		ForEachObjectWithPackage(InPackage, [](UObject* InObject)
+		{
+			ExtractLoaded(InObject);
+			return true;
+		}, false);
+	}
+	else
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not load %s for the tag usage index"), *InPackageName.ToString());
+	}
+
+	if (NumOldPackagesDone < OldPackages.Num())
+	{
+		LoadNextOldAssets();
+		return;
+	}
+
+	UE_LOG(LogGASAttachEditor, Display, TEXT("Loaded %d old GAS packages into the tag usage index"), OldPackages.Num());
+
+	OldPackages.Reset();
+	NextOldPackage = 0;
+	NumOldPackagesDone = 0;
+
+	Save();
+	ChangedEvent.Broadcast();
+}
+
+bool FGASTagUsageIndex::ExtractLoaded(const UObject* InAsset)
+{
+	const UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	if (!Blueprint || !FGASTagUsageExtractor::IsIndexedClass(Blueprint->GeneratedClass))
+	{
+		return false;
+	}
+
+	const FName PackageName = Blueprint->GetOutermost()->GetFName();
+
+	FGASPackageTagUsages Usages;
+	if (TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageName))
+	{
+		Usages.Hash = PackageData->GetPackageSavedHash();
+	}
+	FGASTagUsageExtractor::ExtractObject(Blueprint->GeneratedClass->GetDefaultObject(), FSoftObjectPath(Blueprint), Usages.Entries);
+
+	SetPackage(PackageName, MoveTemp(Usages));
+	return true;
+}
+
+void FGASTagUsageIndex::SetPackage(FName InPackageName, FGASPackageTagUsages&& InUsages)
+{
+	if (const FGASPackageTagUsages* Existing = Packages.Find(InPackageName))
+	{
+		RemoveTagEntries(*Existing);
+	}
+
+	AddTagEntries(Packages.Add(InPackageName, MoveTemp(InUsages)));
+	bDirty = true;
+}
+
+void FGASTagUsageIndex::RemovePackage(FName InPackageName)
+{
+	FGASPackageTagUsages Existing;
+	if (Packages.RemoveAndCopyValue(InPackageName, Existing))
+	{
+		RemoveTagEntries(Existing);
+		bDirty = true;
+	}
+}
+
+void FGASTagUsageIndex::AddTagEntries(const FGASPackageTagUsages& InUsages)
+{
+	for (const FGASTagUsageEntry& Entry : InUsages.Entries)
+	{
+		TagEntries.FindOrAdd(Entry.TagName).Add(Entry);
+		UpdateTagTree(Entry.TagName, 1);
+	}
+}
+
+void FGASTagUsageIndex::RemoveTagEntries(const FGASPackageTagUsages& InUsages)
+{
+	for (const FGASTagUsageEntry& Entry : InUsages.Entries)
+	{
+		TArray<FGASTagUsageEntry>* Entries = TagEntries.Find(Entry.TagName);
+		if (!Entries)
+		{
+			continue;
+		}
+
+		const int32 NumRemoved = Entries->RemoveAll([&Entry](const FGASTagUsageEntry& Other)
+		{
+			return Other.AssetPath == Entry.AssetPath;
+		});
+
+		if (Entries->Num() == 0)
+		{
+			TagEntries.Remove(Entry.TagName);
+		}
+
+		if (NumRemoved > 0)
+		{
+			UpdateTagTree(Entry.TagName, -NumRemoved);
+		}
+	}
+}
+
+void FGASTagUsageIndex::UpdateTagTree(FName InTag, int32 InDelta)
+{
+	FName ChildTag;
+	bool bChildAdded = false;
+	bool bChildRemoved = false;
+	for (FName Tag = InTag; !Tag.IsNone(); Tag = GetParentTagName(Tag))
+	{
+		FTagNode* Node = TagTree.Find(Tag);
+		const bool bAdded = Node == nullptr;
+		if (bAdded)
+		{
+			Node = &TagTree.Add(Tag);
+		}
+
+		Node->SubtreeCount += InDelta;
+		if (bChildAdded)
+		{
+			Node->ChildTags.Add(ChildTag);
+		}
+		else if (bChildRemoved)
+		{
+			Node->ChildTags.RemoveSwap(ChildTag);
+		}
+
+		const bool bRemoved = Node->SubtreeCount <= 0;
+		if (bRemoved)
+		{
+			TagTree.Remove(Tag);
+		}
+
+		ChildTag = Tag;
+		bChildAdded = bAdded && !bRemoved;
+		bChildRemoved = bRemoved && !bAdded;
+	}
+}
+
+FString FGASTagUsageIndex::GetIndexFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GASAttachEditor") / TEXT("TagUsageIndex.bin");
+}
+
+bool FGASTagUsageIndex::Load()
+{
+	const FString Filename = GetIndexFilename();
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!FileReader.IsValid())
+	{
+		return false;
+	}
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	*FileReader << FileMagic;
+	*FileReader << FileVersion;
+	if (FileReader->IsError() || FileMagic != GASTagUsageIndexFile::Magic || FileVersion != GASTagUsageIndexFile::Version)
+	{
+		UE_LOG(LogGASAttachEditor, Log, TEXT("Ignoring tag usage index %s written by another version"), *Filename);
+		return false;
+	}
+
+	Serialize(*FileReader);
+	if (FileReader->IsError())
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Tag usage index %s is corrupt and will be rebuilt"), *Filename);
+		Packages.Reset();
+		TagEntries.Reset();
+		TagTree.Reset();
+		return false;
+	}
+
+	TagEntries.Reset();
+	TagTree.Reset();
+	for (const TPair<FName, FGASPackageTagUsages>& Package : Packages)
+	{
+		AddTagEntries(Package.Value);
+	}
+
+	UE_LOG(LogGASAttachEditor, Log, TEXT("Loaded tag usage index of %d GAS packages from %s"), Packages.Num(), *Filename);
+	return true;
+}
+
+bool FGASTagUsageIndex::Save()
+{
+	if (!bDirty)
+	{
+		return true;
+	}
+
+	const FString Filename = GetIndexFilename();
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Could not write tag usage index %s"), *Filename);
+		return false;
+	}
+
+	uint32 FileMagic = GASTagUsageIndexFile::Magic;
+	uint32 FileVersion = GASTagUsageIndexFile::Version;
+	*FileWriter << FileMagic;
+	*FileWriter << FileVersion;
+	Serialize(*FileWriter);
+
+	const bool bSucceeded = FileWriter->Close() && !FileWriter->IsError();
+	if (!bSucceeded)
+	{
+		UE_LOG(LogGASAttachEditor, Warning, TEXT("Failed to write tag usage index %s"), *Filename);
+		return false;
+	}
+
+	bDirty = false;
+	return true;
+}
+
+void FGASTagUsageIndex::Serialize(FArchive& Ar)
+{
+	int32 NumPackages = Packages.Num();
+	Ar << NumPackages;
+
+	if (Ar.IsLoading())
+	{
+		Packages.Reset();
+		if (NumPackages < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+
+		for (int32 Index = 0; Index < NumPackages && !Ar.IsError(); ++Index)
+		{
+			FString PackageName;
+			FGASPackageTagUsages Usages;
+			GASTagUsageIndexFile::SerializePackage(Ar, PackageName, Usages);
+			Packages.Add(FName(*PackageName), MoveTemp(Usages));
+		}
+		return;
+	}
+
+	for (TPair<FName, FGASPackageTagUsages>& Package : Packages)
+	{
+		FString PackageName = Package.Key.ToString();
+		GASTagUsageIndexFile::SerializePackage(Ar, PackageName, Package.Value);
+	}
+}
+
+void FGASTagUsageIndex::Reset()
+{
+	if (ActiveScan.IsValid())
+	{
+		ActiveScan->Cancel();
+		ActiveScan.Reset();
+	}
+
+	// 回调指向这个模块，关闭之前让还在进行的加载完成，回调因为序号对不上什么都不做
+	// The callbacks point into this module; in-flight loads finish before shutdown and their callbacks do nothing since the serial no longer matches
+	const bool bHadOldAssetLoads = NumOldPackagesLoading > 0;
+	++OldPackagesSerial;
+	OldPackages.Reset();
+	NextOldPackage = 0;
+	NumOldPackagesLoading = 0;
+	NumOldPackagesDone = 0;
+	if (bHadOldAssetLoads)
+	{
+		FlushAsyncLoading();
+	}
+
+	UnbindAssetEvents();
+
+	if (FlushTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+		FlushTickerHandle.Reset();
+	}
+	QueuedPackages.Reset();
+
+	if (FilesLoadedHandle.IsValid())
+	{
+		if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+		{
+			AssetRegistry->OnFilesLoaded().Remove(FilesLoadedHandle);
+		}
+		FilesLoadedHandle.Reset();
+	}
+
+	Save();
+
+	Packages.Reset();
+	TagEntries.Reset();
+	TagTree.Reset();
+	ChangedEvent.Clear();
+	bLoaded = false;
+	bBuilt = false;
+	bBuilding = false;
+	bDirty = false;
+}
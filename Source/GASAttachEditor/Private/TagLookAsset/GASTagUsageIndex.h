@@ -0,0 +1,233 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Containers/Ticker.h"
+#include "UObject/UObjectGlobals.h"
+#include "TagLookAsset/GASTagUsageScan.h"
+
+class FArchive;
+class UPackage;
+class FObjectPostSaveContext;
+struct FAssetData;
+
+// 标签使用索引文件格式: Magic | 版本 | 包数 | (包名 | 保存哈希 | 条目数 | (标签 | 资源 | 使用方式 | 触发方式 | 是否精确)...)...
+//
+// Tag usage index file layout: Magic | Version | Package count | (Package name | Saved hash | Entry count | (Tag | Asset | Usage | Source | Exact)...)...
+namespace GASTagUsageIndexFile
+{
+	constexpr uint32 Magic = 0x58445554;
+
+	constexpr uint32 Version = 1;
+}
+
+// 标签 -> 使用它的技能、效果和 Cue Notify 的持久索引，按使用方式区分，保存在 Saved/GASAttachEditor/TagUsageIndex.bin
+// 每个GAS资源包按保存哈希记录，打开编辑器后只重新提取哈希变了的包，查询只查内存里的表
+// 用到的标签另外组成一棵树，每个节点记着子树的使用数量，查询父标签只走有使用的分支
+// 构建之后跟着资源注册表和包保存事件增量更新: 只记下变了的包，安静一段时间之后一起在后台提取，源码管理同步这类大批改动也只提取一次
+// (GASAttachEditor.TagUsageIndex.QuietSeconds, 持续不断的改动最多等 MaxDelaySeconds)
+//
+// Persistent index from tag to the abilities, effects and cue notifies using it, by usage kind, stored in Saved/GASAttachEditor/TagUsageIndex.bin
+// Every GAS package is recorded with its saved hash; after the editor starts only packages whose hash changed are extracted again, and queries only read the in-memory table
+// The used tags also form a tree whose nodes keep their subtree usage count, so a query on a parent tag only walks the branches that have usages
+// Once built it follows asset registry and package saved events: changed packages are only queued, then extracted together in the background after a quiet period, so a source control sync touching thousands of assets is extracted once
+// (GASAttachEditor.TagUsageIndex.QuietSeconds, at most MaxDelaySeconds during a continuous burst)
+//
+// 导出之前保存的资源在注册表里只有引用。构建完之后在后台分批异步加载这些包一次，精确结果按保存哈希缓存在索引文件里，包没变就不再加载
+// Assets saved before the export only have references in the registry. After the build those packages are loaded asynchronously in batches once;
+// the exact results are cached in the index file by saved hash, so an unchanged package is never loaded again
+class FGASTagUsageIndex
+{
+public:
+
+	// 第一次调用时读入磁盘上的索引，然后在后台重新提取变了的包，已经在构建或者构建完时不做什么
+	// The first call reads the index from disk, then re-extracts the changed packages in the background; does nothing while building or once built
+	static void Build();
+
+	static void CancelBuild();
+
+	static bool IsBuilt() { return bBuilt; }
+
+	// 增量更新不算
+	// Incremental updates do not count
+	static bool IsBuilding() { return bBuilding; }
+
+	// 正在后台提取的扫描，没有时为空
+	// Scan extracting in the background, null while there is none
+	static TSharedPtr<FGASTagUsageScan> GetActiveScan() { return ActiveScan; }
+
+	// 使用的标签是筛选标签本身、它下面的标签或者它的父标签时匹配，父标签和 HandleGameplayEvent 一样也会触发
+	// A used tag matches when it is a filter tag, a tag below one, or one of its parents, since parents trigger too as in HandleGameplayEvent
+	static void Query(const FGameplayTagContainer& InTags, TArray<FGASTagUsageEntry>& OutEntries);
+
+	// 标签自己和它下面所有标签的使用，只走标签树里有使用的节点
+	// Usages of a tag and every tag below it; only walks tag tree nodes that have usages
+	static void QuerySubtree(FName InTag, TArray<FGASTagUsageEntry>& OutEntries);
+
+	// 精确使用这个标签的条目
+	// Entries using exactly this tag
+	static const TArray<FGASTagUsageEntry>* FindEntries(FName InTag) { return TagEntries.Find(InTag); }
+
+	// 标签自己和它下面所有标签的使用数量，在标签树里预先算好
+	// Number of usages of a tag and every tag below it, precomputed in the tag tree
+	static int32 GetSubtreeCount(FName InTag);
+
+	// 标签树里直接的子标签，只有下面有使用的才在
+	// Direct children in the tag tree; only those with usages below them are present
+	static const TArray<FName>* GetChildTags(FName InTag);
+
+	// 按标签名里的点取父标签，标签不需要还注册着
+	// Parent tag taken from the dots in the tag name; the tag does not have to still be registered
+	static FName GetParentTagName(FName InTag);
+
+	// 用户打开资源之后用精确的结果替换
+	// Replaced with exact results once the user opened the asset
+	static void AddLoaded(const UObject* InAsset);
+
+	// 在后台分批异步加载还没有精确结果的包，可以取消，进度可以在游戏线程读取
+	// Loads the packages still without exact results asynchronously in batches; can be cancelled and its progress read on the game thread
+	static void LoadOldAssets();
+
+	static void CancelLoadOldAssets();
+
+	static bool IsLoadingOldAssets() { return OldPackages.Num() > 0; }
+
+	static int32 GetNumOldAssetsDone() { return NumOldPackagesDone; }
+
+	static int32 GetNumOldAssetsTotal() { return OldPackages.Num(); }
+
+	// 索引内容变化时广播
+	// Broadcast whenever the contents of the index change
+	static FSimpleMulticastDelegate& OnChanged() { return ChangedEvent; }
+
+	static int32 GetNumPackages() { return Packages.Num(); }
+
+	static const TMap<FName, FGASPackageTagUsages>& GetPackages() { return Packages; }
+
+	static FString GetIndexFilename();
+
+	// 模块关闭时调用，有改动时先写盘
+	// Called on module shutdown; writes the index first when it changed
+	static void Reset();
+
+private:
+
+	static void StartScan();
+
+	static void BindAssetEvents();
+
+	static void UnbindAssetEvents();
+
+	static void HandleAssetAdded(const FAssetData& InAssetData);
+
+	static void HandleAssetRemoved(const FAssetData& InAssetData);
+
+	static void HandleAssetRenamed(const FAssetData& InAssetData, const FString& InOldObjectPath);
+
+	static void HandleAssetUpdated(const FAssetData& InAssetData);
+
+#if WITH_EDITOR
+	static void HandlePackageSaved(const FString& InFilename, UPackage* InPackage, FObjectPostSaveContext InContext);
+#endif
+
+	// 记下要重新提取的包，由 HandleFlushTicker 合并处理
+	// Queues a package for extraction; merged by HandleFlushTicker
+	static void QueuePackage(FName InPackageName);
+
+	static bool HandleFlushTicker(float InDeltaTime);
+
+	static void HandleScanFinished(FGASTagUsageScan& InScan);
+
+	static void SetPackage(FName InPackageName, FGASPackageTagUsages&& InUsages);
+
+	static void RemovePackage(FName InPackageName);
+
+	static void AddTagEntries(const FGASPackageTagUsages& InUsages);
+
+	static void RemoveTagEntries(const FGASPackageTagUsages& InUsages);
+
+	// 给标签和它所有父标签的子树数量加上 InDelta，新的节点挂到父节点下，数量为零的节点删掉
+	// Adds InDelta to the subtree count of the tag and all its parents, links new nodes under their parent and drops nodes whose count reaches zero
+	static void UpdateTagTree(FName InTag, int32 InDelta);
+
+	// 补足正在加载的包，直到 GASAttachEditor.TagUsageIndex.LoadBatchSize 个
+	// Tops up the packages being loaded to GASAttachEditor.TagUsageIndex.LoadBatchSize
+	static void LoadNextOldAssets();
+
+	static void HandleOldAssetLoaded(const FName& InPackageName, UPackage* InPackage, EAsyncLoadingResult::Type InResult, uint32 InSerial);
+
+	// 不广播，调用的人在合适的时候广播一次
+	// Does not broadcast; the caller broadcasts once when appropriate
+	static bool ExtractLoaded(const UObject* InAsset);
+
+	static bool Load();
+
+	static bool Save();
+
+	static void Serialize(FArchive& Ar);
+
+private:
+
+	static TMap<FName, FGASPackageTagUsages> Packages;
+
+	static TMap<FName, TArray<FGASTagUsageEntry>> TagEntries;
+
+	struct FTagNode
+	{
+		TArray<FName> ChildTags;
+
+		int32 SubtreeCount = 0;
+	};
+
+	// 用到的标签和它们的父标签组成的树
+	// Tree of the used tags and their parents
+	static TMap<FName, FTagNode> TagTree;
+
+	static TSharedPtr<FGASTagUsageScan> ActiveScan;
+
+	static FSimpleMulticastDelegate ChangedEvent;
+
+	static FDelegateHandle FilesLoadedHandle;
+
+	static FDelegateHandle AssetAddedHandle;
+
+	static FDelegateHandle AssetRemovedHandle;
+
+	static FDelegateHandle AssetRenamedHandle;
+
+	static FDelegateHandle AssetUpdatedHandle;
+
+	static FDelegateHandle PackageSavedHandle;
+
+	static FTSTicker::FDelegateHandle FlushTickerHandle;
+
+	static TSet<FName> QueuedPackages;
+
+	static double FirstQueuedTime;
+
+	static double LastQueuedTime;
+
+	// 后台加载的包，下一个要加载的位置，正在加载和已经完成的数量
+	// Packages of the background load, the next one to load, and how many are loading and done
+	static TArray<FName> OldPackages;
+
+	static int32 NextOldPackage;
+
+	static int32 NumOldPackagesLoading;
+
+	static int32 NumOldPackagesDone;
+
+	// 取消后加一，旧的加载回调对不上就忽略
+	// Incremented on cancel; load callbacks with an older value are ignored
+	static uint32 OldPackagesSerial;
+
+	static bool bLoaded;
+
+	static bool bBuilt;
+
+	// 当前的扫描是构建，不是增量更新
+	// The active scan is the build rather than an incremental update
+	static bool bBuilding;
+
+	static bool bDirty;
+};
@@ -0,0 +1,568 @@
+#include "TagLookAsset/GASTagUsageScan.h"
+#include "Abilities/GameplayAbility.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Blueprint.h"
+#include "GameplayCueNotify_Actor.h"
+#include "GameplayCueNotify_Static.h"
+#include "GameplayEffect.h"
+#include "GameplayTagContainer.h"
+#include "Misc/PackageName.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectIterator.h"
+#if WITH_EDITOR
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
+#include "GASAttachEditorLog.h"
+#include "GASAttachEditorStats.h"
+
+#define LOCTEXT_NAMESPACE "SGASAttachEditor"
+
+const FName FGASTagUsageExtractor::AssetRegistryTagName(TEXT("GASTagUsage"));
+TSet<FString> FGASTagUsageExtractor::NativeClassPaths;
+FDelegateHandle FGASTagUsageExtractor::ExtraObjectTagsHandle;
+
+namespace GASTagUsageScan
+{
+	// 没有使用标签的资源也写一个值，和没有导出过的资源区分开
+	// Assets using no tag still get a value, to tell them apart from assets never exported
+	const TCHAR* NoUsages = TEXT("None");
+
+	// 实例化子对象(比如效果组件)最多往下找几层
+	// How deep instanced subobjects (such as effect components) are followed
+	constexpr int32 MaxObjectDepth = 4;
+
+	const TCHAR* const UsageNames[] =
+	{
+		TEXT("Trigger"),
+		TEXT("AbilityTags"),
+		TEXT("CancelAbilitiesWithTag"),
+		TEXT("BlockAbilitiesWithTag"),
+		TEXT("ActivationOwnedTags"),
+		TEXT("ActivationRequiredTags"),
+		TEXT("ActivationBlockedTags"),
+		TEXT("SourceTags"),
+		TEXT("TargetTags"),
+		TEXT("EffectAssetTags"),
+		TEXT("EffectGrantedTags"),
+		TEXT("EffectApplicationTags"),
+		TEXT("EffectRemovalTags"),
+		TEXT("GameplayCue"),
+		TEXT("Other"),
+	};
+	static_assert(UE_ARRAY_COUNT(UsageNames) == static_cast<int32>(EGASTagUsage::Num), "One name per usage");
+
+	FName GetGameplayTagStructName()
+	{
+		static const FName StructName = FGameplayTag::StaticStruct()->GetFName();
+		return StructName;
+	}
+
+	// 属性名 -> 使用方式，效果的属性在 5.3 之后移到了效果组件上，新旧名字都列出来
+	// Property name -> usage; effect properties moved to effect components in 5.3, so both old and new names are listed
+	EGASTagUsage FindPropertyUsage(FName InPropertyName)
+	{
+		static const TMap<FName, EGASTagUsage> PropertyUsages =
+		{
+			{ TEXT("AbilityTags"), EGASTagUsage::AbilityTags },
+			{ TEXT("CancelAbilitiesWithTag"), EGASTagUsage::CancelAbilitiesWithTag },
+			{ TEXT("BlockAbilitiesWithTag"), EGASTagUsage::BlockAbilitiesWithTag },
+			{ TEXT("ActivationOwnedTags"), EGASTagUsage::ActivationOwnedTags },
+			{ TEXT("ActivationRequiredTags"), EGASTagUsage::ActivationRequiredTags },
+			{ TEXT("ActivationBlockedTags"), EGASTagUsage::ActivationBlockedTags },
+			{ TEXT("SourceRequiredTags"), EGASTagUsage::SourceTags },
+			{ TEXT("SourceBlockedTags"), EGASTagUsage::SourceTags },
+			{ TEXT("TargetRequiredTags"), EGASTagUsage::TargetTags },
+			{ TEXT("TargetBlockedTags"), EGASTagUsage::TargetTags },
+			{ TEXT("InheritableGameplayEffectTags"), EGASTagUsage::EffectAssetTags },
+			{ TEXT("InheritableAssetTags"), EGASTagUsage::EffectAssetTags },
+			{ TEXT("InheritableOwnedTagsContainer"), EGASTagUsage::EffectGrantedTags },
+			{ TEXT("InheritableGrantedTagsContainer"), EGASTagUsage::EffectGrantedTags },
+			{ TEXT("ApplicationTagRequirements"), EGASTagUsage::EffectApplicationTags },
+			{ TEXT("OngoingTagRequirements"), EGASTagUsage::EffectApplicationTags },
+			{ TEXT("RemovalTagRequirements"), EGASTagUsage::EffectRemovalTags },
+			{ TEXT("RemoveGameplayEffectsWithTags"), EGASTagUsage::EffectRemovalTags },
+			{ TEXT("RemoveGameplayEffectQuery"), EGASTagUsage::EffectRemovalTags },
+			{ TEXT("RemoveGameplayEffectQueries"), EGASTagUsage::EffectRemovalTags },
+			{ TEXT("GameplayCues"), EGASTagUsage::GameplayCue },
+			{ TEXT("GameplayCueTag"), EGASTagUsage::GameplayCue },
+		};
+
+		const EGASTagUsage* Usage = PropertyUsages.Find(InPropertyName);
+		return Usage ? *Usage : EGASTagUsage::Other;
+	}
+
+	using FUsageSet = TSet<TPair<FName, EGASTagUsage>>;
+
+	void CollectObject(const UObject* InObject, const UObject* InRoot, int32 InDepth, FUsageSet& OutUsages);
+
+	void CollectValue(const FProperty* InProperty, const void* InValue, EGASTagUsage InUsage, const UObject* InRoot, int32 InDepth, FUsageSet& OutUsages)
+	{
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(InProperty))
+		{
+			const UScriptStruct* Struct = StructProperty->Struct;
+			if (Struct == FGameplayTag::StaticStruct())
+			{
+				const FGameplayTag& Tag = *static_cast<const FGameplayTag*>(InValue);
+				if (Tag.IsValid())
+				{
+					OutUsages.Add(MakeTuple(Tag.GetTagName(), InUsage));
+				}
+			}
+			else if (Struct == FGameplayTagContainer::StaticStruct())
+			{
+				for (const FGameplayTag& Tag : *static_cast<const FGameplayTagContainer*>(InValue))
+				{
+					OutUsages.Add(MakeTuple(Tag.GetTagName(), InUsage));
+				}
+			}
+			else if (Struct == FGameplayTagQuery::StaticStruct())
+			{
+				for (const FGameplayTag& Tag : static_cast<const FGameplayTagQuery*>(InValue)->GetGameplayTagArray())
+				{
+					OutUsages.Add(MakeTuple(Tag.GetTagName(), InUsage));
+				}
+			}
+			else
+			{
+				for (TFieldIterator<FProperty> It(Struct); It; ++It)
+				{
+					for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+					{
+						CollectValue(*It, It->ContainerPtrToValuePtr<void>(InValue, Index), InUsage, InRoot, InDepth, OutUsages);
+					}
+				}
+			}
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(InProperty))
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, InValue);
+			for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+			{
+				CollectValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index), InUsage, InRoot, InDepth, OutUsages);
+			}
+		}
+		else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(InProperty))
+		{
+			// 只跟进自己的子对象，不跟进引用的其他资源
+			// Only the object's own subobjects are followed, not other assets it references
+			const UObject* SubObject = ObjectProperty->GetObjectPropertyValue(InValue);
+			if (SubObject && SubObject != InRoot && SubObject->IsIn(InRoot) && InDepth < MaxObjectDepth)
+			{
+				CollectObject(SubObject, InRoot, InDepth + 1, OutUsages);
+			}
+		}
+	}
+
+	void CollectObject(const UObject* InObject, const UObject* InRoot, int32 InDepth, FUsageSet& OutUsages)
+	{
+		static const FName AbilityTriggersName(TEXT("AbilityTriggers"));
+
+		for (TFieldIterator<FProperty> It(InObject->GetClass()); It; ++It)
+		{
+			// 触发标签带触发方式，单独处理
+			// Trigger tags carry their source and are handled separately
+			if (It->GetFName() == AbilityTriggersName)
+			{
+				continue;
+			}
+
+			const EGASTagUsage Usage = FindPropertyUsage(It->GetFName());
+			for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+			{
+				CollectValue(*It, It->ContainerPtrToValuePtr<void>(InObject, Index), Usage, InRoot, InDepth, OutUsages);
+			}
+		}
+	}
+}
+
+const TCHAR* GASTagUsage::ToName(EGASTagUsage InUsage)
+{
+	const int32 Index = static_cast<int32>(InUsage);
+	return Index < static_cast<int32>(EGASTagUsage::Num) ? GASTagUsageScan::UsageNames[Index] : GASTagUsageScan::UsageNames[static_cast<int32>(EGASTagUsage::Other)];
+}
+
+EGASTagUsage GASTagUsage::FromName(const FString& InName)
+{
+	for (int32 Index = 0; Index < static_cast<int32>(EGASTagUsage::Num); ++Index)
+	{
+		if (InName == GASTagUsageScan::UsageNames[Index])
+		{
+			return static_cast<EGASTagUsage>(Index);
+		}
+	}
+	return EGASTagUsage::Other;
+}
+
+FText GASTagUsage::GetDisplayText(EGASTagUsage InUsage)
+{
+	switch (InUsage)
+	{
+	//case EGASTagUsage::Trigger:					return LOCTEXT("TagUsageTrigger", "触发技能");
+	case EGASTagUsage::Trigger:					return LOCTEXT("TagUsageTrigger", "Ability Triggers");
+	case EGASTagUsage::AbilityTags:				return LOCTEXT("TagUsageAbilityTags", "Ability Tags");
+	case EGASTagUsage::CancelAbilitiesWithTag:	return LOCTEXT("TagUsageCancelAbilities", "Cancel Abilities With Tag");
+	case EGASTagUsage::BlockAbilitiesWithTag:	return LOCTEXT("TagUsageBlockAbilities", "Block Abilities With Tag");
+	case EGASTagUsage::ActivationOwnedTags:		return LOCTEXT("TagUsageActivationOwned", "Activation Owned Tags");
+	case EGASTagUsage::ActivationRequiredTags:	return LOCTEXT("TagUsageActivationRequired", "Activation Required Tags");
+	case EGASTagUsage::ActivationBlockedTags:	return LOCTEXT("TagUsageActivationBlocked", "Activation Blocked Tags");
+	case EGASTagUsage::SourceTags:				return LOCTEXT("TagUsageSourceTags", "Source Required/Blocked Tags");
+	case EGASTagUsage::TargetTags:				return LOCTEXT("TagUsageTargetTags", "Target Required/Blocked Tags");
+	case EGASTagUsage::EffectAssetTags:			return LOCTEXT("TagUsageEffectAsset", "Effect Asset Tags");
+	case EGASTagUsage::EffectGrantedTags:		return LOCTEXT("TagUsageEffectGranted", "Effect Granted Tags");
+	case EGASTagUsage::EffectApplicationTags:	return LOCTEXT("TagUsageEffectApplication", "Effect Application Requirements");
+	case EGASTagUsage::EffectRemovalTags:		return LOCTEXT("TagUsageEffectRemoval", "Effect Removal Tags");
+	case EGASTagUsage::GameplayCue:				return LOCTEXT("TagUsageGameplayCue", "Gameplay Cues");
+	default:									break;
+	}
+	//return LOCTEXT("TagUsageOther", "其他引用");
+	return LOCTEXT("TagUsageOther", "Other References");
+}
+
+void FGASTagUsageExtractor::Startup()
+{
+#if WITH_EDITOR
+	ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&FGASTagUsageExtractor::HandleGetExtraObjectTags);
+#endif
+}
+
+void FGASTagUsageExtractor::Shutdown()
+{
+#if WITH_EDITOR
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(ExtraObjectTagsHandle);
+#endif
+	ExtraObjectTagsHandle.Reset();
+
+	// 工作线程还在读 NativeClassPaths 时不能清空
+	// NativeClassPaths must not be cleared while workers still read it
+	FGASTagUsageScan::CancelAndWaitAll();
+	NativeClassPaths.Reset();
+}
+
+#if WITH_EDITOR
+void FGASTagUsageExtractor::HandleGetExtraObjectTags(FAssetRegistryTagsContext InContext)
+{
+	// 反射遍历只在保存和完整更新时做，编辑器里其他时候也会频繁查询注册表标签
+	// The reflection walk only runs on save and full updates; the editor also queries registry tags often at other times
+	if (!InContext.IsSaving() && !InContext.IsFullUpdate())
+	{
+		return;
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(InContext.GetObject());
+	if (!Blueprint || !IsIndexedClass(Blueprint->GeneratedClass))
+	{
+		return;
+	}
+
+	TArray<FGASTagUsageEntry> Entries;
+	ExtractObject(Blueprint->GeneratedClass->GetDefaultObject(), FSoftObjectPath(Blueprint), Entries);
+	InContext.AddTag(UObject::FAssetRegistryTag(AssetRegistryTagName, FormatUsages(Entries), UObject::FAssetRegistryTag::TT_Hidden));
+}
+#endif
+
+bool FGASTagUsageExtractor::IsIndexedClass(const UClass* InClass)
+{
+	return InClass && (InClass->IsChildOf(UGameplayAbility::StaticClass())
+		|| InClass->IsChildOf(UGameplayEffect::StaticClass())
+		|| InClass->IsChildOf(UGameplayCueNotify_Static::StaticClass())
+		|| InClass->IsChildOf(AGameplayCueNotify_Actor::StaticClass()));
+}
+
+void FGASTagUsageExtractor::CacheNativeClasses()
+{
+	check(IsInGameThread());
+
+	if (NativeClassPaths.Num() > 0)
+	{
+		return;
+	}
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsNative() && IsIndexedClass(*It))
+		{
+			NativeClassPaths.Add(It->GetPathName());
+		}
+	}
+}
+
+bool FGASTagUsageExtractor::IsIndexedAsset(const FAssetData& InAssetData)
+{
+	return InAssetData.FindTag(AssetRegistryTagName) || IsIndexedBlueprint(InAssetData);
+}
+
+bool FGASTagUsageExtractor::IsIndexedBlueprint(const FAssetData& InAssetData)
+{
+	FString NativeParentClass;
+	if (!InAssetData.GetTagValue(FBlueprintTags::NativeParentClassPath, NativeParentClass))
+	{
+		return false;
+	}
+
+	return NativeClassPaths.Contains(FPackageName::ExportTextPathToObjectPath(NativeParentClass));
+}
+
+void FGASTagUsageExtractor::ExtractPackage(const IAssetRegistry& InAssetRegistry, FName InPackageName, FGASPackageTagUsages& OutUsages)
+{
+	OutUsages.Entries.Reset();
+	OutUsages.bFound = false;
+
+	if (TOptional<FAssetPackageData> PackageData = InAssetRegistry.GetAssetPackageDataCopy(InPackageName))
+	{
+		OutUsages.Hash = PackageData->GetPackageSavedHash();
+	}
+
+	TArray<FAssetData> Assets;
+	InAssetRegistry.GetAssetsByPackageName(InPackageName, Assets, true);
+
+	const FAssetData* Indexed = nullptr;
+	for (const FAssetData& Asset : Assets)
+	{
+		FString Value;
+		if (Asset.GetTagValue(AssetRegistryTagName, Value))
+		{
+			OutUsages.bFound = true;
+			ParseUsages(Value, Asset.GetSoftObjectPath(), OutUsages.Entries);
+			return;
+		}
+
+		if (!Indexed && IsIndexedBlueprint(Asset))
+		{
+			Indexed = &Asset;
+		}
+	}
+
+	if (!Indexed)
+	{
+		return;
+	}
+	OutUsages.bFound = true;
+
+	// 旧资源: 只知道引用了哪些标签，不知道怎么用的
+	// Old asset: only the referenced tags are known, not how they are used
+	TArray<FAssetIdentifier> Dependencies;
+	InAssetRegistry.GetDependencies(FAssetIdentifier(InPackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::SearchableName);
+
+	for (const FAssetIdentifier& Dependency : Dependencies)
+	{
+		if (Dependency.ObjectName != GASTagUsageScan::GetGameplayTagStructName() || Dependency.ValueName.IsNone())
+		{
+			continue;
+		}
+
+		FGASTagUsageEntry& Entry = OutUsages.Entries.AddDefaulted_GetRef();
+		Entry.TagName = Dependency.ValueName;
+		Entry.AssetPath = Indexed->GetSoftObjectPath();
+		Entry.Usage = EGASTagUsage::Other;
+		Entry.bExact = false;
+	}
+}
+
+void FGASTagUsageExtractor::ExtractObject(const UObject* InDefaultObject, const FSoftObjectPath& InAssetPath, TArray<FGASTagUsageEntry>& OutEntries)
+{
+	if (!InDefaultObject)
+	{
+		return;
+	}
+
+	if (const TArray<FAbilityTriggerData>* Triggers = GetAbilityTriggers(Cast<UGameplayAbility>(InDefaultObject)))
+	{
+		for (const FAbilityTriggerData& Trigger : *Triggers)
+		{
+			if (!Trigger.TriggerTag.IsValid())
+			{
+				continue;
+			}
+
+			FGASTagUsageEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			Entry.TagName = Trigger.TriggerTag.GetTagName();
+			Entry.AssetPath = InAssetPath;
+			Entry.Usage = EGASTagUsage::Trigger;
+			Entry.Source = Trigger.TriggerSource;
+		}
+	}
+
+	// 同一个标签同一种用法只记一次，比如效果组件和已弃用的旧属性里的同一个标签
+	// One entry per tag and usage, e.g. the same tag in an effect component and in the deprecated property it replaced
+	GASTagUsageScan::FUsageSet Usages;
+	GASTagUsageScan::CollectObject(InDefaultObject, InDefaultObject, 0, Usages);
+
+	for (const TPair<FName, EGASTagUsage>& Usage : Usages)
+	{
+		FGASTagUsageEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.TagName = Usage.Key;
+		Entry.AssetPath = InAssetPath;
+		Entry.Usage = Usage.Value;
+	}
+}
+
+FString FGASTagUsageExtractor::FormatUsages(const TArray<FGASTagUsageEntry>& InEntries)
+{
+	const UEnum* SourceEnum = StaticEnum<EGameplayAbilityTriggerSource::Type>();
+
+	// Usage:Tag,Trigger:Tag:Source
+	FString Value;
+	for (const FGASTagUsageEntry& Entry : InEntries)
+	{
+		Value += Value.IsEmpty() ? TEXT("") : TEXT(",");
+		Value += FString(GASTagUsage::ToName(Entry.Usage)) + TEXT(":") + Entry.TagName.ToString();
+		if (Entry.Usage == EGASTagUsage::Trigger)
+		{
+			Value += TEXT(":") + SourceEnum->GetNameStringByValue(Entry.Source);
+		}
+	}
+
+	return Value.IsEmpty() ? GASTagUsageScan::NoUsages : Value;
+}
+
+void FGASTagUsageExtractor::ParseUsages(const FString& InValue, const FSoftObjectPath& InAssetPath, TArray<FGASTagUsageEntry>& OutEntries)
+{
+	if (InValue == GASTagUsageScan::NoUsages)
+	{
+		return;
+	}
+
+	const UEnum* SourceEnum = StaticEnum<EGameplayAbilityTriggerSource::Type>();
+
+	TArray<FString> Usages;
+	InValue.ParseIntoArray(Usages, TEXT(","));
+
+	TArray<FString> Fields;
+	for (const FString& Usage : Usages)
+	{
+		Usage.ParseIntoArray(Fields, TEXT(":"), false);
+		if (Fields.Num() < 2)
+		{
+			continue;
+		}
+
+		FGASTagUsageEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Usage = GASTagUsage::FromName(Fields[0]);
+		Entry.TagName = FName(*Fields[1]);
+		Entry.AssetPath = InAssetPath;
+
+		if (Entry.Usage == EGASTagUsage::Trigger && Fields.Num() > 2)
+		{
+			const int64 Source = SourceEnum->GetValueByNameString(Fields[2]);
+			Entry.Source = Source == INDEX_NONE ? EGameplayAbilityTriggerSource::GameplayEvent : static_cast<EGameplayAbilityTriggerSource::Type>(Source);
+		}
+	}
+}
+
+const TArray<FAbilityTriggerData>* FGASTagUsageExtractor::GetAbilityTriggers(const UGameplayAbility* InAbility)
+{
+	// AbilityTriggers 是 protected 的，通过反射访问
+	// AbilityTriggers is protected and is reached through reflection
+	static FArrayProperty* Property = FindFProperty<FArrayProperty>(UGameplayAbility::StaticClass(), TEXT("AbilityTriggers"));
+	if (!Property || !InAbility)
+	{
+		return nullptr;
+	}
+
+	return Property->ContainerPtrToValuePtr<TArray<FAbilityTriggerData>>(InAbility);
+}
+
+TArray<TWeakPtr<FGASTagUsageScan>> FGASTagUsageScan::RunningScans;
+
+FGASTagUsageScan::FGASTagUsageScan()
+	:NumDone(0)
+	,bCancelled(false)
+	,bRunning(false)
+{
+}
+
+TSharedRef<FGASTagUsageScan> FGASTagUsageScan::Start(const TArray<FName>& InPackageNames, FOnGASTagUsageScanFinished InOnFinished)
+{
+	check(IsInGameThread());
+
+	FGASTagUsageExtractor::CacheNativeClasses();
+
+	TSharedRef<FGASTagUsageScan> Scan = MakeShareable(new FGASTagUsageScan());
+	Scan->PackageNames = InPackageNames;
+	Scan->OnFinished = InOnFinished;
+	Scan->Results.SetNum(InPackageNames.Num());
+	Scan->bRunning = true;
+
+	if (InPackageNames.Num() == 0)
+	{
+		Scan->Finish();
+		return Scan;
+	}
+
+	RunningScans.Add(Scan);
+
+	Scan->Task = UE::Tasks::Launch(TEXT("ScanGASTagUsage"), [Scan]()
+	{
+		Scan->Run();
+
+		AsyncTask(ENamedThreads::GameThread, [Scan]()
+		{
+			Scan->Finish();
+		});
+	});
+
+	return Scan;
+}
+
+void FGASTagUsageScan::Cancel()
+{
+	bCancelled = true;
+}
+
+void FGASTagUsageScan::CancelAndWaitAll()
+{
+	check(IsInGameThread());
+
+	for (const TWeakPtr<FGASTagUsageScan>& WeakScan : RunningScans)
+	{
+		if (TSharedPtr<FGASTagUsageScan> Scan = WeakScan.Pin())
+		{
+			Scan->Cancel();
+			Scan->Task.Wait();
+		}
+	}
+	RunningScans.Reset();
+}
+
+void FGASTagUsageScan::Run()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GASAttachEditor_TagUsageScan);
+
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	ParallelFor(PackageNames.Num(), [this, &AssetRegistry](int32 Index)
+	{
+		if (bCancelled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		FGASTagUsageExtractor::ExtractPackage(AssetRegistry, PackageNames[Index], Results[Index]);
+
+		NumDone.fetch_add(1, std::memory_order_relaxed);
+	});
+}
+
+void FGASTagUsageScan::Finish()
+{
+	check(IsInGameThread());
+
+	bRunning = false;
+	RunningScans.RemoveAll([this](const TWeakPtr<FGASTagUsageScan>& WeakScan)
+	{
+		return !WeakScan.IsValid() || WeakScan.HasSameObject(this);
+	});
+
+	if (bCancelled)
+	{
+		return;
+	}
+
+	UE_LOG(LogGASAttachEditor, Verbose, TEXT("Tag usage scan: %d packages extracted"), PackageNames.Num());
+
+	OnFinished.ExecuteIfBound(*this);
+}
+
+#undef LOCTEXT_NAMESPACE
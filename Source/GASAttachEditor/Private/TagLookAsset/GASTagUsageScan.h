@@ -0,0 +1,231 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "IO/IoHash.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+class IAssetRegistry;
+class UGameplayAbility;
+class FAssetRegistryTagsContext;
+struct FAssetData;
+
+// GAS资源使用一个标签的方式
+// How a GAS asset uses a tag
+enum class EGASTagUsage : uint8
+{
+	// 技能的 AbilityTriggers
+	// An ability's AbilityTriggers
+	Trigger,
+
+	AbilityTags,
+
+	CancelAbilitiesWithTag,
+
+	BlockAbilitiesWithTag,
+
+	ActivationOwnedTags,
+
+	ActivationRequiredTags,
+
+	ActivationBlockedTags,
+
+	// SourceRequiredTags / SourceBlockedTags
+	SourceTags,
+
+	// TargetRequiredTags / TargetBlockedTags
+	TargetTags,
+
+	EffectAssetTags,
+
+	EffectGrantedTags,
+
+	// 效果的 ApplicationTagRequirements / OngoingTagRequirements
+	// An effect's ApplicationTagRequirements / OngoingTagRequirements
+	EffectApplicationTags,
+
+	// 效果的 RemovalTagRequirements 和移除其他效果的标签
+	// An effect's RemovalTagRequirements and the tags it removes other effects with
+	EffectRemovalTags,
+
+	// 效果的 GameplayCues 和 Cue Notify 的 GameplayCueTag
+	// An effect's GameplayCues and a cue notify's GameplayCueTag
+	GameplayCue,
+
+	// 其他标签属性，或者导出之前保存的资源里的引用
+	// Any other tag property, or a reference in an asset saved before its usage was exported
+	Other,
+
+	Num,
+};
+
+namespace GASTagUsage
+{
+	// 注册表标签里用的名字，不随显示文本变化
+	// Name used in the registry tag; does not change with the display text
+	const TCHAR* ToName(EGASTagUsage InUsage);
+
+	EGASTagUsage FromName(const FString& InName);
+
+	FText GetDisplayText(EGASTagUsage InUsage);
+}
+
+// 一个GAS资源对一个标签的一次使用，不需要加载资源
+// One use of one tag by one GAS asset, known without loading the asset
+struct FGASTagUsageEntry
+{
+	FName TagName;
+
+	// 技能、效果或者 Cue Notify 蓝图资源
+	// Ability, effect or cue notify blueprint asset
+	FSoftObjectPath AssetPath;
+
+	EGASTagUsage Usage = EGASTagUsage::Trigger;
+
+	// 只对 Trigger 有意义
+	// Only meaningful for Trigger
+	TEnumAsByte<EGameplayAbilityTriggerSource::Type> Source = EGameplayAbilityTriggerSource::GameplayEvent;
+
+	// 为假时只知道资源引用了这个标签，资源是在导出使用方式之前保存的
+	// When false the asset is only known to reference the tag; it was saved before its usage was exported
+	bool bExact = true;
+};
+
+// 一个包的提取结果，按包的保存哈希缓存在索引里
+// Extraction result of one package, kept in the index by the package's saved hash
+struct FGASPackageTagUsages
+{
+	FIoHash Hash;
+
+	TArray<FGASTagUsageEntry> Entries;
+
+	// 包里有GAS资源，为假时这个包应该从索引里删除，不保存
+	// The package holds a GAS asset; when false the package should leave the index. Not saved
+	bool bFound = false;
+};
+
+// 不加载资源读取技能、效果和 Cue Notify 使用的标签
+// 保存蓝图时把默认对象上所有标签属性按使用方式写进资源注册表的标签里，读取时只查注册表
+// 效果的组件也算在内，注册表标签名是 GASTagUsage
+// 之前保存的资源退回到注册表里的 SearchableName 依赖，只知道引用了哪些标签
+//
+// Reads the tags used by abilities, effects and cue notifies without loading them
+// Saving a blueprint writes every tag property of its default object, by usage, to an asset registry tag, so reading only queries the registry
+// Effect components are included; the registry tag is named GASTagUsage
+// Assets saved before that fall back to the registry's SearchableName dependencies, which only tell which tags they reference
+class FGASTagUsageExtractor
+{
+public:
+
+	// 资源注册表里的标签名
+	// Name of the asset registry tag
+	static const FName AssetRegistryTagName;
+
+	// 模块启动/关闭时调用，在编辑器里挂上保存时导出标签的回调
+	// Called on module startup/shutdown; in the editor, hooks the export of the tag on save
+	static void Startup();
+	static void Shutdown();
+
+	// 可以在工作线程调用，只读注册表
+	// Safe to call on worker threads; only reads the registry
+	static void ExtractPackage(const IAssetRegistry& InAssetRegistry, FName InPackageName, FGASPackageTagUsages& OutUsages);
+
+	// 从已经加载的默认对象读取，保存时导出和用户点开资源之后都用它
+	// Reads a default object that is already loaded; used by the export on save and once the user opened an asset
+	static void ExtractObject(const UObject* InDefaultObject, const FSoftObjectPath& InAssetPath, TArray<FGASTagUsageEntry>& OutEntries);
+
+	static FString FormatUsages(const TArray<FGASTagUsageEntry>& InEntries);
+
+	static void ParseUsages(const FString& InValue, const FSoftObjectPath& InAssetPath, TArray<FGASTagUsageEntry>& OutEntries);
+
+	static const TArray<FAbilityTriggerData>* GetAbilityTriggers(const UGameplayAbility* InAbility);
+
+	// 技能、效果和 Cue Notify 的类
+	// Ability, effect and cue notify classes
+	static bool IsIndexedClass(const UClass* InClass);
+
+	// 在游戏线程收集原生GAS类的路径，之后工作线程用它判断旧资源是不是GAS资源
+	// Collects the paths of the native GAS classes on the game thread; workers then use them to tell whether an old asset is a GAS asset
+	static void CacheNativeClasses();
+
+	// 导出过使用方式，或者父类是技能、效果或 Cue Notify 的蓝图
+	// Blueprint whose usage was exported or whose parent class is an ability, effect or cue notify
+	static bool IsIndexedAsset(const FAssetData& InAssetData);
+
+private:
+
+	static bool IsIndexedBlueprint(const FAssetData& InAssetData);
+
+	static TSet<FString> NativeClassPaths;
+
+#if WITH_EDITOR
+	static void HandleGetExtraObjectTags(FAssetRegistryTagsContext InContext);
+#endif
+
+	static FDelegateHandle ExtraObjectTagsHandle;
+};
+
+class FGASTagUsageScan;
+
+DECLARE_DELEGATE_OneParam(FOnGASTagUsageScanFinished, FGASTagUsageScan& /*Scan*/)
+
+// 在工作线程上并行提取一组包的标签使用，可以取消，进度可以在游戏线程读取
+// 完成时在游戏线程回调，结果和包名一一对应
+//
+// Extracts the tag usage of a set of packages in parallel on worker threads; can be cancelled and its progress read on the game thread
+// The callback runs on the game thread once done, with one result per package name
+class FGASTagUsageScan : public TSharedFromThis<FGASTagUsageScan>
+{
+public:
+
+	static TSharedRef<FGASTagUsageScan> Start(const TArray<FName>& InPackageNames, FOnGASTagUsageScanFinished InOnFinished);
+
+	const TArray<FName>& GetPackageNames() const { return PackageNames; }
+
+	TArray<FGASPackageTagUsages>& GetResults() { return Results; }
+
+	// 取消后不再回调
+	// No callback once cancelled
+	void Cancel();
+
+	bool IsRunning() const { return bRunning; }
+
+	int32 GetNumDone() const { return NumDone.load(std::memory_order_relaxed); }
+
+	int32 GetNumTotal() const { return PackageNames.Num(); }
+
+	// 取消所有进行中的扫描并等工作线程结束，模块关闭时在释放扫描读取的数据之前调用
+	// Cancels every scan in flight and waits for its workers; called on module shutdown before the data the scans read is released
+	static void CancelAndWaitAll();
+
+private:
+
+	FGASTagUsageScan();
+
+	void Run();
+
+	void Finish();
+
+private:
+
+	TArray<FName> PackageNames;
+
+	// 每个包一个位置，工作线程各写各的
+	// One slot per package; each worker writes its own
+	TArray<FGASPackageTagUsages> Results;
+
+	FOnGASTagUsageScanFinished OnFinished;
+
+	std::atomic<int32> NumDone;
+
+	std::atomic<bool> bCancelled;
+
+	bool bRunning;
+
+	UE::Tasks::FTask Task;
+
+	// 只在游戏线程访问
+	// Only accessed on the game thread
+	static TArray<TWeakPtr<FGASTagUsageScan>> RunningScans;
+};
@@ -1,4 +1,5 @@
 #include "TagLookAsset/SGASLookAssetBase.h"
+#include "TagLookAsset/GASTagUsageIndex.h"
 #include "AbilitySystemComponent.h"
 #include "Widgets/Input/SButton.h"
 #if WITH_EDITOR
@@ -11,6 +12,7 @@
 #include "Widgets/Input/SHyperlink.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Layout/SBox.h"
+#include "Widgets/Views/SExpanderArrow.h"
 
 #define LOCTEXT_NAMESPACE "SGASAttachEditor"
 
@@ -23,36 +25,70 @@ FGASLookAsset::~FGASLookAsset()
 }
 
 
-TSharedRef<FGASLookAsset> FGASLookAsset::Create(UObject* AssObj, FAbilityTriggerData InActivationTag)
+TSharedRef<FGASLookAsset> FGASLookAsset::Create(const FGASTagUsageEntry& InEntry)
 {
-	return MakeShareable(new FGASLookAsset(AssObj,InActivationTag));
+	return MakeShareable(new FGASLookAsset(InEntry));
 }
 
 FText FGASLookAsset::GetTriggerSourceName() const
 {
-	return UEnum::GetDisplayValueAsText(ActivationTag.TriggerSource);
+	if (!Entry.bExact)
+	{
+		//return LOCTEXT("TriggerSourceNotIndexed", "引用了标签，重新保存后可知使用方式");
+		return LOCTEXT("TriggerSourceNotIndexed", "References the tag (resave or open to index)");
+	}
+
+	if (Entry.Usage != EGASTagUsage::Trigger)
+	{
+		return GASTagUsage::GetDisplayText(Entry.Usage);
+	}
+
+	return UEnum::GetDisplayValueAsText(Entry.Source);
 }
 
 FName FGASLookAsset::GetTagName() const
 {
-	return *ActivationTag.TriggerTag.ToString();
+	return Entry.TagName;
 }
 
 
 FName FGASLookAsset::GetAbilitieAsset() const
 {
-	return LookAssObj->GetFName();
+	return Entry.AssetPath.GetAssetFName();
 }
 
 UObject* FGASLookAsset::GetAbilitieAssetObj() const
 {
-	return LookAssObj;
+	// 只在用户点开时加载
+	// Only loaded once the user clicks through
+	UObject* Asset = Entry.AssetPath.TryLoad();
+	if (Asset && !Entry.bExact)
+	{
+		FGASTagUsageIndex::AddLoaded(Asset);
+	}
+	return Asset;
+}
+
+FGASLookAsset::FGASLookAsset(const FGASTagUsageEntry& InEntry)
+	:Entry(InEntry)
+{
 }
 
-FGASLookAsset::FGASLookAsset(UObject* AssObj, FAbilityTriggerData InActivationTag)
+TSharedRef<FGASLookAssetGroup> FGASLookAssetGroup::Create(const FText& InName, int32 InCount, FName InTagName)
+{
+	return MakeShareable(new FGASLookAssetGroup(InName, InCount, InTagName));
+}
+
+FText FGASLookAssetGroup::GetDisplayText() const
+{
+	return FText::Format(LOCTEXT("LookAssetGroup", "{0} ({1})"), Name, Count == INDEX_NONE ? ChildNodes.Num() : Count);
+}
+
+FGASLookAssetGroup::FGASLookAssetGroup(const FText& InName, int32 InCount, FName InTagName)
+	:Name(InName)
+	,Count(InCount)
+	,TagName(InTagName)
 {
-	LookAssObj = AssObj;
-	ActivationTag = InActivationTag;
 }
 
 void SGASLookAssetTreeItem::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
@@ -62,10 +98,9 @@ void SGASLookAssetTreeItem::Construct(const FArguments& InArgs, const TSharedRef
 
 	check(WidgetInfo.IsValid());
 
-	TagName = WidgetInfo->GetTagName();
+	TagText = WidgetInfo->GetDisplayText();
 
 	AbilitieAsset = WidgetInfo->GetAbilitieAsset();
-	LookAssObj = WidgetInfo->GetAbilitieAssetObj();
 	TriggerSourceName = WidgetInfo->GetTriggerSourceName();
 	SMultiColumnTableRow< TSharedRef<FGASLookAssetBase> >::Construct(SMultiColumnTableRow< TSharedRef<FGASLookAssetBase> >::FArguments().Padding(0), InOwnerTableView);
 }
@@ -74,18 +109,32 @@ TSharedRef<SWidget> SGASLookAssetTreeItem::GenerateWidgetForColumn(const FName&
 {
 	if (NAME_TagName == ColumnName)
 	{
-		return SNew(SBox)
+		return SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SExpanderArrow, SharedThis(this))
+			]
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
 			.HAlign(HAlign_Left)
 			.VAlign(VAlign_Center)
 			.Padding(FMargin(2.0f, 0.0f))
 			[
 				SNew(STextBlock)
-				.Text(FText::FromName(TagName))
+				.Text(TagText)
 				.Justification(ETextJustify::Center)
 			];
 	}
 	else if (NAME_AbilitieAsset == ColumnName)
 	{
+		if (AbilitieAsset.IsNone())
+		{
+			return SNullWidget::NullWidget;
+		}
+
 		return SNew(SBox)
 			.HAlign(HAlign_Left)
 			.VAlign(VAlign_Center)
@@ -125,6 +174,7 @@ TSharedRef<SWidget> SGASLookAssetTreeItem::GenerateWidgetForColumn(const FName&
 
 void SGASLookAssetTreeItem::HandleHyperlinkNavigate()
 {
+	UObject* LookAssObj = WidgetInfo->GetAbilitieAssetObj();
 	if (!LookAssObj) return;
 
 #if WITH_EDITOR
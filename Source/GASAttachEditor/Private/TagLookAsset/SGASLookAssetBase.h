@@ -6,6 +6,7 @@
 #include "Widgets/Views/STableViewBase.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Views/SListView.h"
+#include "TagLookAsset/GASTagUsageScan.h"
 
 
 static FName NAME_TagName(TEXT("TagName"));
@@ -29,17 +30,35 @@ public:
 	// Current asset name
 	virtual FName GetAbilitieAsset() const = 0;
 
-	// 资源指针
-	// Resource pointer
+	// 资源指针，没有加载时会加载
+	// Resource pointer; loads the asset when it is not loaded yet
 	virtual UObject* GetAbilitieAssetObj() const = 0;
 
 	// 当前Tag响应的事件发生器
 	// Event generator for current tag response
 	virtual FText GetTriggerSourceName() const = 0;
 
+	// 第一列显示的文本，分组节点显示组名和数量
+	// Text of the first column; group nodes show their name and count
+	virtual FText GetDisplayText() const { return FText::FromName(GetTagName()); }
+
 public:
 
 	FGASLookAssetBase(){};
+
+	// 将给定节点添加到此节点的子级列表中
+	// Adds the given node to the list of children of this node
+	void AddChildNode(TSharedRef<FGASLookAssetBase> InChildNode) { ChildNodes.Add(MoveTemp(InChildNode)); }
+
+	// 返回子条目的数组
+	// Returns an array of subentries
+	const TArray<TSharedRef<FGASLookAssetBase>>& GetChildNodes() const { return ChildNodes; }
+
+	TArray<TSharedRef<FGASLookAssetBase>>& GetChildNodes() { return ChildNodes; }
+
+protected:
+
+	TArray<TSharedRef<FGASLookAssetBase>> ChildNodes;
 };
 
 class SGASLookAssetTreeItem : public SMultiColumnTableRow<TSharedRef<FGASLookAssetBase>>
@@ -68,10 +87,9 @@ protected:
 	// Information about the widget we are visualizing
 	TSharedPtr<FGASLookAssetBase> WidgetInfo;
 
-	FName TagName;
+	FText TagText;
 	FName AbilitieAsset;
 	FText TriggerSourceName;
-	UObject* LookAssObj;
 };
 
 class FGASLookAsset : public FGASLookAssetBase
@@ -79,7 +97,7 @@ class FGASLookAsset : public FGASLookAssetBase
 public:
 	virtual ~FGASLookAsset() override;
 
-	static TSharedRef<FGASLookAsset> Create(UObject* AssObj, FAbilityTriggerData ActivationTag);
+	static TSharedRef<FGASLookAsset> Create(const FGASTagUsageEntry& InEntry);
 
 public:
 
@@ -91,11 +109,42 @@ public:
 	virtual FText GetTriggerSourceName() const override;
 private:
 
-	explicit FGASLookAsset(UObject* AssObj, FAbilityTriggerData ActivationTag);
+	explicit FGASLookAsset(const FGASTagUsageEntry& InEntry);
+
+protected:
+	FGASTagUsageEntry Entry;
+};
+
+// 分组节点: 标签树里的一个标签，或者按使用方式分的一组
+// Group node: one tag of the tag tree, or the entries of one usage kind
+class FGASLookAssetGroup : public FGASLookAssetBase
+{
+public:
+
+	// 数量为 INDEX_NONE 时显示子节点的数量
+	// Shows the number of child nodes when the count is INDEX_NONE
+	static TSharedRef<FGASLookAssetGroup> Create(const FText& InName, int32 InCount = INDEX_NONE, FName InTagName = NAME_None);
+
+public:
+
+	virtual FName GetTagName() const override { return TagName; }
+
+	virtual FName GetAbilitieAsset() const override { return NAME_None; }
+
+	virtual UObject* GetAbilitieAssetObj() const override { return nullptr; }
+
+	virtual FText GetTriggerSourceName() const override { return FText::GetEmpty(); }
+
+	virtual FText GetDisplayText() const override;
+
+private:
+
+	FGASLookAssetGroup(const FText& InName, int32 InCount, FName InTagName);
 
 protected:
-	UObject* LookAssObj;
-	FAbilityTriggerData ActivationTag;
+	FText Name;
+	int32 Count;
+	FName TagName;
 };
 
 DECLARE_DELEGATE_OneParam(FOnLookAssetDel,FGameplayTag)
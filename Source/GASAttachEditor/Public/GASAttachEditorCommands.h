@@ -1,28 +1,32 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Framework/Commands/Commands.h"
-#include "GASAttachEditorStyle.h"
-
-class FGASAttachEditorCommands : public TCommands<FGASAttachEditorCommands>
-{
-public:
-
-	FGASAttachEditorCommands()
-		: TCommands<FGASAttachEditorCommands>(TEXT("GASAttachEditor"), NSLOCTEXT("Contexts", "GASAttachEditor", /*"查看角色携带GA插件"*/"View GA Plugins Carried By Roles"), NAME_None, FGASAttachEditorStyle::GetStyleSetName())
-	{
-	}
-
-	// TCommands<> interface
-	virtual void RegisterCommands() override;
-
-public:
-	TSharedPtr< FUICommandInfo > ShowGASAttachEditorViewer;
-
-#if WITH_EDITOR
-	TSharedPtr< FUICommandInfo > ShowGASTagLookAssetViewer;
-#endif
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Commands/Commands.h"
+#include "GASAttachEditorStyle.h"
+
+class FGASAttachEditorCommands : public TCommands<FGASAttachEditorCommands>
+{
+public:
+
+	FGASAttachEditorCommands()
+		: TCommands<FGASAttachEditorCommands>(TEXT("GASAttachEditor"), NSLOCTEXT("Contexts", "GASAttachEditor", /*"查看角色携带GA插件"*/"View GA Plugins Carried By Roles"), NAME_None, FGASAttachEditorStyle::GetStyleSetName())
+	{
+	}
+
+	// TCommands<> interface
+	virtual void RegisterCommands() override;
+
+public:
+	TSharedPtr< FUICommandInfo > ShowGASAttachEditorViewer;
+
+	// 冻结帧快照的快捷键，可在编辑器偏好设置的快捷键里修改
+	// Freeze frame hotkey; can be rebound in the editor's keyboard shortcut preferences
+	TSharedPtr< FUICommandInfo > TakeFreezeFrame;
+
+#if WITH_EDITOR
+	TSharedPtr< FUICommandInfo > ShowGASTagLookAssetViewer;
+#endif
+
 };
\ No newline at end of file